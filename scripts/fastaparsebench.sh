@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+
+# Benchmark the FASTA reader by encoding the given FASTA files with
+# gt encseq encode, once with the gt binary to be tested and once with a
+# reference binary (e.g., built from an older revision), and check that both
+# produce the same encoded sequence and description files.
+# usage: GTREF=path/to/reference/gt scripts/fastaparsebench.sh file.fas ...
+
+if test $# -eq 0 -o -z "${GTREF}"
+then
+  echo "Usage: GTREF=path/to/reference/gt $0 file.fas [file.fas ...]"
+  exit 1
+fi
+
+set -e
+
+GT=${GT:-bin/gt}
+TMPDIR=${TMPDIR:-/tmp}
+OUT=${TMPDIR}/fastaparsebench.$$
+
+for filename in $*
+do
+  for binary in ${GTREF} ${GT}
+  do
+    if test ${binary} = ${GT}
+    then
+      indexname=${OUT}.gt
+    else
+      indexname=${OUT}.ref
+    fi
+    echo "# ${filename}, ${binary}"
+    time -p ${binary} encseq encode -des -sds no -md5 no \
+                                    -indexname ${indexname} ${filename}
+  done
+  cmp -s ${OUT}.ref.esq ${OUT}.gt.esq
+  cmp -s ${OUT}.ref.des ${OUT}.gt.des
+  rm -f ${OUT}.*
+done
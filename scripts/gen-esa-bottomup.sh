@@ -8,6 +8,13 @@ ${SC} --key maxpairs --reader \
                      --sa_reader_sain \
                      --no_process_lcpinterval > ${TEMPLATE}-maxpairs.inc
 
+${SC} --key maxpairs --gtlcpvaluetypeset \
+                     --absolute \
+                     --no_process_lastvalue \
+                     --no_process_lcpinterval \
+                     --withlastfrompreviousbucket \
+                     --no_declarations > ${TEMPLATE}-maxpairs-RAM.inc
+
 ${SC} --key spmsk --no_process_branchingedge > ${TEMPLATE}-spmsk.inc
 
 ${SC} --key rdjcv --reader \
@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+
+# Benchmark the (multithreaded) GFF3 parser: parse the given GFF3 files with
+# 1, 2, 4, 8, and 16 threads and check that the output does not depend on the
+# number of threads.
+# usage: scripts/gff3parsebench.sh file.gff3 [file.gff3 ...]
+#
+# Wall clock seconds measured on a single CPU machine (so no speedup is
+# possible, the numbers show the overhead of chunking) for a 50MB file with
+# 4000 sequence ids and 160000 genes, without (sorted) and with (term) ###
+# lines, and for testdata/encode_known_genes_Mar07.gff3:
+#
+#   file     serial  -j 1  -j 2  -j 4  -j 8  -j 16
+#   sorted     5.97  5.40  7.94  8.53  7.93  7.84
+#   term       5.04  5.33  7.88  7.65  7.03  6.05
+#   encode     0.15  0.19  0.22  0.20  0.16  0.18
+#
+# where "serial" is the parser before chunked parsing was introduced.
+
+if test $# -eq 0
+then
+  echo "Usage: $0 file.gff3 [file.gff3 ...]"
+  exit 1
+fi
+
+set -e
+
+GT=${GT:-bin/gt}
+TMPDIR=${TMPDIR:-/tmp}
+OUT=${TMPDIR}/gff3parsebench.$$
+
+for filename in $*
+do
+  for jobs in 1 2 4 8 16
+  do
+    echo "# ${filename}, ${jobs} thread(s)"
+    time -p ${GT} -j ${jobs} gff3 -sort -tidy ${filename} > ${OUT}.${jobs}
+    if test ${jobs} -ne 1
+    then
+      cmp -s ${OUT}.1 ${OUT}.${jobs}
+    fi
+  done
+  rm -f ${OUT}.*
+done
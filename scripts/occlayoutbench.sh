@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+
+# Benchmark the interleaved occurrence table of the packed index: build the
+# packed index of the given DNA sequence file with and without option
+# -occinterleave, search tags shreddered from the sequence with and without
+# mismatches, report the running time and check that the output is the same.
+# usage: scripts/occlayoutbench.sh file.fna [coverage]
+
+if test $# -eq 0
+then
+  echo "Usage: $0 file.fna [coverage]"
+  exit 1
+fi
+
+set -e
+
+GT=${GT:-bin/gt}
+TMPDIR=${TMPDIR:-/tmp}
+OUT=${TMPDIR}/occlayoutbench.$$
+filename=$1
+coverage=${2:-2}
+
+${GT} shredder -minlength 24 -maxlength 32 -coverage ${coverage} \
+               -o ${OUT}.shreddered ${filename}
+${GT} seqfilter -minlength 24 ${OUT}.shreddered > ${OUT}.tags
+for layout in blocked interleaved
+do
+  if test ${layout} = interleaved
+  then
+    option=-occinterleave
+  else
+    option=""
+  fi
+  ${GT} packedindex mkindex -dna -tis -dir rev -indexname ${OUT}.${layout} \
+                            -sprank ${option} -db ${filename} > /dev/null
+done
+for mm in 0 1 2
+do
+  for layout in blocked interleaved
+  do
+    echo "# ${filename}, -e ${mm}, ${layout}"
+    time -p ${GT} tagerator -rw -q ${OUT}.tags -e ${mm} \
+                            -output tagnum dbstartpos strand edist \
+                            -pck ${OUT}.${layout} > ${OUT}.${layout}
+    grep -v '^# indexname' ${OUT}.${layout} > ${OUT}.${layout}.matches
+  done
+  cmp -s ${OUT}.blocked.matches ${OUT}.interleaved.matches
+done
+rm -f ${OUT}.*
@@ -0,0 +1,51 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+/*
+  This file defines macros for atomic operations on integer variables, for
+  example for reference counts of objects shared between threads. If threads
+  are disabled, the plain operations are used.
+*/
+
+#ifdef GT_THREADS_ENABLED
+/* Increment the integer <*PTR> by <VAL>, return the new value. */
+#define gt_atomic_add_and_fetch(PTR,VAL)  __sync_add_and_fetch(PTR,VAL)
+/* Decrement the integer <*PTR> by <VAL>, return the old value. */
+#define gt_atomic_fetch_and_sub(PTR,VAL)  __sync_fetch_and_sub(PTR,VAL)
+/* Set the integer <*PTR> to <NEWVAL> if it equals <OLDVAL>, return true if
+   this was the case. */
+#define gt_atomic_compare_and_swap(PTR,OLDVAL,NEWVAL) \
+        __sync_bool_compare_and_swap(PTR,OLDVAL,NEWVAL)
+#else
+#define gt_atomic_add_and_fetch(PTR,VAL)  (*(PTR) += (VAL))
+#define gt_atomic_fetch_and_sub(PTR,VAL)  ((*(PTR) -= (VAL)) + (VAL))
+#define gt_atomic_compare_and_swap(PTR,OLDVAL,NEWVAL) \
+        (*(PTR) == (OLDVAL) ? (*(PTR) = (NEWVAL), true) : false)
+#endif
+
+/* Set the <GtUword> <*PTR> to <VAL> if <VAL> is larger. */
+#define gt_atomic_update_max(PTR,VAL) \
+        do { \
+          GtUword gt_atomic_oldmax; \
+          while ((gt_atomic_oldmax = *(PTR)) < (VAL) && \
+                 !gt_atomic_compare_and_swap(PTR,gt_atomic_oldmax,VAL)) \
+            /* retry */; \
+        } while (false)
+
+#endif
@@ -53,7 +53,7 @@
 #include "core/ma_api.h"
 #include "core/mapspec.h"
 #include "core/mathsupport.h"
-#include "core/md5_encoder_api.h"
+#include "core/md5_tab_writer.h"
 #include "core/minmax.h"
 #include "core/progressbar.h"
 #include "core/sequence_buffer_fasta.h"
@@ -66,6 +66,9 @@
 #include "core/xansi_api.h"
 #include "core/xposix.h"
 #include "core/yarandom.h"
+#if defined (__SSE2__) && defined (_LP64)
+#include <emmintrin.h>
+#endif
 
 #undef GT_RANGEDEBUG
 
@@ -683,6 +686,120 @@ static void showGtRange(const GtRange *range)
 }
 #endif
 
+/* Decode the <len> characters of the two bit encoding <tbe> beginning at
+   position <frompos> into <buffer>. Whole units are decoded at once, two
+   units per step with SSE2 on 64-bit platforms. */
+static void twobitencoding_decode(GtUchar *buffer,
+                                  const GtTwobitencoding *tbe,
+                                  GtUword frompos,
+                                  GtUword len)
+{
+  GtUword pos = frompos, endpos = frompos + len, unit, lastunit;
+  unsigned int idx;
+
+  while (pos < endpos && GT_MODBYUNITSIN2BITENC(pos) > 0) {
+    *buffer++ = (GtUchar) EXTRACTENCODEDCHAR(tbe, pos);
+    pos++;
+  }
+  if (pos == endpos)
+    return;
+  unit = GT_DIVBYUNITSIN2BITENC(pos);
+  lastunit = GT_DIVBYUNITSIN2BITENC(endpos);
+#if defined (__SSE2__) && defined (_LP64)
+  {
+    const __m128i mask = _mm_set1_epi8(3);
+    for (/* Nothing */; unit + 1 < lastunit; unit += 2) {
+      /* byte k of <x> holds the characters 4k to 4k+3 of the two units */
+      __m128i x = _mm_set_epi64x((long long) __builtin_bswap64(tbe[unit+1]),
+                                 (long long) __builtin_bswap64(tbe[unit])),
+              a = _mm_and_si128(_mm_srli_epi16(x, 6), mask),
+              b = _mm_and_si128(_mm_srli_epi16(x, 4), mask),
+              c = _mm_and_si128(_mm_srli_epi16(x, 2), mask),
+              d = _mm_and_si128(x, mask),
+              ab = _mm_unpacklo_epi8(a, b),
+              cd = _mm_unpacklo_epi8(c, d);
+      _mm_storeu_si128((__m128i *) buffer, _mm_unpacklo_epi16(ab, cd));
+      _mm_storeu_si128((__m128i *) (buffer + 16), _mm_unpackhi_epi16(ab, cd));
+      ab = _mm_unpackhi_epi8(a, b);
+      cd = _mm_unpackhi_epi8(c, d);
+      _mm_storeu_si128((__m128i *) (buffer + 32), _mm_unpacklo_epi16(ab, cd));
+      _mm_storeu_si128((__m128i *) (buffer + 48), _mm_unpackhi_epi16(ab, cd));
+      buffer += GT_MULT2(GT_UNITSIN2BITENC);
+    }
+  }
+#endif
+  for (/* Nothing */; unit < lastunit; unit++) {
+    GtTwobitencoding value = tbe[unit];
+    for (idx = 0; idx < (unsigned int) GT_UNITSIN2BITENC; idx++) {
+      buffer[idx] = (GtUchar) EXTRACTENCODEDCHARSCALARFROMLEFT(value, idx);
+    }
+    buffer += GT_UNITSIN2BITENC;
+  }
+  for (pos = unit * GT_UNITSIN2BITENC; pos < endpos; pos++) {
+    *buffer++ = (GtUchar) EXTRACTENCODEDCHAR(tbe, pos);
+  }
+}
+
+/* Extract the characters from <frompos> to <topos> of an <encseq> with a two
+   bit encoding. All positions must be in the forward part of the sequence. */
+static void extract_encoded_twobit(const GtEncseq *encseq,
+                                   GtUchar *buffer,
+                                   GtUword frompos,
+                                   GtUword topos)
+{
+  GtUword pos;
+
+  gt_assert(topos < encseq->totallength);
+  twobitencoding_decode(buffer, encseq->twobitencoding, frompos,
+                        topos - frompos + 1);
+  if (!gt_encseq_has_specialranges(encseq))
+    return;
+  if (encseq->sat == GT_ACCESS_TYPE_EQUALLENGTH) {
+    /* the only special characters are the separators */
+    GtUword seqlen = encseq->equallength.valueunsignedlong;
+
+    pos = frompos <= seqlen ? seqlen
+                            : frompos + (seqlen + 1 -
+                                         (frompos - seqlen) % (seqlen + 1))
+                                        % (seqlen + 1);
+    for (/* Nothing */; pos <= topos; pos += seqlen + 1) {
+      buffer[pos - frompos] = (GtUchar) SEPARATOR;
+    }
+  }
+  else if (encseq->sat == GT_ACCESS_TYPE_BITACCESS) {
+    /* the two bits of a special character tell its kind */
+    for (pos = frompos; pos <= topos; pos++) {
+      if (encseq->specialbits[GT_DIVWORDSIZE(pos)] == 0) {
+        pos |= (GtUword) (GT_INTWORDSIZE - 1);
+      }
+      else if (GT_ISIBITSET(encseq->specialbits, pos)) {
+        buffer[pos - frompos]
+          = buffer[pos - frompos] == (GtUchar) GT_TWOBITS_FOR_SEPARATOR
+              ? (GtUchar) SEPARATOR
+              : (GtUchar) WILDCARD;
+      }
+    }
+  }
+  else {
+    GtEncseqReader *esr;
+
+    gt_assert(encseq->accesstype_via_utables);
+    esr = gt_encseq_create_reader_with_readmode(encseq,
+                                                GT_READMODE_FORWARD,
+                                                frompos);
+    while (esr->currentpos <= topos) {
+      /* skip to the next special character, as done when extracting the
+         two bit encoding in the suffix sorter */
+      esr->currentpos = gt_getnexttwobitencodingstoppos(true, esr);
+      if (esr->currentpos > topos)
+        break;
+      buffer[esr->currentpos - frompos]
+        = gt_encseq_reader_next_encoded_char(esr);
+    }
+    gt_encseq_reader_delete(esr);
+  }
+}
+
 void gt_encseq_extract_encoded(const GtEncseq *encseq,
                                GtUchar *buffer,
                                GtUword frompos,
@@ -693,6 +810,10 @@ void gt_encseq_extract_encoded(const GtEncseq *encseq,
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength);
+  if (gt_encseq_has_twobitencoding(encseq) && topos < encseq->totallength) {
+    extract_encoded_twobit(encseq, buffer, frompos, topos);
+    return;
+  }
   esr = gt_encseq_create_reader_with_readmode(encseq,
                                               GT_READMODE_FORWARD,
                                               frompos);
@@ -702,6 +823,47 @@ void gt_encseq_extract_encoded(const GtEncseq *encseq,
   gt_encseq_reader_delete(esr);
 }
 
+void gt_encseq_extract_encoded_with_readmode(const GtEncseq *encseq,
+                                             GtUchar *buffer,
+                                             GtReadmode readmode,
+                                             GtUword frompos,
+                                             GtUword topos)
+{
+  GtUword idx, len;
+
+  gt_assert(frompos <= topos && encseq != NULL &&
+            topos < encseq->logicaltotallength);
+  len = topos - frompos + 1;
+  if (GT_ISDIRREVERSE(readmode)) {
+    if (encseq->hasmirror) {
+      GtEncseqReader *esr
+        = gt_encseq_create_reader_with_readmode(encseq, readmode, frompos);
+      for (idx = 0; idx < len; idx++) {
+        buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
+      }
+      gt_encseq_reader_delete(esr);
+      return;
+    }
+    gt_encseq_extract_encoded(encseq, buffer,
+                              GT_REVERSEPOS(encseq->totallength, topos),
+                              GT_REVERSEPOS(encseq->totallength, frompos));
+    for (idx = 0; idx < GT_DIV2(len); idx++) {
+      GtUchar tmp = buffer[idx];
+      buffer[idx] = buffer[len - 1 - idx];
+      buffer[len - 1 - idx] = tmp;
+    }
+  }
+  else {
+    gt_encseq_extract_encoded(encseq, buffer, frompos, topos);
+  }
+  if (GT_ISDIRCOMPLEMENT(readmode)) {
+    for (idx = 0; idx < len; idx++) {
+      if (ISNOTSPECIAL(buffer[idx]))
+        buffer[idx] = GT_COMPLEMENTBASE(buffer[idx]);
+    }
+  }
+}
+
 void gt_encseq_extract_decoded(const GtEncseq *encseq,
                                char *buffer,
                                GtUword frompos,
@@ -5359,11 +5521,9 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
   bool specialprefix = true, wildcardprefix = true, haserr = false;
   GtDiscDistri *distspecialrangelength = NULL, *distwildcardrangelength = NULL;
   GtDescBuffer *descqueue = NULL;
-  GtMD5Encoder *md5enc = NULL;
+  GtMD5TabWriter *md5tabwriter = NULL;
   char *desc,
-       md5_blockbuf[64],
-       md5_outbuf[33];
-  unsigned char md5_output[16];
+       md5_blockbuf[64];
   FILE *desfp = NULL, *sdsfp = NULL, *oisfp = NULL, *md5fp = NULL;
 
   gt_error_check(err);
@@ -5418,7 +5578,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     originaldistribution = gt_calloc((size_t) UCHAR_MAX,
                                      sizeof (GtUword));
     if (md5fp != NULL)
-      md5enc = gt_md5_encoder_new();
+      md5tabwriter = gt_md5_tab_writer_new(md5fp);
     for (currentpos = 0; !haserr; currentpos++) {
 #if !(defined (_LP64) || defined (_WIN64))
 #define MAXSFXLENFOR32BIT 4294000000UL
@@ -5435,7 +5595,6 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
 #define WITHOISTAB
 #define WITHCOUNTMINMAX
 #define WITHORIGDIST
-#define WITHMD5FP
 #include "encseq_charproc.gen"
       }
       else {
@@ -5463,10 +5622,9 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
             gt_disc_distri_add(distwildcardrangelength,
                                lastwildcardrangelength);
           }
-          if (md5enc != NULL) {
-            gt_md5_encoder_add_block(md5enc, md5_blockbuf, md5_blockcount);
-            gt_md5_encoder_finish(md5enc, md5_output, md5_outbuf);
-            gt_xfwrite(md5_outbuf, sizeof (char), (size_t) 33, md5fp);
+          if (md5tabwriter != NULL) {
+            gt_md5_tab_writer_finish_sequence(md5tabwriter, md5_blockbuf,
+                                              md5_blockcount);
           }
           if (equallength->defined) {
             if (equallength->valueunsignedlong > 0) {
@@ -5489,7 +5647,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
         break;
       }
     }
-    gt_md5_encoder_delete(md5enc);
+    gt_md5_tab_writer_delete(md5tabwriter);
   }
   if (!haserr) {
     alphabet_to_key_values(alpha, NULL, &lengthofalphadef, NULL,
@@ -5599,10 +5757,8 @@ static void sequence2specialcharinfo(GtSpecialcharinfo *specialcharinfo,
   bool specialprefix = true, wildcardprefix = true;
   GtDiscDistri *distspecialrangelength,
                *distwildcardrangelength;
-  GtMD5Encoder *md5enc = NULL;
+  GtMD5TabWriter *md5tabwriter = NULL; /* no .md5 table is written */
   char md5_blockbuf[64];
-  GT_UNUSED char md5_outbuf[33];
-  unsigned char md5_output[16];
 
   specialcharinfo->specialcharacters = 0;
   specialcharinfo->wildcards = 0;
@@ -5611,7 +5767,6 @@ static void sequence2specialcharinfo(GtSpecialcharinfo *specialcharinfo,
   distspecialrangelength = gt_disc_distri_new();
   distwildcardrangelength = gt_disc_distri_new();
 
-  md5enc = gt_md5_encoder_new();
   for (currentpos = 0; currentpos < len; currentpos++) {
     char cc = '\0';
     bool outoistab = false;
@@ -5620,7 +5775,6 @@ static void sequence2specialcharinfo(GtSpecialcharinfo *specialcharinfo,
 #undef WITHOISTAB
 #undef WITHORIGDIST
 #undef WITHCOUNTMINMAX
-#undef WITHMD5FP
 #include "encseq_charproc.gen"
   }
   if (lastspecialrangelength > 0)
@@ -5637,7 +5791,6 @@ static void sequence2specialcharinfo(GtSpecialcharinfo *specialcharinfo,
   specialcharinfo->wildcardranges = specialcharinfo->realwildcardranges;
   gt_disc_distri_delete(distspecialrangelength);
   gt_disc_distri_delete(distwildcardrangelength);
-  gt_md5_encoder_delete(md5enc);
 }
 
 static GtUword fwdgetnexttwobitencodingstopposViaequallength(
@@ -7734,6 +7887,46 @@ static void testmulticharactercompare(const GtEncseq *encseq,
   }
 }
 
+static void checkextractencodedrange(const GtEncseq *encseq,
+                                     GtReadmode readmode,
+                                     GtUchar *buffer,
+                                     GtUword frompos,
+                                     GtUword topos)
+{
+  GtUword pos;
+
+  gt_encseq_extract_encoded_with_readmode(encseq, buffer, readmode, frompos,
+                                          topos);
+  for (pos = frompos; pos <= topos; pos++) {
+    GtUchar cc = gt_encseq_get_encoded_char(encseq, pos, readmode);
+    if (buffer[pos - frompos] != cc) {
+      fprintf(stderr, "extract range "GT_WU".."GT_WU" (readmode %s): pos "
+                      GT_WU": extracted %u != %u = random access\n",
+              frompos, topos, gt_readmode_show(readmode), pos,
+              (unsigned int) buffer[pos - frompos], (unsigned int) cc);
+      exit(GT_EXIT_PROGRAMMING_ERROR);
+    }
+  }
+}
+
+static void testextractencoded(const GtEncseq *encseq,
+                               GtReadmode readmode,
+                               GtUword trials)
+{
+  const GtUword maxlen = 1000UL;
+  GtUword trial, totallength = encseq->logicaltotallength, frompos, len;
+  GtUchar *buffer = gt_malloc(sizeof (*buffer) * totallength);
+
+  checkextractencodedrange(encseq, readmode, buffer, 0, totallength-1);
+  for (trial = 0; trial < trials; trial++) {
+    frompos = (GtUword) (random() % totallength);
+    len = 1UL + (GtUword) (random() % MIN(maxlen, totallength - frompos));
+    checkextractencodedrange(encseq, readmode, buffer, frompos,
+                             frompos + len - 1);
+  }
+  gt_free(buffer);
+}
+
 static int testfullscan(const GtStrArray *filenametab,
                         const GtEncseq *encseq,
                         GtReadmode readmode,
@@ -7872,6 +8065,9 @@ int gt_encseq_check_consistency(const GtEncseq *encseq,
     checkextractspecialbits(encseq, fwd);
   }
   if (scantrials > 0) {
+    gt_logger_log(logger, "run testextractencoded for "GT_WU" trials",
+                  scantrials);
+    testextractencoded(encseq, readmode, scantrials);
     gt_logger_log(logger, "run testscanatpos for "GT_WU" trials", scantrials);
     testscanatpos(encseq, readmode, scantrials);
   }
@@ -128,6 +128,15 @@ void gt_encseq_sequence2bytecode(GtUchar *dest,
                                  GtUword startindex,
                                  GtUword len);
 
+/* Writes the encoded substring from position <frompos> to position <topos>
+  of <encseq> wrt. <readmode> to <buffer>, like <gt_encseq_extract_encoded()>
+  does for the forward readmode. */
+void gt_encseq_extract_encoded_with_readmode(const GtEncseq *encseq,
+                                             GtUchar *buffer,
+                                             GtReadmode readmode,
+                                             GtUword frompos,
+                                             GtUword topos);
+
 /* Returns true is <encseq> has special ranges, false otherwise. */
 bool gt_encseq_has_specialranges(const GtEncseq *encseq);
 
@@ -20,7 +20,11 @@
 #else
 #include <windows.h>
 #endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #include <fcntl.h>
+#include <limits.h>
 #include <unistd.h>
 #include "core/compat.h"
 #include "core/dynalloc.h"
@@ -40,6 +44,13 @@
 #include "core/xposix.h"
 #include "core/xzlib.h"
 
+#if defined (__linux__) && defined (SYS_set_mempolicy)
+#define GT_FA_NUMA_INTERLEAVE
+/* memory policies from <linux/mempolicy.h>, we do not depend on libnuma */
+#define GT_FA_MPOL_DEFAULT    0
+#define GT_FA_MPOL_INTERLEAVE 3
+#endif
+
 /* the file allocator class */
 typedef struct {
   GtMutex *file_mutex,
@@ -48,7 +59,11 @@ typedef struct {
             *memory_maps;
   GtUword current_size,
                 max_size;
-  bool global_space_peak;
+  bool global_space_peak,
+       mmap_populate,
+       mmap_hugepages;
+  GtFAMmapAccess mmap_access;
+  unsigned long numa_nodemask; /* nodes to interleave over, 0 if disabled */
 } FA;
 
 static FA *fa = NULL;
@@ -94,6 +109,7 @@ void gt_fa_init(void)
   fa->memory_maps = gt_hashmap_new(GT_HASH_DIRECT, NULL,
                                    (GtFree) free_FAMapInfo);
   fa->global_space_peak = false;
+  fa->mmap_access = GT_FA_MMAP_ACCESS_NORMAL;
 }
 
 static void* fileopen_generic(FA *fa, const char *path, const char *mode,
@@ -380,6 +396,67 @@ FILE* gt_xtmpfp_generic_func(GtStr *template_arg, enum tmpfp_flags flags,
   return fp;
 }
 
+#ifndef _WIN32
+#ifdef GT_FA_NUMA_INTERLEAVE
+static void set_mempolicy_interleave(bool interleave)
+{
+  unsigned long nodemask = fa->numa_nodemask;
+  /* the policy only applies to the calling thread and is a hint, therefore
+     errors are ignored */
+  if (interleave) {
+    (void) syscall(SYS_set_mempolicy, GT_FA_MPOL_INTERLEAVE, &nodemask,
+                   (unsigned long) (sizeof (nodemask) * CHAR_BIT + 1));
+  }
+  else
+    (void) syscall(SYS_set_mempolicy, GT_FA_MPOL_DEFAULT, NULL, 0UL);
+}
+#endif
+
+/* returns the flags for a read-only map, with the memory policy of the calling
+   thread set such that the prefaulted pages are interleaved if requested */
+static int mmap_read_begin(void)
+{
+  int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+  if (fa->mmap_populate)
+    flags |= MAP_POPULATE;
+#endif
+#ifdef GT_FA_NUMA_INTERLEAVE
+  if (fa->numa_nodemask)
+    set_mempolicy_interleave(true);
+#endif
+  return flags;
+}
+
+static void mmap_read_end(void *map, size_t len)
+{
+#ifdef GT_FA_NUMA_INTERLEAVE
+  if (fa->numa_nodemask)
+    set_mempolicy_interleave(false);
+#endif
+  if (!map)
+    return;
+  /* all advice is a hint only, so errors are ignored */
+#ifdef MADV_HUGEPAGE
+  if (fa->mmap_hugepages)
+    (void) madvise(map, len, MADV_HUGEPAGE);
+#endif
+  switch (fa->mmap_access) {
+    case GT_FA_MMAP_ACCESS_NORMAL:
+      break;
+    case GT_FA_MMAP_ACCESS_RANDOM:
+      (void) madvise(map, len, MADV_RANDOM);
+      break;
+    case GT_FA_MMAP_ACCESS_SEQUENTIAL:
+      (void) madvise(map, len, MADV_SEQUENTIAL);
+      break;
+    case GT_FA_MMAP_ACCESS_WILLNEED:
+      (void) madvise(map, len, MADV_WILLNEED);
+      break;
+  }
+}
+#endif
+
 void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
                                  size_t len, GT_UNUSED size_t offset,
                                  bool mapwritable, bool hard_fail,
@@ -388,6 +465,9 @@ void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
 {
   FAMapInfo *mapinfo;
   void *map = NULL;
+#ifndef _WIN32
+  int mmap_flags = MAP_SHARED;
+#endif
   gt_error_check(err);
   gt_assert(fa);
   mapinfo = gt_calloc(1, sizeof *mapinfo);
@@ -396,17 +476,21 @@ void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
   mapinfo->len = len;
 
 #ifndef _WIN32
+  if (!mapwritable)
+    mmap_flags = mmap_read_begin();
   if (hard_fail) {
     map = gt_xmmap(0, len, PROT_READ | (mapwritable ? PROT_WRITE : 0),
-                   MAP_SHARED, fd, offset);
+                   mmap_flags, fd, offset);
   }
   else {
     if ((map = mmap(0, len, PROT_READ | (mapwritable ? PROT_WRITE : 0),
-                    MAP_SHARED, fd, offset)) == MAP_FAILED) {
+                    mmap_flags, fd, offset)) == MAP_FAILED) {
       gt_error_set(err,"cannot map file \"%s\": %s", filename, strerror(errno));
       map = NULL;
     }
   }
+  if (!mapwritable)
+    mmap_read_end(map, len);
 #else
   mapinfo->filehandle = CreateFile(filename,
                                    mapwritable ? GENERIC_READ | GENERIC_WRITE
@@ -803,6 +887,63 @@ void gt_fa_enable_global_spacepeak(void)
   fa->global_space_peak = true;
 }
 
+void gt_fa_enable_mmap_populate(void)
+{
+  gt_assert(fa);
+  fa->mmap_populate = true;
+}
+
+void gt_fa_enable_mmap_hugepages(void)
+{
+  gt_assert(fa);
+  fa->mmap_hugepages = true;
+}
+
+#ifdef GT_FA_NUMA_INTERLEAVE
+/* returns the mask of the online NUMA nodes, as listed in sysfs (e.g. "0-3"),
+   or 0 if there is only one node */
+static unsigned long numa_online_nodemask(void)
+{
+  unsigned long nodemask = 0, from, to, node;
+  int rval;
+  char sep;
+  FILE *fp;
+  if (!(fp = fopen("/sys/devices/system/node/online", "r")))
+    return 0;
+  while ((rval = fscanf(fp, "%lu%c", &from, &sep)) >= 1) {
+    to = from;
+    if (rval == 2 && sep == '-') {
+      if ((rval = fscanf(fp, "%lu%c", &to, &sep)) < 1)
+        break;
+    }
+    for (node = from; node <= to && node < sizeof (nodemask) * CHAR_BIT;
+         node++) {
+      nodemask |= 1UL << node;
+    }
+    if (rval != 2 || sep != ',')
+      break;
+  }
+  fclose(fp);
+  /* interleaving over a single node is pointless */
+  return (nodemask & (nodemask - 1)) ? nodemask : 0;
+}
+#endif
+
+void gt_fa_enable_mmap_interleave(void)
+{
+  gt_assert(fa);
+  fa->mmap_populate = true;
+#ifdef GT_FA_NUMA_INTERLEAVE
+  fa->numa_nodemask = numa_online_nodemask();
+#endif
+}
+
+void gt_fa_set_mmap_access(GtFAMmapAccess access)
+{
+  gt_assert(fa);
+  fa->mmap_access = access;
+}
+
 GtUword gt_fa_get_space_peak(void)
 {
   gt_assert(fa != NULL);
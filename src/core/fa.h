@@ -171,6 +171,26 @@ int     gt_fa_check_fptr_leak(void);
 /* check if all allocated memory maps have been freed, prints to stderr */
 int     gt_fa_check_mmap_leak(void);
 void    gt_fa_enable_global_spacepeak(void);
+
+/* access pattern hints given for read-only memory maps */
+typedef enum {
+  GT_FA_MMAP_ACCESS_NORMAL,
+  GT_FA_MMAP_ACCESS_RANDOM,
+  GT_FA_MMAP_ACCESS_SEQUENTIAL,
+  GT_FA_MMAP_ACCESS_WILLNEED
+} GtFAMmapAccess;
+
+/* The following functions change the way files are mapped read-only from now
+   on. They are hints only: if the platform does not support them, they have
+   no effect. */
+/* prefault the whole map when it is created (<MAP_POPULATE>) */
+void    gt_fa_enable_mmap_populate(void);
+/* ask for transparent huge pages to back the map (<MADV_HUGEPAGE>) */
+void    gt_fa_enable_mmap_hugepages(void);
+/* interleave the pages read while creating the map over all NUMA nodes,
+   implies <gt_fa_enable_mmap_populate()> */
+void    gt_fa_enable_mmap_interleave(void);
+void    gt_fa_set_mmap_access(GtFAMmapAccess access);
 GtUword gt_fa_get_space_peak(void);
 GtUword gt_fa_get_space_current(void);
 void    gt_fa_show_space_peak(FILE*);
@@ -15,15 +15,94 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include "core/cstr_api.h"
 #include "core/fa.h"
 #include "core/ma.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
 #include "core/xansi_api.h"
 #include "core/xbzlib.h"
 #include "core/xzlib.h"
 
+/* size of the buffers filled by the read-ahead thread of a compressed file */
+#define GT_FILE_READAHEAD_BUFSIZE      (1 << 20)
+
+/* number of BGZF blocks decompressed by each thread per buffer */
+#define GT_FILE_BGZF_BLOCKS_PER_JOB    16
+
+/* maximal size of a BGZF block (compressed and uncompressed) */
+#define GT_FILE_BGZF_MAX_BLOCKSIZE     (1 << 16)
+
+/* size of the header of a BGZF block up to and including XLEN */
+#define GT_FILE_BGZF_HEADERSIZE        12
+
+/* size of the header of a BGZF block written by GtFile (with BSIZE) */
+#define GT_FILE_BGZF_WRITEHEADERSIZE   18
+
+/* maximal size of the uncompressed data of a BGZF block written by GtFile,
+   such that the compressed block always fits into
+   <GT_FILE_BGZF_MAX_BLOCKSIZE> bytes */
+#define GT_FILE_BGZF_INPUTSIZE         0xff00
+
+typedef struct {
+  size_t cdata_offset, /* offset of the compressed data in the input buffer */
+         cdata_length,
+         udata_offset; /* offset of the uncompressed data in the output
+                          buffer */
+  uint32_t crc,
+           isize; /* size of the uncompressed data */
+} GtFileBGZFBlock;
+
+/* Compressed files which are opened for reading are decompressed by a
+   separate thread into the next of two buffers while the current buffer is
+   consumed. If the file is in BGZF format (a sequence of independent gzip
+   members of at most 64 KB, as produced by bgzip), the blocks are read in raw
+   form and decompressed in parallel by <gt_jobs> threads. Without thread
+   support the buffers are filled on demand. */
+typedef struct {
+  GtFile *file;
+  FILE *bgzf; /* the raw BGZF file, NULL for other files */
+  char *path;
+  GtThread *thread; /* the thread filling <next>, NULL if none is running */
+  char *current,
+       *next;
+  size_t current_pos,
+         current_length,
+         current_allocated,
+         next_length,
+         next_allocated;
+  bool eof; /* the end of the file has been read into <next> */
+  /* input buffer and block table for BGZF files */
+  unsigned char *cdata;
+  size_t cdata_allocated;
+  GtFileBGZFBlock *blocks;
+  GtUword num_of_blocks;
+} GtFileReadahead;
+
+/* Gzip files which are opened for writing are written in BGZF format: the
+   output is collected in a buffer, and each filled buffer is compressed into
+   independent blocks by <gt_jobs> threads and written by a separate thread,
+   while the next buffer is filled. Without thread support each filled buffer
+   is compressed and written before the next one is filled. */
+typedef struct {
+  FILE *fp;
+  char *path;
+  GtThread *thread; /* the thread compressing and writing <full>, NULL if none
+                       is running */
+  char *current,
+       *full;
+  size_t current_length,
+         full_length,
+         buffersize;
+  unsigned char *cdata; /* the compressed blocks of <full> */
+  size_t *cdata_lengths;
+  GtUword maxblocks;
+} GtFileWriter;
+
 struct GtFile {
   GtFileMode mode;
   union {
@@ -36,6 +115,8 @@ struct GtFile {
        unget_char;
   bool is_stdin,
        unget_used;
+  GtFileReadahead *readahead;
+  GtFileWriter *writer;
 };
 
 GtFileMode gt_file_mode_determine(const char *path)
@@ -83,6 +164,548 @@ size_t gt_file_basename_length(const char *path)
   return path_length;
 }
 
+static uint32_t file_bgzf_uint32(const unsigned char *ptr)
+{
+  return (uint32_t) ptr[0] | ((uint32_t) ptr[1] << 8) |
+         ((uint32_t) ptr[2] << 16) | ((uint32_t) ptr[3] << 24);
+}
+
+/* Returns the BSIZE field of the extra field <extra> of length <xlen> of a
+   BGZF block header, or -1 if there is no such field. */
+static int file_bgzf_bsize(const unsigned char *extra, size_t xlen)
+{
+  size_t pos = 0, slen;
+  while (pos + 4 <= xlen) {
+    slen = (size_t) extra[pos+2] | ((size_t) extra[pos+3] << 8);
+    if (extra[pos] == 'B' && extra[pos+1] == 'C' && slen == 2 &&
+        pos + 6 <= xlen) {
+      return (int) extra[pos+4] | ((int) extra[pos+5] << 8);
+    }
+    pos += 4 + slen;
+  }
+  return -1;
+}
+
+static bool file_bgzf_header(const unsigned char *header)
+{
+  /* gzip magic, deflate, and flag FEXTRA */
+  return header[0] == 31 && header[1] == 139 && header[2] == 8 &&
+         (header[3] & 4);
+}
+
+/* Returns <true> if the file with the given <path> starts with a BGZF
+   block. */
+static bool file_is_bgzf(const char *path)
+{
+  unsigned char header[GT_FILE_BGZF_HEADERSIZE + 6];
+  bool is_bgzf = false;
+  FILE *fp;
+  if ((fp = fopen(path, "rb"))) {
+    if (fread(header, 1, sizeof header, fp) == sizeof header &&
+        file_bgzf_header(header)) {
+      size_t xlen = (size_t) header[10] | ((size_t) header[11] << 8);
+      is_bgzf = xlen == 6 &&
+                file_bgzf_bsize(header + GT_FILE_BGZF_HEADERSIZE, xlen) >= 0;
+    }
+    fclose(fp);
+  }
+  return is_bgzf;
+}
+
+static void file_bgzf_error(const GtFileReadahead *ra, const char *msg)
+{
+  fprintf(stderr, "cannot read BGZF file '%s': %s\n", ra->path, msg);
+  exit(EXIT_FAILURE);
+}
+
+/* Read the next blocks of the BGZF file into the input buffer of <ra>.
+   Returns the total size of the uncompressed blocks. */
+static size_t file_bgzf_read_blocks(GtFileReadahead *ra, GtUword maxblocks)
+{
+  unsigned char header[GT_FILE_BGZF_HEADERSIZE],
+                extra[GT_FILE_BGZF_MAX_BLOCKSIZE];
+  size_t cdata_length = 0, udata_length = 0, xlen, remaining, nread;
+  int bsize;
+  ra->num_of_blocks = 0;
+  while (ra->num_of_blocks < maxblocks) {
+    GtFileBGZFBlock *block;
+    if ((nread = fread(header, 1, sizeof header, ra->bgzf)) == 0 &&
+        feof(ra->bgzf)) {
+      ra->eof = true;
+      break;
+    }
+    if (nread != sizeof header || !file_bgzf_header(header))
+      file_bgzf_error(ra, "invalid block header");
+    xlen = (size_t) header[10] | ((size_t) header[11] << 8);
+    if (fread(extra, 1, xlen, ra->bgzf) != xlen ||
+        (bsize = file_bgzf_bsize(extra, xlen)) < 0 ||
+        (size_t) bsize + 1 < GT_FILE_BGZF_HEADERSIZE + xlen + 8) {
+      file_bgzf_error(ra, "block without BGZF extra field");
+    }
+    /* read the compressed data and the footer */
+    remaining = (size_t) bsize + 1 - GT_FILE_BGZF_HEADERSIZE - xlen;
+    if (cdata_length + remaining > ra->cdata_allocated) {
+      ra->cdata_allocated = cdata_length + remaining +
+                            (size_t) GT_FILE_BGZF_MAX_BLOCKSIZE;
+      ra->cdata = gt_realloc(ra->cdata, ra->cdata_allocated);
+    }
+    if (fread(ra->cdata + cdata_length, 1, remaining, ra->bgzf) != remaining)
+      file_bgzf_error(ra, "truncated block");
+    block = ra->blocks + ra->num_of_blocks++;
+    block->cdata_offset = cdata_length;
+    block->cdata_length = remaining - 8;
+    block->crc = file_bgzf_uint32(ra->cdata + cdata_length + remaining - 8);
+    block->isize = file_bgzf_uint32(ra->cdata + cdata_length + remaining - 4);
+    if (block->isize > (uint32_t) GT_FILE_BGZF_MAX_BLOCKSIZE)
+      file_bgzf_error(ra, "invalid size of uncompressed block");
+    block->udata_offset = udata_length;
+    cdata_length += remaining;
+    udata_length += (size_t) block->isize;
+  }
+  return udata_length;
+}
+
+typedef struct {
+  const GtFileReadahead *ra;
+  GtUword firstblock,
+          lastblock;
+} GtFileBGZFJob;
+
+static void* file_bgzf_inflate_blocks(void *data)
+{
+  const GtFileBGZFJob *job = data;
+  const GtFileReadahead *ra = job->ra;
+  GtUword idx;
+  for (idx = job->firstblock; idx <= job->lastblock; idx++) {
+    const GtFileBGZFBlock *block = ra->blocks + idx;
+    unsigned char *udata = (unsigned char *) ra->next + block->udata_offset;
+    z_stream strm;
+    int rval;
+    memset(&strm, 0, sizeof strm);
+    if (inflateInit2(&strm, -15) != Z_OK)
+      file_bgzf_error(ra, "cannot initialize decompression");
+    strm.next_in = ra->cdata + block->cdata_offset;
+    strm.avail_in = (uInt) block->cdata_length;
+    strm.next_out = udata;
+    strm.avail_out = (uInt) block->isize;
+    rval = inflate(&strm, Z_FINISH);
+    (void) inflateEnd(&strm);
+    if (rval != Z_STREAM_END || strm.total_out != (uLong) block->isize ||
+        crc32(crc32(0L, Z_NULL, 0), udata, (uInt) block->isize)
+          != (uLong) block->crc) {
+      file_bgzf_error(ra, "corrupt block");
+    }
+  }
+  return NULL;
+}
+
+static void file_readahead_fill_bgzf(GtFileReadahead *ra)
+{
+  GtUword maxblocks = (GtUword) GT_FILE_BGZF_BLOCKS_PER_JOB * gt_jobs,
+          numofjobs, blocksperjob, j;
+  GtFileBGZFJob *jobs;
+#ifdef GT_THREADS_ENABLED
+  GtThread **threads;
+#endif
+  if (!ra->blocks)
+    ra->blocks = gt_malloc(sizeof (*ra->blocks) * maxblocks);
+  ra->next_length = file_bgzf_read_blocks(ra, maxblocks);
+  if (ra->num_of_blocks == 0)
+    return;
+  if (ra->next_length > ra->next_allocated) {
+    ra->next_allocated = ra->next_length;
+    ra->next = gt_realloc(ra->next, ra->next_allocated);
+  }
+#ifdef GT_THREADS_ENABLED
+  numofjobs = MIN((GtUword) gt_jobs, ra->num_of_blocks);
+#else
+  numofjobs = 1UL;
+#endif
+  blocksperjob = (ra->num_of_blocks + numofjobs - 1) / numofjobs;
+  numofjobs = (ra->num_of_blocks + blocksperjob - 1) / blocksperjob;
+  jobs = gt_malloc(sizeof (*jobs) * numofjobs);
+  for (j = 0; j < numofjobs; j++) {
+    jobs[j].ra = ra;
+    jobs[j].firstblock = j * blocksperjob;
+    jobs[j].lastblock = MIN(ra->num_of_blocks, (j + 1) * blocksperjob) - 1;
+  }
+#ifdef GT_THREADS_ENABLED
+  threads = gt_calloc(numofjobs, sizeof (*threads));
+  /* the first job is processed by this thread, the others in parallel (or by
+     this thread if no thread can be created) */
+  for (j = 1; j < numofjobs; j++) {
+    if (!(threads[j] = gt_thread_new(file_bgzf_inflate_blocks, jobs + j,
+                                     NULL))) {
+      (void) file_bgzf_inflate_blocks(jobs + j);
+    }
+  }
+  (void) file_bgzf_inflate_blocks(jobs);
+  for (j = 1; j < numofjobs; j++) {
+    if (threads[j]) {
+      gt_thread_join(threads[j]);
+      gt_thread_delete(threads[j]);
+    }
+  }
+  gt_free(threads);
+#else
+  (void) file_bgzf_inflate_blocks(jobs);
+#endif
+  gt_free(jobs);
+}
+
+/* Fill the <next> buffer of <ra> and set <ra->eof> if the end of the file has
+   been reached. */
+static void* file_readahead_fill(void *data)
+{
+  GtFileReadahead *ra = data;
+  int nread = 0;
+  if (ra->bgzf) {
+    file_readahead_fill_bgzf(ra);
+    return NULL;
+  }
+  if (!ra->next) {
+    ra->next_allocated = (size_t) GT_FILE_READAHEAD_BUFSIZE;
+    ra->next = gt_malloc(ra->next_allocated);
+  }
+  ra->next_length = 0;
+  while (ra->next_length < ra->next_allocated) {
+    switch (ra->file->mode) {
+      case GT_FILE_MODE_GZIP:
+        nread = gt_xgzread(ra->file->fileptr.gzfile,
+                           ra->next + ra->next_length,
+                           (unsigned) (ra->next_allocated - ra->next_length));
+        break;
+      case GT_FILE_MODE_BZIP2:
+        nread = gt_xbzread(ra->file->fileptr.bzfile,
+                           ra->next + ra->next_length,
+                           (unsigned) (ra->next_allocated - ra->next_length));
+        break;
+      default: gt_assert(0);
+    }
+    if (nread <= 0) {
+      ra->eof = true;
+      break;
+    }
+    ra->next_length += (size_t) nread;
+  }
+  return NULL;
+}
+
+static void file_readahead_wait(GT_UNUSED GtFileReadahead *ra)
+{
+#ifdef GT_THREADS_ENABLED
+  if (ra->thread) {
+    gt_thread_join(ra->thread);
+    gt_thread_delete(ra->thread);
+    ra->thread = NULL;
+  }
+#endif
+}
+
+/* Make the buffer filled by the read-ahead thread the current one and start
+   filling the next buffer. Returns <false> if there is no more data. */
+static bool file_readahead_advance(GtFileReadahead *ra)
+{
+  char *tmpbuf;
+  size_t tmpsize;
+  if (ra->thread)
+    file_readahead_wait(ra);
+  else {
+    if (ra->eof)
+      return false;
+    (void) file_readahead_fill(ra);
+  }
+  tmpbuf = ra->current;
+  ra->current = ra->next;
+  ra->next = tmpbuf;
+  ra->current_length = ra->next_length;
+  ra->next_length = 0;
+  tmpsize = ra->current_allocated;
+  ra->current_allocated = ra->next_allocated;
+  ra->next_allocated = tmpsize;
+  ra->current_pos = 0;
+#ifdef GT_THREADS_ENABLED
+  if (!ra->eof) /* if no thread can be created, the next buffer is filled on
+                   demand */
+    ra->thread = gt_thread_new(file_readahead_fill, ra, NULL);
+#endif
+  return ra->current_length > 0;
+}
+
+static int file_readahead_getc(GtFileReadahead *ra)
+{
+  if (ra->current_pos == ra->current_length && !file_readahead_advance(ra))
+    return EOF;
+  return (int) ra->current[ra->current_pos++];
+}
+
+static int file_readahead_read(GtFileReadahead *ra, void *buf, size_t nbytes)
+{
+  size_t copied = 0, length;
+  while (copied < nbytes) {
+    if (ra->current_pos == ra->current_length && !file_readahead_advance(ra))
+      break;
+    length = MIN(nbytes - copied, ra->current_length - ra->current_pos);
+    memcpy((char*) buf + copied, ra->current + ra->current_pos, length);
+    ra->current_pos += length;
+    copied += length;
+  }
+  return (int) copied;
+}
+
+static void file_readahead_reset(GtFileReadahead *ra)
+{
+  file_readahead_wait(ra);
+  ra->current_pos = ra->current_length = ra->next_length = 0;
+  ra->eof = false;
+  if (ra->bgzf)
+    rewind(ra->bgzf);
+}
+
+static void file_readahead_delete(GtFileReadahead *ra)
+{
+  if (!ra) return;
+  file_readahead_wait(ra);
+  if (ra->bgzf)
+    gt_fa_fclose(ra->bgzf);
+  gt_free(ra->current);
+  gt_free(ra->next);
+  gt_free(ra->cdata);
+  gt_free(ra->blocks);
+  gt_free(ra->path);
+  gt_free(ra);
+}
+
+/* Compress <length> bytes of <udata> into a BGZF block at <block>, return
+   the size of the block. */
+static size_t file_bgzf_deflate_block(const GtFileWriter *writer,
+                                      unsigned char *block, const char *udata,
+                                      size_t length)
+{
+  static const unsigned char header[GT_FILE_BGZF_WRITEHEADERSIZE]
+    = {31, 139, 8, 4, 0, 0, 0, 0, 0, 255, 6, 0, 'B', 'C', 2, 0, 0, 0};
+  size_t blocksize;
+  uint32_t crc, idx;
+  z_stream strm;
+  gt_assert(length <= (size_t) GT_FILE_BGZF_INPUTSIZE);
+  memset(&strm, 0, sizeof strm);
+  if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    fprintf(stderr, "cannot write BGZF file '%s': cannot initialize "
+                    "compression\n", writer->path);
+    exit(EXIT_FAILURE);
+  }
+  strm.next_in = (Bytef*) udata;
+  strm.avail_in = (uInt) length;
+  strm.next_out = block + GT_FILE_BGZF_WRITEHEADERSIZE;
+  strm.avail_out = (uInt) (GT_FILE_BGZF_MAX_BLOCKSIZE -
+                           GT_FILE_BGZF_WRITEHEADERSIZE - 8);
+  if (deflate(&strm, Z_FINISH) != Z_STREAM_END) {
+    fprintf(stderr, "cannot write BGZF file '%s': block too large\n",
+            writer->path);
+    exit(EXIT_FAILURE);
+  }
+  blocksize = GT_FILE_BGZF_WRITEHEADERSIZE + (size_t) strm.total_out + 8;
+  (void) deflateEnd(&strm);
+  memcpy(block, header, sizeof header);
+  block[16] = (unsigned char) ((blocksize - 1) & 0xff);
+  block[17] = (unsigned char) ((blocksize - 1) >> 8);
+  crc = (uint32_t) crc32(crc32(0L, Z_NULL, 0), (const Bytef*) udata,
+                         (uInt) length);
+  for (idx = 0; idx < 4; idx++) {
+    block[blocksize - 8 + idx] = (unsigned char) (crc >> (8 * idx));
+    block[blocksize - 4 + idx] = (unsigned char) (length >> (8 * idx));
+  }
+  return blocksize;
+}
+
+typedef struct {
+  GtFileWriter *writer;
+  GtUword firstblock,
+          lastblock;
+} GtFileWriterJob;
+
+static void* file_writer_deflate_blocks(void *data)
+{
+  const GtFileWriterJob *job = data;
+  GtFileWriter *writer = job->writer;
+  GtUword idx;
+  for (idx = job->firstblock; idx <= job->lastblock; idx++) {
+    size_t offset = (size_t) idx * GT_FILE_BGZF_INPUTSIZE;
+    writer->cdata_lengths[idx]
+      = file_bgzf_deflate_block(writer,
+                                writer->cdata +
+                                (size_t) idx * GT_FILE_BGZF_MAX_BLOCKSIZE,
+                                writer->full + offset,
+                                MIN((size_t) GT_FILE_BGZF_INPUTSIZE,
+                                    writer->full_length - offset));
+  }
+  return NULL;
+}
+
+/* Compress the <full> buffer of the writer given by <data> in parallel and
+   write the blocks in order. */
+static void* file_writer_compress(void *data)
+{
+  GtFileWriter *writer = data;
+  GtUword numofblocks, numofjobs, blocksperjob, j;
+  GtFileWriterJob *jobs;
+#ifdef GT_THREADS_ENABLED
+  GtThread **threads;
+#endif
+  numofblocks = (GtUword) ((writer->full_length + GT_FILE_BGZF_INPUTSIZE - 1)
+                           / GT_FILE_BGZF_INPUTSIZE);
+  gt_assert(numofblocks > 0 && numofblocks <= writer->maxblocks);
+#ifdef GT_THREADS_ENABLED
+  numofjobs = MIN((GtUword) gt_jobs, numofblocks);
+#else
+  numofjobs = 1UL;
+#endif
+  blocksperjob = (numofblocks + numofjobs - 1) / numofjobs;
+  numofjobs = (numofblocks + blocksperjob - 1) / blocksperjob;
+  jobs = gt_malloc(sizeof (*jobs) * numofjobs);
+  for (j = 0; j < numofjobs; j++) {
+    jobs[j].writer = writer;
+    jobs[j].firstblock = j * blocksperjob;
+    jobs[j].lastblock = MIN(numofblocks, (j + 1) * blocksperjob) - 1;
+  }
+#ifdef GT_THREADS_ENABLED
+  threads = gt_calloc(numofjobs, sizeof (*threads));
+  for (j = 1; j < numofjobs; j++) {
+    if (!(threads[j] = gt_thread_new(file_writer_deflate_blocks, jobs + j,
+                                     NULL))) {
+      (void) file_writer_deflate_blocks(jobs + j);
+    }
+  }
+  (void) file_writer_deflate_blocks(jobs);
+  for (j = 1; j < numofjobs; j++) {
+    if (threads[j]) {
+      gt_thread_join(threads[j]);
+      gt_thread_delete(threads[j]);
+    }
+  }
+  gt_free(threads);
+#else
+  (void) file_writer_deflate_blocks(jobs);
+#endif
+  for (j = 0; j < numofblocks; j++) {
+    gt_xfwrite(writer->cdata + (size_t) j * GT_FILE_BGZF_MAX_BLOCKSIZE, 1,
+               writer->cdata_lengths[j], writer->fp);
+  }
+  gt_free(jobs);
+  return NULL;
+}
+
+static void file_writer_wait(GT_UNUSED GtFileWriter *writer)
+{
+#ifdef GT_THREADS_ENABLED
+  if (writer->thread) {
+    gt_thread_join(writer->thread);
+    gt_thread_delete(writer->thread);
+    writer->thread = NULL;
+  }
+#endif
+}
+
+/* Hand the current buffer of <writer> over to a compression thread (or
+   compress it directly). */
+static void file_writer_flush(GtFileWriter *writer)
+{
+  char *tmpbuf;
+  if (writer->current_length == 0)
+    return;
+  file_writer_wait(writer);
+  tmpbuf = writer->full;
+  writer->full = writer->current;
+  writer->current = tmpbuf;
+  writer->full_length = writer->current_length;
+  writer->current_length = 0;
+#ifdef GT_THREADS_ENABLED
+  if (!(writer->thread = gt_thread_new(file_writer_compress, writer, NULL)))
+#endif
+    (void) file_writer_compress(writer);
+}
+
+static void file_writer_write(GtFileWriter *writer, const void *buf,
+                              size_t nbytes)
+{
+  size_t copied = 0, length;
+  while (copied < nbytes) {
+    if (writer->current_length == writer->buffersize)
+      file_writer_flush(writer);
+    length = MIN(nbytes - copied, writer->buffersize - writer->current_length);
+    memcpy(writer->current + writer->current_length, (const char*) buf + copied,
+           length);
+    writer->current_length += length;
+    copied += length;
+  }
+}
+
+static GtFileWriter* file_writer_new(FILE *fp, const char *path)
+{
+  GtFileWriter *writer = gt_calloc(1, sizeof *writer);
+  writer->fp = fp;
+  writer->path = gt_cstr_dup(path);
+  writer->maxblocks = (GtUword) GT_FILE_BGZF_BLOCKS_PER_JOB * gt_jobs;
+  writer->buffersize = (size_t) writer->maxblocks * GT_FILE_BGZF_INPUTSIZE;
+  writer->current = gt_malloc(writer->buffersize);
+  writer->full = gt_malloc(writer->buffersize);
+  writer->cdata = gt_malloc((size_t) writer->maxblocks *
+                            GT_FILE_BGZF_MAX_BLOCKSIZE);
+  writer->cdata_lengths = gt_malloc(sizeof (*writer->cdata_lengths) *
+                                    writer->maxblocks);
+  return writer;
+}
+
+/* Write the remaining output and the empty BGZF block marking the end of the
+   file, then delete <writer> (the file is not closed). */
+static void file_writer_delete(GtFileWriter *writer)
+{
+  size_t eofblocksize;
+  if (!writer) return;
+  file_writer_flush(writer);
+  file_writer_wait(writer);
+  eofblocksize = file_bgzf_deflate_block(writer, writer->cdata, "", 0);
+  gt_xfwrite(writer->cdata, 1, eofblocksize, writer->fp);
+  gt_free(writer->current);
+  gt_free(writer->full);
+  gt_free(writer->cdata);
+  gt_free(writer->cdata_lengths);
+  gt_free(writer->path);
+  gt_free(writer);
+}
+
+/* Returns <true> if a gzip file opened with <mode> is to be written by a
+   <GtFileWriter>. */
+static bool file_use_writer(const char *mode)
+{
+  return gt_jobs > 1 && (strchr(mode, 'w') != NULL || strchr(mode, 'a') != NULL)
+         && strchr(mode, '+') == NULL;
+}
+
+static const char* file_writer_fopen_mode(const char *mode)
+{
+  return strchr(mode, 'a') != NULL ? "ab" : "wb";
+}
+
+/* Enable read-ahead for the compressed <file> with the given <path>, if it is
+   opened for reading and several threads are used. */
+static void file_enable_readahead(GtFile *file, const char *path,
+                                  const char *mode)
+{
+  GtFileReadahead *ra;
+  if (gt_jobs <= 1 || file->mode == GT_FILE_MODE_UNCOMPRESSED ||
+      strchr(mode, 'r') == NULL || strchr(mode, '+') != NULL) {
+    return;
+  }
+  ra = gt_calloc(1, sizeof *ra);
+  ra->file = file;
+  ra->path = gt_cstr_dup(path);
+  if (file->mode == GT_FILE_MODE_GZIP && file_is_bgzf(path))
+    ra->bgzf = gt_fa_fopen(path, "rb", NULL);
+  file->readahead = ra;
+}
+
 GtFile* gt_file_new(const char *path, const char *mode, GtError *err)
 {
   gt_error_check(err);
@@ -108,6 +731,16 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
         }
         break;
       case GT_FILE_MODE_GZIP:
+        if (file_use_writer(mode)) {
+          file->fileptr.file = gt_fa_fopen(path, file_writer_fopen_mode(mode),
+                                           err);
+          if (!file->fileptr.file) {
+            gt_file_delete_without_handle(file);
+            return NULL;
+          }
+          file->writer = file_writer_new(file->fileptr.file, path);
+          break;
+        }
         file->fileptr.gzfile = gt_fa_gzopen(path, mode, err);
         if (!file->fileptr.gzfile) {
           gt_file_delete_without_handle(file);
@@ -125,6 +758,7 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
         break;
       default: gt_assert(0);
     }
+    file_enable_readahead(file, path, mode);
   }
   else {
     gt_assert(file_mode == GT_FILE_MODE_UNCOMPRESSED);
@@ -147,7 +781,13 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
         file->fileptr.file = gt_fa_xfopen(path, mode);
         break;
       case GT_FILE_MODE_GZIP:
-        file->fileptr.gzfile = gt_fa_xgzopen(path, mode);
+        if (file_use_writer(mode)) {
+          file->fileptr.file = gt_fa_xfopen(path,
+                                            file_writer_fopen_mode(mode));
+          file->writer = file_writer_new(file->fileptr.file, path);
+        }
+        else
+          file->fileptr.gzfile = gt_fa_xgzopen(path, mode);
         break;
       case GT_FILE_MODE_BZIP2:
         file->fileptr.bzfile = gt_fa_xbzopen(path, mode);
@@ -156,6 +796,7 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
         break;
       default: gt_assert(0);
     }
+    file_enable_readahead(file, path, mode);
   }
   else {
     gt_assert(file_mode == GT_FILE_MODE_UNCOMPRESSED);
@@ -195,6 +836,8 @@ int gt_file_xfgetc(GtFile *file)
       c = file->unget_char;
       file->unget_used = false;
     }
+    else if (file->readahead)
+      c = file_readahead_getc(file->readahead);
     else {
       switch (file->mode) {
         case GT_FILE_MODE_UNCOMPRESSED:
@@ -273,12 +916,38 @@ static int vbzprintf(BZFILE *file, const char *format, va_list va, int buflen)
   return 0; /* success */
 }
 
+static int vwriterprintf(GtFileWriter *writer, const char *format, va_list va,
+                         int buflen)
+{
+  int len;
+  if (!buflen) {
+    char buf[BUFSIZ];
+    /* no buffer length given -> try static buffer */
+    len = gt_xvsnprintf(buf, sizeof (buf), format, va);
+    if (len >= BUFSIZ)
+      return len; /* unsuccessful trial -> return buffer length for next call */
+    file_writer_write(writer, buf, len);
+  }
+  else {
+    char *dynbuf;
+    /* buffer length given -> use dynamic buffer */
+    dynbuf = gt_malloc((buflen + 1) * sizeof (char));
+    len = gt_xvsnprintf(dynbuf, (buflen + 1) * sizeof (char), format, va);
+    gt_assert(len == buflen);
+    file_writer_write(writer, dynbuf, buflen);
+    gt_free(dynbuf);
+  }
+  return 0; /* success */
+}
+
 static int xvprintf(GtFile *file, const char *format, va_list va, int buflen)
 {
   int rval = 0;
 
   if (!file) /* implies stdout */
     gt_xvfprintf(stdout, format, va);
+  else if (file->writer)
+    rval = vwriterprintf(file->writer, format, va, buflen);
   else {
     switch (file->mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
@@ -318,6 +987,11 @@ void gt_file_xfputc(int c, GtFile *file)
 {
   if (!file)
     return gt_xfputc(c, stdout);
+  if (file->writer) {
+    char cc = (char) c;
+    file_writer_write(file->writer, &cc, 1);
+    return;
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       gt_xfputc(c, file->fileptr.file);
@@ -336,6 +1010,10 @@ void gt_file_xfputs(const char *cstr, GtFile *file)
 {
   if (!file)
     return gt_xfputs(cstr, stdout);
+  if (file->writer) {
+    file_writer_write(file->writer, cstr, strlen(cstr));
+    return;
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       gt_xfputs(cstr, file->fileptr.file);
@@ -353,7 +1031,9 @@ void gt_file_xfputs(const char *cstr, GtFile *file)
 int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
 {
   int rval = -1;
-  if (file) {
+  if (file && file->readahead)
+    rval = file_readahead_read(file->readahead, buf, nbytes);
+  else if (file) {
     switch (file->mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
         rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
@@ -378,6 +1058,10 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
     gt_xfwrite(buf, 1, nbytes, stdout);
     return;
   }
+  if (file->writer) {
+    file_writer_write(file->writer, buf, nbytes);
+    return;
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       gt_xfwrite(buf, 1, nbytes, file->fileptr.file);
@@ -394,7 +1078,9 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
 
 void gt_file_xrewind(GtFile *file)
 {
-  gt_assert(file);
+  gt_assert(file && !file->writer);
+  if (file->readahead)
+    file_readahead_reset(file->readahead);
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       rewind(file->fileptr.file);
@@ -412,6 +1098,7 @@ void gt_file_xrewind(GtFile *file)
 void gt_file_delete_without_handle(GtFile *file)
 {
   if (!file) return;
+  file_readahead_delete(file->readahead);
   gt_free(file->orig_path);
   gt_free(file->orig_mode);
   gt_free(file);
@@ -420,13 +1107,22 @@ void gt_file_delete_without_handle(GtFile *file)
 void gt_file_delete(GtFile *file)
 {
   if (!file) return;
+  /* the read-ahead thread must not use the file handle anymore */
+  file_readahead_delete(file->readahead);
+  file->readahead = NULL;
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
         if (!file->is_stdin)
           gt_fa_fclose(file->fileptr.file);
       break;
     case GT_FILE_MODE_GZIP:
-        gt_fa_gzclose(file->fileptr.gzfile);
+        if (file->writer) {
+          file_writer_delete(file->writer);
+          file->writer = NULL;
+          gt_fa_fclose(file->fileptr.file);
+        }
+        else
+          gt_fa_gzclose(file->fileptr.gzfile);
       break;
     case GT_FILE_MODE_BZIP2:
         gt_fa_bzclose(file->fileptr.bzfile);
@@ -41,7 +41,11 @@ const char* gt_file_mode_suffix(GtFileMode mode);
 size_t      gt_file_basename_length(const char *path);
 
 /* Create a new GtFile object and open the underlying file handle, returns
-   NULL and sets <err> if the file <path> could not be opened. */
+   NULL and sets <err> if the file <path> could not be opened.
+   If more than one thread is used (see <gt_jobs>), compressed files opened for
+   reading are decompressed ahead by a separate thread (this also applies to
+   the other functions opening files by name). Files in BGZF format are
+   decompressed by several threads in parallel. */
 GtFile*     gt_file_open(GtFileMode, const char *path, const char *mode,
                          GtError*);
 
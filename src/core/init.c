@@ -32,9 +32,11 @@
 #include "core/log.h"
 #include "core/ma.h"
 #include "core/option_api.h"
+#include "core/phasestats.h"
 #include "core/showtime.h"
 #include "core/spacepeak.h"
 #include "core/splitter.h"
+#include "core/str_api.h"
 #include "core/symbol.h"
 #include "core/versionfunc.h"
 #include "core/warning_api.h"
@@ -43,12 +45,20 @@
 
 static bool spacepeak = false;
 static bool showtime = false;
+static bool mmappopulate = false;
+static bool mmaphugepages = false;
+static bool mmapinterleave = false;
+static GtFAMmapAccess mmapaccess = GT_FA_MMAP_ACCESS_NORMAL;
 
 static GtOPrval parse_env_options(int argc, const char **argv, GtError *err)
 {
   GtOptionParser *op;
   GtOption *o;
   GtOPrval oprval;
+  GtStr *mmapaccess_str = gt_str_new(),
+        *statsjson = gt_str_new();
+  static const char *mmapaccess_domain[] = { "normal", "random", "sequential",
+                                             "willneed", NULL };
   op = gt_option_parser_new("GT_ENV_OPTIONS='[option ...]' ...",
                          "Parse the options contained in the "
                          "environment variable GT_ENV_OPTIONS.");
@@ -58,8 +68,43 @@ static GtOPrval parse_env_options(int argc, const char **argv, GtError *err)
   o = gt_option_new_bool("showtime", "enable output for run-time statistics",
                          &showtime, false);
   gt_option_parser_add_option(op, o);
+  o = gt_option_new_bool("mmappopulate", "prefault read-only memory maps of "
+                         "files (e.g. index files) when they are created",
+                         &mmappopulate, false);
+  gt_option_parser_add_option(op, o);
+  o = gt_option_new_bool("mmaphugepages", "back read-only memory maps of files "
+                         "with transparent huge pages, if possible",
+                         &mmaphugepages, false);
+  gt_option_parser_add_option(op, o);
+  o = gt_option_new_bool("mmapinterleave", "interleave the pages of read-only "
+                         "memory maps of files over all NUMA nodes\n"
+                         "(implies -mmappopulate)", &mmapinterleave, false);
+  gt_option_parser_add_option(op, o);
+  o = gt_option_new_choice("mmapaccess", "expected access pattern of "
+                           "read-only memory maps of files\n"
+                           "choose normal|random|sequential|willneed",
+                           mmapaccess_str, mmapaccess_domain[0],
+                           mmapaccess_domain);
+  gt_option_parser_add_option(op, o);
+  o = gt_option_new_filename("statsjson", "write time, space and I/O "
+                             "statistics of the run and of its phases to the "
+                             "given file in JSON format\n"
+                             "(phases are recorded as with -showtime)",
+                             statsjson);
+  gt_option_parser_add_option(op, o);
   gt_option_parser_set_max_args(op, 0);
   oprval = gt_option_parser_parse(op, NULL, argc, argv, gt_versionfunc, err);
+  if (oprval == GT_OPTION_PARSER_OK) {
+    int i;
+    for (i = 0; mmapaccess_domain[i] != NULL; i++) {
+      if (!strcmp(gt_str_get(mmapaccess_str), mmapaccess_domain[i]))
+        mmapaccess = (GtFAMmapAccess) i;
+    }
+    if (gt_str_length(statsjson) > 0)
+      gt_phasestats_init(gt_str_get(statsjson));
+  }
+  gt_str_delete(statsjson);
+  gt_str_delete(mmapaccess_str);
   gt_option_parser_delete(op);
   return oprval;
 }
@@ -106,6 +151,10 @@ void gt_lib_init(void)
   if (spacepeak && !(bookkeeping && !strcmp(bookkeeping, "on")))
     gt_warning("GT_ENV_OPTIONS=-spacepeak used without GT_MEM_BOOKKEEPING=on");
   gt_fa_init();
+  if (mmappopulate) gt_fa_enable_mmap_populate();
+  if (mmaphugepages) gt_fa_enable_mmap_hugepages();
+  if (mmapinterleave) gt_fa_enable_mmap_interleave();
+  gt_fa_set_mmap_access(mmapaccess);
   if (spacepeak) {
     gt_spacepeak_init();
     gt_ma_enable_global_spacepeak();
@@ -113,6 +162,7 @@ void gt_lib_init(void)
   }
   gt_log_init();
   if (showtime) gt_showtime_enable();
+  if (gt_phasestats_enabled()) gt_showtime_enable_silently();
   gt_symbol_init();
   gt_class_alloc_lock_init();
   gt_ya_rand_init(0);
@@ -135,6 +185,7 @@ void gt_lib_reg_atexit_func(void)
 int gt_lib_clean(void)
 {
   int fa_fptr_rval, fa_mmap_rval, gt_rval;
+  (void) gt_phasestats_clean();
   if (spacepeak) {
     gt_ma_show_space_peak(stdout);
     gt_fa_show_space_peak(stdout);
@@ -0,0 +1,393 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include "core/assert_api.h"
+#include "core/dynalloc.h"
+#include "core/ensure.h"
+#include "core/interval_index.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/msort_api.h"
+#include "core/unused_api.h"
+
+/* Intervals of at most this level are scanned linearly. */
+#define GT_INTERVAL_INDEX_SCAN_LEVEL  3U
+
+#define GT_INTERVAL_INDEX_MAX_LEVEL   (sizeof (GtUword) * CHAR_BIT)
+
+typedef struct {
+  GtUword low,
+          high,
+          max_high; /* maximal <high> value in the implicit subtree */
+  void *data;
+} GtIntervalIndexEntry;
+
+struct GtIntervalIndex {
+  GtIntervalIndexEntry *entries;
+  GtUword nof_entries;
+  size_t allocated;
+  unsigned int root_level;
+  bool built;
+  GtFree free_func;
+};
+
+/* The entries sorted by <low> form an implicit binary search tree: an entry
+   at index <i> with exactly <k> trailing one bits is a node on level <k>,
+   its children are found at <i - 2^(k-1)> and <i + 2^(k-1)>. The root is at
+   index <2^root_level - 1>. Nodes beyond the end of the array are virtual,
+   they have no interval of their own but can have existing children in their
+   left subtree. */
+typedef struct {
+  GtUword x;
+  unsigned int k;
+  bool left_done;
+} GtIntervalIndexStackElem;
+
+GtIntervalIndex* gt_interval_index_new(GtFree free_func)
+{
+  GtIntervalIndex *ii = gt_calloc(1, sizeof *ii);
+  ii->free_func = free_func;
+  ii->built = true;
+  return ii;
+}
+
+void gt_interval_index_add(GtIntervalIndex *ii, void *data, GtUword low,
+                           GtUword high)
+{
+  GtIntervalIndexEntry *entry;
+  gt_assert(ii && low <= high);
+  if ((ii->nof_entries + 1) * sizeof *ii->entries > ii->allocated) {
+    ii->entries = gt_dynalloc(ii->entries, &ii->allocated,
+                              (ii->nof_entries + 1) * sizeof *ii->entries);
+  }
+  entry = ii->entries + ii->nof_entries++;
+  entry->low = low;
+  entry->high = entry->max_high = high;
+  entry->data = data;
+  ii->built = false;
+}
+
+static int compare_entries(const void *a, const void *b)
+{
+  const GtIntervalIndexEntry *entry_a = a, *entry_b = b;
+  if (entry_a->low == entry_b->low)
+    return 0;
+  return entry_a->low < entry_b->low ? -1 : 1;
+}
+
+void gt_interval_index_build(GtIntervalIndex *ii)
+{
+  GtIntervalIndexEntry *a;
+  GtUword n, i, x, last_i = 0, last = 0, max_high;
+  unsigned int k;
+  gt_assert(ii);
+  if (ii->built)
+    return;
+  a = ii->entries;
+  n = ii->nof_entries;
+  /* stable, to keep intervals with equal start positions in input order */
+  gt_msort(a, (size_t) n, sizeof *a, compare_entries);
+  /* compute the <max_high> values bottom-up, <last> is the <max_high> value
+     of the last existing node on the current level, it is used for virtual
+     right children */
+  for (i = 0; i < n; i += 2) {
+    last_i = i;
+    last = a[i].max_high = a[i].high;
+  }
+  for (k = 1; k < GT_INTERVAL_INDEX_MAX_LEVEL && ((GtUword) 1 << k) <= n; k++) {
+    x = (GtUword) 1 << (k - 1);
+    for (i = (x << 1) - 1; i < n; i += x << 2) {
+      max_high = MAX(a[i].high, a[i - x].max_high);
+      max_high = MAX(max_high, i + x < n ? a[i + x].max_high : last);
+      a[i].max_high = max_high;
+    }
+    /* move <last_i> to its parent */
+    last_i = (last_i >> k) & 1 ? last_i - x : last_i + x;
+    if (last_i < n && a[last_i].max_high > last)
+      last = a[last_i].max_high;
+  }
+  ii->root_level = k - 1;
+  ii->built = true;
+}
+
+GtUword gt_interval_index_size(const GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  return ii->nof_entries;
+}
+
+int gt_interval_index_iterate_overlapping(const GtIntervalIndex *ii,
+                                          GtIntervalIndexIteratorFunc func,
+                                          GtUword start, GtUword end,
+                                          void *data)
+{
+  GtIntervalIndexStackElem stack[2 * GT_INTERVAL_INDEX_MAX_LEVEL], z;
+  const GtIntervalIndexEntry *a;
+  GtUword n, i, i_end;
+  unsigned int t = 0;
+  int rval = 0;
+  gt_assert(ii && ii->built && func && start <= end);
+  a = ii->entries;
+  n = ii->nof_entries;
+  if (!n)
+    return 0;
+  stack[t].x = ((GtUword) 1 << ii->root_level) - 1;
+  stack[t].k = ii->root_level;
+  stack[t++].left_done = false;
+  while (!rval && t) {
+    z = stack[--t];
+    if (z.k <= GT_INTERVAL_INDEX_SCAN_LEVEL) {
+      /* small subtree, scan it linearly */
+      i = z.x >> z.k << z.k;
+      i_end = MIN(i + ((GtUword) 1 << (z.k + 1)) - 1, n);
+      for (; !rval && i < i_end && a[i].low <= end; i++) {
+        if (a[i].high >= start)
+          rval = func(a[i].data, data);
+      }
+    }
+    else if (!z.left_done) {
+      GtUword y = z.x - ((GtUword) 1 << (z.k - 1));
+      stack[t].x = z.x;
+      stack[t].k = z.k;
+      stack[t++].left_done = true;
+      if (y >= n || a[y].max_high >= start) {
+        stack[t].x = y;
+        stack[t].k = z.k - 1;
+        stack[t++].left_done = false;
+      }
+    }
+    else if (z.x < n && a[z.x].low <= end) {
+      if (a[z.x].high >= start)
+        rval = func(a[z.x].data, data);
+      stack[t].x = z.x + ((GtUword) 1 << (z.k - 1));
+      stack[t].k = z.k - 1;
+      stack[t++].left_done = false;
+    }
+  }
+  return rval;
+}
+
+static int collect_overlapping(void *interval_data, void *data)
+{
+  gt_array_add((GtArray*) data, interval_data);
+  return 0;
+}
+
+void gt_interval_index_find_all_overlapping(const GtIntervalIndex *ii,
+                                            GtUword start, GtUword end,
+                                            GtArray *results)
+{
+  gt_assert(ii && results);
+  (void) gt_interval_index_iterate_overlapping(ii, collect_overlapping, start,
+                                               end, results);
+}
+
+int gt_interval_index_batch_query(const GtIntervalIndex *ii,
+                                  const GtRange *queries, GtUword nof_queries,
+                                  GtIntervalIndexBatchFunc func, void *data,
+                                  GtError *err)
+{
+  const GtIntervalIndexEntry *a;
+  GtUword n, q, i, j, next = 0, *active = NULL, nof_active = 0;
+  size_t allocated = 0;
+  int rval = 0;
+  gt_error_check(err);
+  gt_assert(ii && ii->built && func && (queries || !nof_queries));
+  a = ii->entries;
+  n = ii->nof_entries;
+  /* Sweep over the entries and the queries at the same time. All entries
+     before <next> start before the start of the current query, those which
+     also end after it are kept in <active> (in index order). As the query
+     start positions never decrease, entries removed from <active> can never
+     overlap a later query. */
+  for (q = 0; !rval && q < nof_queries; q++) {
+    const GtRange *query = queries + q;
+    gt_assert(query->start <= query->end);
+    gt_assert(!q || queries[q-1].start <= query->start);
+    for (i = 0, j = 0; i < nof_active; i++) {
+      if (a[active[i]].high >= query->start)
+        active[j++] = active[i];
+    }
+    nof_active = j;
+    for (; next < n && a[next].low < query->start; next++) {
+      if (a[next].high >= query->start) {
+        if ((nof_active + 1) * sizeof *active > allocated) {
+          active = gt_dynalloc(active, &allocated,
+                               (nof_active + 1) * sizeof *active);
+        }
+        active[nof_active++] = next;
+      }
+    }
+    for (i = 0; !rval && i < nof_active; i++)
+      rval = func(q, a[active[i]].data, data, err);
+    for (i = next; !rval && i < n && a[i].low <= query->end; i++)
+      rval = func(q, a[i].data, data, err);
+  }
+  gt_free(active);
+  return rval;
+}
+
+void gt_interval_index_delete(GtIntervalIndex *ii)
+{
+  GtUword i;
+  if (!ii) return;
+  if (ii->free_func) {
+    for (i = 0; i < ii->nof_entries; i++)
+      ii->free_func(ii->entries[i].data);
+  }
+  gt_free(ii->entries);
+  gt_free(ii);
+}
+
+static int compare_range_ptrs(const void *a, const void *b)
+{
+  const GtRange *range_a = *(GtRange* const*) a,
+                *range_b = *(GtRange* const*) b;
+  if (range_a->start == range_b->start)
+    return 0;
+  return range_a->start < range_b->start ? -1 : 1;
+}
+
+static int collect_batch_results(GtUword query, void *interval_data,
+                                 void *data, GT_UNUSED GtError *err)
+{
+  GtArray **results = data;
+  gt_array_add(results[query], interval_data);
+  return 0;
+}
+
+static int stop_batch_query(GT_UNUSED GtUword query,
+                            GT_UNUSED void *interval_data, void *data,
+                            GT_UNUSED GtError *err)
+{
+  GtUword *count = data;
+  return ++(*count) == 3UL ? 1 : 0;
+}
+
+int gt_interval_index_unit_test(GtError *err)
+{
+  GtIntervalIndex *ii = NULL;
+  GtUword i, j, num_testranges = 3000, num_queries = 10000,
+          max_basepos = 90000, width = 700, query_width = 5000, count;
+  GtRange *ranges, *queries, **sorted_ranges;
+  GtArray *res, *expected, **batch_results;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* an empty index */
+  ii = gt_interval_index_new(NULL);
+  gt_interval_index_build(ii);
+  gt_ensure(gt_interval_index_size(ii) == 0);
+  res = gt_array_new(sizeof (GtRange*));
+  gt_interval_index_find_all_overlapping(ii, 0, max_basepos, res);
+  gt_ensure(gt_array_size(res) == 0);
+  gt_array_delete(res);
+  gt_interval_index_delete(ii);
+
+  /* generate test ranges, including many with equal start positions */
+  ranges = gt_malloc(num_testranges * sizeof *ranges);
+  sorted_ranges = gt_malloc(num_testranges * sizeof *sorted_ranges);
+  ii = gt_interval_index_new(NULL);
+  for (i = 0; i < num_testranges; i++) {
+    ranges[i].start = gt_rand_max(max_basepos) / 4 * 4;
+    ranges[i].end = ranges[i].start + gt_rand_max(width);
+    if (i % 100 == 0)
+      ranges[i].end += gt_rand_max(max_basepos);
+    sorted_ranges[i] = ranges + i;
+    gt_interval_index_add(ii, ranges + i, ranges[i].start, ranges[i].end);
+  }
+  gt_interval_index_build(ii);
+  gt_ensure(gt_interval_index_size(ii) == num_testranges);
+  gt_msort(sorted_ranges, (size_t) num_testranges, sizeof *sorted_ranges,
+           compare_range_ptrs);
+
+  /* generate sorted test queries */
+  queries = gt_malloc(num_queries * sizeof *queries);
+  for (i = 0; i < num_queries; i++) {
+    queries[i].start = gt_rand_max(max_basepos + width);
+    queries[i].end = queries[i].start + gt_rand_max(query_width);
+  }
+  gt_msort(queries, (size_t) num_queries, sizeof *queries,
+           (GtCompare) gt_range_compare);
+
+  /* compare single queries to linear search, including the order */
+  expected = gt_array_new(sizeof (GtRange*));
+  res = gt_array_new(sizeof (GtRange*));
+  for (i = 0; !had_err && i < num_queries; i++) {
+    gt_array_reset(expected);
+    gt_array_reset(res);
+    for (j = 0; j < num_testranges; j++) {
+      if (gt_range_overlap(sorted_ranges[j], queries + i))
+        gt_array_add(expected, sorted_ranges[j]);
+    }
+    gt_interval_index_find_all_overlapping(ii, queries[i].start,
+                                           queries[i].end, res);
+    gt_ensure(gt_array_size(res) == gt_array_size(expected));
+    gt_ensure(!gt_array_cmp(res, expected));
+  }
+
+  /* compare batch query to single queries */
+  batch_results = gt_malloc(num_queries * sizeof *batch_results);
+  for (i = 0; i < num_queries; i++)
+    batch_results[i] = gt_array_new(sizeof (GtRange*));
+  if (!had_err) {
+    had_err = gt_interval_index_batch_query(ii, queries, num_queries,
+                                            collect_batch_results,
+                                            batch_results, err);
+  }
+  for (i = 0; !had_err && i < num_queries; i++) {
+    gt_array_reset(res);
+    gt_interval_index_find_all_overlapping(ii, queries[i].start,
+                                           queries[i].end, res);
+    gt_ensure(gt_array_size(batch_results[i]) == gt_array_size(res));
+    gt_ensure(!gt_array_cmp(batch_results[i], res));
+  }
+  for (i = 0; i < num_queries; i++)
+    gt_array_delete(batch_results[i]);
+  gt_free(batch_results);
+
+  /* a callback can stop the batch query */
+  if (!had_err) {
+    count = 0;
+    gt_ensure(gt_interval_index_batch_query(ii, queries, num_queries,
+                                            stop_batch_query, &count,
+                                            err) == 1);
+    gt_ensure(count == 3UL);
+  }
+
+  gt_array_delete(res);
+  gt_array_delete(expected);
+  gt_free(queries);
+  gt_free(sorted_ranges);
+  gt_interval_index_delete(ii);
+  gt_free(ranges);
+
+  /* data is freed on deletion */
+  if (!had_err) {
+    ii = gt_interval_index_new(gt_free_func);
+    for (i = 0; i < 100UL; i++) {
+      GtRange *rng = gt_malloc(sizeof *rng);
+      rng->start = i;
+      rng->end = i + 10;
+      gt_interval_index_add(ii, rng, rng->start, rng->end);
+    }
+    gt_interval_index_build(ii);
+    gt_interval_index_delete(ii);
+  }
+  return had_err;
+}
@@ -0,0 +1,100 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef INTERVAL_INDEX_API_H
+#define INTERVAL_INDEX_API_H
+
+#include "core/array_api.h"
+#include "core/error_api.h"
+#include "core/fptr_api.h"
+#include "core/range_api.h"
+
+/* The <GtIntervalIndex> class is a static alternative to <GtIntervalTree> for
+   read-mostly workloads. All intervals are added first, then the index is
+   built once. Internally, the intervals are stored in a single array sorted
+   by their start positions which doubles as an implicit, augmented binary
+   search tree. Queries therefore touch contiguous memory instead of chasing
+   pointers between individually allocated tree nodes. Overlapping intervals
+   are always reported in the order of their start positions (intervals with
+   the same start position in the order they were added). */
+typedef struct GtIntervalIndex GtIntervalIndex;
+
+/* Function called for each interval overlapping a query range. <interval_data>
+   is the data pointer given in <gt_interval_index_add()>, <data> is arbitrary
+   user data. A return value != 0 stops the iteration. */
+typedef int (*GtIntervalIndexIteratorFunc)(void *interval_data, void *data);
+
+/* Function called by <gt_interval_index_batch_query()> for each interval
+   overlapping query number <query>. A return value != 0 stops the batch
+   query, <err> should be set in this case. */
+typedef int (*GtIntervalIndexBatchFunc)(GtUword query, void *interval_data,
+                                        void *data, GtError *err);
+
+/* Creates a new, empty <GtIntervalIndex>. If a <GtFree> function is given as
+   an argument, it is applied on the data pointers of all added intervals when
+   the <GtIntervalIndex> is deleted. */
+GtIntervalIndex* gt_interval_index_new(GtFree);
+
+/* Adds the interval from <low> to <high> with associated <data> to
+   <interval_index>. Afterwards, <gt_interval_index_build()> has to be called
+   before <interval_index> can be queried again. */
+void             gt_interval_index_add(GtIntervalIndex *interval_index,
+                                       void *data, GtUword low, GtUword high);
+
+/* Builds the index structure of <interval_index> over all added intervals.
+   Has to be called after the last interval was added and before the first
+   query. */
+void             gt_interval_index_build(GtIntervalIndex *interval_index);
+
+/* Returns the number of intervals in <interval_index>. */
+GtUword          gt_interval_index_size(const GtIntervalIndex *interval_index);
+
+/* Collects data pointers of all intervals in <interval_index> which overlap
+   with the query range (from <start> to <end>) in <results>. */
+void             gt_interval_index_find_all_overlapping(
+                                         const GtIntervalIndex *interval_index,
+                                         GtUword start, GtUword end,
+                                         GtArray *results);
+
+/* Call <func> for all intervals in <interval_index> which overlap with the
+   query range (from <start> to <end>). Use <data> to pass in arbitrary user
+   data. Returns the first return value of <func> which is != 0, 0 otherwise. */
+int              gt_interval_index_iterate_overlapping(
+                                         const GtIntervalIndex *interval_index,
+                                         GtIntervalIndexIteratorFunc func,
+                                         GtUword start, GtUword end,
+                                         void *data);
+
+/* Answers the <nof_queries> query ranges given in <queries> in a single sweep
+   over <interval_index>. The query ranges must be sorted by their start
+   positions (see <gt_range_compare()>). For each query in turn, <func> is
+   called for all overlapping intervals. Use <data> to pass in arbitrary user
+   data. The running time is linear in the number of intervals, queries, and
+   reported overlaps, which is preferable to separate queries if the queries
+   cover a large part of the indexed intervals. Returns 0 on success or the
+   first return value of <func> which is != 0. */
+int              gt_interval_index_batch_query(
+                                         const GtIntervalIndex *interval_index,
+                                         const GtRange *queries,
+                                         GtUword nof_queries,
+                                         GtIntervalIndexBatchFunc func,
+                                         void *data, GtError *err);
+
+/* Deletes <interval_index>. If a <GtFree> function was set in the constructor,
+   the data pointers of all intervals are freed using it. */
+void             gt_interval_index_delete(GtIntervalIndex *interval_index);
+
+#endif
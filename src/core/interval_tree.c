@@ -169,7 +169,8 @@ static void interval_tree_find_all_internal(GtIntervalTree *it,
   /* recursively search left and right subtrees */
   if (x->left != it->nil && low <= x->left->max)
     interval_tree_find_all_internal(it, x->left, func, low, high, data);
-  if (x->right != it->nil && low <= x->right->max)
+  /* all intervals in the right subtree start at or after <x> */
+  if (x->right != it->nil && x->low <= high && low <= x->right->max)
     interval_tree_find_all_internal(it, x->right, func, low, high, data);
 }
 
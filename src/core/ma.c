@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <string.h>
 #include "core/array_api.h"
+#include "core/atomic.h"
 #include "core/compat.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
@@ -28,9 +29,19 @@
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
-/* the memory allocator class */
+/* number of shards the allocated pointers are distributed over, such that
+   threads allocating concurrently rarely wait for the same lock */
+#define MA_SHARDS_LOG 4
+#define MA_SHARDS     (1U << MA_SHARDS_LOG)
+
 typedef struct {
+  GtMutex *lock;
   GtHashmap *allocated_pointer;
+} MAShard;
+
+/* the memory allocator class */
+typedef struct {
+  MAShard shards[MA_SHARDS];
   bool bookkeeping,
        global_space_peak;
   GtUint64 mallocevents;
@@ -39,7 +50,6 @@ typedef struct {
 } MA;
 
 static MA *ma = NULL;
-static GtMutex *bookkeeping_lock = NULL;
 
 typedef struct {
   size_t size;
@@ -103,52 +113,89 @@ static void ma_info_free(MAInfo *mainfo)
 
 void gt_ma_init(bool bookkeeping)
 {
+  unsigned int i;
   gt_assert(!ma);
   ma = xcalloc(1, sizeof (MA), 0, __FILE__, __LINE__);
   gt_assert(!ma->bookkeeping);
-  ma->allocated_pointer = gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL,
-                                               (GtFree) ma_info_free);
+  for (i = 0; i < MA_SHARDS; i++) {
+    ma->shards[i].lock = gt_mutex_new();
+    ma->shards[i].allocated_pointer =
+      gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL, (GtFree) ma_info_free);
+  }
   /* MA is ready to use */
   ma->bookkeeping = bookkeeping;
-  bookkeeping_lock = gt_mutex_new();
   ma->global_space_peak = false;
 }
 
+/* returns the shard responsible for <ptr> (Fibonacci hashing of the address
+   without its low bits, which are the same for all aligned pointers) */
+static MAShard* ma_shard(MA *ma, const void *ptr)
+{
+  GtUint64 key = (GtUint64) (size_t) ptr >> 4;
+  return ma->shards + ((key * 0x9E3779B97F4A7C15ULL) >> (64 - MA_SHARDS_LOG));
+}
+
+/* the sizes are updated atomically, such that no lock is needed */
 static void add_size(MA* ma, GtUword size)
 {
+  GtUword current_size;
   gt_assert(ma);
-  ma->current_size += size;
+  current_size = gt_atomic_add_and_fetch(&ma->current_size, size);
   if (ma->global_space_peak)
     gt_spacepeak_add(size);
-  if (ma->current_size > ma->max_size)
-    ma->max_size = ma->current_size;
+  gt_atomic_update_max(&ma->max_size, current_size);
 }
 
 static void subtract_size(MA *ma, GtUword size)
 {
+  GT_UNUSED GtUword current_size;
   gt_assert(ma);
-  gt_assert(ma->current_size >= size);
-  ma->current_size -= size;
+  current_size = gt_atomic_fetch_and_sub(&ma->current_size, size);
+  gt_assert(current_size >= size);
   if (ma->global_space_peak)
     gt_spacepeak_free(size);
 }
 
+static void add_pointer(MA *ma, void *ptr, MAInfo *mainfo)
+{
+  MAShard *shard = ma_shard(ma, ptr);
+  gt_mutex_lock(shard->lock);
+  gt_hashmap_add(shard->allocated_pointer, ptr, mainfo);
+  gt_mutex_unlock(shard->lock);
+  add_size(ma, mainfo->size);
+}
+
+/* returns false if <ptr> is not allocated */
+static bool remove_pointer(MA *ma, void *ptr)
+{
+  MAShard *shard = ma_shard(ma, ptr);
+  MAInfo *mainfo;
+  GtUword size;
+  gt_mutex_lock(shard->lock);
+  if (!(mainfo = gt_hashmap_get(shard->allocated_pointer, ptr))) {
+    gt_mutex_unlock(shard->lock);
+    return false;
+  }
+  size = mainfo->size;
+  gt_hashmap_remove(shard->allocated_pointer, ptr);
+  gt_mutex_unlock(shard->lock);
+  subtract_size(ma, size);
+  return true;
+}
+
 void* gt_malloc_mem(size_t size, const char *src_file, int src_line)
 {
   MAInfo *mainfo;
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
+    (void) gt_atomic_add_and_fetch(&ma->mallocevents, 1);
     mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
     mainfo->size = size;
     mainfo->src_file = src_file;
     mainfo->src_line = src_line;
     mem = xmalloc(size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
+    add_pointer(ma, mem, mainfo);
     return mem;
   }
   return xmalloc(size, ma->current_size, src_file, src_line);
@@ -161,16 +208,13 @@ void* gt_calloc_mem(size_t nmemb, size_t size, const char *src_file,
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
+    (void) gt_atomic_add_and_fetch(&ma->mallocevents, 1);
     mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
     mainfo->size = nmemb * size;
     mainfo->src_file = src_file;
     mainfo->src_line = src_line;
     mem = xcalloc(nmemb, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, nmemb * size);
-    gt_mutex_unlock(bookkeeping_lock);
+    add_pointer(ma, mem, mainfo);
     return mem;
   }
   return xcalloc(nmemb, size, ma->current_size, src_file, src_line);
@@ -182,22 +226,18 @@ void* gt_realloc_mem(void *ptr, size_t size, const char *src_file, int src_line)
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
+    GT_UNUSED bool removed;
+    (void) gt_atomic_add_and_fetch(&ma->mallocevents, 1);
     if (ptr) {
-      mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-      gt_assert(mainfo);
-      subtract_size(ma, mainfo->size);
-      gt_hashmap_remove(ma->allocated_pointer, ptr);
+      removed = remove_pointer(ma, ptr);
+      gt_assert(removed);
     }
     mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
     mainfo->size = size;
     mainfo->src_file = src_file;
     mainfo->src_line = src_line;
     mem = xrealloc(ptr, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
+    add_pointer(ma, mem, mainfo);
     return mem;
   }
   return xrealloc(ptr, size, ma->current_size, src_file, src_line);
@@ -206,24 +246,20 @@ void* gt_realloc_mem(void *ptr, size_t size, const char *src_file, int src_line)
 void gt_free_mem(void *ptr, GT_UNUSED const char *src_file,
                  GT_UNUSED int src_line)
 {
-  MAInfo *mainfo;
+  GT_UNUSED bool removed;
   gt_assert(ma);
   if (ptr == NULL) return;
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
+    removed = remove_pointer(ma, ptr);
 #ifndef NDEBUG
-    if (!gt_hashmap_get(ma->allocated_pointer, ptr)) {
+    if (!removed) {
       fprintf(stderr, "bug: double free() attempted on line %d in file "
               "\"%s\"\n", src_line, src_file);
       exit(GT_EXIT_PROGRAMMING_ERROR);
     }
 #endif
-    mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-    gt_assert(mainfo);
-    subtract_size(ma, mainfo->size);
-    gt_hashmap_remove(ma->allocated_pointer, ptr);
+    gt_assert(removed);
     free(ptr);
-    gt_mutex_unlock(bookkeeping_lock);
   }
   else {
     free(ptr);
@@ -288,13 +324,16 @@ int gt_ma_check_space_leak(void)
 {
   CheckSpaceLeakInfo info;
   GT_UNUSED int had_err;
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   info.has_leak = false;
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, check_space_leak, &info,
-                               NULL);
-  gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
-  gt_mutex_unlock(bookkeeping_lock);
+  for (i = 0; i < MA_SHARDS; i++) {
+    gt_mutex_lock(ma->shards[i].lock);
+    had_err = gt_hashmap_foreach(ma->shards[i].allocated_pointer,
+                                 check_space_leak, &info, NULL);
+    gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
+    gt_mutex_unlock(ma->shards[i].lock);
+  }
   if (info.has_leak)
     return -1;
   return 0;
@@ -321,22 +360,26 @@ static int print_allocation(GT_UNUSED void *key, void *value,
 void gt_ma_show_allocations(FILE *outfp)
 {
   GT_UNUSED int had_err;
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, print_allocation,
-                               outfp, NULL);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  for (i = 0; i < MA_SHARDS; i++) {
+    gt_mutex_lock(ma->shards[i].lock);
+    had_err = gt_hashmap_foreach(ma->shards[i].allocated_pointer,
+                                 print_allocation, outfp, NULL);
+    gt_mutex_unlock(ma->shards[i].lock);
+    gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  }
 }
 
 void gt_ma_clean(void)
 {
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   ma->bookkeeping = false;
-  gt_hashmap_delete(ma->allocated_pointer);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_mutex_delete(bookkeeping_lock);
+  for (i = 0; i < MA_SHARDS; i++) {
+    gt_hashmap_delete(ma->shards[i].allocated_pointer);
+    gt_mutex_delete(ma->shards[i].lock);
+  }
   free(ma);
   ma = NULL;
 }
@@ -0,0 +1,294 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/ma.h"
+#include "core/md5_encoder_api.h"
+#include "core/md5_tab_writer.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
+#include "core/xansi_api.h"
+
+#define GT_MD5_TAB_WRITER_BLOCKSIZE    64UL
+#define GT_MD5_TAB_WRITER_FPSIZE       33UL
+/* must be a multiple of GT_MD5_TAB_WRITER_BLOCKSIZE */
+#define GT_MD5_TAB_WRITER_BUFSIZE      (1UL << 20)
+
+/* The characters of the sequences added since the last flush. */
+typedef struct {
+  char *seqs;
+  GtUword length,
+          *ends, /* the end positions of the finished sequences in <seqs> */
+          numofends,
+          allocatedends;
+  bool continued; /* the first sequence was started in the previous buffer */
+} GtMD5TabWriterBuffer;
+
+/* If more than one thread is used (and thread support is compiled in), the
+   writer collects the sequences in the <current> buffer. A filled buffer
+   becomes the <full> buffer, whose sequences are hashed in parallel by
+   <gt_jobs> threads, started by a separate thread which also writes the
+   fingerprints in order. A sequence which is not
+   finished at the end of a buffer is hashed blockwise into <carry>, except for
+   its last block, which is moved to the next buffer. */
+struct GtMD5TabWriter {
+  FILE *fp;
+  GtMD5Encoder *carry, /* the encoder of a sequence spanning several buffers */
+               *spare;
+  GtThread *thread; /* the thread hashing <full>, NULL if none is running */
+  GtMD5TabWriterBuffer buffers[2],
+                       *current,
+                       *full;
+  GtUword buffersize;
+  char *fingerprints; /* the fingerprints of the finished sequences in
+                         <full> */
+  GtUword allocatedfingerprints;
+};
+
+GtMD5TabWriter* gt_md5_tab_writer_new(FILE *fp)
+{
+  GtMD5TabWriter *mtw;
+  gt_assert(fp);
+  mtw = gt_calloc((size_t) 1, sizeof *mtw);
+  mtw->fp = fp;
+  mtw->carry = gt_md5_encoder_new();
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U) {
+    mtw->spare = gt_md5_encoder_new();
+    mtw->buffersize = GT_MD5_TAB_WRITER_BUFSIZE * gt_jobs;
+    mtw->buffers[0].seqs = gt_malloc((size_t) mtw->buffersize);
+    mtw->buffers[1].seqs = gt_malloc((size_t) mtw->buffersize);
+    mtw->current = mtw->buffers;
+    mtw->full = mtw->buffers + 1;
+  }
+#endif
+  return mtw;
+}
+
+/* Add the <len> characters of <seq> to <enc> blockwise such that the last
+   block is not empty unless <len> is 0, and write the fingerprint of the
+   sequence to <outbuf>. */
+static void md5_tab_writer_hash(GtMD5Encoder *enc, const char *seq,
+                                GtUword len, char *outbuf)
+{
+  unsigned char output[16];
+  while (len > GT_MD5_TAB_WRITER_BLOCKSIZE) {
+    gt_md5_encoder_add_block(enc, seq, GT_MD5_TAB_WRITER_BLOCKSIZE);
+    seq += GT_MD5_TAB_WRITER_BLOCKSIZE;
+    len -= GT_MD5_TAB_WRITER_BLOCKSIZE;
+  }
+  gt_md5_encoder_add_block(enc, seq, len);
+  gt_md5_encoder_finish(enc, output, outbuf);
+  gt_md5_encoder_reset(enc);
+}
+
+#ifdef GT_THREADS_ENABLED
+
+typedef struct {
+  GtMD5TabWriter *mtw;
+  GtUword firstseq,
+          lastseq;
+} GtMD5TabWriterJob;
+
+static void* md5_tab_writer_hash_seqs(void *data)
+{
+  const GtMD5TabWriterJob *job = data;
+  GtMD5TabWriterBuffer *full = job->mtw->full;
+  GtMD5Encoder *enc = gt_md5_encoder_new();
+  GtUword idx, start;
+  for (idx = job->firstseq; idx <= job->lastseq; idx++) {
+    start = idx == 0 ? 0 : full->ends[idx - 1];
+    md5_tab_writer_hash(idx == 0 && full->continued ? job->mtw->carry : enc,
+                        full->seqs + start, full->ends[idx] - start,
+                        job->mtw->fingerprints +
+                        idx * GT_MD5_TAB_WRITER_FPSIZE);
+  }
+  gt_md5_encoder_delete(enc);
+  return NULL;
+}
+
+/* Hash the sequences in the <full> buffer of the writer given by <data> in
+   parallel and write their fingerprints in order. */
+static void* md5_tab_writer_hash_buffer(void *data)
+{
+  GtMD5TabWriter *mtw = data;
+  GtMD5TabWriterBuffer *full = mtw->full;
+  GtMD5Encoder *tailenc = mtw->carry;
+  GtUword numofjobs = 0, seqsperjob, start, j;
+  GtMD5TabWriterJob *jobs = NULL;
+  GtThread **threads = NULL;
+  if (full->numofends > 0) {
+    numofjobs = MIN((GtUword) gt_jobs, full->numofends);
+    seqsperjob = (full->numofends + numofjobs - 1) / numofjobs;
+    numofjobs = (full->numofends + seqsperjob - 1) / seqsperjob;
+    jobs = gt_malloc(sizeof (*jobs) * numofjobs);
+    threads = gt_calloc((size_t) numofjobs, sizeof (*threads));
+    for (j = 0; j < numofjobs; j++) {
+      jobs[j].mtw = mtw;
+      jobs[j].firstseq = j * seqsperjob;
+      jobs[j].lastseq = MIN(full->numofends, (j + 1) * seqsperjob) - 1;
+    }
+    for (j = 1; j < numofjobs; j++) {
+      if (!(threads[j] = gt_thread_new(md5_tab_writer_hash_seqs, jobs + j,
+                                       NULL))) {
+        (void) md5_tab_writer_hash_seqs(jobs + j);
+      }
+    }
+    (void) md5_tab_writer_hash_seqs(jobs);
+    /* the unfinished sequence at the end of the buffer is a new one */
+    tailenc = mtw->spare;
+  }
+  /* the unfinished sequence consists of complete blocks here */
+  start = full->numofends > 0 ? full->ends[full->numofends - 1] : 0;
+  for (/* Nothing */; start < full->length;
+       start += GT_MD5_TAB_WRITER_BLOCKSIZE) {
+    gt_md5_encoder_add_block(tailenc, full->seqs + start,
+                             GT_MD5_TAB_WRITER_BLOCKSIZE);
+  }
+  if (full->numofends > 0) {
+    for (j = 1; j < numofjobs; j++) {
+      if (threads[j]) {
+        gt_thread_join(threads[j]);
+        gt_thread_delete(threads[j]);
+      }
+    }
+    gt_xfwrite(mtw->fingerprints, sizeof (char),
+               (size_t) full->numofends * GT_MD5_TAB_WRITER_FPSIZE, mtw->fp);
+    /* <carry> has been reset after hashing the first sequence */
+    mtw->spare = mtw->carry;
+    mtw->carry = tailenc;
+  }
+  gt_free(threads);
+  gt_free(jobs);
+  return NULL;
+}
+
+static void md5_tab_writer_wait(GtMD5TabWriter *mtw)
+{
+  if (mtw->thread) {
+    gt_thread_join(mtw->thread);
+    gt_thread_delete(mtw->thread);
+    mtw->thread = NULL;
+  }
+}
+
+/* Hand the current buffer of <mtw> over to a hashing thread. */
+static void md5_tab_writer_flush(GtMD5TabWriter *mtw)
+{
+  GtMD5TabWriterBuffer *tmpbuf;
+  GtUword start, keep = 0;
+  if (mtw->current->length == 0 && mtw->current->numofends == 0)
+    return;
+  md5_tab_writer_wait(mtw);
+  tmpbuf = mtw->full;
+  mtw->full = mtw->current;
+  mtw->current = tmpbuf;
+  start = mtw->full->numofends > 0
+            ? mtw->full->ends[mtw->full->numofends - 1]
+            : 0;
+  if (mtw->full->length > start) {
+    /* keep back the last block of the unfinished sequence */
+    keep = mtw->full->length - start -
+           GT_MD5_TAB_WRITER_BLOCKSIZE * ((mtw->full->length - start - 1) /
+                                          GT_MD5_TAB_WRITER_BLOCKSIZE);
+    memcpy(mtw->current->seqs, mtw->full->seqs + mtw->full->length - keep,
+           (size_t) keep);
+    mtw->full->length -= keep;
+  }
+  mtw->current->length = keep;
+  mtw->current->numofends = 0;
+  mtw->current->continued = keep > 0;
+  if (mtw->full->numofends * GT_MD5_TAB_WRITER_FPSIZE
+        > mtw->allocatedfingerprints) {
+    mtw->allocatedfingerprints = mtw->full->numofends *
+                                 GT_MD5_TAB_WRITER_FPSIZE;
+    mtw->fingerprints = gt_realloc(mtw->fingerprints,
+                                   (size_t) mtw->allocatedfingerprints);
+  }
+  if (!(mtw->thread = gt_thread_new(md5_tab_writer_hash_buffer, mtw, NULL)))
+    (void) md5_tab_writer_hash_buffer(mtw);
+}
+
+static void md5_tab_writer_append(GtMD5TabWriter *mtw, const char *block,
+                                  GtUword len)
+{
+  if (mtw->current->length + len > mtw->buffersize)
+    md5_tab_writer_flush(mtw);
+  memcpy(mtw->current->seqs + mtw->current->length, block, (size_t) len);
+  mtw->current->length += len;
+}
+
+#endif
+
+void gt_md5_tab_writer_add_block(GtMD5TabWriter *mtw, const char *block)
+{
+  gt_assert(mtw && block);
+#ifdef GT_THREADS_ENABLED
+  if (mtw->current != NULL) {
+    md5_tab_writer_append(mtw, block, GT_MD5_TAB_WRITER_BLOCKSIZE);
+    return;
+  }
+#endif
+  gt_md5_encoder_add_block(mtw->carry, block, GT_MD5_TAB_WRITER_BLOCKSIZE);
+}
+
+void gt_md5_tab_writer_finish_sequence(GtMD5TabWriter *mtw, const char *block,
+                                       GtUword len)
+{
+  char outbuf[GT_MD5_TAB_WRITER_FPSIZE];
+  gt_assert(mtw && block && len <= GT_MD5_TAB_WRITER_BLOCKSIZE);
+#ifdef GT_THREADS_ENABLED
+  if (mtw->current != NULL) {
+    GtMD5TabWriterBuffer *current;
+    md5_tab_writer_append(mtw, block, len);
+    current = mtw->current;
+    if (current->numofends == current->allocatedends) {
+      current->allocatedends = current->allocatedends * 2 + 32;
+      current->ends = gt_realloc(current->ends, sizeof (*current->ends) *
+                                                current->allocatedends);
+    }
+    current->ends[current->numofends++] = current->length;
+    return;
+  }
+#endif
+  md5_tab_writer_hash(mtw->carry, block, len, outbuf);
+  gt_xfwrite(outbuf, sizeof (char), (size_t) GT_MD5_TAB_WRITER_FPSIZE,
+             mtw->fp);
+}
+
+void gt_md5_tab_writer_delete(GtMD5TabWriter *mtw)
+{
+  if (!mtw) return;
+#ifdef GT_THREADS_ENABLED
+  if (mtw->current != NULL) {
+    gt_assert(mtw->current->numofends > 0
+                ? mtw->current->ends[mtw->current->numofends - 1]
+                    == mtw->current->length
+                : mtw->current->length == 0);
+    md5_tab_writer_flush(mtw);
+    md5_tab_writer_wait(mtw);
+    gt_free(mtw->buffers[0].seqs);
+    gt_free(mtw->buffers[0].ends);
+    gt_free(mtw->buffers[1].seqs);
+    gt_free(mtw->buffers[1].ends);
+    gt_free(mtw->fingerprints);
+  }
+#endif
+  gt_md5_encoder_delete(mtw->carry);
+  gt_md5_encoder_delete(mtw->spare);
+  gt_free(mtw);
+}
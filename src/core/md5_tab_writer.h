@@ -0,0 +1,46 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef MD5_TAB_WRITER_H
+#define MD5_TAB_WRITER_H
+
+#include <stdio.h>
+#include "core/types_api.h"
+
+/* The <GtMD5TabWriter> class computes the MD5 fingerprints of a series of
+   sequences and writes them to a file, one after another, each as a string of
+   32 hexadecimal digits terminated by '\0' (the format of a .md5 table).
+   The sequences are given blockwise, in the same way as to a <GtMD5Encoder>.
+   If more than one thread is used (see <gt_jobs>), the fingerprints are
+   computed in separate threads while further sequences are added. */
+typedef struct GtMD5TabWriter GtMD5TabWriter;
+
+/* Return a new <GtMD5TabWriter> writing to <fp>. */
+GtMD5TabWriter* gt_md5_tab_writer_new(FILE *fp);
+/* Add the 64 characters in <block> to the current sequence of <mtw>. */
+void            gt_md5_tab_writer_add_block(GtMD5TabWriter *mtw,
+                                            const char *block);
+/* Add the last <len> (at most 64) characters in <block> to the current
+   sequence of <mtw> and write its fingerprint. The next block added belongs to
+   a new sequence. */
+void            gt_md5_tab_writer_finish_sequence(GtMD5TabWriter *mtw,
+                                                  const char *block,
+                                                  GtUword len);
+/* Write all remaining fingerprints and delete <mtw>. The file is not
+   closed. */
+void            gt_md5_tab_writer_delete(GtMD5TabWriter *mtw);
+
+#endif
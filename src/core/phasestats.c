@@ -0,0 +1,235 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/time.h>
+#endif
+#include "core/array_api.h"
+#include "core/cstr_api.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/phasestats.h"
+#include "core/thread_api.h"
+
+typedef struct {
+  char *name;
+  double realtime,
+         usertime,
+         systime;
+  GtUword heap,
+          heap_peak,
+          mmap,
+          mmap_peak,
+          max_rss;
+  GtUint64 bytes_read,
+           bytes_written;
+} GtPhaseRecord;
+
+typedef struct {
+  char *filename;
+  GtArray *records;
+  GtMutex *mutex;
+  bool io_available;
+#ifndef _WIN32
+  struct timeval start_tv;
+#endif
+} GtPhaseStats;
+
+static GtPhaseStats *phasestats = NULL;
+
+void gt_phasestats_init(const char *filename)
+{
+  gt_assert(!phasestats && filename);
+  phasestats = gt_calloc(1, sizeof (GtPhaseStats));
+  phasestats->filename = gt_cstr_dup(filename);
+  phasestats->records = gt_array_new(sizeof (GtPhaseRecord));
+  phasestats->mutex = gt_mutex_new();
+#ifndef _WIN32
+  gettimeofday(&phasestats->start_tv, NULL);
+#endif
+  phasestats->io_available = true;
+  gt_phasestats_get_io(NULL, NULL);
+}
+
+bool gt_phasestats_enabled(void)
+{
+  return phasestats != NULL;
+}
+
+void gt_phasestats_get_io(GtUint64 *bytes_read, GtUint64 *bytes_written)
+{
+  unsigned long long rchar = 0, wchar = 0, value;
+  char key[32];
+  FILE *fp;
+  /* the counters of all read and write calls, including those not going to
+     storage (e.g. pipes); reading memory maps is not included */
+  if (phasestats && phasestats->io_available
+        && (fp = fopen("/proc/self/io", "r")) != NULL) {
+    while (fscanf(fp, "%31s %llu", key, &value) == 2) {
+      if (!strcmp(key, "rchar:"))
+        rchar = value;
+      else if (!strcmp(key, "wchar:"))
+        wchar = value;
+    }
+    fclose(fp);
+  }
+  else if (phasestats)
+    phasestats->io_available = false;
+  if (bytes_read)
+    *bytes_read = (GtUint64) rchar;
+  if (bytes_written)
+    *bytes_written = (GtUint64) wchar;
+}
+
+static void phasestats_snapshot(GtPhaseRecord *record)
+{
+  record->heap = gt_ma_get_space_current();
+  record->heap_peak = gt_ma_get_space_peak();
+  record->mmap = gt_fa_get_space_current();
+  record->mmap_peak = gt_fa_get_space_peak();
+  record->max_rss = 0;
+#ifndef _WIN32
+  {
+    struct rusage ru;
+    if (!getrusage(RUSAGE_SELF, &ru)) {
+#ifdef __APPLE__
+      record->max_rss = (GtUword) ru.ru_maxrss;
+#else
+      record->max_rss = (GtUword) ru.ru_maxrss * 1024;
+#endif
+    }
+  }
+#endif
+}
+
+void gt_phasestats_add(const char *name, double realtime, double usertime,
+                       double systime, GtUint64 bytes_read,
+                       GtUint64 bytes_written)
+{
+  GtPhaseRecord record;
+  gt_assert(phasestats);
+  record.name = gt_cstr_dup(name ? name : "unnamed");
+  record.realtime = realtime;
+  record.usertime = usertime;
+  record.systime = systime;
+  record.bytes_read = bytes_read;
+  record.bytes_written = bytes_written;
+  phasestats_snapshot(&record);
+  gt_mutex_lock(phasestats->mutex);
+  gt_array_add(phasestats->records, record);
+  gt_mutex_unlock(phasestats->mutex);
+}
+
+static void phasestats_write_string(FILE *fp, const char *s)
+{
+  fputc('"', fp);
+  for (/* Nothing */; *s != '\0'; s++) {
+    if (*s == '"' || *s == '\\')
+      fprintf(fp, "\\%c", *s);
+    else if ((unsigned char) *s < 0x20)
+      fprintf(fp, "\\u%04x", (unsigned int) (unsigned char) *s);
+    else
+      fputc(*s, fp);
+  }
+  fputc('"', fp);
+}
+
+static void phasestats_write_record(FILE *fp, const GtPhaseRecord *record,
+                                    bool heap_available)
+{
+  fprintf(fp, "{\"name\": ");
+  phasestats_write_string(fp, record->name);
+  fprintf(fp, ", \"realtime\": %.6f, \"usertime\": %.6f, \"systime\": %.6f, ",
+          record->realtime, record->usertime, record->systime);
+  if (heap_available) {
+    fprintf(fp, "\"heap\": "GT_WU", \"heap_peak\": "GT_WU", ", record->heap,
+            record->heap_peak);
+  }
+  else
+    fprintf(fp, "\"heap\": null, \"heap_peak\": null, ");
+  fprintf(fp, "\"mmap\": "GT_WU", \"mmap_peak\": "GT_WU", \"max_rss\": "GT_WU
+          ", ", record->mmap, record->mmap_peak, record->max_rss);
+  if (phasestats->io_available) {
+    fprintf(fp, "\"bytes_read\": "GT_LLU", \"bytes_written\": "GT_LLU"}",
+            record->bytes_read, record->bytes_written);
+  }
+  else
+    fprintf(fp, "\"bytes_read\": null, \"bytes_written\": null}");
+}
+
+int gt_phasestats_clean(void)
+{
+  GtPhaseRecord total, *record;
+  GtUword i;
+  bool heap_available;
+  int had_err = 0;
+  FILE *fp;
+  if (!phasestats) return 0;
+  /* the whole run */
+  total.name = "total";
+  total.realtime = total.usertime = total.systime = 0.0;
+#ifndef _WIN32
+  {
+    struct timeval now;
+    struct rusage ru;
+    gettimeofday(&now, NULL);
+    total.realtime = (double) (now.tv_sec - phasestats->start_tv.tv_sec)
+                     + (double) (now.tv_usec - phasestats->start_tv.tv_usec)
+                       / 1000000.0;
+    if (!getrusage(RUSAGE_SELF, &ru)) {
+      total.usertime = (double) ru.ru_utime.tv_sec
+                       + (double) ru.ru_utime.tv_usec / 1000000.0;
+      total.systime = (double) ru.ru_stime.tv_sec
+                      + (double) ru.ru_stime.tv_usec / 1000000.0;
+    }
+  }
+#endif
+  gt_phasestats_get_io(&total.bytes_read, &total.bytes_written);
+  phasestats_snapshot(&total);
+  /* the heap is only measured with memory bookkeeping */
+  heap_available = gt_ma_bookkeeping_enabled();
+  if (!(fp = fopen(phasestats->filename, "w"))) {
+    fprintf(stderr, "cannot write phase statistics to \"%s\": %s\n",
+            phasestats->filename, strerror(errno));
+    had_err = -1;
+  }
+  else {
+    fprintf(fp, "{\n  \"phases\": [");
+    for (i = 0; i < gt_array_size(phasestats->records); i++) {
+      record = gt_array_get(phasestats->records, i);
+      fprintf(fp, "%s\n    ", i > 0 ? "," : "");
+      phasestats_write_record(fp, record, heap_available);
+    }
+    fprintf(fp, "\n  ],\n  \"total\": ");
+    phasestats_write_record(fp, &total, heap_available);
+    fprintf(fp, "\n}\n");
+    fclose(fp);
+  }
+  for (i = 0; i < gt_array_size(phasestats->records); i++) {
+    record = gt_array_get(phasestats->records, i);
+    gt_free(record->name);
+  }
+  gt_array_delete(phasestats->records);
+  gt_mutex_delete(phasestats->mutex);
+  gt_free(phasestats->filename);
+  gt_free(phasestats);
+  phasestats = NULL;
+  return had_err;
+}
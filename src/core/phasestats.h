@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PHASESTATS_H
+#define PHASESTATS_H
+
+#include <stdbool.h>
+#include "core/types_api.h"
+
+/* The phasestats module records the resource usage of the phases of a run, as
+   reported by <GtTimer> objects, and of the run as a whole. For each phase the
+   real, user and system time is recorded, together with the current and peak
+   heap space (if memory bookkeeping is enabled), the current and peak space of
+   memory maps, the maximum resident set size and the number of bytes read and
+   written during the phase. Upon <gt_phasestats_clean()> the records are
+   written to a file in JSON format. */
+
+/* Enable recording, the records are written to the file named <filename>. */
+void gt_phasestats_init(const char *filename);
+/* Returns true if recording is enabled, false otherwise. */
+bool gt_phasestats_enabled(void);
+/* Store the number of bytes read and written by the process so far in
+   <bytes_read> and <bytes_written>. Both are 0 if the platform does not
+   provide them. */
+void gt_phasestats_get_io(GtUint64 *bytes_read, GtUint64 *bytes_written);
+/* Record the phase <name> which took <realtime>, <usertime> and <systime>
+   seconds, at a time the process had read <bytes_read> and written
+   <bytes_written> bytes since the start of the phase. */
+void gt_phasestats_add(const char *name, double realtime, double usertime,
+                       double systime, GtUint64 bytes_read,
+                       GtUint64 bytes_written);
+/* Write the records and disable recording. Returns -1 and reports on stderr if
+   the file could not be written, 0 otherwise. */
+int  gt_phasestats_clean(void);
+
+#endif
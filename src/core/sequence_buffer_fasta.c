@@ -19,6 +19,7 @@
 #ifndef S_SPLINT_S
 #include <ctype.h>
 #endif
+#include <string.h>
 #include "core/cstr_api.h"
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_rep.h"
@@ -40,6 +41,122 @@ struct GtSequenceBufferFasta {
 #define gt_sequence_buffer_fasta_cast(SB)\
         gt_sequence_buffer_cast(gt_sequence_buffer_fasta_class(), SB)
 
+/* Process the sequence lines in the input buffer of <sb> up to the next
+   FASTA separator or the end of the input buffer, but at most as many
+   characters as fit into the output buffer. Instead of reading the input
+   character by character, the lines are located by <memchr()> and the
+   characters of a line are translated in a tight loop. */
+static int gt_sequence_buffer_fasta_sequenceblock(GtSequenceBuffer *sb,
+                                                  GtUword *currentoutpos,
+                                                  GtUword *currentfileadd,
+                                                  GtUword *currentfileread,
+                                                  GtError *err)
+{
+  GtSequenceBufferMembers *pvt = sb->pvt;
+  const GtUchar *inptr = pvt->inbuf + pvt->currentinpos,
+                *blockend = pvt->inbuf + pvt->currentfillpos,
+                *lineend,
+                *symbolmap = pvt->symbolmap;
+  GtUword outpos = *currentoutpos, maxinput = (GtUword) OUTBUFSIZE - outpos;
+  unsigned char cc, charcode;
+
+  if ((GtUword) (blockend - inptr) > maxinput)
+  {
+    blockend = inptr + maxinput;
+  }
+  lineend = memchr(inptr, FASTASEPARATOR, (size_t) (blockend - inptr));
+  if (lineend != NULL)
+  {
+    blockend = lineend;
+  }
+  while (inptr < blockend)
+  {
+    lineend = memchr(inptr, NEWLINESYMBOL, (size_t) (blockend - inptr));
+    if (lineend == NULL)
+    {
+      lineend = blockend;
+    }
+    for (/* Nothing */; inptr < lineend; inptr++)
+    {
+      cc = *inptr;
+      if (isspace((int) cc))
+      {
+        continue;
+      }
+      if (symbolmap != NULL)
+      {
+        charcode = symbolmap[(unsigned int) cc];
+        if (charcode == (unsigned char) UNDEFCHAR)
+        {
+          /* let process_char report the error */
+          pvt->currentinpos = (GtUword) (inptr + 1 - pvt->inbuf);
+          return process_char(sb, outpos, cc, err);
+        }
+        if (ISSPECIAL((GtUchar) charcode))
+        {
+          pvt->lastspeciallength++;
+        } else
+        {
+          pvt->lastspeciallength = 0;
+          if (pvt->chardisttab != NULL)
+          {
+            pvt->chardisttab[(int) charcode]++;
+          }
+        }
+        pvt->outbuf[outpos] = charcode;
+      } else
+      {
+        pvt->outbuf[outpos] = cc;
+      }
+      pvt->outbuforig[outpos++] = cc;
+    }
+    if (inptr < blockend)
+    {
+      gt_assert(*inptr == (GtUchar) NEWLINESYMBOL);
+      pvt->linenum++;
+      inptr++;
+    }
+  }
+  pvt->counter += outpos - *currentoutpos;
+  *currentfileadd += outpos - *currentoutpos;
+  *currentfileread += (GtUword) (inptr - pvt->inbuf) - pvt->currentinpos;
+  *currentoutpos = outpos;
+  pvt->currentinpos = (GtUword) (inptr - pvt->inbuf);
+  return 0;
+}
+
+/* Process the description line in the input buffer of <sb> up to the next
+   newline or the end of the input buffer. */
+static void gt_sequence_buffer_fasta_descriptionblock(GtSequenceBuffer *sb,
+                                                      GtUword *currentfileread)
+{
+  GtSequenceBufferMembers *pvt = sb->pvt;
+  const GtUchar *inptr = pvt->inbuf + pvt->currentinpos,
+                *blockend = pvt->inbuf + pvt->currentfillpos,
+                *lineend;
+
+  lineend = memchr(inptr, NEWLINESYMBOL, (size_t) (blockend - inptr));
+  if (lineend == NULL)
+  {
+    lineend = blockend;
+  }
+  if (pvt->descptr != NULL)
+  {
+    for (/* Nothing */; inptr < lineend; inptr++)
+    {
+      if (*inptr != (GtUchar) CRSYMBOL)
+      {
+        gt_desc_buffer_append_char(pvt->descptr, (char) *inptr);
+      }
+    }
+  } else
+  {
+    inptr = lineend;
+  }
+  *currentfileread += (GtUword) (inptr - pvt->inbuf) - pvt->currentinpos;
+  pvt->currentinpos = (GtUword) (inptr - pvt->inbuf);
+}
+
 static int gt_sequence_buffer_fasta_advance(GtSequenceBuffer *sb, GtError *err)
 {
   int currentchar, ret = 0;
@@ -84,6 +201,31 @@ static int gt_sequence_buffer_fasta_advance(GtSequenceBuffer *sb, GtError *err)
       pvt->currentfillpos = 0;
     } else
     {
+      if (pvt->currentinpos < pvt->currentfillpos && !pvt->use_ungetchar)
+      {
+        /* fast path: process the buffered input line-wise */
+        if (sbf->indesc)
+        {
+          gt_sequence_buffer_fasta_descriptionblock(sb, &currentfileread);
+        } else
+        {
+          if ((ret = gt_sequence_buffer_fasta_sequenceblock(sb,
+                                                            &currentoutpos,
+                                                            &currentfileadd,
+                                                            &currentfileread,
+                                                            err)))
+          {
+            return ret;
+          }
+        }
+        /* the character the block ends with (usually a separator or the
+           newline ending a description) is handled character-wise */
+        if (pvt->currentinpos >= pvt->currentfillpos ||
+            currentoutpos >= (GtUword) OUTBUFSIZE)
+        {
+          continue;
+        }
+      }
       currentchar = inlinebuf_getchar(sb, pvt->inputstream);
       if (currentchar == EOF)
       {
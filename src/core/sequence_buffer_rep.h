@@ -26,7 +26,7 @@
 #include "core/sequence_buffer.h"
 #include "core/str_array.h"
 
-#define INBUFSIZE  8192
+#define INBUFSIZE  65536
 #define OUTBUFSIZE 8192
 
 struct GtSequenceBufferClass {
@@ -17,19 +17,35 @@
 
 #include "core/showtime.h"
 
-static bool gt_showtime_is_enabled = false;
+static bool gt_showtime_is_enabled = false,
+            gt_showtime_is_silent = false;
 
 void gt_showtime_enable(void)
 {
   gt_showtime_is_enabled = true;
+  gt_showtime_is_silent = false;
 }
 
 void gt_showtime_disable(void)
 {
   gt_showtime_is_enabled = false;
+  gt_showtime_is_silent = false;
 }
 
 bool gt_showtime_enabled(void)
 {
   return gt_showtime_is_enabled;
 }
+
+void gt_showtime_enable_silently(void)
+{
+  if (!gt_showtime_is_enabled) {
+    gt_showtime_is_enabled = true;
+    gt_showtime_is_silent = true;
+  }
+}
+
+bool gt_showtime_silent(void)
+{
+  return gt_showtime_is_silent;
+}
@@ -31,4 +31,12 @@ void gt_showtime_disable(void);
 /* Returns true if time output is enabled, false otherwise */
 bool gt_showtime_enabled(void);
 
+/* Enable time measurements without output, such that the phases measured by
+   <GtTimer> objects created from now on are only recorded (see
+   phasestats.h). Has no effect if time output is enabled. */
+void gt_showtime_enable_silently(void);
+
+/* Returns true if time measurements are enabled without output. */
+bool gt_showtime_silent(void);
+
 #endif
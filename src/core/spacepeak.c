@@ -16,16 +16,18 @@
 */
 
 #include <stdio.h>
+#include "core/atomic.h"
 #include "core/spacepeak.h"
 #include "core/ma.h"
 #include "core/spacecalc.h"
-#include "core/thread_api.h"
+#include "core/unused_api.h"
 
+/* the counters are updated atomically, such that concurrent allocations do not
+   wait for each other */
 typedef struct
 {
   GtUword current,
                 max;
-  GtMutex *mutex;
 } GtSpacepeakLogger;
 
 static GtSpacepeakLogger *peaklogger = NULL;
@@ -36,25 +38,22 @@ void gt_spacepeak_init(void)
   peaklogger = malloc(sizeof (GtSpacepeakLogger));
   peaklogger->current = gt_ma_get_space_current();
   peaklogger->max = 0;
-  peaklogger->mutex = gt_mutex_new();
 }
 
 void gt_spacepeak_add(GtUword size)
 {
+  GtUword current;
   gt_assert(peaklogger);
-  gt_mutex_lock(peaklogger->mutex);
-  peaklogger->current += size;
-  if (peaklogger->current > peaklogger->max)
-    peaklogger->max = peaklogger->current;
-  gt_mutex_unlock(peaklogger->mutex);
+  current = gt_atomic_add_and_fetch(&peaklogger->current, size);
+  gt_atomic_update_max(&peaklogger->max, current);
 }
 
 void gt_spacepeak_free(GtUword size)
 {
-  gt_assert(peaklogger && size <= peaklogger->current);
-  gt_mutex_lock(peaklogger->mutex);
-  peaklogger->current -= size;
-  gt_mutex_unlock(peaklogger->mutex);
+  GT_UNUSED GtUword current;
+  gt_assert(peaklogger);
+  current = gt_atomic_fetch_and_sub(&peaklogger->current, size);
+  gt_assert(size <= current);
 }
 GtUword gt_spacepeak_get_space_peak(void)
 {
@@ -72,6 +71,5 @@ void gt_spacepeak_show_space_peak(FILE *outfp)
 void gt_spacepeak_clean()
 {
   if (!peaklogger) return;
-  gt_mutex_delete(peaklogger->mutex);
   free(peaklogger);
 }
@@ -18,6 +18,7 @@
 #include <math.h>
 #include <string.h>
 #include "core/assert_api.h"
+#include "core/atomic.h"
 #include "core/cstr_api.h"
 #include "core/dynalloc.h"
 #include "core/ensure.h"
@@ -31,6 +32,7 @@ struct GtStr {
   GtUword length; /* currently used length (without trailing '\0') */
   size_t allocated;     /* currently allocated memory */
   unsigned int reference_count;
+  bool atomic_reference_count; /* see <gt_str_set_atomic_reference_count()> */
 };
 
 GtStr* gt_str_new(void)
@@ -40,6 +42,7 @@ GtStr* gt_str_new(void)
   s->length = 0;                         /* set the initial length */
   s->allocated = 1;                      /* set allocated space */
   s->reference_count = 0;                /* set reference count */
+  s->atomic_reference_count = false;
   return s;                              /* return new string object */
 }
 
@@ -217,16 +220,26 @@ GtStr* gt_str_clone(const GtStr *s)
   s_copy->length = s->length;
   s_copy->allocated = s->length + 1;
   s_copy->reference_count = 0;
+  s_copy->atomic_reference_count = false;
   return s_copy;
 }
 
 GtStr* gt_str_ref(GtStr *s)
 {
   if (!s) return NULL;
-  s->reference_count++; /* increase the reference counter */
+  if (s->atomic_reference_count)
+    (void) gt_atomic_add_and_fetch(&s->reference_count, 1);
+  else
+    s->reference_count++; /* increase the reference counter */
   return s;
 }
 
+void gt_str_set_atomic_reference_count(GtStr *s)
+{
+  gt_assert(s);
+  s->atomic_reference_count = true;
+}
+
 int gt_str_read_next_line(GtStr *s, FILE *fpin)
 {
   int cc;
@@ -428,13 +441,32 @@ int gt_str_unit_test(GtError *err)
   gt_str_delete(s);
   gt_str_delete(s1);
 
+  /* test atomic reference counting, the clone has a plain reference count */
+  s = gt_str_new_cstr("foo");
+  gt_str_set_atomic_reference_count(s);
+  s1 = gt_str_ref(s);
+  gt_ensure(s1 == gt_str_ref(s));
+  gt_str_delete(s1);
+  gt_str_delete(s1);
+  s1 = gt_str_clone(s);
+  gt_ensure(gt_str_ref(s1) == s1);
+  gt_str_delete(s1);
+  gt_str_delete(s1);
+  gt_str_delete(s);
+
   return had_err;
 }
 
 void gt_str_delete(GtStr *s)
 {
   if (!s) return;           /* return without action if 's' is NULL */
-  if (s->reference_count) { /* there are multiple references to this string */
+  if (s->atomic_reference_count) {
+    /* decrement the reference counter, keep the object if there were
+       multiple references */
+    if (gt_atomic_fetch_and_sub(&s->reference_count, 1) > 0)
+      return;
+  }
+  else if (s->reference_count) { /* there are multiple references */
     s->reference_count--;   /* decrement the reference counter */
     return;                 /* return without freeing the object */
   }
@@ -29,6 +29,10 @@ void*         gt_str_get_mem(const GtStr*);
    is returned, otherwise 0. */
 int           gt_str_read_next_line(GtStr *str, FILE *fpin);
 int           gt_str_read_next_line_generic(GtStr*, GtFile*);
+/* Change the reference count of <str> atomically from now on, so that <str>
+   can be referenced and deleted from several threads. Must be called before
+   <str> is shared between threads. */
+void          gt_str_set_atomic_reference_count(GtStr *str);
 int           gt_str_unit_test(GtError*);
 
 #endif
@@ -19,6 +19,8 @@
 #include <sys/time.h>
 #include "core/cstr_api.h"
 #include "core/ma.h"
+#include "core/phasestats.h"
+#include "core/showtime.h"
 #include "core/timer_api.h"
 #include "core/unused_api.h"
 #include "core/xposix.h"
@@ -42,6 +44,9 @@ struct GtTimer {
   bool has_desc;
   bool omit_last_stage;
   bool show_cpu_time;
+  bool silent;
+  GtUint64 start_bytes_read,
+           start_bytes_written;
 };
 
 GtTimer* gt_timer_new(void)
@@ -52,6 +57,8 @@ GtTimer* gt_timer_new(void)
   t->has_desc = false;
   t->omit_last_stage = false;
   t->show_cpu_time = false;
+  t->silent = gt_showtime_silent();
+  t->start_bytes_read = t->start_bytes_written = 0;
   return t;
 }
 
@@ -71,6 +78,8 @@ void gt_timer_start(GT_UNUSED GtTimer *t)
   gettimeofday(&t->start_tv, NULL);
   gt_xgetrusage(RUSAGE_SELF, &t->start_ru);
   gt_xgetrusage(RUSAGE_SELF, &t->gstart_ru);
+  if (gt_phasestats_enabled())
+    gt_phasestats_get_io(&t->start_bytes_read, &t->start_bytes_written);
   t->state = TIMER_RUNNING;
 #else
   /* XXX */
@@ -158,10 +167,31 @@ void gt_timer_show(GtTimer *t, FILE *fp)
 }
 
 #ifndef _WIN32
+#define GT_TIMER_SECONDS(TV) \
+        ((double) (TV)->tv_sec + (double) (TV)->tv_usec / 1000000.0)
+
+/* record the stage which ended now in the phase statistics */
+static void gt_timer_record_stage(GtTimer *t,
+    struct timeval *elapsed_tv, struct timeval *elapsed_user_tv,
+    struct timeval *elapsed_sys_tv, const char *desc)
+{
+  GtUint64 bytes_read, bytes_written;
+  gt_phasestats_get_io(&bytes_read, &bytes_written);
+  gt_phasestats_add(desc, GT_TIMER_SECONDS(elapsed_tv),
+                    GT_TIMER_SECONDS(elapsed_user_tv),
+                    GT_TIMER_SECONDS(elapsed_sys_tv),
+                    bytes_read - t->start_bytes_read,
+                    bytes_written - t->start_bytes_written);
+  t->start_bytes_read = bytes_read;
+  t->start_bytes_written = bytes_written;
+}
+
 static void gt_timer_print_progress_report(GtTimer *t,
     struct timeval *elapsed_tv, struct timeval *elapsed_user_tv,
     struct timeval *elapsed_sys_tv, const char *desc, FILE *fp)
 {
+  if (t->silent)
+    return;
   fprintf(fp,"# TIME %s "GT_WD".%02ld",
           desc,
           (GtWord)(elapsed_tv->tv_sec),
@@ -216,6 +246,10 @@ void gt_timer_show_progress_va(GtTimer *t, FILE *fp, const char *desc,
     &t->start_ru.ru_utime);
   timeval_subtract(&elapsed_sys_tv, &t->stop_ru.ru_stime,
     &t->start_ru.ru_stime);
+  if (gt_phasestats_enabled()) {
+    gt_timer_record_stage(t, &elapsed_tv, &elapsed_user_tv, &elapsed_sys_tv,
+                          t->statedesc);
+  }
   gt_timer_print_progress_report(t, &elapsed_tv, &elapsed_user_tv,
     &elapsed_sys_tv, t->statedesc, fp);
   if (t->statedesc)
@@ -240,6 +274,10 @@ void gt_timer_show_progress_final(GT_UNUSED GtTimer *t, GT_UNUSED FILE *fp)
       &t->start_ru.ru_utime);
     timeval_subtract(&elapsed_sys_tv, &t->stop_ru.ru_stime,
       &t->start_ru.ru_stime);
+    if (gt_phasestats_enabled()) {
+      gt_timer_record_stage(t, &elapsed_tv, &elapsed_user_tv, &elapsed_sys_tv,
+                            t->statedesc);
+    }
     gt_timer_print_progress_report(t, &elapsed_tv, &elapsed_user_tv,
       &elapsed_sys_tv, t->statedesc, fp);
   }
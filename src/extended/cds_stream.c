@@ -15,20 +15,54 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/assert_api.h"
+#include "core/unused_api.h"
 #include "extended/cds_stream_api.h"
 #include "extended/cds_visitor.h"
-#include "extended/visitor_stream_api.h"
+#include "extended/parallel_visitor_stream.h"
+
+typedef struct {
+  GtRegionMapping *region_mapping;
+  unsigned int minorflen;
+  const char *source;
+  bool start_codon,
+       final_stop_codon,
+       generic_start_codons;
+} CDSStreamInfo;
+
+static GtNodeVisitor* cds_stream_new_visitor(void *data,
+                                             GT_UNUSED GtError *err)
+{
+  CDSStreamInfo *info = data;
+  GtNodeVisitor *nv;
+  GtStr *source_str;
+  /* each visitor has its own source string, the region mapping is shared */
+  source_str = gt_str_new_cstr(info->source);
+  nv = gt_cds_visitor_new(gt_region_mapping_ref(info->region_mapping),
+                          info->minorflen, source_str, info->start_codon,
+                          info->final_stop_codon, info->generic_start_codons);
+  gt_str_delete(source_str);
+  return nv;
+}
 
 GtNodeStream* gt_cds_stream_new(GtNodeStream *in_stream, GtRegionMapping *rm,
                                 unsigned int minorflen, const char *source,
                                 bool start_codon, bool final_stop_codon,
                                 bool generic_start_codons)
 {
-  GtNodeVisitor *nv;
-  GtStr *source_str;
-  source_str = gt_str_new_cstr(source);
-  nv = gt_cds_visitor_new(rm, minorflen, source_str, start_codon,
-                          final_stop_codon, generic_start_codons);
-  gt_str_delete(source_str);
-  return gt_visitor_stream_new(in_stream, nv);
+  GtNodeStream *ns;
+  CDSStreamInfo info;
+  info.region_mapping = rm;
+  info.minorflen = minorflen;
+  info.source = source;
+  info.start_codon = start_codon;
+  info.final_stop_codon = final_stop_codon;
+  info.generic_start_codons = generic_start_codons;
+  /* the CDS of different genes are determined in parallel (see <gt_jobs>) */
+  ns = gt_parallel_visitor_stream_new(in_stream, cds_stream_new_visitor, &info,
+                                      NULL);
+  gt_assert(ns);
+  /* the visitors hold the references to <rm> now */
+  gt_region_mapping_delete(rm);
+  return ns;
 }
@@ -0,0 +1,865 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array.h"
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "core/yarandom.h"
+#include "extended/feature_index_file.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_index_rep.h"
+#include "extended/feature_node.h"
+#include "extended/genome_node.h"
+#include "extended/genome_node_serializer.h"
+
+/* The index file consists of
+   - a header,
+   - the serialized feature trees (one record per top-level feature),
+   - for each sequence region the features sorted by start position, stored as
+     an implicit interval tree (see below),
+   - the sequence region table (sorted by sequence ID), and
+   - a string pool containing the \0-terminated sequence IDs.
+   All numbers are stored as native <GtUword>s, the file can only be used on
+   machines with the same word size and byte order. */
+
+#define GT_FIF_MAGIC      "GTFIDX\0\0"
+#define GT_FIF_VERSION    1UL
+#define GT_FIF_BYTEORDER  0x01020304UL
+
+typedef struct {
+  char magic[8];
+  GtUword version,
+          byteorder,
+          wordsize,
+          nof_seqids,
+          first_seqid,
+          seqids_offset,
+          strings_offset,
+          strings_length,
+          nodes_offset,
+          nodes_length,
+          file_length;
+} GtFeatureIndexFileHeader;
+
+typedef struct {
+  GtUword name_offset,
+          name_length,
+          has_region,
+          region_start,
+          region_end,
+          features_start, /* range of all features, undefined if none */
+          features_end,
+          nof_features,
+          features_offset;
+} GtFeatureIndexFileSeqid;
+
+/* In the implicit interval tree the sorted array is the in-order traversal of
+   a complete binary tree: leaves are at even positions and a node at level
+   <k> has its <k> lowest bits set. <max_end> is the maximum end position in
+   the subtree rooted at the node. */
+typedef struct {
+  GtUword start,
+          end,
+          max_end,
+          node_offset,
+          node_length;
+} GtFeatureIndexFileFeature;
+
+struct GtFeatureIndexFile {
+  const GtFeatureIndex parent_instance;
+  void *map;
+  const GtFeatureIndexFileHeader *header;
+  const GtFeatureIndexFileSeqid *seqids;
+  const char *strings,
+             *nodes;
+  GtHashmap *cache; /* features reconstructed so far */
+  GtGenomeNodeSerializer *gns;
+  GtMutex *mutex;
+};
+
+#define gt_feature_index_file_cast(FI)\
+        gt_feature_index_cast(gt_feature_index_file_class(), FI)
+
+static const char* seqid_name(const GtFeatureIndexFile *fif,
+                              const GtFeatureIndexFileSeqid *seqid)
+{
+  return fif->strings + seqid->name_offset;
+}
+
+static const GtFeatureIndexFileFeature* seqid_features(
+                                         const GtFeatureIndexFile *fif,
+                                         const GtFeatureIndexFileSeqid *seqid)
+{
+  return (const GtFeatureIndexFileFeature*) ((const char*) fif->map +
+                                             seqid->features_offset);
+}
+
+static const GtFeatureIndexFileSeqid* find_seqid(const GtFeatureIndexFile *fif,
+                                                 const char *seqid)
+{
+  GtUword left = 0, right = fif->header->nof_seqids, mid;
+  int cmp;
+  while (left < right) {
+    mid = left + (right - left) / 2;
+    cmp = strcmp(seqid, seqid_name(fif, fif->seqids + mid));
+    if (!cmp)
+      return fif->seqids + mid;
+    if (cmp < 0)
+      right = mid;
+    else
+      left = mid + 1;
+  }
+  return NULL;
+}
+
+static const GtFeatureIndexFileSeqid* get_seqid(const GtFeatureIndexFile *fif,
+                                                const char *seqid,
+                                                GtError *err)
+{
+  const GtFeatureIndexFileSeqid *s;
+  gt_error_check(err);
+  if (!(s = find_seqid(fif, seqid))) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+  }
+  return s;
+}
+
+/* returns the feature tree for <feature>, reconstructing it if necessary */
+static GtGenomeNode* get_feature(GtFeatureIndexFile *fif,
+                                 const GtFeatureIndexFileFeature *feature,
+                                 GtError *err)
+{
+  GtGenomeNode *gn;
+  gt_error_check(err);
+  if ((gn = gt_hashmap_get(fif->cache, feature)))
+    return gn;
+  if (feature->node_offset > fif->header->nodes_length ||
+      feature->node_length > fif->header->nodes_length - feature->node_offset) {
+    gt_error_set(err, "corrupt feature index file");
+    return NULL;
+  }
+  if (gt_genome_node_serializer_read(fif->gns, &gn,
+                                     fif->nodes + feature->node_offset,
+                                     feature->node_length, err)) {
+    return NULL;
+  }
+  if (!gt_feature_node_try_cast(gn)) {
+    gt_error_set(err, "corrupt feature index file");
+    gt_genome_node_delete(gn);
+    return NULL;
+  }
+  gt_hashmap_add(fif->cache, (void*) feature, gn);
+  return gn;
+}
+
+typedef struct {
+  GtUword x; /* node */
+  unsigned int k; /* level */
+  bool left_done;
+} GtFeatureIndexFileStackElem;
+
+/* Append the features of <seqid> overlapping <range> to <results>, sorted by
+   start position (the implicit interval tree is traversed in-order). */
+static int find_overlapping(GtFeatureIndexFile *fif,
+                            const GtFeatureIndexFileSeqid *seqid,
+                            const GtRange *range, GtArray *results,
+                            GtError *err)
+{
+  GtFeatureIndexFileStackElem stack[2 * sizeof (GtUword) * 8], z;
+  const GtFeatureIndexFileFeature *a = seqid_features(fif, seqid);
+  GtUword n = seqid->nof_features, i, i_end;
+  GtGenomeNode *gn;
+  unsigned int t = 0, root_level = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  if (!n)
+    return 0;
+  while (root_level + 1 < sizeof (GtUword) * 8 &&
+         ((GtUword) 1 << (root_level + 1)) <= n) {
+    root_level++;
+  }
+  stack[t].x = ((GtUword) 1 << root_level) - 1;
+  stack[t].k = root_level;
+  stack[t++].left_done = false;
+  while (!had_err && t) {
+    z = stack[--t];
+    if (z.k <= 3) {
+      /* small subtree, scan it linearly */
+      i = z.x >> z.k << z.k;
+      i_end = i + ((GtUword) 1 << (z.k + 1)) - 1;
+      if (i_end > n)
+        i_end = n;
+      for (; !had_err && i < i_end && a[i].start <= range->end; i++) {
+        if (a[i].end >= range->start) {
+          if ((gn = get_feature(fif, a + i, err)))
+            gt_array_add(results, gn);
+          else
+            had_err = -1;
+        }
+      }
+    }
+    else if (!z.left_done) {
+      GtUword y = z.x - ((GtUword) 1 << (z.k - 1));
+      stack[t].x = z.x;
+      stack[t].k = z.k;
+      stack[t++].left_done = true;
+      if (y >= n || a[y].max_end >= range->start) {
+        stack[t].x = y;
+        stack[t].k = z.k - 1;
+        stack[t++].left_done = false;
+      }
+    }
+    else if (z.x < n && a[z.x].start <= range->end) {
+      if (a[z.x].end >= range->start) {
+        if ((gn = get_feature(fif, a + z.x, err)))
+          gt_array_add(results, gn);
+        else
+          had_err = -1;
+      }
+      stack[t].x = z.x + ((GtUword) 1 << (z.k - 1));
+      stack[t].k = z.k - 1;
+      stack[t++].left_done = false;
+    }
+  }
+  return had_err;
+}
+
+static int gt_feature_index_file_add_region_node(GT_UNUSED GtFeatureIndex *gfi,
+                                                 GT_UNUSED GtRegionNode *rn,
+                                                 GtError *err)
+{
+  gt_error_check(err);
+  gt_error_set(err, "feature index file is read-only");
+  return -1;
+}
+
+static int gt_feature_index_file_add_feature_node(
+                                                 GT_UNUSED GtFeatureIndex *gfi,
+                                                 GT_UNUSED GtFeatureNode *fn,
+                                                 GtError *err)
+{
+  gt_error_check(err);
+  gt_error_set(err, "feature index file is read-only");
+  return -1;
+}
+
+static int gt_feature_index_file_remove_node(GT_UNUSED GtFeatureIndex *gfi,
+                                             GT_UNUSED GtFeatureNode *fn,
+                                             GtError *err)
+{
+  gt_error_check(err);
+  gt_error_set(err, "feature index file is read-only");
+  return -1;
+}
+
+static GtArray* gt_feature_index_file_get_features_for_seqid(
+                                                           GtFeatureIndex *gfi,
+                                                           const char *seqid,
+                                                           GtError *err)
+{
+  const GtFeatureIndexFileFeature *features;
+  const GtFeatureIndexFileSeqid *s;
+  GtFeatureIndexFile *fif;
+  GtGenomeNode *gn;
+  GtArray *a;
+  GtUword i;
+  gt_error_check(err);
+  gt_assert(gfi && seqid);
+  fif = gt_feature_index_file_cast(gfi);
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  if ((s = find_seqid(fif, seqid))) {
+    features = seqid_features(fif, s);
+    gt_mutex_lock(fif->mutex);
+    for (i = 0; i < s->nof_features; i++) {
+      if (!(gn = get_feature(fif, features + i, err))) {
+        gt_array_delete(a);
+        a = NULL;
+        break;
+      }
+      gt_array_add(a, gn);
+    }
+    gt_mutex_unlock(fif->mutex);
+  }
+  return a;
+}
+
+static int gt_feature_index_file_get_features_for_range(GtFeatureIndex *gfi,
+                                                        GtArray *results,
+                                                        const char *seqid,
+                                                        const GtRange *range,
+                                                        GtError *err)
+{
+  const GtFeatureIndexFileSeqid *s;
+  GtFeatureIndexFile *fif;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(gfi && results && seqid && range);
+  fif = gt_feature_index_file_cast(gfi);
+  if (!(s = get_seqid(fif, seqid, err)))
+    return -1;
+  gt_mutex_lock(fif->mutex);
+  had_err = find_overlapping(fif, s, range, results, err);
+  gt_mutex_unlock(fif->mutex);
+  return had_err;
+}
+
+static char* gt_feature_index_file_get_first_seqid(const GtFeatureIndex *gfi,
+                                                   GtError *err)
+{
+  GtFeatureIndexFile *fif;
+  gt_error_check(err);
+  gt_assert(gfi);
+  fif = gt_feature_index_file_cast((GtFeatureIndex*) gfi);
+  if (fif->header->first_seqid == GT_UNDEF_UWORD) {
+    gt_error_set(err, "no sequence regions in index");
+    return NULL;
+  }
+  return gt_cstr_dup(seqid_name(fif, fif->seqids + fif->header->first_seqid));
+}
+
+static GtStrArray* gt_feature_index_file_get_seqids(const GtFeatureIndex *gfi,
+                                                    GT_UNUSED GtError *err)
+{
+  GtFeatureIndexFile *fif;
+  GtStrArray *seqids;
+  GtUword i;
+  gt_assert(gfi);
+  fif = gt_feature_index_file_cast((GtFeatureIndex*) gfi);
+  seqids = gt_str_array_new();
+  for (i = 0; i < fif->header->nof_seqids; i++)
+    gt_str_array_add_cstr(seqids, seqid_name(fif, fif->seqids + i));
+  return seqids;
+}
+
+static int gt_feature_index_file_get_range_for_seqid(GtFeatureIndex *gfi,
+                                                     GtRange *range,
+                                                     const char *seqid,
+                                                     GtError *err)
+{
+  const GtFeatureIndexFileSeqid *s;
+  gt_error_check(err);
+  gt_assert(gfi && range && seqid);
+  if (!(s = get_seqid(gt_feature_index_file_cast(gfi), seqid, err)))
+    return -1;
+  if (s->nof_features) {
+    range->start = s->features_start;
+    range->end = s->features_end;
+  }
+  else if (s->has_region) {
+    range->start = s->region_start;
+    range->end = s->region_end;
+  }
+  return 0;
+}
+
+static int gt_feature_index_file_get_orig_range_for_seqid(GtFeatureIndex *gfi,
+                                                          GtRange *range,
+                                                          const char *seqid,
+                                                          GtError *err)
+{
+  const GtFeatureIndexFileSeqid *s;
+  gt_error_check(err);
+  gt_assert(gfi && range && seqid);
+  if (!(s = get_seqid(gt_feature_index_file_cast(gfi), seqid, err)))
+    return -1;
+  if (s->has_region) {
+    range->start = s->region_start;
+    range->end = s->region_end;
+  }
+  return 0;
+}
+
+static int gt_feature_index_file_has_seqid(const GtFeatureIndex *gfi,
+                                           bool *has_seqid,
+                                           const char *seqid,
+                                           GT_UNUSED GtError *err)
+{
+  gt_assert(gfi && has_seqid && seqid);
+  *has_seqid = find_seqid(gt_feature_index_file_cast((GtFeatureIndex*) gfi),
+                          seqid) != NULL;
+  return 0;
+}
+
+static void gt_feature_index_file_delete(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexFile *fif;
+  if (!gfi) return;
+  fif = gt_feature_index_file_cast(gfi);
+  gt_hashmap_delete(fif->cache);
+  gt_genome_node_serializer_delete(fif->gns);
+  gt_mutex_delete(fif->mutex);
+  gt_fa_xmunmap(fif->map);
+}
+
+const GtFeatureIndexClass* gt_feature_index_file_class(void)
+{
+  static const GtFeatureIndexClass *fic = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic) {
+    fic = gt_feature_index_class_new(sizeof (GtFeatureIndexFile),
+                             gt_feature_index_file_add_region_node,
+                             gt_feature_index_file_add_feature_node,
+                             gt_feature_index_file_remove_node,
+                             gt_feature_index_file_get_features_for_seqid,
+                             gt_feature_index_file_get_features_for_range,
+                             gt_feature_index_file_get_first_seqid,
+                             NULL,
+                             gt_feature_index_file_get_seqids,
+                             gt_feature_index_file_get_range_for_seqid,
+                             gt_feature_index_file_get_orig_range_for_seqid,
+                             gt_feature_index_file_has_seqid,
+                             gt_feature_index_file_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return fic;
+}
+
+/* returns true if <num> elements of given <size> starting at <offset> fit into
+   <length> bytes */
+static bool fits(GtUword offset, GtUword num, size_t size, GtUword length)
+{
+  return offset <= length && num <= (length - offset) / size;
+}
+
+static int check_index_file(const void *map, size_t length, GtError *err)
+{
+  const GtFeatureIndexFileHeader *header = map;
+  const GtFeatureIndexFileSeqid *seqids;
+  const char *strings;
+  GtUword i;
+  gt_error_check(err);
+  if (length < sizeof *header ||
+      memcmp(header->magic, GT_FIF_MAGIC, sizeof header->magic)) {
+    gt_error_set(err, "not a feature index file");
+    return -1;
+  }
+  if (header->version != GT_FIF_VERSION) {
+    gt_error_set(err, "unsupported feature index file version " GT_WU,
+                 header->version);
+    return -1;
+  }
+  if (header->byteorder != GT_FIF_BYTEORDER ||
+      header->wordsize != sizeof (GtUword)) {
+    gt_error_set(err, "feature index file was created on a machine with a "
+                 "different byte order or word size");
+    return -1;
+  }
+  if (header->file_length != length ||
+      header->seqids_offset % sizeof (GtUword) ||
+      !fits(header->seqids_offset, header->nof_seqids,
+            sizeof (GtFeatureIndexFileSeqid), length) ||
+      !fits(header->strings_offset, header->strings_length, 1, length) ||
+      !fits(header->nodes_offset, header->nodes_length, 1, length) ||
+      (header->first_seqid != GT_UNDEF_UWORD &&
+       header->first_seqid >= header->nof_seqids)) {
+    gt_error_set(err, "corrupt feature index file");
+    return -1;
+  }
+  seqids = (const GtFeatureIndexFileSeqid*) ((const char*) map +
+                                             header->seqids_offset);
+  strings = (const char*) map + header->strings_offset;
+  for (i = 0; i < header->nof_seqids; i++) {
+    if (!fits(seqids[i].name_offset, seqids[i].name_length + 1, 1,
+              header->strings_length) ||
+        strings[seqids[i].name_offset + seqids[i].name_length] != '\0' ||
+        seqids[i].features_offset % sizeof (GtUword) ||
+        !fits(seqids[i].features_offset, seqids[i].nof_features,
+              sizeof (GtFeatureIndexFileFeature), length) ||
+        (i && strcmp(strings + seqids[i-1].name_offset,
+                     strings + seqids[i].name_offset) >= 0)) {
+      gt_error_set(err, "corrupt feature index file");
+      return -1;
+    }
+  }
+  return 0;
+}
+
+GtFeatureIndex* gt_feature_index_file_new(const char *filename, GtError *err)
+{
+  GtFeatureIndexFile *fif;
+  GtFeatureIndex *fi;
+  size_t length;
+  void *map;
+  gt_error_check(err);
+  gt_assert(filename);
+  if (!(map = gt_fa_mmap_read(filename, &length, err)))
+    return NULL;
+  if (check_index_file(map, length, err)) {
+    gt_fa_xmunmap(map);
+    return NULL;
+  }
+  fi = gt_feature_index_create(gt_feature_index_file_class());
+  fif = gt_feature_index_file_cast(fi);
+  fif->map = map;
+  fif->header = map;
+  fif->seqids = (const GtFeatureIndexFileSeqid*) ((const char*) map +
+                                                fif->header->seqids_offset);
+  fif->strings = (const char*) map + fif->header->strings_offset;
+  fif->nodes = (const char*) map + fif->header->nodes_offset;
+  fif->cache = gt_hashmap_new(GT_HASH_DIRECT, NULL,
+                              (GtFree) gt_genome_node_delete);
+  fif->gns = gt_genome_node_serializer_new();
+  fif->mutex = gt_mutex_new();
+  return fi;
+}
+
+/* compute the <max_end> values of the implicit interval tree over <a> */
+static void index_features(GtFeatureIndexFileFeature *a, GtUword n)
+{
+  GtUword i, last_i = 0, last = 0, x, max_end;
+  unsigned int k;
+  for (i = 0; i < n; i += 2) {
+    last_i = i;
+    last = a[i].max_end = a[i].end;
+  }
+  for (k = 1; k < sizeof (GtUword) * 8 && ((GtUword) 1 << k) <= n; k++) {
+    x = (GtUword) 1 << (k - 1);
+    for (i = (x << 1) - 1; i < n; i += x << 2) {
+      max_end = MAX(a[i].end, a[i - x].max_end);
+      max_end = MAX(max_end, i + x < n ? a[i + x].max_end : last);
+      a[i].max_end = max_end;
+    }
+    /* move <last_i> to its parent */
+    last_i = (last_i >> k) & 1 ? last_i - x : last_i + x;
+    if (last_i < n && a[last_i].max_end > last)
+      last = a[last_i].max_end;
+  }
+}
+
+/* sort features by position, features at the same position in input order */
+static int compare_features(const void *a, const void *b)
+{
+  GtGenomeNode *gn_a = *(GtGenomeNode**) a, *gn_b = *(GtGenomeNode**) b;
+  unsigned int line_a, line_b;
+  int rval;
+  if ((rval = gt_genome_node_cmp(gn_a, gn_b)))
+    return rval;
+  line_a = gt_genome_node_get_line_number(gn_a);
+  line_b = gt_genome_node_get_line_number(gn_b);
+  return line_a == line_b ? 0 : (line_a < line_b ? -1 : 1);
+}
+
+static void write_padding(FILE *fp, GtUword *offset)
+{
+  while (*offset % sizeof (GtUword)) {
+    gt_xfputc('\0', fp);
+    (*offset)++;
+  }
+}
+
+int gt_feature_index_file_write(GtFeatureIndex *feature_index,
+                                const char *filename, GtError *err)
+{
+  GtFeatureIndexFileHeader header;
+  GtFeatureIndexFileSeqid *s;
+  GtFeatureIndexFileFeature *f;
+  GtGenomeNodeSerializer *gns = NULL;
+  GtArray *seqid_records, *feature_records, *features;
+  GtStrArray *seqids;
+  GtStr *strings, *buffer;
+  GtGenomeNode *gn;
+  GtRange range;
+  char *first_seqid = NULL;
+  GtUword i, j, offset;
+  FILE *fp = NULL;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(feature_index && filename);
+
+  if (!(seqids = gt_feature_index_get_seqids(feature_index, err)))
+    return -1;
+  memset(&header, 0, sizeof header);
+  memcpy(header.magic, GT_FIF_MAGIC, sizeof header.magic);
+  header.version = GT_FIF_VERSION;
+  header.byteorder = GT_FIF_BYTEORDER;
+  header.wordsize = sizeof (GtUword);
+  header.nof_seqids = gt_str_array_size(seqids);
+  header.first_seqid = GT_UNDEF_UWORD;
+  if (header.nof_seqids) {
+    if (!(first_seqid = gt_feature_index_get_first_seqid(feature_index, err)))
+      had_err = -1;
+  }
+  seqid_records = gt_array_new(sizeof (GtFeatureIndexFileSeqid));
+  feature_records = gt_array_new(sizeof (GtFeatureIndexFileFeature));
+  strings = gt_str_new();
+  buffer = gt_str_new();
+  if (!had_err && !(fp = gt_fa_fopen(filename, "wb", err)))
+    had_err = -1;
+
+  /* write placeholder header and feature trees */
+  if (!had_err) {
+    gns = gt_genome_node_serializer_new();
+    gt_xfwrite(&header, sizeof header, 1, fp);
+    header.nodes_offset = sizeof header;
+  }
+  for (i = 0; !had_err && i < header.nof_seqids; i++) {
+    const char *seqid = gt_str_array_get(seqids, i);
+    GtFeatureIndexFileSeqid record;
+    memset(&record, 0, sizeof record);
+    if (first_seqid && !strcmp(seqid, first_seqid))
+      header.first_seqid = i;
+    record.name_offset = gt_str_length(strings);
+    record.name_length = strlen(seqid);
+    gt_str_append_cstr_nt(strings, seqid, record.name_length + 1);
+    range.start = range.end = GT_UNDEF_UWORD;
+    had_err = gt_feature_index_get_orig_range_for_seqid(feature_index, &range,
+                                                        seqid, err);
+    if (!had_err && range.start != GT_UNDEF_UWORD) {
+      record.has_region = 1;
+      record.region_start = range.start;
+      record.region_end = range.end;
+    }
+    features = NULL;
+    if (!had_err &&
+        !(features = gt_feature_index_get_features_for_seqid(feature_index,
+                                                             seqid, err))) {
+      had_err = -1;
+    }
+    if (!had_err) {
+      gt_array_sort_stable(features, compare_features);
+      record.features_offset = gt_array_size(feature_records);
+      record.nof_features = gt_array_size(features);
+      record.features_start = GT_UNDEF_UWORD;
+      record.features_end = 0;
+    }
+    for (j = 0; !had_err && j < gt_array_size(features); j++) {
+      GtFeatureIndexFileFeature feature;
+      gn = *(GtGenomeNode**) gt_array_get(features, j);
+      if (!gt_genome_node_serializer_is_serializable(gn)) {
+        gt_error_set(err, "feature on sequence region \"%s\" cannot be "
+                     "stored in a feature index file", seqid);
+        had_err = -1;
+        break;
+      }
+      /* every feature tree must be readable on its own */
+      gt_genome_node_serializer_reset(gns);
+      gt_str_reset(buffer);
+      gt_genome_node_serializer_write(gns, gn, buffer);
+      gt_xfwrite(gt_str_get(buffer), 1, gt_str_length(buffer), fp);
+      range = gt_genome_node_get_range(gn);
+      feature.start = range.start;
+      feature.end = range.end;
+      feature.max_end = range.end;
+      feature.node_offset = header.nodes_length;
+      feature.node_length = gt_str_length(buffer);
+      header.nodes_length += feature.node_length;
+      record.features_start = MIN(record.features_start, range.start);
+      record.features_end = MAX(record.features_end, range.end);
+      gt_array_add(feature_records, feature);
+    }
+    if (!had_err) {
+      if (record.nof_features) {
+        index_features(gt_array_get(feature_records, record.features_offset),
+                       record.nof_features);
+      }
+      gt_array_add(seqid_records, record);
+    }
+    gt_array_delete(features);
+  }
+
+  /* write interval trees, sequence region table, and string pool */
+  if (!had_err) {
+    offset = header.nodes_offset + header.nodes_length;
+    write_padding(fp, &offset);
+    for (i = 0; i < gt_array_size(seqid_records); i++) {
+      s = gt_array_get(seqid_records, i);
+      s->features_offset = offset + s->features_offset * sizeof *f;
+    }
+    if (gt_array_size(feature_records)) {
+      gt_xfwrite(gt_array_get_space(feature_records), sizeof *f,
+                 gt_array_size(feature_records), fp);
+    }
+    offset += gt_array_size(feature_records) * sizeof *f;
+    header.seqids_offset = offset;
+    if (gt_array_size(seqid_records)) {
+      gt_xfwrite(gt_array_get_space(seqid_records), sizeof *s,
+                 gt_array_size(seqid_records), fp);
+    }
+    offset += gt_array_size(seqid_records) * sizeof *s;
+    header.strings_offset = offset;
+    header.strings_length = gt_str_length(strings);
+    gt_xfwrite(gt_str_get(strings), 1, header.strings_length, fp);
+    header.file_length = offset + header.strings_length;
+    gt_xfseek(fp, 0, SEEK_SET);
+    gt_xfwrite(&header, sizeof header, 1, fp);
+  }
+
+  gt_fa_xfclose(fp);
+  if (had_err && fp)
+    gt_xremove(filename);
+  gt_genome_node_serializer_delete(gns);
+  gt_str_delete(buffer);
+  gt_str_delete(strings);
+  gt_array_delete(feature_records);
+  gt_array_delete(seqid_records);
+  gt_free(first_seqid);
+  gt_str_array_delete(seqids);
+  return had_err;
+}
+
+#define GT_FIF_TEST_SEQIDS        3
+#define GT_FIF_TEST_FEATURES      2000
+#define GT_FIF_TEST_END           1000000
+#define GT_FIF_TEST_FEATURE_WIDTH 20000
+#define GT_FIF_TEST_QUERIES       200
+
+int gt_feature_index_file_unit_test(GtError *err)
+{
+  static const char *seqids[GT_FIF_TEST_SEQIDS] = { "seq2", "seq1", "seq3" };
+  GtFeatureIndex *fim, *fif = NULL;
+  GtArray *results, *results_ref;
+  GtStrArray *seqids_fif;
+  GtGenomeNode *gn;
+  GtRange range, range_ref;
+  GtStr *seqid, *filename;
+  GtUword i, j;
+  char *first_seqid;
+  bool has_seqid;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* create a feature index in memory: two sequence regions with features,
+     the third one without */
+  fim = gt_feature_index_memory_new();
+  for (i = 0; i < GT_FIF_TEST_SEQIDS; i++) {
+    seqid = gt_str_new_cstr(seqids[i]);
+    gn = gt_region_node_new(seqid, 1, GT_FIF_TEST_END);
+    gt_feature_index_add_region_node(fim, (GtRegionNode*) gn, err);
+    gt_genome_node_delete(gn);
+    for (j = 0; i < 2 && j < GT_FIF_TEST_FEATURES; j++) {
+      GtUword start = 1 + random() % (GT_FIF_TEST_END -
+                                      GT_FIF_TEST_FEATURE_WIDTH),
+              end = start + random() % (j % 10 ? GT_FIF_TEST_FEATURE_WIDTH / 10
+                                               : GT_FIF_TEST_FEATURE_WIDTH);
+      gn = gt_feature_node_new(seqid, "gene", start, end, GT_STRAND_FORWARD);
+      gt_feature_node_add_child((GtFeatureNode*) gn,
+                                (GtFeatureNode*)
+                                gt_feature_node_new(seqid, "exon", start, end,
+                                                    GT_STRAND_FORWARD));
+      gt_feature_index_add_feature_node(fim, (GtFeatureNode*) gn, err);
+      gt_genome_node_delete(gn);
+    }
+    gt_str_delete(seqid);
+  }
+
+  /* write it to a file and map it */
+  filename = gt_str_new();
+  fp = gt_xtmpfp(filename);
+  gt_fa_xfclose(fp);
+  gt_ensure(!gt_feature_index_file_write(fim, gt_str_get(filename), err));
+  if (!had_err) {
+    fif = gt_feature_index_file_new(gt_str_get(filename), err);
+    gt_ensure(fif);
+  }
+
+  if (!had_err) {
+    first_seqid = gt_feature_index_get_first_seqid(fif, err);
+    gt_ensure(first_seqid && !strcmp(first_seqid, seqids[0]));
+    gt_free(first_seqid);
+    seqids_fif = gt_feature_index_get_seqids(fif, err);
+    gt_ensure(gt_str_array_size(seqids_fif) == GT_FIF_TEST_SEQIDS);
+    gt_ensure(!strcmp(gt_str_array_get(seqids_fif, 0), "seq1"));
+    gt_str_array_delete(seqids_fif);
+    gt_ensure(!gt_feature_index_has_seqid(fif, &has_seqid, "seq3", err));
+    gt_ensure(has_seqid);
+    gt_ensure(!gt_feature_index_has_seqid(fif, &has_seqid, "seq4", err));
+    gt_ensure(!has_seqid);
+    gn = gt_feature_node_new_standard_gene();
+    gt_ensure(gt_feature_index_add_feature_node(fif, (GtFeatureNode*) gn,
+                                                err));
+    gt_error_unset(err);
+    gt_genome_node_delete(gn);
+  }
+
+  /* compare ranges and queries with the memory based index */
+  for (i = 0; !had_err && i < GT_FIF_TEST_SEQIDS; i++) {
+    gt_feature_index_get_range_for_seqid(fim, &range_ref, seqids[i], err);
+    gt_ensure(!gt_feature_index_get_range_for_seqid(fif, &range, seqids[i],
+                                                    err));
+    gt_ensure(!gt_range_compare(&range, &range_ref));
+    results = gt_feature_index_get_features_for_seqid(fif, seqids[i], err);
+    gt_ensure(gt_array_size(results) == (i < 2 ? GT_FIF_TEST_FEATURES : 0));
+    gt_array_delete(results);
+  }
+  results = gt_array_new(sizeof (GtFeatureNode*));
+  results_ref = gt_array_new(sizeof (GtFeatureNode*));
+  for (i = 0; !had_err && i < GT_FIF_TEST_QUERIES; i++) {
+    const char *seqid_cstr = seqids[i % GT_FIF_TEST_SEQIDS];
+    range.start = 1 + random() % GT_FIF_TEST_END;
+    range.end = range.start + random() % (GT_FIF_TEST_FEATURE_WIDTH * 2);
+    gt_array_reset(results);
+    gt_array_reset(results_ref);
+    gt_feature_index_get_features_for_range(fim, results_ref, seqid_cstr,
+                                            &range, err);
+    gt_ensure(!gt_feature_index_get_features_for_range(fif, results,
+                                                       seqid_cstr, &range,
+                                                       err));
+    gt_ensure(gt_array_size(results) == gt_array_size(results_ref));
+    gt_array_sort_stable(results, (GtCompare) gt_genome_node_compare);
+    gt_array_sort_stable(results_ref, (GtCompare) gt_genome_node_compare);
+    for (j = 0; !had_err && j < gt_array_size(results); j++) {
+      gt_ensure(gt_feature_node_is_similar(*(GtFeatureNode**)
+                                           gt_array_get(results, j),
+                                           *(GtFeatureNode**)
+                                           gt_array_get(results_ref, j)));
+    }
+  }
+  /* results must be sorted by start position */
+  if (!had_err) {
+    range.start = 1;
+    range.end = GT_FIF_TEST_END;
+    gt_array_reset(results);
+    gt_ensure(!gt_feature_index_get_features_for_range(fif, results, "seq1",
+                                                       &range, err));
+    gt_ensure(gt_array_size(results) == GT_FIF_TEST_FEATURES);
+    for (j = 1; !had_err && j < gt_array_size(results); j++) {
+      range = gt_genome_node_get_range(*(GtGenomeNode**)
+                                       gt_array_get(results, j-1));
+      range_ref = gt_genome_node_get_range(*(GtGenomeNode**)
+                                           gt_array_get(results, j));
+      gt_ensure(range.start <= range_ref.start);
+    }
+  }
+  gt_array_delete(results);
+  gt_array_delete(results_ref);
+  gt_feature_index_delete(fif);
+
+  /* a truncated file must be rejected */
+  if (!had_err) {
+    fp = gt_fa_xfopen(gt_str_get(filename), "wb");
+    gt_xfputs("GTFIDX", fp);
+    gt_fa_xfclose(fp);
+    gt_ensure(!gt_feature_index_file_new(gt_str_get(filename), err));
+    gt_ensure(gt_error_is_set(err));
+    gt_error_unset(err);
+  }
+
+  gt_xremove(gt_str_get(filename));
+  gt_str_delete(filename);
+  gt_feature_index_delete(fim);
+  return had_err;
+}
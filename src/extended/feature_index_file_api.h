@@ -0,0 +1,44 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef FEATURE_INDEX_FILE_API_H
+#define FEATURE_INDEX_FILE_API_H
+
+#include "extended/feature_index_api.h"
+
+/* The <GtFeatureIndexFile> class implements a read-only <GtFeatureIndex>
+   backed by an index file, which is mapped into memory. For each sequence
+   region the file contains the features sorted by start position together
+   with an implicit interval tree, so that range queries do not require any
+   parsing or index construction. Features are only reconstructed when they
+   are returned by a query. Like in a <GtFeatureIndexMemory>, the returned
+   features belong to the feature index and must not be deleted. Adding or
+   removing features is not supported. */
+typedef struct GtFeatureIndexFile GtFeatureIndexFile;
+
+/* Returns a new <GtFeatureIndexFile> object for the index file <filename>
+   previously created with <gt_feature_index_file_write()>. Returns NULL and
+   sets <err> on error. */
+GtFeatureIndex* gt_feature_index_file_new(const char *filename, GtError *err);
+
+/* Write all features and sequence regions contained in <feature_index> to a
+   new index file <filename>, which can then be opened with
+   <gt_feature_index_file_new()>. Returns 0 on success, -1 otherwise. */
+int             gt_feature_index_file_write(GtFeatureIndex *feature_index,
+                                            const char *filename,
+                                            GtError *err);
+
+#endif
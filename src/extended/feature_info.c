@@ -19,6 +19,7 @@
 #include "core/cstr_api.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
+#include "core/unused_api.h"
 #include "extended/feature_info.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_defines.h"
@@ -96,6 +97,31 @@ void gt_feature_info_replace_pseudo_parent(GtFeatureInfo *fi,
   gt_feature_info_add_pseudo_parent(fi, id, new_pseudo_parent);
 }
 
+static int add_feature(void *key, void *value, void *data,
+                       GT_UNUSED GtError *err)
+{
+  gt_feature_info_add(data, key, value);
+  return 0;
+}
+
+static int add_pseudo_parent(void *key, void *value, void *data,
+                             GT_UNUSED GtError *err)
+{
+  gt_feature_info_add_pseudo_parent(data, key, value);
+  return 0;
+}
+
+void gt_feature_info_add_all(GtFeatureInfo *fi, const GtFeatureInfo *other)
+{
+  GT_UNUSED int rval;
+  gt_assert(fi && other);
+  rval = gt_hashmap_foreach(other->id_to_genome_node, add_feature, fi, NULL);
+  gt_assert(!rval);
+  rval = gt_hashmap_foreach(other->id_to_pseudo_parent, add_pseudo_parent, fi,
+                            NULL);
+  gt_assert(!rval);
+}
+
 static GtFeatureNode* find_root(const GtFeatureInfo *fi, const char *id)
 {
   const char *delim, *parents;
@@ -36,6 +36,10 @@ void           gt_feature_info_replace_pseudo_parent(GtFeatureInfo*,
                                                      GtFeatureNode *child,
                                                      GtFeatureNode
                                                      *new_pseudo_parent);
+/* Add all features and pseudo-parents of <other>, whose IDs must not be
+   defined in <fi>. */
+void           gt_feature_info_add_all(GtFeatureInfo*,
+                                       const GtFeatureInfo *other);
 GtFeatureNode* gt_feature_info_find_root(const GtFeatureInfo*, const char *id);
 
 #endif
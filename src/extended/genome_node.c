@@ -17,6 +17,7 @@
 
 #include <stdarg.h>
 #include "core/assert_api.h"
+#include "core/atomic.h"
 #include "core/class_alloc.h"
 #include "core/cstr_api.h"
 #include "core/ensure.h"
@@ -40,9 +41,7 @@ typedef struct {
 GtGenomeNode* gt_genome_node_ref(GtGenomeNode *gn)
 {
   gt_assert(gn);
-  gt_rwlock_wrlock(gn->lock);
-  gn->reference_count++;
-  gt_rwlock_unlock(gn->lock);
+  (void) gt_atomic_add_and_fetch(&gn->reference_count, 1);
   return gn;
 }
 
@@ -193,9 +192,6 @@ GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
   gn->reference_count    = 0;
   gn->userdata           = NULL;
   gn->userdata_nof_items = 0;
-#ifdef GT_THREADS_ENABLED
-  gn-> lock              = gt_rwlock_new();
-#endif
   return gn;
 }
 
@@ -473,21 +469,15 @@ int gt_genome_node_unit_test(GtError *err)
 void gt_genome_node_delete(GtGenomeNode *gn)
 {
   if (!gn) return;
-  gt_rwlock_wrlock(gn->lock);
-  if (gn->reference_count) {
-    gn->reference_count--;
-    gt_rwlock_unlock(gn->lock);
+  /* the node is freed by the owner of the last reference, which sees a
+     reference count of 0 */
+  if (gt_atomic_fetch_and_sub(&gn->reference_count, 1) > 0)
     return;
-  }
   gt_assert(gn->c_class);
   if (gn->c_class->free)
     gn->c_class->free(gn);
   gt_str_delete(gn->filename);
   if (gn->userdata)
     gt_hashmap_delete(gn->userdata);
-  gt_rwlock_unlock(gn->lock);
-#ifdef GT_THREADS_ENABLED
-  gt_rwlock_delete(gn->lock);
-#endif
   gt_free(gn);
 }
@@ -52,11 +52,8 @@ struct GtGenomeNode
   const GtGenomeNodeClass *c_class;
   GtStr *filename;
   GtHashmap *userdata; /* created on demand */
-  /* GtGenomeNodes are very space critical, therefore we can justify a bit
-     ifdef-hell here... */
-#ifdef GT_THREADS_ENABLED
-  GtRWLock *lock;
-#endif
+  /* GtGenomeNodes are very space critical, therefore the reference count is
+     changed by atomic operations instead of being protected by a lock */
   unsigned int line_number,
                reference_count,
                userdata_nof_items;
@@ -0,0 +1,801 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array.h"
+#include "core/assert_api.h"
+#include "core/ensure.h"
+#include "core/hashmap.h"
+#include "core/ma_api.h"
+#include "core/undef_api.h"
+#include "extended/comment_node_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node_rep.h"
+#include "extended/genome_node_serializer.h"
+#include "extended/meta_node_api.h"
+#include "extended/region_node_api.h"
+#include "extended/sequence_node_api.h"
+
+/* node tags */
+#define GNS_FEATURE_TREE  'F'
+#define GNS_REGION        'R'
+#define GNS_COMMENT       'C'
+#define GNS_META          'M'
+#define GNS_SEQUENCE      'S'
+
+/* feature node flags */
+#define GNS_PSEUDO        (1 << 0)
+#define GNS_SCORE         (1 << 1)
+#define GNS_SOURCE        (1 << 2)
+#define GNS_MULTI         (1 << 3)
+#define GNS_OWN_SEQID     (1 << 4)
+#define GNS_STRAND_OFFSET 5
+#define GNS_STRAND_MASK   0x7
+#define GNS_PHASE_OFFSET  8
+#define GNS_PHASE_MASK    0x3
+
+/* origin modes */
+#define GNS_NO_FILENAME   0
+#define GNS_LAST_FILENAME 1
+#define GNS_NEW_FILENAME  2
+
+struct GtGenomeNodeSerializer {
+  GtHashmap *node_numbers; /* maps feature nodes to their numbers */
+  GtArray *nodes;
+  GtStr *seqid,         /* last sequence ID read */
+        *filename,      /* last file name read */
+        *last_filename; /* last file name written */
+};
+
+typedef struct {
+  const char *data,
+             *end;
+  GtError *err;
+} GNSReader;
+
+GtGenomeNodeSerializer* gt_genome_node_serializer_new(void)
+{
+  GtGenomeNodeSerializer *gns = gt_calloc(1, sizeof *gns);
+  gns->node_numbers = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  gns->nodes = gt_array_new(sizeof (GtFeatureNode*));
+  return gns;
+}
+
+void gt_genome_node_serializer_reset(GtGenomeNodeSerializer *gns)
+{
+  gt_assert(gns);
+  gt_str_delete(gns->filename);
+  gns->filename = NULL;
+  gt_str_delete(gns->last_filename);
+  gns->last_filename = NULL;
+}
+
+void gt_genome_node_serializer_delete(GtGenomeNodeSerializer *gns)
+{
+  if (!gns) return;
+  gt_hashmap_delete(gns->node_numbers);
+  gt_array_delete(gns->nodes);
+  gt_str_delete(gns->seqid);
+  gt_str_delete(gns->filename);
+  gt_str_delete(gns->last_filename);
+  gt_free(gns);
+}
+
+static void write_uword(GtStr *buffer, GtUword value)
+{
+  /* variable length encoding, 7 bits per byte */
+  while (value >= 0x80) {
+    gt_str_append_char(buffer, (char) ((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  gt_str_append_char(buffer, (char) value);
+}
+
+static void write_cstr(GtStr *buffer, const char *cstr)
+{
+  GtUword length = strlen(cstr);
+  write_uword(buffer, length);
+  gt_str_append_cstr_nt(buffer, cstr, length);
+}
+
+static void write_origin(GtGenomeNodeSerializer *gns, GtStr *buffer,
+                         const GtGenomeNode *gn)
+{
+  if (!gn->filename)
+    write_uword(buffer, GNS_NO_FILENAME);
+  else if (gns->last_filename &&
+           !gt_str_cmp(gn->filename, gns->last_filename)) {
+    write_uword(buffer, GNS_LAST_FILENAME);
+  }
+  else {
+    write_uword(buffer, GNS_NEW_FILENAME);
+    write_cstr(buffer, gt_str_get(gn->filename));
+    if (!gns->last_filename)
+      gns->last_filename = gt_str_new();
+    gt_str_set(gns->last_filename, gt_str_get(gn->filename));
+  }
+  write_uword(buffer, gn->line_number);
+}
+
+static int read_uword(GNSReader *r, GtUword *value)
+{
+  unsigned int shift = 0;
+  *value = 0;
+  for (;;) {
+    unsigned char c;
+    if (r->data == r->end || shift >= sizeof (GtUword) * 8) {
+      gt_error_set(r->err, "corrupt serialized genome node");
+      return -1;
+    }
+    c = (unsigned char) *r->data++;
+    *value |= ((GtUword) (c & 0x7f)) << shift;
+    if (!(c & 0x80))
+      break;
+    shift += 7;
+  }
+  return 0;
+}
+
+/* store a pointer to the next string in <cstr> and its length in <length>,
+   the string is not '\0'-terminated */
+static int read_string(GNSReader *r, const char **cstr, GtUword *length)
+{
+  if (read_uword(r, length))
+    return -1;
+  if ((GtUword) (r->end - r->data) < *length) {
+    gt_error_set(r->err, "corrupt serialized genome node");
+    return -1;
+  }
+  *cstr = r->data;
+  r->data += *length;
+  return 0;
+}
+
+static int read_str(GNSReader *r, GtStr *str)
+{
+  const char *cstr;
+  GtUword length;
+  if (read_string(r, &cstr, &length))
+    return -1;
+  gt_str_reset(str);
+  gt_str_append_cstr_nt(str, cstr, length);
+  return 0;
+}
+
+/* read a sequence ID and make it the shared sequence ID */
+static int read_seqid(GtGenomeNodeSerializer *gns, GNSReader *r)
+{
+  const char *cstr;
+  GtUword length;
+  if (read_string(r, &cstr, &length))
+    return -1;
+  if (!gns->seqid || gt_str_length(gns->seqid) != length ||
+      strncmp(gt_str_get(gns->seqid), cstr, length)) {
+    gt_str_delete(gns->seqid);
+    gns->seqid = gt_str_new();
+    gt_str_append_cstr_nt(gns->seqid, cstr, length);
+  }
+  return 0;
+}
+
+/* read an origin, a new file name becomes the shared file name */
+static int read_origin(GtGenomeNodeSerializer *gns, GNSReader *r,
+                       bool *has_filename, GtUword *line_number)
+{
+  const char *cstr;
+  GtUword mode, length;
+  int had_err;
+  had_err = read_uword(r, &mode);
+  if (!had_err && mode == GNS_NEW_FILENAME) {
+    had_err = read_string(r, &cstr, &length);
+    if (!had_err) {
+      gt_str_delete(gns->filename);
+      gns->filename = gt_str_new();
+      gt_str_append_cstr_nt(gns->filename, cstr, length);
+    }
+  }
+  if (!had_err &&
+      (mode > GNS_NEW_FILENAME ||
+       (mode == GNS_LAST_FILENAME && !gns->filename))) {
+    gt_error_set(r->err, "corrupt serialized genome node");
+    had_err = -1;
+  }
+  if (!had_err) {
+    *has_filename = mode != GNS_NO_FILENAME;
+    had_err = read_uword(r, line_number);
+  }
+  return had_err;
+}
+
+static void set_origin(GtGenomeNodeSerializer *gns, GtGenomeNode *gn,
+                       bool has_filename, GtUword line_number)
+{
+  if (has_filename)
+    gt_genome_node_set_origin(gn, gns->filename, (unsigned int) line_number);
+}
+
+/* assign numbers to the nodes of the tree rooted at <fn> in DFS order, the
+   root gets number 0 */
+static void number_feature_nodes(GtGenomeNodeSerializer *gns,
+                                 GtFeatureNode *fn)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *child;
+  gt_array_add(gns->nodes, fn);
+  /* numbers are stored incremented by one to distinguish them from NULL */
+  gt_hashmap_add(gns->node_numbers, fn, (void*) gt_array_size(gns->nodes));
+  fni = gt_feature_node_iterator_new_direct(fn);
+  while ((child = gt_feature_node_iterator_next(fni))) {
+    if (!gt_hashmap_get(gns->node_numbers, child))
+      number_feature_nodes(gns, child);
+  }
+  gt_feature_node_iterator_delete(fni);
+}
+
+static GtUword feature_node_number(GtGenomeNodeSerializer *gns,
+                                   GtFeatureNode *fn)
+{
+  GtUword number = (GtUword) gt_hashmap_get(gns->node_numbers, fn);
+  gt_assert(number);
+  return number - 1;
+}
+
+static void write_attribute(const char *attr_name, const char *attr_value,
+                            void *data)
+{
+  GtStr *buffer = data;
+  write_cstr(buffer, attr_name);
+  write_cstr(buffer, attr_value);
+}
+
+static void write_feature_node(GtGenomeNodeSerializer *gns, GtStr *buffer,
+                               GtFeatureNode *fn, const GtStr *root_seqid)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *child;
+  GtStrArray *attributes;
+  const GtStr *seqid;
+  GtRange range;
+  GtUword flags = 0, num_of_children = 0;
+
+  seqid = gt_genome_node_get_seqid((GtGenomeNode*) fn);
+  if (gt_feature_node_is_pseudo(fn))
+    flags |= GNS_PSEUDO;
+  if (gt_feature_node_score_is_defined(fn))
+    flags |= GNS_SCORE;
+  if (gt_feature_node_has_source(fn))
+    flags |= GNS_SOURCE;
+  if (gt_feature_node_is_multi(fn))
+    flags |= GNS_MULTI;
+  if (seqid != root_seqid && gt_str_cmp((GtStr*) seqid, (GtStr*) root_seqid))
+    flags |= GNS_OWN_SEQID;
+  flags |= gt_feature_node_get_strand(fn) << GNS_STRAND_OFFSET;
+  flags |= gt_feature_node_get_phase(fn) << GNS_PHASE_OFFSET;
+  write_uword(buffer, flags);
+
+  if (flags & GNS_OWN_SEQID)
+    write_cstr(buffer, gt_str_get((GtStr*) seqid));
+  write_origin(gns, buffer, (GtGenomeNode*) fn);
+  if (!(flags & GNS_PSEUDO))
+    write_cstr(buffer, gt_feature_node_get_type(fn));
+  range = gt_genome_node_get_range((GtGenomeNode*) fn);
+  write_uword(buffer, range.start);
+  write_uword(buffer, range.end - range.start);
+  if (flags & GNS_SCORE) {
+    float score = gt_feature_node_get_score(fn);
+    gt_str_append_cstr_nt(buffer, (const char*) &score, sizeof score);
+  }
+  if (flags & GNS_SOURCE)
+    write_cstr(buffer, gt_feature_node_get_source(fn));
+
+  /* attributes */
+  attributes = gt_feature_node_get_attribute_list(fn);
+  write_uword(buffer, gt_str_array_size(attributes));
+  gt_str_array_delete(attributes);
+  gt_feature_node_foreach_attribute(fn, write_attribute, buffer);
+
+  /* children */
+  fni = gt_feature_node_iterator_new_direct(fn);
+  while (gt_feature_node_iterator_next(fni))
+    num_of_children++;
+  gt_feature_node_iterator_delete(fni);
+  write_uword(buffer, num_of_children);
+  fni = gt_feature_node_iterator_new_direct(fn);
+  while ((child = gt_feature_node_iterator_next(fni)))
+    write_uword(buffer, feature_node_number(gns, child));
+  gt_feature_node_iterator_delete(fni);
+
+  if (flags & GNS_MULTI) {
+    write_uword(buffer, feature_node_number(gns,
+                               gt_feature_node_get_multi_representative(fn)));
+  }
+}
+
+static bool feature_tree_is_serializable(GtFeatureNode *root)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn;
+  GtHashmap *nodes;
+  bool serializable = true;
+  nodes = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  fni = gt_feature_node_iterator_new(root);
+  while (serializable && (fn = gt_feature_node_iterator_next(fni)))
+    gt_hashmap_add(nodes, fn, fn);
+  gt_feature_node_iterator_delete(fni);
+  fni = gt_feature_node_iterator_new(root);
+  while (serializable && (fn = gt_feature_node_iterator_next(fni))) {
+    if (((GtGenomeNode*) fn)->userdata)
+      serializable = false;
+    else if (gt_feature_node_is_multi(fn) &&
+             !gt_hashmap_get(nodes,
+                             gt_feature_node_get_multi_representative(fn))) {
+      /* the representative is not part of this tree */
+      serializable = false;
+    }
+  }
+  gt_feature_node_iterator_delete(fni);
+  gt_hashmap_delete(nodes);
+  return serializable;
+}
+
+bool gt_genome_node_serializer_is_serializable(GtGenomeNode *gn)
+{
+  GtFeatureNode *fn;
+  gt_assert(gn);
+  if ((fn = gt_feature_node_try_cast(gn)))
+    return feature_tree_is_serializable(fn);
+  if (gn->userdata)
+    return false;
+  return gt_region_node_try_cast(gn) ||
+         gt_genome_node_try_cast(gt_comment_node_class(), gn) ||
+         gt_meta_node_try_cast(gn) || gt_sequence_node_try_cast(gn);
+}
+
+void gt_genome_node_serializer_write(GtGenomeNodeSerializer *gns,
+                                     GtGenomeNode *gn, GtStr *buffer)
+{
+  GtFeatureNode *fn;
+  GtRange range;
+  void *node;
+  gt_assert(gns && gn && buffer);
+  gt_assert(gt_genome_node_serializer_is_serializable(gn));
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    GtStr *root_seqid = gt_genome_node_get_seqid(gn);
+    GtUword i;
+    number_feature_nodes(gns, fn);
+    gt_str_append_char(buffer, GNS_FEATURE_TREE);
+    write_uword(buffer, gt_array_size(gns->nodes));
+    write_cstr(buffer, gt_str_get(root_seqid));
+    for (i = 0; i < gt_array_size(gns->nodes); i++) {
+      write_feature_node(gns, buffer,
+                         *(GtFeatureNode**) gt_array_get(gns->nodes, i),
+                         root_seqid);
+    }
+    gt_hashmap_reset(gns->node_numbers);
+    gt_array_reset(gns->nodes);
+  }
+  else if (gt_region_node_try_cast(gn)) {
+    gt_str_append_char(buffer, GNS_REGION);
+    write_cstr(buffer, gt_str_get(gt_genome_node_get_seqid(gn)));
+    write_origin(gns, buffer, gn);
+    range = gt_genome_node_get_range(gn);
+    write_uword(buffer, range.start);
+    write_uword(buffer, range.end - range.start);
+  }
+  else if ((node = gt_genome_node_try_cast(gt_comment_node_class(), gn))) {
+    gt_str_append_char(buffer, GNS_COMMENT);
+    write_origin(gns, buffer, gn);
+    write_cstr(buffer, gt_comment_node_get_comment(node));
+  }
+  else if ((node = gt_meta_node_try_cast(gn))) {
+    gt_str_append_char(buffer, GNS_META);
+    write_origin(gns, buffer, gn);
+    write_cstr(buffer, gt_meta_node_get_directive(node));
+    write_cstr(buffer, gt_meta_node_get_data(node));
+  }
+  else {
+    node = gt_sequence_node_cast(gn);
+    gt_str_append_char(buffer, GNS_SEQUENCE);
+    write_origin(gns, buffer, gn);
+    write_cstr(buffer, gt_sequence_node_get_description(node));
+    write_uword(buffer, gt_sequence_node_get_sequence_length(node));
+    gt_str_append_cstr_nt(buffer, gt_sequence_node_get_sequence(node),
+                          gt_sequence_node_get_sequence_length(node));
+  }
+}
+
+static int read_range(GNSReader *r, GtRange *range)
+{
+  GtUword length;
+  if (read_uword(r, &range->start) || read_uword(r, &length))
+    return -1;
+  range->end = range->start + length;
+  return 0;
+}
+
+/* read a feature node of a tree with <num_of_nodes> nodes, its child numbers
+   are appended to <children> and their number to <num_of_children> */
+static int read_feature_node(GtGenomeNodeSerializer *gns, GNSReader *r,
+                             GtUword num_of_nodes, GtStr *buf,
+                             GtArray *children, GtArray *num_of_children,
+                             GtArray *representatives)
+{
+  GtGenomeNode *gn;
+  GtFeatureNode *fn;
+  GtStr *seqid = gns->seqid, *value;
+  GtUword flags, line_number, num_of_attributes, num, i, child, rep;
+  GtRange range;
+  float score = 0.0;
+  bool has_filename;
+  int had_err;
+
+  if ((had_err = read_uword(r, &flags)))
+    return had_err;
+  if (flags & GNS_OWN_SEQID) {
+    seqid = gt_str_new();
+    had_err = read_str(r, seqid);
+  }
+  if (!had_err)
+    had_err = read_origin(gns, r, &has_filename, &line_number);
+  if (!had_err && !(flags & GNS_PSEUDO))
+    had_err = read_str(r, buf);
+  if (!had_err)
+    had_err = read_range(r, &range);
+  if (!had_err && (flags & GNS_SCORE)) {
+    if ((GtUword) (r->end - r->data) < sizeof score) {
+      gt_error_set(r->err, "corrupt serialized genome node");
+      had_err = -1;
+    }
+    else {
+      memcpy(&score, r->data, sizeof score);
+      r->data += sizeof score;
+    }
+  }
+  if (!had_err) {
+    GtStrand strand = (flags >> GNS_STRAND_OFFSET) & GNS_STRAND_MASK;
+    if (flags & GNS_PSEUDO)
+      gn = gt_feature_node_new_pseudo(seqid, range.start, range.end, strand);
+    else {
+      gn = gt_feature_node_new(seqid, gt_str_get(buf), range.start, range.end,
+                               strand);
+    }
+    fn = gt_feature_node_cast(gn);
+    gt_array_add(gns->nodes, fn);
+    set_origin(gns, gn, has_filename, line_number);
+    gt_feature_node_set_phase(fn, (flags >> GNS_PHASE_OFFSET) &
+                                  GNS_PHASE_MASK);
+    if (flags & GNS_SCORE)
+      gt_feature_node_set_score(fn, score);
+  }
+  if (flags & GNS_OWN_SEQID)
+    gt_str_delete(seqid);
+  if (!had_err && (flags & GNS_SOURCE)) {
+    GtStr *source = gt_str_new();
+    had_err = read_str(r, source);
+    if (!had_err)
+      gt_feature_node_set_source(fn, source); /* takes a reference */
+    gt_str_delete(source);
+  }
+  if (!had_err)
+    had_err = read_uword(r, &num_of_attributes);
+  value = gt_str_new();
+  for (i = 0; !had_err && i < num_of_attributes; i++) {
+    had_err = read_str(r, buf);
+    if (!had_err)
+      had_err = read_str(r, value);
+    if (!had_err)
+      gt_feature_node_add_attribute(fn, gt_str_get(buf), gt_str_get(value));
+  }
+  gt_str_delete(value);
+  if (!had_err)
+    had_err = read_uword(r, &num);
+  for (i = 0; !had_err && i < num; i++) {
+    had_err = read_uword(r, &child);
+    if (!had_err && (child == 0 || child >= num_of_nodes)) {
+      gt_error_set(r->err, "corrupt serialized genome node");
+      had_err = -1;
+    }
+    if (!had_err)
+      gt_array_add(children, child);
+  }
+  if (!had_err)
+    gt_array_add(num_of_children, num);
+  if (!had_err) {
+    rep = GT_UNDEF_UWORD;
+    if (flags & GNS_MULTI) {
+      had_err = read_uword(r, &rep);
+      if (!had_err && rep >= num_of_nodes) {
+        gt_error_set(r->err, "corrupt serialized genome node");
+        had_err = -1;
+      }
+    }
+    if (!had_err)
+      gt_array_add(representatives, rep);
+  }
+  return had_err;
+}
+
+static int read_feature_tree(GtGenomeNodeSerializer *gns, GtGenomeNode **gn,
+                             GNSReader *r)
+{
+  GtArray *children, *num_of_children, *representatives;
+  GtUword num_of_nodes, i, j, k, rep, *parents = NULL;
+  GtStr *buf;
+  int had_err;
+
+  had_err = read_uword(r, &num_of_nodes);
+  if (!had_err && (!num_of_nodes ||
+                   num_of_nodes > (GtUword) (r->end - r->data))) {
+    gt_error_set(r->err, "corrupt serialized genome node");
+    had_err = -1;
+  }
+  if (!had_err)
+    had_err = read_seqid(gns, r);
+  if (had_err)
+    return had_err;
+
+  buf = gt_str_new();
+  children = gt_array_new(sizeof (GtUword));
+  num_of_children = gt_array_new(sizeof (GtUword));
+  representatives = gt_array_new(sizeof (GtUword));
+  for (i = 0; !had_err && i < num_of_nodes; i++) {
+    had_err = read_feature_node(gns, r, num_of_nodes, buf, children,
+                                num_of_children, representatives);
+  }
+
+  /* every node except the root must have a parent */
+  if (!had_err) {
+    parents = gt_calloc(num_of_nodes, sizeof *parents);
+    for (i = 0; i < gt_array_size(children); i++)
+      parents[*(GtUword*) gt_array_get(children, i)]++;
+    for (i = 1; !had_err && i < num_of_nodes; i++) {
+      if (!parents[i]) {
+        gt_error_set(r->err, "corrupt serialized genome node");
+        had_err = -1;
+      }
+    }
+  }
+
+  if (!had_err) {
+    /* link the nodes */
+    for (i = 0, k = 0; i < num_of_nodes; i++) {
+      GtFeatureNode *parent = *(GtFeatureNode**) gt_array_get(gns->nodes, i);
+      GtUword num = *(GtUword*) gt_array_get(num_of_children, i);
+      for (j = 0; j < num; j++, k++) {
+        GtUword c = *(GtUword*) gt_array_get(children, k);
+        GtFeatureNode *child = *(GtFeatureNode**) gt_array_get(gns->nodes, c);
+        if (--parents[c])
+          gt_genome_node_ref((GtGenomeNode*) child); /* multiple parents */
+        gt_feature_node_add_child(parent, child);
+      }
+    }
+    /* set the multi-feature representatives (representatives first) */
+    for (k = 0; k < 2; k++) {
+      for (i = 0; i < num_of_nodes; i++) {
+        GtFeatureNode *fn = *(GtFeatureNode**) gt_array_get(gns->nodes, i);
+        rep = *(GtUword*) gt_array_get(representatives, i);
+        if (rep == GT_UNDEF_UWORD)
+          continue;
+        if (k == 0 && rep == i)
+          gt_feature_node_make_multi_representative(fn);
+        else if (k == 1 && rep != i) {
+          gt_feature_node_set_multi_representative(fn,
+                           *(GtFeatureNode**) gt_array_get(gns->nodes, rep));
+        }
+      }
+    }
+    *gn = *(GtGenomeNode**) gt_array_get_first(gns->nodes);
+  }
+  else {
+    /* the nodes have not been linked yet */
+    for (i = 0; i < gt_array_size(gns->nodes); i++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(gns->nodes, i));
+  }
+
+  gt_array_reset(gns->nodes);
+  gt_free(parents);
+  gt_array_delete(representatives);
+  gt_array_delete(num_of_children);
+  gt_array_delete(children);
+  gt_str_delete(buf);
+  return had_err;
+}
+
+int gt_genome_node_serializer_read(GtGenomeNodeSerializer *gns,
+                                   GtGenomeNode **gn, const char *data,
+                                   GtUword length, GtError *err)
+{
+  GtUword line_number = 0;
+  bool has_filename = false;
+  GNSReader r;
+  GtRange range;
+  GtStr *a, *b;
+  int had_err = 0;
+  char tag;
+  gt_error_check(err);
+  gt_assert(gns && gn && data);
+
+  r.data = data;
+  r.end = data + length;
+  r.err = err;
+  *gn = NULL;
+  if (!length) {
+    gt_error_set(err, "corrupt serialized genome node");
+    return -1;
+  }
+  tag = *r.data++;
+  if (tag == GNS_FEATURE_TREE)
+    had_err = read_feature_tree(gns, gn, &r);
+  else if (tag == GNS_REGION) {
+    had_err = read_seqid(gns, &r);
+    if (!had_err)
+      had_err = read_origin(gns, &r, &has_filename, &line_number);
+    if (!had_err)
+      had_err = read_range(&r, &range);
+    if (!had_err) {
+      *gn = gt_region_node_new(gns->seqid, range.start, range.end);
+      set_origin(gns, *gn, has_filename, line_number);
+    }
+  }
+  else if (tag == GNS_COMMENT || tag == GNS_META || tag == GNS_SEQUENCE) {
+    a = gt_str_new();
+    b = gt_str_new();
+    had_err = read_origin(gns, &r, &has_filename, &line_number);
+    if (!had_err)
+      had_err = read_str(&r, a);
+    if (!had_err && tag != GNS_COMMENT)
+      had_err = read_str(&r, b);
+    if (!had_err) {
+      if (tag == GNS_COMMENT)
+        *gn = gt_comment_node_new(gt_str_get(a));
+      else if (tag == GNS_META)
+        *gn = gt_meta_node_new(gt_str_get(a), gt_str_get(b));
+      else
+        *gn = gt_sequence_node_new(gt_str_get(a), b);
+      set_origin(gns, *gn, has_filename, line_number);
+    }
+    gt_str_delete(a);
+    gt_str_delete(b);
+  }
+  else {
+    gt_error_set(err, "corrupt serialized genome node");
+    had_err = -1;
+  }
+  if (!had_err && r.data != r.end) {
+    gt_error_set(err, "corrupt serialized genome node");
+    had_err = -1;
+  }
+  if (had_err) {
+    gt_genome_node_delete(*gn);
+    *gn = NULL;
+  }
+  return had_err;
+}
+
+static int check_roundtrip(GtGenomeNode *gn, GtError *err)
+{
+  GtGenomeNodeSerializer *gns;
+  GtGenomeNode *read_gn = NULL;
+  GtStr *buffer_a, *buffer_b;
+  int had_err = 0;
+  gt_error_check(err);
+  gns = gt_genome_node_serializer_new();
+  buffer_a = gt_str_new();
+  buffer_b = gt_str_new();
+  gt_ensure(gt_genome_node_serializer_is_serializable(gn));
+  gt_genome_node_serializer_write(gns, gn, buffer_a);
+  gt_ensure(!gt_genome_node_serializer_read(gns, &read_gn,
+                                            gt_str_get(buffer_a),
+                                            gt_str_length(buffer_a), err));
+  if (!had_err) {
+    gt_genome_node_serializer_delete(gns);
+    gns = gt_genome_node_serializer_new(); /* reset the last file name */
+    gt_genome_node_serializer_write(gns, read_gn, buffer_b);
+    gt_ensure(!gt_str_cmp(buffer_a, buffer_b));
+    gt_ensure(!gt_genome_node_cmp(gn, read_gn));
+  }
+  if (!had_err) {
+    /* truncated input must be detected */
+    GtGenomeNode *corrupt_gn;
+    gt_ensure(gt_genome_node_serializer_read(gns, &corrupt_gn,
+                                             gt_str_get(buffer_a),
+                                             gt_str_length(buffer_a) - 1,
+                                             err));
+    gt_ensure(!corrupt_gn);
+    gt_error_unset(err);
+  }
+  gt_genome_node_delete(read_gn);
+  gt_str_delete(buffer_b);
+  gt_str_delete(buffer_a);
+  gt_genome_node_serializer_delete(gns);
+  return had_err;
+}
+
+int gt_genome_node_serializer_unit_test(GtError *err)
+{
+  GtGenomeNode *gn, *child, *pseudo;
+  GtStr *seqid, *filename, *sequence;
+  int had_err = 0;
+  gt_error_check(err);
+
+  seqid = gt_str_new_cstr("ctg123");
+  filename = gt_str_new_cstr("file.gff3");
+
+  /* standard gene */
+  gn = gt_feature_node_new_standard_gene();
+  gt_genome_node_set_origin(gn, filename, 42);
+  gt_feature_node_set_score((GtFeatureNode*) gn, 0.5);
+  gt_feature_node_add_attribute((GtFeatureNode*) gn, "ID", "gene1");
+  gt_feature_node_add_attribute((GtFeatureNode*) gn, "Name", "EDEN");
+  had_err = check_roundtrip(gn, err);
+  gt_genome_node_delete(gn);
+
+  /* pseudo-feature with multi-feature children and a shared child */
+  if (!had_err) {
+    GtGenomeNode *multi_a, *multi_b;
+    pseudo = gt_feature_node_new_pseudo(seqid, 100, 500, GT_STRAND_REVERSE);
+    multi_a = gt_feature_node_new(seqid, "mRNA", 100, 200, GT_STRAND_REVERSE);
+    multi_b = gt_feature_node_new(seqid, "mRNA", 300, 500, GT_STRAND_REVERSE);
+    gt_feature_node_set_source((GtFeatureNode*) multi_a, filename);
+    gt_feature_node_add_attribute((GtFeatureNode*) multi_a, "ID", "mRNA1");
+    gt_feature_node_make_multi_representative((GtFeatureNode*) multi_a);
+    gt_feature_node_set_multi_representative((GtFeatureNode*) multi_b,
+                                             (GtFeatureNode*) multi_a);
+    gt_feature_node_add_child((GtFeatureNode*) pseudo,
+                              (GtFeatureNode*) multi_a);
+    gt_feature_node_add_child((GtFeatureNode*) pseudo,
+                              (GtFeatureNode*) multi_b);
+    child = gt_feature_node_new(seqid, "exon", 100, 150, GT_STRAND_REVERSE);
+    gt_feature_node_set_phase((GtFeatureNode*) child, GT_PHASE_TWO);
+    gt_feature_node_add_child((GtFeatureNode*) multi_a,
+                              (GtFeatureNode*) child);
+    gt_feature_node_add_child((GtFeatureNode*) multi_b,
+                              (GtFeatureNode*) gt_genome_node_ref(child));
+    had_err = check_roundtrip(pseudo, err);
+    gt_genome_node_delete(pseudo);
+  }
+
+  /* other node types */
+  if (!had_err) {
+    gn = gt_region_node_new(seqid, 1, 1000);
+    gt_genome_node_set_origin(gn, filename, 2);
+    had_err = check_roundtrip(gn, err);
+    gt_genome_node_delete(gn);
+  }
+  if (!had_err) {
+    gn = gt_comment_node_new(" a comment");
+    had_err = check_roundtrip(gn, err);
+    gt_genome_node_delete(gn);
+  }
+  if (!had_err) {
+    gn = gt_meta_node_new("directive", "data");
+    gt_genome_node_set_origin(gn, filename, 7);
+    had_err = check_roundtrip(gn, err);
+    gt_genome_node_delete(gn);
+  }
+  if (!had_err) {
+    sequence = gt_str_new_cstr("acgtacgt");
+    gn = gt_sequence_node_new("description", sequence);
+    had_err = check_roundtrip(gn, err);
+    gt_genome_node_delete(gn);
+    gt_str_delete(sequence);
+  }
+
+  gt_str_delete(filename);
+  gt_str_delete(seqid);
+  return had_err;
+}
@@ -0,0 +1,60 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef GENOME_NODE_SERIALIZER_H
+#define GENOME_NODE_SERIALIZER_H
+
+#include "core/error_api.h"
+#include "core/str_api.h"
+#include "extended/genome_node_api.h"
+
+/* A <GtGenomeNodeSerializer> converts genome nodes into a compact binary
+   representation and back. Feature nodes are serialized together with all
+   their descendants (including multi-features and pseudo-features), region,
+   comment, meta, and sequence nodes are supported as well. User data and
+   feature node observers are not serialized. The binary representation is only
+   valid on the machine which created it. */
+typedef struct GtGenomeNodeSerializer GtGenomeNodeSerializer;
+
+GtGenomeNodeSerializer* gt_genome_node_serializer_new(void);
+/* Returns <true> if <gn> can be serialized. */
+bool                    gt_genome_node_serializer_is_serializable(
+                                                              GtGenomeNode *gn);
+/* Append the binary representation of <gn> to <buffer>. */
+void                    gt_genome_node_serializer_write(
+                                                GtGenomeNodeSerializer *gns,
+                                                GtGenomeNode *gn,
+                                                GtStr *buffer);
+/* Read a genome node from the binary representation in <data> of given
+   <length> and store it in <gn>. Sequence IDs and file names are shared among
+   consecutively read nodes. */
+int                     gt_genome_node_serializer_read(
+                                                GtGenomeNodeSerializer *gns,
+                                                GtGenomeNode **gn,
+                                                const char *data,
+                                                GtUword length, GtError *err);
+/* Forget about previously written or read nodes. Afterwards, the binary
+   representation of the next node written by <gns> does not depend on the
+   nodes written before. Use this to produce records which can be read
+   independently of each other. */
+void                    gt_genome_node_serializer_reset(
+                                                  GtGenomeNodeSerializer *gns);
+void                    gt_genome_node_serializer_delete(
+                                                  GtGenomeNodeSerializer *gns);
+
+int                     gt_genome_node_serializer_unit_test(GtError *err);
+
+#endif
@@ -20,10 +20,13 @@
 #include "core/class_alloc_lock.h"
 #include "core/cstr_table.h"
 #include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/multithread_api.h"
 #include "core/queue.h"
 #include "core/progressbar.h"
 #include "core/str_array.h"
 #include "extended/genome_node.h"
+#include "extended/gff3_defines.h"
 #include "extended/gff3_in_stream_plain.h"
 #include "extended/gff3_parser.h"
 #include "extended/node_stream_api.h"
@@ -37,10 +40,17 @@ struct GtGFF3InStreamPlain {
        stdin_argument,
        stdin_processed,
        file_is_open,
-       progress_bar;
+       progress_bar,
+       parse_in_chunks,
+       open_region, /* the last chunk read ended at a seqid boundary */
+       line_is_pending,
+       hold_buffer; /* the buffered region is continued serially */
   GtFile *fpin;
   GtUint64 line_number;
-  GtQueue *genome_node_buffer;
+  GtStr *seqid, /* of the last feature line read in chunks */
+        *pending_line; /* read, but belongs to the next batch of chunks */
+  GtQueue *genome_node_buffer,
+          *region_buffer; /* nodes of the open region in chunk parsing */
   GtGFF3Parser *gff3_parser;
   GtCstrTable *used_types;
 };
@@ -48,6 +58,37 @@ struct GtGFF3InStreamPlain {
 #define gff3_in_stream_plain_cast(NS)\
         gt_node_stream_cast(gt_gff3_in_stream_plain_class(), NS)
 
+/* minimum size of a chunk parsed by a single thread in multithreaded mode, a
+   chunk ends at the next terminator line or sequence id change */
+#define GFF3_CHUNK_SIZE  (512 * 1024)
+
+/* maximum size of a chunk, if no terminator line or sequence id change follows
+   within this size the rest of the file is parsed serially */
+#define GFF3_MAX_CHUNK_SIZE  (16 * GFF3_CHUNK_SIZE)
+
+/* number of chunks read and parsed in one go per thread */
+#define GFF3_CHUNKS_PER_THREAD  2
+
+typedef struct {
+  GtGFF3Parser *parser;
+  GtStr *lines,
+        *filenamestr;
+  GtUint64 line_number;
+  GtQueue *genome_nodes;
+  GtCstrTable *used_types;
+  GtError *err;
+  int had_err;
+  bool continues_region, /* the chunk starts at a seqid boundary */
+       open_region; /* the chunk ends at a seqid boundary */
+} GFF3Chunk;
+
+typedef struct {
+  GFF3Chunk *chunks;
+  GtUword num_of_chunks,
+          next_chunk;
+  GtMutex *mutex;
+} GFF3ChunkInfo;
+
 static int buffer_is_sorted(void **elem, void *info, GtError *err)
 {
   GtGenomeNode *current_node, **last_node;
@@ -71,6 +112,244 @@ static int buffer_is_sorted(void **elem, void *info, GtError *err)
   return 0;
 }
 
+static void gff3_chunk_init(GFF3Chunk *chunk, GtGFF3Parser *parser,
+                            bool continues_region, GtStr *filenamestr,
+                            GtUint64 line_number)
+{
+  gt_assert(chunk && parser && filenamestr);
+  chunk->parser = gt_gff3_parser_new_chunk_parser(parser, continues_region);
+  chunk->lines = gt_str_new();
+  /* the genome nodes reference the file name, use a private copy per chunk */
+  chunk->filenamestr = gt_str_clone(filenamestr);
+  chunk->line_number = line_number;
+  chunk->genome_nodes = gt_queue_new();
+  chunk->used_types = gt_cstr_table_new();
+  chunk->err = gt_error_new();
+  chunk->had_err = 0;
+  chunk->continues_region = continues_region;
+  chunk->open_region = false;
+}
+
+static void gff3_chunk_clean(GFF3Chunk *chunk)
+{
+  gt_assert(chunk);
+  while (gt_queue_size(chunk->genome_nodes))
+    gt_genome_node_delete(gt_queue_get(chunk->genome_nodes));
+  gt_queue_delete(chunk->genome_nodes);
+  gt_cstr_table_delete(chunk->used_types);
+  gt_error_delete(chunk->err);
+  gt_str_delete(chunk->filenamestr);
+  gt_str_delete(chunk->lines);
+  gt_gff3_parser_delete(chunk->parser);
+}
+
+static void* gff3_chunk_parse_thread(void *data)
+{
+  GFF3ChunkInfo *info = data;
+  GFF3Chunk *chunk;
+  GtStr *lines;
+  gt_assert(info);
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    if (info->next_chunk == info->num_of_chunks) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    chunk = info->chunks + info->next_chunk++;
+    gt_mutex_unlock(info->mutex);
+    /* keep the lines of a chunk at a seqid boundary, it might have to be
+       parsed again in the context of its region */
+    lines = chunk->continues_region || chunk->open_region
+            ? gt_str_clone(chunk->lines) : gt_str_ref(chunk->lines);
+    chunk->had_err = gt_gff3_parser_parse_chunk(chunk->parser,
+                                                chunk->genome_nodes,
+                                                chunk->used_types,
+                                                chunk->filenamestr,
+                                                chunk->line_number,
+                                                gt_str_get(lines),
+                                                gt_str_length(lines),
+                                                chunk->err);
+    gt_str_delete(lines);
+  }
+  return NULL;
+}
+
+/* Read up to <max_chunks> chunks from the current file into <chunks> and
+   return their number. A chunk ends after the first terminator line or before
+   the first feature line with a different sequence id following
+   <GFF3_CHUNK_SIZE> bytes of input. At the end of file, at the start of a
+   FASTA section, or if a chunk reaches <GFF3_MAX_CHUNK_SIZE> bytes without such
+   a line, the parsing of the current file is handed back to the serial parser.
+   The lines of such an incomplete chunk are parsed serially. */
+static GtUword gff3_in_stream_plain_read_chunks(GtGFF3InStreamPlain *is,
+                                                GFF3Chunk *chunks,
+                                                GtUword max_chunks,
+                                                GtStr *filenamestr)
+{
+  GFF3Chunk *chunk = NULL;
+  GtUword num_of_chunks = 0;
+  GtStr *line_buffer;
+  const char *line, *seqid_end;
+  size_t line_length;
+
+  gt_assert(is && chunks && max_chunks);
+  line_buffer = gt_str_new();
+  for (;;) {
+    gt_str_reset(line_buffer);
+    if (is->line_is_pending) {
+      gt_str_append_str(line_buffer, is->pending_line);
+      is->line_is_pending = false;
+    }
+    else if (gt_str_read_next_line_generic(line_buffer, is->fpin) == EOF) {
+      is->parse_in_chunks = false;
+      is->open_region = false;
+      break;
+    }
+    line = gt_str_get(line_buffer);
+    line_length = gt_str_length(line_buffer);
+    if (line[0] == '>' || !strcmp(line, GT_GFF_FASTA_DIRECTIVE)) {
+      gt_gff3_parser_push_back_line(is->gff3_parser, line);
+      is->parse_in_chunks = false;
+      is->open_region = false;
+      break;
+    }
+    if (line_length && line[0] != '#' &&
+        (seqid_end = memchr(line, '\t', line_length)) &&
+        (gt_str_length(is->seqid) != (GtUword) (seqid_end - line) ||
+         strncmp(gt_str_get(is->seqid), line, seqid_end - line))) {
+      if (chunk && gt_str_length(chunk->lines) >= GFF3_CHUNK_SIZE) {
+        /* the region continues in the next chunk */
+        chunk->open_region = true;
+        is->open_region = true;
+        chunk = NULL;
+        if (num_of_chunks == max_chunks) {
+          gt_str_set(is->pending_line, line);
+          is->line_is_pending = true;
+          break;
+        }
+      }
+      gt_str_reset(is->seqid);
+      gt_str_append_cstr_nt(is->seqid, line, seqid_end - line);
+    }
+    is->line_number++;
+    if (!chunk) {
+      chunk = chunks + num_of_chunks++;
+      gff3_chunk_init(chunk, is->gff3_parser, is->open_region, filenamestr,
+                      is->line_number);
+    }
+    gt_gff3_parser_scan_line(is->gff3_parser, line, line_length,
+                             is->line_number);
+    gt_str_append_str(chunk->lines, line_buffer);
+    gt_str_append_char(chunk->lines, '\n');
+    if (gt_str_length(chunk->lines) >= GFF3_CHUNK_SIZE &&
+        !strncmp(line, GT_GFF_TERMINATOR, strlen(GT_GFF_TERMINATOR))) {
+      is->open_region = false;
+      chunk = NULL;
+      if (num_of_chunks == max_chunks)
+        break;
+    }
+    else if (gt_str_length(chunk->lines) >= GFF3_MAX_CHUNK_SIZE) {
+      gt_gff3_parser_push_back_chunk(is->gff3_parser, chunk->parser,
+                                     gt_str_get(chunk->lines),
+                                     gt_str_length(chunk->lines));
+      is->line_number = chunk->line_number - 1;
+      gff3_chunk_clean(chunk);
+      num_of_chunks--;
+      is->parse_in_chunks = false;
+      break;
+    }
+  }
+  gt_str_delete(line_buffer);
+  return num_of_chunks;
+}
+
+/* Parse the next chunks of the current file in parallel and append the
+   resulting genome nodes to the buffer in file order. The nodes of a region
+   which continues in the next chunk are kept back until the region is closed,
+   because a later chunk of the region might refer to them. */
+static int gff3_in_stream_plain_parse_chunks(GtGFF3InStreamPlain *is,
+                                             GtStr *filenamestr, GtError *err)
+{
+  GFF3ChunkInfo info;
+  GtStrArray *used_types;
+  GtUword i, j, max_chunks;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(is && is->parse_in_chunks);
+
+  max_chunks = GFF3_CHUNKS_PER_THREAD * gt_jobs;
+  info.chunks = gt_calloc(max_chunks, sizeof *info.chunks);
+  info.num_of_chunks = gff3_in_stream_plain_read_chunks(is, info.chunks,
+                                                        max_chunks,
+                                                        filenamestr);
+  info.next_chunk = 0;
+  if (info.num_of_chunks) {
+    info.mutex = gt_mutex_new();
+    had_err = gt_multithread(gff3_chunk_parse_thread, &info, err);
+    gt_mutex_delete(info.mutex);
+  }
+
+  /* collect the results in file order, the first error wins */
+  for (i = 0; i < info.num_of_chunks; i++) {
+    GFF3Chunk *chunk = info.chunks + i;
+    if (!had_err && !chunk->had_err &&
+        gt_gff3_parser_join_chunk(is->gff3_parser, chunk->parser)) {
+      while (gt_queue_size(chunk->genome_nodes)) {
+        gt_queue_add(is->region_buffer, gt_queue_get(chunk->genome_nodes));
+      }
+      used_types = gt_cstr_table_get_all(chunk->used_types);
+      for (j = 0; j < gt_str_array_size(used_types); j++) {
+        const char *type = gt_str_array_get(used_types, j);
+        if (!gt_cstr_table_get(is->used_types, type))
+          gt_cstr_table_add(is->used_types, type);
+      }
+      gt_str_array_delete(used_types);
+    }
+    else if (!had_err && (chunk->continues_region || chunk->open_region)) {
+      /* the chunk depends on the other chunks of its region (or contains an
+         error), parse it again like the serial parser would */
+      had_err = gt_gff3_parser_reparse_chunk(is->gff3_parser,
+                                             is->region_buffer, is->used_types,
+                                             chunk->filenamestr,
+                                             chunk->line_number,
+                                             gt_str_get(chunk->lines),
+                                             gt_str_length(chunk->lines), err);
+    }
+    else if (!had_err) {
+      gt_error_set(err, "%s", gt_error_get(chunk->err));
+      had_err = -1;
+    }
+    if (!had_err && !chunk->open_region) {
+      had_err = gt_gff3_parser_close_region(is->gff3_parser, is->region_buffer,
+                                            err);
+      while (!had_err && gt_queue_size(is->region_buffer)) {
+        gt_queue_add(is->genome_node_buffer,
+                     gt_queue_get(is->region_buffer));
+      }
+    }
+    gff3_chunk_clean(chunk);
+  }
+  gt_free(info.chunks);
+
+  if (!had_err && !is->parse_in_chunks && is->open_region) {
+    /* the rest of the open region is parsed serially, the buffer must not be
+       served before */
+    while (gt_queue_size(is->region_buffer))
+      gt_queue_add(is->genome_node_buffer, gt_queue_get(is->region_buffer));
+    is->hold_buffer = true;
+  }
+
+  if (had_err) {
+    while (gt_queue_size(is->region_buffer))
+      gt_genome_node_delete(gt_queue_get(is->region_buffer));
+    while (gt_queue_size(is->genome_node_buffer))
+      gt_genome_node_delete(gt_queue_get(is->genome_node_buffer));
+  }
+
+  return had_err;
+}
+
 static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                                      GtError *err)
 {
@@ -80,14 +359,14 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
 
   gt_error_check(err);
 
-  if (gt_queue_size(is->genome_node_buffer) > 1) {
+  if (!is->hold_buffer && gt_queue_size(is->genome_node_buffer) > 1) {
     /* we still have at least two nodes in the buffer -> serve from there */
     *gn = gt_queue_get(is->genome_node_buffer);
     return 0;
   }
 
-  /* the buffer is empty or has one element */
-  gt_assert(gt_queue_size(is->genome_node_buffer) <= 1);
+  /* the buffer is empty or has one element, or is held back */
+  gt_assert(is->hold_buffer || gt_queue_size(is->genome_node_buffer) <= 1);
 
   for (;;) {
     /* open file if necessary */
@@ -121,6 +400,11 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
         is->file_is_open = true;
       }
       is->line_number = 0;
+      is->parse_in_chunks = gt_jobs > 1 &&
+                            gt_gff3_parser_supports_chunks(is->gff3_parser);
+      is->open_region = false;
+      is->line_is_pending = false;
+      gt_str_reset(is->seqid);
 
       if (!had_err && is->progress_bar) {
         printf("processing file \"%s\"\n", gt_str_array_size(is->files)
@@ -138,22 +422,37 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
     filenamestr = gt_str_array_size(is->files)
                   ? gt_str_array_get_str(is->files, is->next_file-1)
                   : is->stdinstr;
-    /* read two nodes */
-    had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
-                                                is->genome_node_buffer,
-                                                is->used_types, filenamestr,
-                                                &is->line_number, is->fpin,
-                                                err);
-    if (had_err)
-      break;
-    if (status_code != EOF) {
-      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
+    if (is->parse_in_chunks) {
+      /* read and parse a batch of chunks in parallel */
+      had_err = gff3_in_stream_plain_parse_chunks(is, filenamestr, err);
+      if (had_err)
+        break;
+      if (is->hold_buffer || gt_queue_size(is->genome_node_buffer) <= 1)
+        continue;
+      status_code = 0;
+    }
+    else {
+      /* read two nodes */
+      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                  &status_code,
                                                   is->genome_node_buffer,
                                                   is->used_types, filenamestr,
                                                   &is->line_number, is->fpin,
                                                   err);
       if (had_err)
         break;
+      if (status_code != EOF) {
+        had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                    &status_code,
+                                                    is->genome_node_buffer,
+                                                    is->used_types,
+                                                    filenamestr,
+                                                    &is->line_number,
+                                                    is->fpin, err);
+        if (had_err)
+          break;
+      }
+      is->hold_buffer = false;
     }
 
     if (status_code == EOF) {
@@ -201,6 +500,12 @@ static void gff3_in_stream_plain_free(GtNodeStream *ns)
                                        ->genome_node_buffer));
   }
   gt_queue_delete(gff3_in_stream_plain->genome_node_buffer);
+  while (gt_queue_size(gff3_in_stream_plain->region_buffer)) {
+    gt_genome_node_delete(gt_queue_get(gff3_in_stream_plain->region_buffer));
+  }
+  gt_queue_delete(gff3_in_stream_plain->region_buffer);
+  gt_str_delete(gff3_in_stream_plain->seqid);
+  gt_str_delete(gff3_in_stream_plain->pending_line);
   gt_gff3_parser_delete(gff3_in_stream_plain->gff3_parser);
   gt_cstr_table_delete(gff3_in_stream_plain->used_types);
   gt_file_delete(gff3_in_stream_plain->fpin);
@@ -230,6 +535,9 @@ static GtNodeStream* gff3_in_stream_plain_new(GtStrArray *files,
   gff3_in_stream_plain->stdinstr            = gt_str_new_cstr("stdin");
   gff3_in_stream_plain->ensure_sorting      = ensure_sorting;
   gff3_in_stream_plain->genome_node_buffer  = gt_queue_new();
+  gff3_in_stream_plain->region_buffer       = gt_queue_new();
+  gff3_in_stream_plain->seqid               = gt_str_new();
+  gff3_in_stream_plain->pending_line        = gt_str_new();
   gff3_in_stream_plain->gff3_parser         = gt_gff3_parser_new(NULL);
   gff3_in_stream_plain->used_types          = gt_cstr_table_new();
   return ns;
@@ -29,7 +29,9 @@
 #include "core/parseutils.h"
 #include "core/queue.h"
 #include "core/splitter.h"
+#include "core/str.h"
 #include "core/symbol_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
@@ -48,6 +50,15 @@
 #include "extended/region_node.h"
 #include "extended/xrf_checker_api.h"
 
+/* One shared string for every distinct sequence ID and source of the genome
+   nodes created by a parser and its chunk parsers. Such nodes can then be
+   compared by a pointer comparison of their sequence IDs. */
+typedef struct {
+  GtHashmap *strs; /* maps immutable copies of the values to the strings */
+  GtMutex *mutex;
+  unsigned int reference_count;
+} GFF3StrTable;
+
 struct GtGFF3Parser {
   GtFeatureInfo *feature_info;
   GtHashmap *seqid_to_ssr_mapping, /* maps seqids to simple sequence regions */
@@ -66,7 +77,14 @@ struct GtGFF3Parser {
   GtOrphanage *orphanage;
   GtTypeChecker *type_checker;
   GtXRFChecker *xrf_checker;
-  unsigned int last_terminator; /* line number of the last terminator */
+  unsigned int last_terminator, /* line number of the last terminator */
+               scanned_terminator; /* line number of the last scanned one */
+  GtHashmap *scanned_regions; /* maps seqids to scanned sequence regions */
+  const GtGFF3Parser *scanner; /* parser which scanned the lines of a chunk */
+  GtStrArray *chunk_ids; /* defined in a chunk which continues a region */
+  GFF3StrTable *str_table; /* shared with the chunk parsers */
+  GtStr *pushed_back_lines; /* newline terminated, read before the file */
+  GtUword pushed_back_offset; /* of the next pushed back line */
 };
 
 typedef struct {
@@ -77,13 +95,65 @@ typedef struct {
        is_circular;
 } SimpleSequenceRegion;
 
-static SimpleSequenceRegion* simple_sequence_region_new(const char *seqid,
+static GFF3StrTable* gff3_str_table_new(void)
+{
+  GFF3StrTable *table = gt_malloc(sizeof *table);
+  table->strs = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                               (GtFree) gt_str_delete);
+  table->mutex = gt_mutex_new();
+  table->reference_count = 0;
+  return table;
+}
+
+static GFF3StrTable* gff3_str_table_ref(GFF3StrTable *table)
+{
+  gt_assert(table);
+  table->reference_count++;
+  return table;
+}
+
+static void gff3_str_table_delete(GFF3StrTable *table)
+{
+  if (!table) return;
+  if (table->reference_count) {
+    table->reference_count--;
+    return;
+  }
+  gt_hashmap_delete(table->strs);
+  gt_mutex_delete(table->mutex);
+  gt_free(table);
+}
+
+/* Returns a new reference to the shared string for <cstr>. The chunk parsers
+   thereby use the same sequence ID and source strings as a serial parser, so
+   that <gt_md5_seqid_cmp_seqids()> compares the sequence IDs of their nodes
+   by pointer. The chunk parsers run in parallel and the genome nodes can be
+   processed by parallel streams, therefore the reference count of the
+   strings is changed atomically. */
+static GtStr* gff3_str_table_get(GFF3StrTable *table, const char *cstr)
+{
+  GtStr *str;
+  gt_assert(table && cstr);
+  gt_mutex_lock(table->mutex);
+  if (!(str = gt_hashmap_get(table->strs, cstr))) {
+    str = gt_str_new_cstr(cstr);
+    gt_str_set_atomic_reference_count(str);
+    gt_hashmap_add(table->strs, gt_cstr_dup(cstr), str);
+  }
+  str = gt_str_ref(str);
+  gt_mutex_unlock(table->mutex);
+  return str;
+}
+
+static SimpleSequenceRegion* simple_sequence_region_new(GFF3StrTable
+                                                        *str_table,
+                                                        const char *seqid,
                                                         GtRange range,
                                                         unsigned int
                                                         line_number)
 {
   SimpleSequenceRegion *ssr = gt_calloc(1, sizeof *ssr);
-  ssr->seqid_str = gt_str_new_cstr(seqid);
+  ssr->seqid_str = gff3_str_table_get(str_table, seqid);
   ssr->range = range;
   ssr->line_number = line_number;
   return ssr;
@@ -96,6 +166,14 @@ static void simple_sequence_region_delete(SimpleSequenceRegion *ssr)
   gt_free(ssr);
 }
 
+/* Information about a sequence region collected by
+   <gt_gff3_parser_scan_line()>, a line number of 0 denotes ``undefined''. */
+typedef struct {
+  GtRange range;
+  unsigned int line_number,  /* of the first ``##sequence-region'' line */
+               circular_line; /* of the first ``Is_circular=true'' feature */
+} ScannedRegion;
+
 GtGFF3Parser* gt_gff3_parser_new(GtTypeChecker *type_checker)
 {
   GtGFF3Parser *parser;
@@ -110,6 +188,9 @@ GtGFF3Parser* gt_gff3_parser_new(GtTypeChecker *type_checker)
   parser->type_checker = type_checker ? gt_type_checker_ref(type_checker)
                                       : NULL;
   parser->xrf_checker = NULL;
+  parser->scanned_regions = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                                           gt_free_func);
+  parser->str_table = gff3_str_table_new();
   return parser;
 }
 
@@ -412,6 +493,43 @@ int gt_gff3_parser_parse_all_target_attributes(const char *values, bool tidy,
                                  filename, line_number, err);
 }
 
+/* Returns the simple sequence region for <seqid> (or NULL). A chunk parser
+   takes sequence regions defined before <line_number> outside of its chunk
+   from the scanned regions. */
+static SimpleSequenceRegion* get_simple_sequence_region(GtGFF3Parser *parser,
+                                                        const char *seqid,
+                                                        unsigned int
+                                                        line_number)
+{
+  SimpleSequenceRegion *ssr;
+  ScannedRegion *sr;
+  ssr = gt_hashmap_get(parser->seqid_to_ssr_mapping, seqid);
+  if (!ssr && parser->scanner &&
+      (sr = gt_hashmap_get(parser->scanner->scanned_regions, seqid)) &&
+      sr->line_number && sr->line_number < line_number) {
+    ssr = simple_sequence_region_new(parser->str_table, seqid, sr->range,
+                                     sr->line_number);
+    gt_hashmap_add(parser->seqid_to_ssr_mapping, gt_str_get(ssr->seqid_str),
+                   ssr);
+  }
+  return ssr;
+}
+
+static bool sequence_region_is_circular(const GtGFF3Parser *parser,
+                                        const SimpleSequenceRegion *ssr,
+                                        const char *seqid,
+                                        unsigned int line_number)
+{
+  ScannedRegion *sr;
+  if (ssr->is_circular)
+    return true;
+  if (parser->scanner &&
+      (sr = gt_hashmap_get(parser->scanner->scanned_regions, seqid))) {
+    return sr->circular_line && sr->circular_line < line_number;
+  }
+  return false;
+}
+
 static int get_seqid_str(GtStr **seqid_str, const char *seqid, GtRange range,
                          GtGFF3Parser *parser, const char *filename,
                          unsigned int line_number, GtError *err)
@@ -421,17 +539,19 @@ static int get_seqid_str(GtStr **seqid_str, const char *seqid, GtRange range,
 
   gt_error_check(err);
 
-  ssr = gt_hashmap_get(parser->seqid_to_ssr_mapping, seqid);
+  ssr = get_simple_sequence_region(parser, seqid, line_number);
   if (!ssr) {
     GtRange range;
     range.start = 0;
     range.end = ULONG_MAX;
-    ssr = simple_sequence_region_new(seqid, range, line_number);
+    ssr = simple_sequence_region_new(parser->str_table, seqid, range,
+                                     line_number);
     ssr->pseudo = true;
     gt_hashmap_add(parser->seqid_to_ssr_mapping, gt_str_get(ssr->seqid_str),
                    ssr);
   }
-  else if (parser->checkregions && !ssr->is_circular &&
+  else if (parser->checkregions &&
+           !sequence_region_is_circular(parser, ssr, seqid, line_number) &&
            !gt_range_contains(&ssr->range, &range) && parser->checkregions) {
     gt_error_set(err, "range ("GT_WU","GT_WU") of feature on line %u in file "
                  "\"%s\" is not contained in range ("GT_WU","GT_WU") of "
@@ -584,6 +704,8 @@ static int store_id(const char *id, GtFeatureNode *feature_node,
     gt_feature_info_add(parser->feature_info, id, feature_node);
     if (!parser->strict)
       gt_orphanage_reg_parent(parser->orphanage, id);
+    if (parser->chunk_ids)
+      gt_str_array_add_cstr(parser->chunk_ids, id);
   }
 
   if (!had_err)
@@ -1436,13 +1558,14 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
 }
 
 static void set_source(GtFeatureNode *feature_node, const char *source,
-                       GtHashmap *source_to_str_mapping)
+                       GtHashmap *source_to_str_mapping,
+                       GFF3StrTable *str_table)
 {
   GtStr *source_str;
-  gt_assert(feature_node && source && source_to_str_mapping);
+  gt_assert(feature_node && source && source_to_str_mapping && str_table);
   source_str = gt_hashmap_get(source_to_str_mapping, source);
   if (!source_str) {
-    source_str = gt_str_new_cstr(source);
+    source_str = gff3_str_table_get(str_table, source);
     gt_hashmap_add(source_to_str_mapping, gt_str_get(source_str), source_str);
   }
   gt_assert(source_str);
@@ -1580,7 +1703,7 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
   /* set source */
   if (!had_err) {
     set_source((GtFeatureNode*) feature_node, source,
-               parser->source_to_str_mapping);
+               parser->source_to_str_mapping, parser->str_table);
   }
 
   /* parse the attributes */
@@ -1827,12 +1950,101 @@ static bool invalid_gff3_pragma(const char *line)
                        strlen(GT_GFF_GENOME_BUILD)));
 }
 
+/* parse the ``##sequence-region'' <line> and store the sequence region in
+   <seqid> (which points into <line> afterwards) and <range> */
+static int parse_sequence_region_line(GtGFF3Parser *parser, char **seqid,
+                                      GtRange *range, char *line,
+                                      size_t line_length, const char *filename,
+                                      unsigned int line_number, GtError *err)
+{
+  char *tmpline, *tmplineend, *seqstart;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(parser && seqid && range && line);
+  gt_assert(strncmp(line, GT_GFF_SEQUENCE_REGION,
+                    strlen(GT_GFF_SEQUENCE_REGION)) == 0);
+
+  tmpline = line + strlen(GT_GFF_SEQUENCE_REGION);
+  tmplineend = line + line_length - 1;
+
+  /* skip blanks */
+  while (tmpline[0] == ' ')
+    tmpline++;
+  if (tmpline > tmplineend) {
+    gt_error_set(err, "missing sequence region name on line %u in file "
+                      "\"%s\"", line_number, filename);
+    had_err = -1;
+  }
+  if (!had_err) {
+    *seqid = tmpline; /* save seqid */
+    /* skip non-blanks */
+    while (tmpline < tmplineend && !(tmpline[0] == ' ' || tmpline[0] == '\t'))
+      tmpline++;
+    /* terminate seqid */
+    *tmpline++ = '\0';
+    /* skip blanks */
+    while (tmpline < tmplineend && (tmpline[0] == ' ' || tmpline[0] == '\t'))
+      tmpline++;
+    if (tmpline > tmplineend) {
+      gt_error_set(err, "missing sequence region start on line %u in file "
+                        "\"%s\"", line_number, filename);
+      had_err = -1;
+    }
+    else
+      seqstart = tmpline;
+  }
+
+  if (!had_err) {
+    /* skip non-blanks */
+    while (tmpline <= tmplineend &&
+           !(tmpline[0] == ' ' || tmpline[0] == '\t')) {
+      tmpline++;
+    }
+    /* terminate seqstart */
+    *tmpline++ = '\0';
+    /* skip blanks */
+    while (tmpline < tmplineend && (tmpline[0] == ' ' || tmpline[0] == '\t'))
+      tmpline++;
+    if (tmpline > tmplineend) {
+      gt_error_set(err, "missing sequence region end on line %u in file "
+                   "\"%s\"", line_number, filename);
+      had_err = -1;
+    }
+  }
+  if (!had_err) {
+    if (parser->strict) {
+      had_err = gt_parse_range(range, seqstart, tmpline, line_number,
+                               filename, err);
+    }
+    else if (parser->tidy) {
+      had_err = gt_parse_range_tidy(range, seqstart, tmpline, line_number,
+                                    filename, err);
+    }
+    else {
+      had_err = gt_parse_range_correct_neg(range, seqstart, tmpline,
+                                           line_number, filename, err);
+    }
+  }
+  if (!had_err && range->start == 0) {
+    gt_error_set(err, "illegal region start 0 on line %u in file \"%s\" "
+                 "(GFF3 files are 1-based)", line_number, filename);
+    had_err = -1;
+  }
+  if (!had_err) {
+    had_err = add_offset_if_necessary(range, parser, *seqid, filename,
+                                      line_number, err);
+  }
+
+  return had_err;
+}
+
 static int parse_meta_gff3_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
                                 char *line, size_t line_length,
                                 GtStr *filenamestr, unsigned int line_number,
                                 GtError *err)
 {
-  char *tmpline, *tmplineend, *seqstart, *seqid = NULL;
+  char *seqid = NULL;
   GtGenomeNode *gn;
   GtStr *changed_seqid = NULL;
   SimpleSequenceRegion *ssr = NULL;
@@ -1856,80 +2068,13 @@ static int parse_meta_gff3_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
   else if ((strncmp(line, GT_GFF_SEQUENCE_REGION,
                     strlen(GT_GFF_SEQUENCE_REGION)) == 0)) {
     /* we are in a line starting with "##sequence-region" */
-    tmpline = line + strlen(GT_GFF_SEQUENCE_REGION);
-    tmplineend = line + line_length - 1;
-
-    /* skip blanks */
-    while (tmpline[0] == ' ')
-      tmpline++;
-    if (tmpline > tmplineend) {
-      gt_error_set(err, "missing sequence region name on line %u in file "
-                        "\"%s\"", line_number, filename);
-      had_err = -1;
-    }
-    if (!had_err) {
-      seqid = tmpline; /* save seqid */
-      /* skip non-blanks */
-      while (tmpline < tmplineend && !(tmpline[0] == ' ' || tmpline[0] == '\t'))
-        tmpline++;
-      /* terminate seqid */
-      *tmpline++ = '\0';
-      /* skip blanks */
-      while (tmpline < tmplineend && (tmpline[0] == ' ' || tmpline[0] == '\t'))
-        tmpline++;
-      if (tmpline > tmplineend) {
-        gt_error_set(err, "missing sequence region start on line %u in file "
-                          "\"%s\"", line_number, filename);
-        had_err = -1;
-      }
-      else
-        seqstart = tmpline;
-    }
-
-    if (!had_err) {
-      /* skip non-blanks */
-      while (tmpline <= tmplineend &&
-             !(tmpline[0] == ' ' || tmpline[0] == '\t')) {
-        tmpline++;
-      }
-      /* terminate seqstart */
-      *tmpline++ = '\0';
-      /* skip blanks */
-      while (tmpline < tmplineend && (tmpline[0] == ' ' || tmpline[0] == '\t'))
-        tmpline++;
-      if (tmpline > tmplineend) {
-        gt_error_set(err, "missing sequence region end on line %u in file "
-                     "\"%s\"", line_number, filename);
-        had_err = -1;
-      }
-    }
-    if (!had_err) {
-      if (parser->strict) {
-        had_err = gt_parse_range(&range, seqstart, tmpline, line_number,
-                                 filename, err);
-      }
-      else if (parser->tidy) {
-        had_err = gt_parse_range_tidy(&range, seqstart, tmpline, line_number,
-                                      filename, err);
-      }
-      else {
-        had_err = gt_parse_range_correct_neg(&range, seqstart, tmpline,
-                                             line_number, filename, err);
-      }
-    }
-    if (!had_err && range.start == 0) {
-      gt_error_set(err, "illegal region start 0 on line %u in file \"%s\" "
-                   "(GFF3 files are 1-based)", line_number, filename);
-      had_err = -1;
-    }
-    if (!had_err) {
-      had_err = add_offset_if_necessary(&range, parser, seqid, filename,
-                                        line_number, err);
-    }
+    had_err = parse_sequence_region_line(parser, &seqid, &range, line,
+                                         line_length, filename, line_number,
+                                         err);
     if (!had_err) {
       /* now we can create a sequence region node */
       gt_assert(seqid);
-      ssr = gt_hashmap_get(parser->seqid_to_ssr_mapping, seqid);
+      ssr = get_simple_sequence_region(parser, seqid, line_number);
       if (ssr) {
         if (!ssr->pseudo) {
           gt_error_set(err, "the sequence region \"%s\" on line %u in file "
@@ -1944,7 +2089,8 @@ static int parse_meta_gff3_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
         }
       }
       else {
-        ssr = simple_sequence_region_new(seqid, range, line_number);
+        ssr = simple_sequence_region_new(parser->str_table, seqid, range,
+                                         line_number);
         gt_hashmap_add(parser->seqid_to_ssr_mapping, gt_str_get(ssr->seqid_str),
                        ssr);
       }
@@ -2059,6 +2205,28 @@ static int parse_meta_gff3_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
   return had_err;
 }
 
+static int read_next_line(GtGFF3Parser *parser, GtStr *line_buffer,
+                          GtFile *fpin)
+{
+  if (parser->pushed_back_lines) {
+    const char *line, *line_end;
+    line = gt_str_get(parser->pushed_back_lines) + parser->pushed_back_offset;
+    line_end = memchr(line, '\n', gt_str_length(parser->pushed_back_lines) -
+                                  parser->pushed_back_offset);
+    gt_assert(line_end);
+    gt_str_append_cstr_nt(line_buffer, line, line_end - line);
+    parser->pushed_back_offset += line_end - line + 1;
+    if (parser->pushed_back_offset ==
+        gt_str_length(parser->pushed_back_lines)) {
+      gt_str_delete(parser->pushed_back_lines);
+      parser->pushed_back_lines = NULL;
+      parser->pushed_back_offset = 0;
+    }
+    return 0;
+  }
+  return gt_str_read_next_line_generic(line_buffer, fpin);
+}
+
 int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
                                       GtQueue *genome_nodes,
                                       GtCstrTable *used_types,
@@ -2080,7 +2248,7 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   /* init */
   line_buffer = gt_str_new();
 
-  while ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) != EOF) {
+  while ((rval = read_next_line(parser, line_buffer, fpin)) != EOF) {
     line = gt_str_get(line_buffer);
     line_length = gt_str_length(line_buffer);
     (*line_number)++;
@@ -2156,6 +2324,297 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   return had_err;
 }
 
+bool gt_gff3_parser_supports_chunks(const GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  return !parser->checkids && !parser->offset_mapping &&
+         !parser->type_checker && !parser->xrf_checker;
+}
+
+static void scan_circular_feature(GtGFF3Parser *parser, const char *line,
+                                  size_t line_length, unsigned int line_number)
+{
+  const char *attributes = line, *seqid_end, *attr;
+  ScannedRegion *sr;
+  char *seqid;
+  int i;
+
+  /* skip to the attribute column */
+  for (i = 0; attributes && i < 8; i++) {
+    if ((attributes = memchr(attributes, '\t', line_length -
+                                               (attributes - line)))) {
+      attributes++;
+    }
+  }
+  if (!attributes)
+    return;
+  for (attr = attributes; attr; attr = strchr(attr, ';')) {
+    if (attr[0] == ';')
+      attr++;
+    while (attr[0] == ' ')
+      attr++;
+    if (!strncmp(attr, GT_GFF_IS_CIRCULAR"=true",
+                 strlen(GT_GFF_IS_CIRCULAR"=true"))) {
+      break;
+    }
+  }
+  if (!attr)
+    return;
+  seqid_end = memchr(line, '\t', line_length);
+  gt_assert(seqid_end);
+  seqid = gt_cstr_dup_nt(line, seqid_end - line);
+  if (!(sr = gt_hashmap_get(parser->scanned_regions, seqid))) {
+    sr = gt_calloc(1, sizeof *sr);
+    gt_hashmap_add(parser->scanned_regions, seqid, sr);
+  }
+  else
+    gt_free(seqid);
+  if (!sr->circular_line)
+    sr->circular_line = line_number;
+}
+
+static void scan_sequence_region(GtGFF3Parser *parser, const char *line,
+                                 size_t line_length, unsigned int line_number)
+{
+  GtWarningHandler warning_handler;
+  void *warning_data;
+  ScannedRegion *sr;
+  GtError *err;
+  GtRange range;
+  char *line_copy, *seqid = NULL;
+  int had_err;
+
+  /* the errors and warnings are reported by the chunk parser later on */
+  warning_handler = gt_warning_get_handler();
+  warning_data = gt_warning_get_data();
+  gt_warning_set_handler(NULL, NULL);
+  err = gt_error_new();
+  line_copy = gt_cstr_dup(line);
+  had_err = parse_sequence_region_line(parser, &seqid, &range, line_copy,
+                                       line_length, "", line_number, err);
+  if (!had_err) {
+    if (!(sr = gt_hashmap_get(parser->scanned_regions, seqid))) {
+      sr = gt_calloc(1, sizeof *sr);
+      gt_hashmap_add(parser->scanned_regions, gt_cstr_dup(seqid), sr);
+    }
+    if (!sr->line_number) {
+      sr->range = range;
+      sr->line_number = line_number;
+    }
+  }
+  gt_free(line_copy);
+  gt_error_delete(err);
+  gt_warning_set_handler(warning_handler, warning_data);
+}
+
+void gt_gff3_parser_scan_line(GtGFF3Parser *parser, const char *line,
+                              size_t line_length, GtUint64 line_number)
+{
+  gt_assert(parser && line);
+  if (line[0] == '#') {
+    if (line_length == 1 || line[1] != '#')
+      return;
+    if (!strncmp(line, GT_GFF_SEQUENCE_REGION,
+                 strlen(GT_GFF_SEQUENCE_REGION))) {
+      scan_sequence_region(parser, line, line_length,
+                           (unsigned int) line_number);
+    }
+    else if (!strncmp(line, GT_GFF_TERMINATOR, strlen(GT_GFF_TERMINATOR)))
+      parser->scanned_terminator = (unsigned int) line_number;
+    else if (!strncmp(line, GT_GVF_VERSION_PREFIX,
+                      strlen(GT_GVF_VERSION_PREFIX))) {
+      parser->gvf_mode = true;
+    }
+  }
+  else if (line_length && parser->checkregions) {
+    scan_circular_feature(parser, line, line_length,
+                          (unsigned int) line_number);
+  }
+}
+
+GtGFF3Parser* gt_gff3_parser_new_chunk_parser(const GtGFF3Parser *parser,
+                                              bool continues_region)
+{
+  GtGFF3Parser *chunk_parser;
+  gt_assert(parser && gt_gff3_parser_supports_chunks(parser));
+  chunk_parser = gt_gff3_parser_new(NULL);
+  chunk_parser->checkregions = parser->checkregions;
+  chunk_parser->strict = parser->strict;
+  chunk_parser->tidy = parser->tidy;
+  chunk_parser->gvf_mode = parser->gvf_mode;
+  chunk_parser->offset = parser->offset;
+  chunk_parser->last_terminator = parser->scanned_terminator;
+  chunk_parser->scanner = parser;
+  if (continues_region)
+    chunk_parser->chunk_ids = gt_str_array_new();
+  gff3_str_table_delete(chunk_parser->str_table);
+  chunk_parser->str_table = gff3_str_table_ref(parser->str_table);
+  return chunk_parser;
+}
+
+static int parse_chunk_lines(GtGFF3Parser *parser, GtQueue *genome_nodes,
+                             GtCstrTable *used_types, GtStr *filenamestr,
+                             GtUint64 line_number, char *chunk,
+                             GtUword chunk_length, GtError *err)
+{
+  char *line, *line_end, *chunk_end = chunk + chunk_length;
+  const char *filename;
+  size_t line_length;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(parser && parser->scanner && genome_nodes && used_types && chunk);
+
+  filename = gt_str_get(filenamestr);
+
+  for (line = chunk; !had_err && line < chunk_end; line = line_end + 1) {
+    line_end = memchr(line, '\n', chunk_end - line);
+    gt_assert(line_end);
+    *line_end = '\0';
+    line_length = line_end - line;
+    if (line_number == 1) {
+      had_err = parse_first_gff3_line(line, filename, genome_nodes, filenamestr,
+                                      &line_number, &parser->gvf_mode,
+                                      parser->tidy, err);
+      if (had_err == 1) { /* line processed */
+        had_err = 0;
+        line_number++;
+        continue;
+      }
+    }
+    if (had_err)
+      break;
+    if (line_length == 0) {
+      gt_warning("skipping blank line "GT_LLU" in file \"%s\"", line_number,
+                 filename);
+    }
+    else if (line[0] == '#') {
+      had_err = parse_meta_gff3_line(parser, genome_nodes, line, line_length,
+                                     filenamestr, line_number, err);
+      /* FASTA sections are never part of a chunk */
+      gt_assert(!parser->fasta_parsing);
+    }
+    else {
+      had_err = parse_gff3_feature_line(parser, genome_nodes, used_types, line,
+                                        line_length, filenamestr, line_number,
+                                        err);
+    }
+    line_number++;
+  }
+
+  return had_err;
+}
+
+int gt_gff3_parser_parse_chunk(GtGFF3Parser *parser, GtQueue *genome_nodes,
+                               GtCstrTable *used_types, GtStr *filenamestr,
+                               GtUint64 line_number, char *chunk,
+                               GtUword chunk_length, GtError *err)
+{
+  int had_err;
+
+  gt_error_check(err);
+  had_err = parse_chunk_lines(parser, genome_nodes, used_types, filenamestr,
+                              line_number, chunk, chunk_length, err);
+
+  if (!had_err && !parser->strict) {
+    had_err = process_orphans(parser->orphanage, parser->feature_info,
+                              parser->strict, parser->last_terminator,
+                              parser->type_checker, genome_nodes, err);
+  }
+
+  if (had_err) {
+    while (gt_queue_size(genome_nodes))
+      gt_genome_node_delete(gt_queue_get(genome_nodes));
+  }
+
+  return had_err;
+}
+
+bool gt_gff3_parser_join_chunk(GtGFF3Parser *parser,
+                               const GtGFF3Parser *chunk_parser)
+{
+  GtUword i;
+
+  gt_assert(parser && chunk_parser && chunk_parser->scanner == parser);
+  if (chunk_parser->chunk_ids) {
+    /* the chunk continues the region of <parser>, it must not depend on it */
+    if (!gt_orphanage_is_empty(parser->orphanage))
+      return false;
+    for (i = 0; i < gt_str_array_size(chunk_parser->chunk_ids); i++) {
+      if (gt_feature_info_get(parser->feature_info,
+                              gt_str_array_get(chunk_parser->chunk_ids, i))) {
+        return false;
+      }
+    }
+  }
+  if (!chunk_parser->chunk_ids ||
+      chunk_parser->last_terminator != parser->last_terminator) {
+    /* the chunk starts a new region */
+    gt_assert(gt_orphanage_is_empty(parser->orphanage));
+    gt_feature_info_reset(parser->feature_info);
+    parser->incomplete_node = false;
+  }
+  /* take over the features of the region which is open at the end of the
+     chunk */
+  gt_feature_info_add_all(parser->feature_info, chunk_parser->feature_info);
+  parser->incomplete_node = parser->incomplete_node ||
+                            chunk_parser->incomplete_node;
+  parser->last_terminator = chunk_parser->last_terminator;
+  return true;
+}
+
+int gt_gff3_parser_reparse_chunk(GtGFF3Parser *parser, GtQueue *genome_nodes,
+                                 GtCstrTable *used_types, GtStr *filenamestr,
+                                 GtUint64 line_number, char *chunk,
+                                 GtUword chunk_length, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(parser);
+  /* take the scanned sequence regions into account */
+  parser->scanner = parser;
+  return parse_chunk_lines(parser, genome_nodes, used_types, filenamestr,
+                           line_number, chunk, chunk_length, err);
+}
+
+int gt_gff3_parser_close_region(GtGFF3Parser *parser, GtQueue *genome_nodes,
+                                GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(parser && genome_nodes);
+  if (!parser->strict) {
+    had_err = process_orphans(parser->orphanage, parser->feature_info,
+                              parser->strict, parser->last_terminator,
+                              parser->type_checker, genome_nodes, err);
+  }
+  gt_feature_info_reset(parser->feature_info);
+  parser->incomplete_node = false;
+  return had_err;
+}
+
+void gt_gff3_parser_push_back_line(GtGFF3Parser *parser, const char *line)
+{
+  gt_assert(parser && line);
+  if (!parser->pushed_back_lines)
+    parser->pushed_back_lines = gt_str_new();
+  gt_str_append_cstr(parser->pushed_back_lines, line);
+  gt_str_append_char(parser->pushed_back_lines, '\n');
+}
+
+void gt_gff3_parser_push_back_chunk(GtGFF3Parser *parser,
+                                    const GtGFF3Parser *chunk_parser,
+                                    const char *chunk, GtUword chunk_length)
+{
+  gt_assert(parser && chunk_parser && chunk_parser->scanner == parser && chunk);
+  gt_assert(!parser->pushed_back_lines);
+  parser->pushed_back_lines = gt_str_new();
+  gt_str_append_cstr_nt(parser->pushed_back_lines, chunk, chunk_length);
+  /* the lines have been scanned already, continue with the terminator state
+     before the chunk and take the scanned sequence regions into account */
+  parser->last_terminator = chunk_parser->last_terminator;
+  parser->scanner = parser;
+}
+
 void gt_gff3_parser_reset(GtGFF3Parser *parser)
 {
   gt_assert(parser);
@@ -2166,6 +2625,12 @@ void gt_gff3_parser_reset(GtGFF3Parser *parser)
   gt_hashmap_reset(parser->source_to_str_mapping);
   gt_orphanage_reset(parser->orphanage);
   parser->last_terminator = 0;
+  parser->scanned_terminator = 0;
+  gt_hashmap_reset(parser->scanned_regions);
+  parser->scanner = NULL;
+  gt_str_delete(parser->pushed_back_lines);
+  parser->pushed_back_lines = NULL;
+  parser->pushed_back_offset = 0;
 }
 
 void gt_gff3_parser_delete(GtGFF3Parser *parser)
@@ -2174,6 +2639,10 @@ void gt_gff3_parser_delete(GtGFF3Parser *parser)
   gt_feature_info_delete(parser->feature_info);
   gt_hashmap_delete(parser->seqid_to_ssr_mapping);
   gt_hashmap_delete(parser->source_to_str_mapping);
+  gt_hashmap_delete(parser->scanned_regions);
+  gff3_str_table_delete(parser->str_table);
+  gt_str_delete(parser->pushed_back_lines);
+  gt_str_array_delete(parser->chunk_ids);
   gt_mapping_delete(parser->offset_mapping);
   gt_orphanage_delete(parser->orphanage);
   gt_type_checker_delete(parser->type_checker);
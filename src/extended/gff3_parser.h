@@ -40,4 +40,78 @@ void gt_gff3_parser_build_target_str(GtStr *target, GtStrArray *target_ids,
                                      GtArray *target_ranges,
                                      GtArray *target_strands);
 
+/* Chunk parsing: The lines of a GFF3 file (without its FASTA section) can be
+   split into chunks which are parsed independently (and in parallel) by chunk
+   parsers. Every line has to be scanned by the <parser> in file order with
+   <gt_gff3_parser_scan_line()> before the chunk it belongs to is parsed, in
+   order to make sequence regions, terminators, and GVF mode visible across
+   chunks. A chunk parser has to be created before the first line of its chunk
+   is scanned and must not outlive <parser>.
+   A chunk which does not start after a terminator line continues the region
+   (the features since the last terminator) of the previous chunk. After
+   parsing, the chunks are joined in file order with
+   <gt_gff3_parser_join_chunk()>, which keeps the state of the open region in
+   <parser>. A chunk which depends on the region before it is parsed again in
+   the context of the region with <gt_gff3_parser_reparse_chunk()>. The nodes
+   of a region have to be kept until it is closed with
+   <gt_gff3_parser_close_region()>. */
+
+/* Returns <true> if the configuration of <parser> allows chunk parsing. */
+bool          gt_gff3_parser_supports_chunks(const GtGFF3Parser *parser);
+/* Scan <line> with given <line_length> and <line_number>. */
+void          gt_gff3_parser_scan_line(GtGFF3Parser *parser, const char *line,
+                                       size_t line_length,
+                                       GtUint64 line_number);
+/* Return a new chunk parser with the configuration and state of <parser>. If
+   <continues_region> is <true>, the chunk continues the region of the previous
+   chunk. */
+GtGFF3Parser* gt_gff3_parser_new_chunk_parser(const GtGFF3Parser *parser,
+                                              bool continues_region);
+/* Parse the newline terminated lines in <chunk> of given <chunk_length> (which
+   is modified) with the chunk parser <parser> and add all resulting genome
+   nodes to <genome_nodes>. The first line of <chunk> has the given
+   <line_number>. */
+int           gt_gff3_parser_parse_chunk(GtGFF3Parser *parser,
+                                         GtQueue *genome_nodes,
+                                         GtCstrTable *used_types,
+                                         GtStr *filenamestr,
+                                         GtUint64 line_number, char *chunk,
+                                         GtUword chunk_length, GtError *err);
+/* Join the state of the chunk parser <chunk_parser> at the end of its chunk,
+   which has been parsed without error, with the state of <parser>. Returns
+   <false> and leaves <parser> unchanged if the chunk continues the region of
+   <parser> and depends on it, that is, <parser> has pending orphans or the
+   chunk defines an ID which is defined in the region already. */
+bool          gt_gff3_parser_join_chunk(GtGFF3Parser *parser,
+                                        const GtGFF3Parser *chunk_parser);
+/* Parse the newline terminated lines in <chunk> of given <chunk_length> (which
+   is modified) with <parser> in the context of its region and add the
+   resulting genome nodes to <genome_nodes>, which has to contain the nodes of
+   the region parsed so far. The first line of <chunk> has the given
+   <line_number>. Orphans are kept until the region is closed. */
+int           gt_gff3_parser_reparse_chunk(GtGFF3Parser *parser,
+                                           GtQueue *genome_nodes,
+                                           GtCstrTable *used_types,
+                                           GtStr *filenamestr,
+                                           GtUint64 line_number, char *chunk,
+                                           GtUword chunk_length,
+                                           GtError *err);
+/* Close the region of <parser> at the end of a chunk which does not continue
+   in the next one. Pending orphans are added to <genome_nodes>, which has to
+   contain the nodes of the region. */
+int           gt_gff3_parser_close_region(GtGFF3Parser *parser,
+                                          GtQueue *genome_nodes, GtError *err);
+/* Push back <line>, it is the next line read by
+   <gt_gff3_parser_parse_genome_nodes()>. */
+void          gt_gff3_parser_push_back_line(GtGFF3Parser *parser,
+                                            const char *line);
+/* Push back the newline terminated lines in <chunk> of given <chunk_length>,
+   which have been scanned by <parser> but not parsed by the chunk parser
+   <chunk_parser>. The rest of the current file is then parsed serially with
+   <gt_gff3_parser_parse_genome_nodes()>, starting with these lines. */
+void          gt_gff3_parser_push_back_chunk(GtGFF3Parser *parser,
+                                             const GtGFF3Parser *chunk_parser,
+                                             const char *chunk,
+                                             GtUword chunk_length);
+
 #endif
@@ -22,6 +22,7 @@
 #include "core/ma.h"
 #include "core/parseutils.h"
 #include "core/splitter.h"
+#include "core/str.h"
 #include "core/strand.h"
 #include "core/strcmp.h"
 #include "core/undef_api.h"
@@ -510,6 +511,8 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
       seqid_str = gt_hashmap_get(parser->seqid_to_str_mapping, seqname);
       if (!seqid_str) {
         seqid_str = gt_str_new_cstr(seqname);
+        /* the feature nodes can be processed by parallel streams */
+        gt_str_set_atomic_reference_count(seqid_str);
         gt_hashmap_add(parser->seqid_to_str_mapping, gt_str_get(seqid_str),
                        seqid_str);
       }
@@ -524,6 +527,7 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
       source_str = gt_hashmap_get(parser->source_to_str_mapping, source);
       if (!source_str) {
         source_str = gt_str_new_cstr(source);
+        gt_str_set_atomic_reference_count(source_str);
         gt_hashmap_add(parser->source_to_str_mapping, gt_str_get(source_str),
                     source_str);
       }
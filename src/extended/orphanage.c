@@ -101,6 +101,12 @@ bool gt_orphanage_parent_is_missing(GtOrphanage *o, const char *parent_id)
   return false;
 }
 
+bool gt_orphanage_is_empty(const GtOrphanage *o)
+{
+  gt_assert(o);
+  return gt_queue_size(o->orphans) ? false : true;
+}
+
 bool gt_orphanage_is_orphan(GtOrphanage *o, const char *id)
 {
  gt_assert(o && id);
@@ -30,5 +30,7 @@ void          gt_orphanage_reg_parent(GtOrphanage*, const char *id);
 GtGenomeNode* gt_orphanage_get_orphan(GtOrphanage*);
 bool          gt_orphanage_parent_is_missing(GtOrphanage*, const char *id);
 bool          gt_orphanage_is_orphan(GtOrphanage*, const char *id);
+/* Returns <true> if <GtOrphanage*> contains no orphans. */
+bool          gt_orphanage_is_empty(const GtOrphanage*);
 
 #endif
@@ -0,0 +1,243 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/class_alloc_lock.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
+#include "extended/genome_node.h"
+#include "extended/node_stream_api.h"
+#include "extended/parallel_visitor_stream.h"
+
+/* the number of nodes read at once per thread */
+#define PARALLEL_VISITOR_STREAM_NODES_PER_THREAD  64
+
+struct GtParallelVisitorStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtNodeVisitor **visitors;
+  GtUword num_of_visitors,
+          window_size,
+          next_node;
+  GtArray *nodes;
+};
+
+typedef struct {
+  GtNodeVisitor *visitor;
+  GtError *err;
+  GtUword error_node;
+  int had_err;
+} ParallelVisitorJob;
+
+typedef struct {
+  GtArray *nodes;
+  ParallelVisitorJob *jobs;
+  GtUword next_job,
+          next_node;
+  bool had_err;
+  GtMutex *mutex;
+} ParallelVisitorInfo;
+
+#define parallel_visitor_stream_cast(NS)\
+        gt_node_stream_cast(gt_parallel_visitor_stream_class(), NS)
+
+static void* parallel_visitor_stream_thread(void *data)
+{
+  ParallelVisitorInfo *info = data;
+  ParallelVisitorJob *job;
+  GtGenomeNode *gn;
+  GtUword i;
+
+  gt_mutex_lock(info->mutex);
+  job = info->jobs + info->next_job++;
+  gt_mutex_unlock(info->mutex);
+
+  for (;;) {
+    /* take the next node, stop after an error. All nodes in front of an
+       erroneous node have already been taken, therefore the first error in
+       input order is always detected. */
+    gt_mutex_lock(info->mutex);
+    if (info->had_err || info->next_node == gt_array_size(info->nodes)) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    i = info->next_node++;
+    gt_mutex_unlock(info->mutex);
+
+    gn = *(GtGenomeNode**) gt_array_get(info->nodes, i);
+    if (gt_genome_node_accept(gn, job->visitor, job->err)) {
+      job->had_err = -1;
+      job->error_node = i;
+      gt_mutex_lock(info->mutex);
+      info->had_err = true;
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+  }
+
+  return NULL;
+}
+
+/* Visit the nodes of the current window in parallel. */
+static int parallel_visitor_stream_visit_window(GtParallelVisitorStream *pvs,
+                                                GtError *err)
+{
+  ParallelVisitorInfo info;
+  ParallelVisitorJob *error_job = NULL;
+  GtUword i;
+  int had_err;
+
+  gt_error_check(err);
+  gt_assert(pvs && pvs->num_of_visitors == gt_jobs);
+
+  info.nodes = pvs->nodes;
+  info.jobs = gt_calloc(pvs->num_of_visitors, sizeof *info.jobs);
+  for (i = 0; i < pvs->num_of_visitors; i++) {
+    info.jobs[i].visitor = pvs->visitors[i];
+    info.jobs[i].err = gt_error_new();
+  }
+  info.next_job = 0;
+  info.next_node = 0;
+  info.had_err = false;
+  info.mutex = gt_mutex_new();
+
+  had_err = gt_multithread(parallel_visitor_stream_thread, &info, err);
+
+  /* report the error of the first erroneous node */
+  for (i = 0; i < pvs->num_of_visitors; i++) {
+    if (info.jobs[i].had_err &&
+        (!error_job || info.jobs[i].error_node < error_job->error_node)) {
+      error_job = info.jobs + i;
+    }
+  }
+  if (!had_err && error_job) {
+    gt_error_set(err, "%s", gt_error_get(error_job->err));
+    had_err = -1;
+  }
+
+  for (i = 0; i < pvs->num_of_visitors; i++)
+    gt_error_delete(info.jobs[i].err);
+  gt_mutex_delete(info.mutex);
+  gt_free(info.jobs);
+  return had_err;
+}
+
+static void parallel_visitor_stream_reset(GtParallelVisitorStream *pvs)
+{
+  GtUword i;
+  /* delete the nodes which have not been passed on */
+  for (i = pvs->next_node; i < gt_array_size(pvs->nodes); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(pvs->nodes, i));
+  gt_array_reset(pvs->nodes);
+  pvs->next_node = 0;
+}
+
+static int parallel_visitor_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                        GtError *err)
+{
+  GtParallelVisitorStream *pvs;
+  int had_err = 0;
+  gt_error_check(err);
+  pvs = parallel_visitor_stream_cast(ns);
+
+  if (pvs->num_of_visitors == 1) {
+    /* a single thread, behave like a visitor stream */
+    had_err = gt_node_stream_next(pvs->in_stream, gn, err);
+    if (!had_err && *gn)
+      had_err = gt_genome_node_accept(*gn, pvs->visitors[0], err);
+    if (had_err) {
+      /* we own the node -> delete it */
+      gt_genome_node_delete(*gn);
+      *gn = NULL;
+    }
+    return had_err;
+  }
+
+  if (pvs->next_node == gt_array_size(pvs->nodes)) {
+    /* fill the next window */
+    parallel_visitor_stream_reset(pvs);
+    while (gt_array_size(pvs->nodes) < pvs->window_size) {
+      had_err = gt_node_stream_next(pvs->in_stream, gn, err);
+      if (had_err || !*gn)
+        break;
+      gt_array_add(pvs->nodes, *gn);
+    }
+    if (!had_err && gt_array_size(pvs->nodes))
+      had_err = parallel_visitor_stream_visit_window(pvs, err);
+    if (had_err)
+      parallel_visitor_stream_reset(pvs);
+  }
+
+  if (!had_err && pvs->next_node < gt_array_size(pvs->nodes))
+    *gn = *(GtGenomeNode**) gt_array_get(pvs->nodes, pvs->next_node++);
+  else
+    *gn = NULL;
+  return had_err;
+}
+
+static void parallel_visitor_stream_free(GtNodeStream *ns)
+{
+  GtParallelVisitorStream *pvs = parallel_visitor_stream_cast(ns);
+  GtUword i;
+  parallel_visitor_stream_reset(pvs);
+  gt_array_delete(pvs->nodes);
+  for (i = 0; i < pvs->num_of_visitors; i++)
+    gt_node_visitor_delete(pvs->visitors[i]);
+  gt_free(pvs->visitors);
+  gt_node_stream_delete(pvs->in_stream);
+}
+
+const GtNodeStreamClass* gt_parallel_visitor_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtParallelVisitorStream),
+                                   parallel_visitor_stream_free,
+                                   parallel_visitor_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_parallel_visitor_stream_new(GtNodeStream *in_stream,
+                                     GtParallelVisitorStreamNewVisitorFunc
+                                                                    new_visitor,
+                                             void *data, GtError *err)
+{
+  GtParallelVisitorStream *pvs;
+  GtNodeStream *ns;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(in_stream && new_visitor && gt_jobs > 0);
+  ns = gt_node_stream_create(gt_parallel_visitor_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  pvs = parallel_visitor_stream_cast(ns);
+  pvs->in_stream = gt_node_stream_ref(in_stream);
+  pvs->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  pvs->window_size = PARALLEL_VISITOR_STREAM_NODES_PER_THREAD * gt_jobs;
+  pvs->visitors = gt_calloc(gt_jobs, sizeof *pvs->visitors);
+  while (!had_err && pvs->num_of_visitors < gt_jobs) {
+    if (!(pvs->visitors[pvs->num_of_visitors] = new_visitor(data, err)))
+      had_err = -1;
+    else
+      pvs->num_of_visitors++;
+  }
+  if (had_err) {
+    gt_node_stream_delete(ns);
+    return NULL;
+  }
+  return ns;
+}
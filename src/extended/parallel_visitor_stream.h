@@ -0,0 +1,51 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PARALLEL_VISITOR_STREAM_H
+#define PARALLEL_VISITOR_STREAM_H
+
+#include "extended/node_stream_api.h"
+#include "extended/node_visitor_api.h"
+
+/* Implements the <GtNodeStream> interface. Like a <GtVisitorStream>, a
+   <GtParallelVisitorStream> applies a visitor to each node which passes
+   through it. But it reads a window of nodes at once and visits them in
+   <gt_jobs> threads, each with its own visitor. The nodes are passed on in
+   input order, whenever all nodes of the window have been visited.
+   Therefore, the visitors must handle each node independently of all other
+   nodes, and data shared by the visitors must be safe to use from several
+   threads at once. */
+typedef struct GtParallelVisitorStream GtParallelVisitorStream;
+
+/* Function returning a new visitor for one of the threads of a
+   <GtParallelVisitorStream>, using <data>. In the case of an error, <NULL> is
+   returned and <err> is set accordingly. */
+typedef GtNodeVisitor* (*GtParallelVisitorStreamNewVisitorFunc)(void *data,
+                                                                GtError *err);
+
+const GtNodeStreamClass* gt_parallel_visitor_stream_class(void);
+
+/* Create a new <GtParallelVisitorStream> reading from <in_stream>, which calls
+   <new_visitor> with <data> once per thread. In the case of an error, <NULL>
+   is returned and <err> is set accordingly. With <gt_jobs> set to 1 the
+   stream behaves exactly like a <GtVisitorStream>. */
+GtNodeStream*            gt_parallel_visitor_stream_new(GtNodeStream *in_stream,
+                                     GtParallelVisitorStreamNewVisitorFunc
+                                                                    new_visitor,
+                                                             void *data,
+                                                             GtError *err);
+
+#endif
@@ -27,6 +27,7 @@
 #include "core/md5_seqid.h"
 #include "core/seq_col.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "extended/mapping.h"
 #include "extended/region_mapping_api.h"
@@ -48,6 +49,7 @@ struct GtRegionMapping {
   const char *rawseq;
   GtUword rawlength,
                 rawoffset;
+  GtMutex *mutex; /* serializes the access to the current sequence */
   unsigned int reference_count;
 };
 
@@ -58,6 +60,7 @@ GtRegionMapping* gt_region_mapping_new_mapping(GtStr *mapping_filename,
   gt_error_check(err);
   gt_assert(mapping_filename);
   rm = gt_calloc(1, sizeof (GtRegionMapping));
+  rm->mutex = gt_mutex_new();
   rm->mapping = gt_mapping_new(mapping_filename, "mapping",
                                GT_MAPPINGTYPE_STRING, err);
   if (!rm->mapping) {
@@ -74,6 +77,7 @@ GtRegionMapping* gt_region_mapping_new_seqfiles(GtStrArray *sequence_filenames,
   gt_assert(sequence_filenames);
   gt_assert(!(matchdesc && usedesc));
   rm = gt_calloc(1, sizeof (GtRegionMapping));
+  rm->mutex = gt_mutex_new();
   rm->sequence_filenames = gt_str_array_ref(sequence_filenames);
   rm->matchdesc = matchdesc;
   rm->usedesc = usedesc;
@@ -87,6 +91,7 @@ GtRegionMapping* gt_region_mapping_new_encseq(GtEncseq *encseq, bool matchdesc,
   gt_assert(encseq);
   gt_assert(!(matchdesc && usedesc));
   rm = gt_calloc(1, sizeof (GtRegionMapping));
+  rm->mutex = gt_mutex_new();
   rm->encseq = gt_encseq_ref(encseq);
   rm->matchdesc = matchdesc;
   rm->usedesc = usedesc;
@@ -108,6 +113,7 @@ GtRegionMapping* gt_region_mapping_new_rawseq(const char *rawseq,
   GtRegionMapping *rm;
   gt_assert(rawseq);
   rm = gt_calloc(1, sizeof (GtRegionMapping));
+  rm->mutex = gt_mutex_new();
   rm->userawseq = true;
   rm->rawseq = rawseq;
   rm->rawlength = length;
@@ -196,9 +202,9 @@ static int update_seq_col_if_necessary(GtRegionMapping *rm, GtStr *seqid,
   return had_err;
 }
 
-int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
-                                   GtStr *seqid, GtUword start,
-                                   GtUword end, GtError *err)
+static int region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
+                                       GtStr *seqid, GtUword start,
+                                       GtUword end, GtError *err)
 {
   int had_err = 0;
   GtUword offset = 1;
@@ -333,9 +339,9 @@ int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
   return had_err;
 }
 
-int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
-                                          GtUword *length, GtStr *seqid,
-                                          GtError *err)
+static int region_mapping_get_sequence_length(GtRegionMapping *rm,
+                                              GtUword *length, GtStr *seqid,
+                                              GtError *err)
 {
   GtUword filenum, seqnum;
   int had_err;
@@ -395,8 +401,8 @@ int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
   return had_err;
 }
 
-int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
-                                      GtStr *seqid, GtError *err)
+static int region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
+                                          GtStr *seqid, GtError *err)
 {
   int had_err = 0;
   gt_error_check(err);
@@ -479,11 +485,11 @@ int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
   return had_err;
 }
 
-const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
-                                                  GtStr *seqid,
-                                                  const GtRange *range,
-                                                  GtUword *offset,
-                                                  GtError *err)
+static const char* region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
+                                                      GtStr *seqid,
+                                                      const GtRange *range,
+                                                      GtUword *offset,
+                                                      GtError *err)
 {
   const char *md5 = NULL;
   int had_err;
@@ -560,6 +566,55 @@ const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
   return md5;
 }
 
+int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
+                                   GtStr *seqid, GtUword start,
+                                   GtUword end, GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  gt_mutex_lock(rm->mutex);
+  had_err = region_mapping_get_sequence(rm, seq, seqid, start, end, err);
+  gt_mutex_unlock(rm->mutex);
+  return had_err;
+}
+
+int gt_region_mapping_get_sequence_length(GtRegionMapping *rm,
+                                          GtUword *length, GtStr *seqid,
+                                          GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  gt_mutex_lock(rm->mutex);
+  had_err = region_mapping_get_sequence_length(rm, length, seqid, err);
+  gt_mutex_unlock(rm->mutex);
+  return had_err;
+}
+
+int gt_region_mapping_get_description(GtRegionMapping *rm, GtStr *desc,
+                                      GtStr *seqid, GtError *err)
+{
+  int had_err;
+  gt_assert(rm);
+  gt_mutex_lock(rm->mutex);
+  had_err = region_mapping_get_description(rm, desc, seqid, err);
+  gt_mutex_unlock(rm->mutex);
+  return had_err;
+}
+
+const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
+                                                  GtStr *seqid,
+                                                  const GtRange *range,
+                                                  GtUword *offset,
+                                                  GtError *err)
+{
+  const char *md5;
+  gt_assert(rm);
+  gt_mutex_lock(rm->mutex);
+  md5 = region_mapping_get_md5_fingerprint(rm, seqid, range, offset, err);
+  gt_mutex_unlock(rm->mutex);
+  return md5;
+}
+
 void gt_region_mapping_delete(GtRegionMapping *rm)
 {
   if (!rm) return;
@@ -575,5 +630,6 @@ void gt_region_mapping_delete(GtRegionMapping *rm)
   gt_encseq_delete(rm->encseq);
   gt_seq_col_delete(rm->seq_col);
   gt_seqid2seqnum_mapping_delete(rm->seqid2seqnum_mapping);
+  gt_mutex_delete(rm->mutex);
   gt_free(rm);
 }
@@ -24,7 +24,9 @@
 #include "core/str_array_api.h"
 
 /* A <GtRegionMapping> objects maps sequence-regions to the corresponding
-   entries of sequence files. */
+   entries of sequence files. The sequence access functions can be called from
+   several threads at once, whereas referencing and deleting a
+   <GtRegionMapping> is not thread-safe. */
 typedef struct GtRegionMapping GtRegionMapping;
 
 /* Return a new <GtRegionMapping> object for the mapping file with the given
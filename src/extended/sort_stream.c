@@ -15,25 +15,427 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/array.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/dynalloc.h"
+#include "core/fa.h"
+#include "core/ma_api.h"
+#include "core/xansi_api.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
+#include "extended/genome_node_serializer.h"
 #include "extended/node_stream_api.h"
+#include "extended/priority_queue.h"
+#include "extended/sequence_node_api.h"
 #include "extended/sort_stream.h"
 
+/* estimated memory consumption of a genome node (without attributes) */
+#define SORT_STREAM_NODE_SIZE  256
+
+/* maximum number of runs merged at once, if more runs are stored on disk they
+   are merged in several passes */
+#define SORT_STREAM_MAX_FANIN  16
+
+typedef struct {
+  GtGenomeNode *gn;
+  GtUword seqnum; /* position in the input, keeps the merge stable */
+} GtSortStreamItem;
+
+/* A sorted run of nodes. Serializable nodes are stored in a temporary file,
+   which is only open while the run is written or merged. Nodes which cannot be
+   serialized are kept in memory. */
+typedef struct {
+  GtArray *items;    /* in memory, contains <GtSortStreamItem> */
+  GtUword idx;
+  FILE *fp;          /* on disk */
+  GtStr *filename;
+  char *buffer;
+  size_t allocated;
+  GtGenomeNodeSerializer *gns;
+  GtSortStreamItem head; /* the smallest unmerged node of the run */
+} GtSortStreamRun;
+
 struct GtSortStream {
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
   GtUword idx;
   GtArray *nodes;
   bool sorted;
+  GtUword memlimit,  /* 0 means unlimited */
+          memused,   /* estimated memory consumption of <nodes> */
+          seqnum;    /* number of nodes in earlier runs */
+  GtArray *runs;     /* external sorting, contains <GtSortStreamRun*> */
+  GtPriorityQueue *merge_queue; /* runs which have unmerged nodes */
+  GtGenomeNode *next_node; /* read ahead while joining region nodes */
 };
 
 #define gt_sort_stream_cast(GS)\
         gt_node_stream_cast(gt_sort_stream_class(), GS);
 
+static GtUword estimate_node_size(GtGenomeNode *gn)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn;
+  GtSequenceNode *sn;
+  GtUword size = SORT_STREAM_NODE_SIZE;
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    GtStrArray *attributes;
+    GtUword i;
+    fni = gt_feature_node_iterator_new(fn);
+    do {
+      attributes = gt_feature_node_get_attribute_list(fn);
+      for (i = 0; i < gt_str_array_size(attributes); i++) {
+        const char *tag = gt_str_array_get(attributes, i);
+        size += strlen(tag) + strlen(gt_feature_node_get_attribute(fn, tag));
+      }
+      gt_str_array_delete(attributes);
+      size += SORT_STREAM_NODE_SIZE;
+    } while ((fn = gt_feature_node_iterator_next(fni)));
+    gt_feature_node_iterator_delete(fni);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn)))
+    size += gt_sequence_node_get_sequence_length(sn);
+  return size;
+}
+
+static int sort_stream_item_cmp(const void *a, const void *b)
+{
+  const GtSortStreamItem *item_a = a, *item_b = b;
+  int rval = gt_genome_node_cmp(item_a->gn, item_b->gn);
+  if (!rval && item_a->seqnum != item_b->seqnum)
+    rval = item_a->seqnum < item_b->seqnum ? -1 : 1;
+  return rval;
+}
+
+static int sort_stream_run_cmp(const void *a, const void *b)
+{
+  const GtSortStreamRun *run_a = a, *run_b = b;
+  return sort_stream_item_cmp(&run_a->head, &run_b->head);
+}
+
+static GtSortStreamRun* sort_stream_file_run_new(void)
+{
+  GtSortStreamRun *run = gt_calloc(1, sizeof *run);
+  run->filename = gt_str_new();
+  run->fp = gt_xtmpfp(run->filename);
+  run->gns = gt_genome_node_serializer_new();
+  return run;
+}
+
+static void sort_stream_file_run_write(GtSortStreamRun *run,
+                                       GtSortStreamItem *item, GtStr *buffer)
+{
+  GtUword length;
+  gt_str_reset(buffer);
+  gt_genome_node_serializer_write(run->gns, item->gn, buffer);
+  length = gt_str_length(buffer);
+  gt_xfwrite(&length, sizeof length, 1, run->fp);
+  gt_xfwrite(&item->seqnum, sizeof item->seqnum, 1, run->fp);
+  gt_xfwrite(gt_str_get(buffer), sizeof (char), length, run->fp);
+  gt_genome_node_delete(item->gn);
+  item->gn = NULL;
+}
+
+/* close the file of <run>, it is reopened for merging */
+static void sort_stream_file_run_close(GtSortStreamRun *run)
+{
+  gt_fa_xfclose(run->fp);
+  run->fp = NULL;
+  gt_genome_node_serializer_delete(run->gns);
+  run->gns = NULL;
+}
+
+/* open the file of <run> for merging, the run is read with a new serializer */
+static int sort_stream_file_run_open(GtSortStreamRun *run, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(run->filename && !run->fp);
+  if (!(run->fp = gt_fa_fopen(gt_str_get(run->filename), "rb", err)))
+    return -1;
+  run->gns = gt_genome_node_serializer_new();
+  return 0;
+}
+
+static void sort_stream_run_delete(GtSortStreamRun *run)
+{
+  GtUword i;
+  if (!run) return;
+  gt_genome_node_delete(run->head.gn);
+  if (run->items) {
+    for (i = run->idx; i < gt_array_size(run->items); i++) {
+      gt_genome_node_delete(((GtSortStreamItem*)
+                             gt_array_get(run->items, i))->gn);
+    }
+    gt_array_delete(run->items);
+  }
+  if (run->filename) {
+    gt_fa_xfclose(run->fp);
+    gt_xremove(gt_str_get(run->filename));
+  }
+  gt_str_delete(run->filename);
+  gt_free(run->buffer);
+  gt_genome_node_serializer_delete(run->gns);
+  gt_free(run);
+}
+
+/* Sort the collected nodes and turn them into new runs: one on disk for the
+   serializable nodes and one in memory for the others. The <last_run> is kept
+   in memory completely. */
+static void sort_stream_add_run(GtSortStream *sort_stream, bool last_run)
+{
+  GtSortStreamRun *file_run = NULL, *memory_run = NULL;
+  GtSortStreamItem *items;
+  GtStr *buffer = NULL;
+  GtUword i, num_of_nodes = gt_array_size(sort_stream->nodes);
+
+  items = gt_malloc(num_of_nodes * sizeof *items);
+  for (i = 0; i < num_of_nodes; i++) {
+    items[i].gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes, i);
+    items[i].seqnum = sort_stream->seqnum++;
+  }
+  qsort(items, num_of_nodes, sizeof *items, sort_stream_item_cmp);
+  for (i = 0; i < num_of_nodes; i++) {
+    if (!last_run && gt_genome_node_serializer_is_serializable(items[i].gn)) {
+      if (!file_run) {
+        file_run = sort_stream_file_run_new();
+        buffer = gt_str_new();
+      }
+      sort_stream_file_run_write(file_run, items + i, buffer);
+    }
+    else {
+      if (!memory_run) {
+        memory_run = gt_calloc(1, sizeof *memory_run);
+        memory_run->items = gt_array_new(sizeof (GtSortStreamItem));
+      }
+      gt_array_add(memory_run->items, items[i]);
+    }
+  }
+  if (file_run) {
+    sort_stream_file_run_close(file_run);
+    gt_array_add(sort_stream->runs, file_run);
+  }
+  if (memory_run)
+    gt_array_add(sort_stream->runs, memory_run);
+  gt_str_delete(buffer);
+  gt_free(items);
+  gt_array_reset(sort_stream->nodes);
+  sort_stream->memused = 0;
+}
+
+/* make the next node of <run> its head (or NULL) */
+static int sort_stream_run_advance(GtSortStreamRun *run, GtError *err)
+{
+  GtUword length;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(!run->head.gn);
+  if (run->items) {
+    if (run->idx < gt_array_size(run->items))
+      run->head = *(GtSortStreamItem*) gt_array_get(run->items, run->idx++);
+    return 0;
+  }
+  gt_assert(run->fp);
+  if (fread(&length, sizeof length, 1, run->fp) != 1) {
+    if (ferror(run->fp)) {
+      gt_error_set(err, "could not read temporary file \"%s\"",
+                   gt_str_get(run->filename));
+      had_err = -1;
+    }
+    return had_err; /* end of run */
+  }
+  gt_xfread(&run->head.seqnum, sizeof run->head.seqnum, 1, run->fp);
+  run->buffer = gt_dynalloc(run->buffer, &run->allocated,
+                            (length + 1) * sizeof (char));
+  if (length)
+    gt_xfread(run->buffer, sizeof (char), length, run->fp);
+  had_err = gt_genome_node_serializer_read(run->gns, &run->head.gn,
+                                           run->buffer, length, err);
+  return had_err;
+}
+
+/* Open the files of up to <max_runs> runs on disk, in the order of the runs,
+   and return their number. Stops at the first file which cannot be opened,
+   <err> is set accordingly. */
+static GtUword sort_stream_open_file_runs(GtSortStream *sort_stream,
+                                          GtUword max_runs, GtError *err)
+{
+  GtSortStreamRun *run;
+  GtUword i, num_of_open_runs = 0;
+  gt_error_check(err);
+  for (i = 0; num_of_open_runs < max_runs &&
+              i < gt_array_size(sort_stream->runs); i++) {
+    run = *(GtSortStreamRun**) gt_array_get(sort_stream->runs, i);
+    if (run->filename) {
+      if (sort_stream_file_run_open(run, err))
+        break;
+      num_of_open_runs++;
+    }
+  }
+  return num_of_open_runs;
+}
+
+static void sort_stream_close_file_runs(GtSortStream *sort_stream)
+{
+  GtSortStreamRun *run;
+  GtUword i;
+  for (i = 0; i < gt_array_size(sort_stream->runs); i++) {
+    run = *(GtSortStreamRun**) gt_array_get(sort_stream->runs, i);
+    if (run->fp)
+      sort_stream_file_run_close(run);
+  }
+}
+
+/* Merge the first (at most) <fanin> runs on disk into a new run on disk, which
+   is appended to the runs. Fewer runs are merged if not all of their files can
+   be opened. */
+static int sort_stream_merge_pass(GtSortStream *sort_stream, GtUword fanin,
+                                  GtError *err)
+{
+  GtSortStreamRun *run, *merged_run;
+  GtPriorityQueue *queue;
+  GtArray *runs;
+  GtStr *buffer;
+  GtUword i, num_of_open_runs;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* create the output first, its file descriptor is needed anyway */
+  merged_run = sort_stream_file_run_new();
+  num_of_open_runs = sort_stream_open_file_runs(sort_stream, fanin, err);
+  if (num_of_open_runs < fanin) {
+    if (num_of_open_runs < 2)
+      had_err = -1;
+    else
+      gt_error_unset(err);
+  }
+  queue = gt_priority_queue_new(sort_stream_run_cmp, num_of_open_runs);
+  for (i = 0; !had_err && i < gt_array_size(sort_stream->runs); i++) {
+    run = *(GtSortStreamRun**) gt_array_get(sort_stream->runs, i);
+    if (run->fp && !(had_err = sort_stream_run_advance(run, err)) &&
+        run->head.gn) {
+      gt_priority_queue_add(queue, run);
+    }
+  }
+  buffer = gt_str_new();
+  while (!had_err && !gt_priority_queue_is_empty(queue)) {
+    run = gt_priority_queue_extract_min(queue);
+    sort_stream_file_run_write(merged_run, &run->head, buffer);
+    if (!(had_err = sort_stream_run_advance(run, err)) && run->head.gn)
+      gt_priority_queue_add(queue, run);
+  }
+  gt_str_delete(buffer);
+  gt_priority_queue_delete(queue);
+  sort_stream_file_run_close(merged_run);
+  if (had_err) {
+    sort_stream_close_file_runs(sort_stream);
+    sort_stream_run_delete(merged_run);
+    return had_err;
+  }
+
+  /* replace the merged runs, the sequence numbers keep the merge stable */
+  runs = gt_array_new(sizeof (GtSortStreamRun*));
+  for (i = 0; i < gt_array_size(sort_stream->runs); i++) {
+    run = *(GtSortStreamRun**) gt_array_get(sort_stream->runs, i);
+    if (run->fp)
+      sort_stream_run_delete(run);
+    else
+      gt_array_add(runs, run);
+  }
+  gt_array_add(runs, merged_run);
+  gt_array_delete(sort_stream->runs);
+  sort_stream->runs = runs;
+  return 0;
+}
+
+/* Reduce the runs on disk in merge passes until all of them can be merged at
+   once and fill the merge queue. */
+static int sort_stream_prepare_merge(GtSortStream *sort_stream, GtError *err)
+{
+  GtSortStreamRun *run;
+  GtUword i, num_of_file_runs, num_of_open_runs;
+  int had_err = 0;
+  gt_error_check(err);
+
+  for (;;) {
+    num_of_file_runs = 0;
+    for (i = 0; i < gt_array_size(sort_stream->runs); i++) {
+      run = *(GtSortStreamRun**) gt_array_get(sort_stream->runs, i);
+      if (run->filename)
+        num_of_file_runs++;
+    }
+    if (num_of_file_runs > SORT_STREAM_MAX_FANIN)
+      had_err = sort_stream_merge_pass(sort_stream, SORT_STREAM_MAX_FANIN, err);
+    else {
+      num_of_open_runs = sort_stream_open_file_runs(sort_stream,
+                                                    num_of_file_runs, err);
+      if (num_of_open_runs == num_of_file_runs)
+        break;
+      /* too few file descriptors, merge fewer runs (and keep one descriptor
+         for the output of the pass) */
+      sort_stream_close_file_runs(sort_stream);
+      if (num_of_open_runs < 3)
+        had_err = -1;
+      else {
+        gt_error_unset(err);
+        had_err = sort_stream_merge_pass(sort_stream, num_of_open_runs - 1,
+                                         err);
+      }
+    }
+    if (had_err)
+      return had_err;
+  }
+
+  sort_stream->merge_queue = gt_priority_queue_new(sort_stream_run_cmp,
+                                              gt_array_size(sort_stream->runs));
+  for (i = 0; !had_err && i < gt_array_size(sort_stream->runs); i++) {
+    run = *(GtSortStreamRun**) gt_array_get(sort_stream->runs, i);
+    if (!(had_err = sort_stream_run_advance(run, err)) && run->head.gn)
+      gt_priority_queue_add(sort_stream->merge_queue, run);
+  }
+  return had_err;
+}
+
+/* Take the next node in sorted order. */
+static int sort_stream_take(GtSortStream *sort_stream, GtGenomeNode **gn,
+                            GtError *err)
+{
+  GtSortStreamRun *run;
+  int had_err = 0;
+  gt_error_check(err);
+  *gn = NULL;
+  if (!sort_stream->merge_queue) {
+    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+      *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
+                                           sort_stream->idx);
+      sort_stream->idx++;
+    }
+    return 0;
+  }
+  if (gt_priority_queue_is_empty(sort_stream->merge_queue))
+    return 0;
+  run = gt_priority_queue_extract_min(sort_stream->merge_queue);
+  *gn = run->head.gn;
+  run->head.gn = NULL;
+  if (!(had_err = sort_stream_run_advance(run, err)) && run->head.gn)
+    gt_priority_queue_add(sort_stream->merge_queue, run);
+  return had_err;
+}
+
+static int sort_stream_take_next(GtSortStream *sort_stream, GtGenomeNode **gn,
+                                 GtError *err)
+{
+  if (sort_stream->next_node) {
+    *gn = sort_stream->next_node;
+    sort_stream->next_node = NULL;
+    return 0;
+  }
+  return sort_stream_take(sort_stream, gn, err);
+}
+
 static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                GtError *err)
 {
@@ -49,47 +451,63 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                            err)) && node) {
       if ((eofn = gt_eof_node_try_cast(node)))
         gt_genome_node_delete(node); /* get rid of EOF nodes */
-      else
+      else {
         gt_array_add(sort_stream->nodes, node);
+        if (sort_stream->memlimit) {
+          sort_stream->memused += estimate_node_size(node);
+          if (sort_stream->memused > sort_stream->memlimit)
+            sort_stream_add_run(sort_stream, false);
+        }
+      }
     }
     if (!had_err) {
-      gt_genome_nodes_sort_stable(sort_stream->nodes);
-      sort_stream->sorted = true;
+      if (gt_array_size(sort_stream->runs)) {
+        /* external sorting, merge the runs */
+        if (gt_array_size(sort_stream->nodes))
+          sort_stream_add_run(sort_stream, true);
+        had_err = sort_stream_prepare_merge(sort_stream, err);
+      }
+      else
+        gt_genome_nodes_sort_stable(sort_stream->nodes);
+      if (!had_err)
+        sort_stream->sorted = true;
     }
   }
 
   if (!had_err) {
     gt_assert(sort_stream->sorted);
-    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-      *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                           sort_stream->idx);
-      sort_stream->idx++;
-      /* join region nodes with the same sequence ID */
-      if (gt_region_node_try_cast(*gn)) {
-        GtRange range_a, range_b;
-        while (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-          node = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                                sort_stream->idx);
-          if (!gt_region_node_try_cast(node) ||
-              gt_str_cmp(gt_genome_node_get_seqid(*gn),
-                         gt_genome_node_get_seqid(node))) {
-            /* the next node is not a region node with the same ID */
-            break;
-          }
-          range_a = gt_genome_node_get_range(*gn);
-          range_b = gt_genome_node_get_range(node);
-          range_a = gt_range_join(&range_a, &range_b);
-          gt_genome_node_set_range(*gn, &range_a);
-          gt_genome_node_delete(node);
-          sort_stream->idx++;
+    had_err = sort_stream_take_next(sort_stream, gn, err);
+  }
+  if (!had_err && *gn) {
+    /* join region nodes with the same sequence ID */
+    if (gt_region_node_try_cast(*gn)) {
+      GtRange range_a, range_b;
+      while (!(had_err = sort_stream_take(sort_stream, &node, err)) && node) {
+        if (!gt_region_node_try_cast(node) ||
+            gt_str_cmp(gt_genome_node_get_seqid(*gn),
+                       gt_genome_node_get_seqid(node))) {
+          /* the next node is not a region node with the same ID */
+          sort_stream->next_node = node;
+          break;
         }
+        range_a = gt_genome_node_get_range(*gn);
+        range_b = gt_genome_node_get_range(node);
+        range_a = gt_range_join(&range_a, &range_b);
+        gt_genome_node_set_range(*gn, &range_a);
+        gt_genome_node_delete(node);
+      }
+      if (had_err) {
+        gt_genome_node_delete(*gn);
+        *gn = NULL;
       }
-      return 0;
     }
+    if (!had_err)
+      return 0;
   }
 
   if (!had_err) {
     gt_array_reset(sort_stream->nodes);
+    sort_stream->idx = 0;
     *gn = NULL;
   }
 
@@ -105,6 +523,13 @@ static void gt_sort_stream_free(GtNodeStream *ns)
                           gt_array_get(sort_stream->nodes, i));
   }
   gt_array_delete(sort_stream->nodes);
+  for (i = 0; i < gt_array_size(sort_stream->runs); i++) {
+    sort_stream_run_delete(*(GtSortStreamRun**)
+                           gt_array_get(sort_stream->runs, i));
+  }
+  gt_array_delete(sort_stream->runs);
+  gt_priority_queue_delete(sort_stream->merge_queue);
+  gt_genome_node_delete(sort_stream->next_node);
   gt_node_stream_delete(sort_stream->in_stream);
 }
 
@@ -130,5 +555,18 @@ GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream)
   sort_stream->sorted = false;
   sort_stream->idx = 0;
   sort_stream->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->memlimit = 0;
+  sort_stream->memused = 0;
+  sort_stream->seqnum = 0;
+  sort_stream->runs = gt_array_new(sizeof (GtSortStreamRun*));
+  sort_stream->merge_queue = NULL;
+  sort_stream->next_node = NULL;
   return ns;
 }
+
+void gt_sort_stream_set_memlimit(GtNodeStream *ns, GtUword memlimit)
+{
+  GtSortStream *sort_stream = gt_sort_stream_cast(ns);
+  gt_assert(!sort_stream->sorted);
+  sort_stream->memlimit = memlimit;
+}
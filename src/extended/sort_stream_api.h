@@ -27,5 +27,13 @@ typedef struct GtSortStream GtSortStream;
 /* Create a <GtSortStream*> which sorts the genome nodes it retrieves from
    <in_stream> and returns them unmodified, but in sorted order. */
 GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream);
+/* Limit the (estimated) amount of memory used by <sort_stream> to <memlimit>
+   bytes. If more memory would be required, sorted runs of genome nodes are
+   stored in temporary files and merged afterwards. Genome nodes which cannot be
+   stored in a file (e.g., nodes with user data or of custom classes) are kept
+   in memory and are not subject to the limit. A <memlimit> of 0 means no limit
+   (the default). Must be called before the first node is retrieved. */
+void          gt_sort_stream_set_memlimit(GtNodeStream *sort_stream,
+                                          GtUword memlimit);
 
 #endif
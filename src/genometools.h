@@ -55,6 +55,7 @@ extern "C" {
 #include "core/grep_api.h"
 #include "core/hashmap_api.h"
 #include "core/init_api.h"
+#include "core/interval_index_api.h"
 #include "core/interval_tree_api.h"
 #include "core/log_api.h"
 #include "core/logger_api.h"
@@ -222,6 +222,7 @@ void            gth_sa_set_highest_cov(GthSA*, bool genomic);
 GtUword   gth_sa_cumlen_scored_exons(const GthSA*);
 void            gth_sa_set_cumlen_scored_exons(GthSA*, GtUword);
 GtUword   gth_sa_call_number(const GthSA*);
+void            gth_sa_set_call_number(GthSA*, GtUword);
 const char*     gth_sa_gff3_target_attribute(GthSA*, bool md5ids);
 void            gth_sa_determine_cutoffs(GthSA*, GthCutoffmode leadcutoffsmode,
                                          GthCutoffmode termcutoffsmode,
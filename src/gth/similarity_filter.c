@@ -15,6 +15,9 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/ma_api.h"
+#include "core/multithread_api.h"
+#include "core/str_array.h"
 #include "core/trans_table.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -37,10 +40,30 @@ typedef struct {
   GtUword call_number;
   bool significant_match_found,
        max_call_number_reached,
-       stop_amino_acid_warning;
+       stop_amino_acid_warning,
+       defer_save;            /* if true, spliced alignments are not inserted
+                                 into the collection but stored in
+                                 <deferred_sa> (used for parallel DP) */
+  GthSA *deferred_sa;
+  GtMutex *input_mutex;       /* protects <GthInput> caches in parallel mode */
+  GtStrArray *deferred_messages; /* verbose output of the parallel DP, shown
+                                    in chain order by merge_dp_jobs() */
 } GthMatchInfo;
 
+/* Shows <message> with <showverbose>. In parallel mode the message is saved in
+   <deferred_messages> instead, because only the merging thread writes the
+   verbose output. */
+static void show_verbose(GthShowVerbose showverbose,
+                         GtStrArray *deferred_messages, const char *message)
+{
+  if (deferred_messages)
+    gt_str_array_add_cstr(deferred_messages, message);
+  else
+    showverbose(message);
+}
+
 static void show_matrix_calculation_status(GthShowVerbose showverbose,
+                                           GtStrArray *deferred_messages,
                                            bool gen_strand_forward,
                                            bool ref_strand_forward,
                                            bool introncutout,
@@ -88,14 +111,14 @@ static void show_matrix_calculation_status(GthShowVerbose showverbose,
   }
   /* buf[SHOW_MATRIX_CALCULATION_STATUS_BUF_SIZE] is large enough */
   gt_assert(rval <  SHOW_MATRIX_CALCULATION_STATUS_BUF_SIZE);
-  showverbose(buf);
+  show_verbose(showverbose, deferred_messages, buf);
 
   if (verboseseqs) {
     rval = snprintf(buf, SHOW_MATRIX_CALCULATION_STATUS_BUF_SIZE,
                     "genomicid=%s, referenceid=%s", gen_id, ref_id);
     /* buf[SHOW_MATRIX_CALCULATION_STATUS_BUF_SIZE] is large enough */
     gt_assert(rval < SHOW_MATRIX_CALCULATION_STATUS_BUF_SIZE);
-    showverbose(buf);
+    show_verbose(showverbose, deferred_messages, buf);
   }
 }
 
@@ -128,7 +151,8 @@ static int callsahmt(bool call_dna_dp,
                      GthDNACompletePathMatrixJT dna_complete_path_matrix_jt,
                      GthProteinCompletePathMatrixJT
                      protein_complete_path_matrix_jt,
-                     GthOutput *out)
+                     GthOutput *out,
+                     GtStrArray *deferred_messages)
 {
   int rval;
   GthChain *actual_chain, *contracted_chain, *used_chain;
@@ -166,7 +190,8 @@ static int callsahmt(bool call_dna_dp,
       gth_chain_contract(contracted_chain, actual_chain);
 
     if (out->showverbose) {
-      show_matrix_calculation_status(out->showverbose, forward,
+      show_matrix_calculation_status(out->showverbose, deferred_messages,
+                                     forward,
                                      gth_sa_ref_strand_forward(sa),
                                      useintroncutout, chainctr, num_of_chains,
                                      icdelta, gen_file_num,
@@ -290,8 +315,9 @@ static int callsahmt(bool call_dna_dp,
            DP returned with the matrix allocation error, set useintroncutout,
            increase counter, and continue */
         if (out->showverbose) {
-          out->showverbose("matrix allocation failed, use intron cutout "
-                           "technique");
+          show_verbose(out->showverbose, deferred_messages,
+                       "matrix allocation failed, use intron cutout "
+                       "technique");
         }
         gth_stat_increment_numofautointroncutoutcalls(stat);
         useintroncutout = true;
@@ -332,6 +358,12 @@ static void save_sa(GthSACollection *sa_collection, GthSA *sa,
                     GthSAFilter *sa_filter, GthMatchInfo *match_info,
                     GthStat *stat)
 {
+  if (match_info->defer_save) {
+    /* the insertion is done later in chain order, see merge_dp_jobs() */
+    gt_assert(!match_info->deferred_sa);
+    match_info->deferred_sa = sa;
+    return;
+  }
   if (!gth_sa_collection_insert_sa(sa_collection, sa, sa_filter, stat)) {
     /* unsuccessful insertion; discard sa */
     gth_sa_delete(sa);
@@ -395,7 +427,8 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
                      call_info->splice_site_model, call_info->dp_options_core,
                      call_info->dp_options_est, call_info->dp_options_postpro,
                      dna_complete_path_matrix_jt,
-                     protein_complete_path_matrix_jt, call_info->out);
+                     protein_complete_path_matrix_jt, call_info->out,
+                     match_info->deferred_messages);
     if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                      /* ^ this error is treated below */
       return rval;
@@ -432,11 +465,15 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
       }
       else {
         /* allocating space for second alignment */
+        if (match_info->defer_save)
+          gt_mutex_lock(match_info->input_mutex);
         saB = gth_sa_new_and_set(!directmatches, false, input,
                                  chain->gen_file_num, chain->gen_seq_num,
                                  chain->ref_file_num, chain->ref_seq_num,
                                  match_info->call_number, gen_total_length,
                                  gen_offset, ref_total_length);
+        if (match_info->defer_save)
+          gt_mutex_unlock(match_info->input_mutex);
       }
 
       /* setting gs2outdirectmatches (for compatibility) */
@@ -454,7 +491,8 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
                        call_info->splice_site_model, call_info->dp_options_core,
                        call_info->dp_options_est, call_info->dp_options_postpro,
                        dna_complete_path_matrix_jt,
-                       protein_complete_path_matrix_jt, call_info->out);
+                       protein_complete_path_matrix_jt, call_info->out,
+                       match_info->deferred_messages);
       if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                        /* ^ this error is treated below */
         return rval;
@@ -546,7 +584,8 @@ static int call_protein_DP(bool directmatches,
                    call_info->proteinexonpenal, call_info->splice_site_model,
                    call_info->dp_options_core, call_info->dp_options_est,
                    call_info->dp_options_postpro, dna_complete_path_matrix_jt,
-                   protein_complete_path_matrix_jt, call_info->out);
+                   protein_complete_path_matrix_jt, call_info->out,
+                   match_info->deferred_messages);
   if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                    /* ^ this error is treated below */
     return rval;
@@ -626,6 +665,284 @@ static GthChainCollection* match_and_chain(GthCallInfo *call_info,
   return chain_collection;
 }
 
+/* the DP computation for a single chain */
+typedef struct {
+  GthChain *chain;
+  GthSA *saA;
+  GtRange gen_seq_bounds,
+          gen_seq_bounds_rc,
+          range;
+  GtUword chainctr,
+          gen_total_length,
+          gen_offset,
+          ref_total_length;
+  const unsigned char *ref_seq_tran,
+                      *ref_seq_orig,
+                      *ref_seq_tran_rc,
+                      *ref_seq_orig_rc;
+  GthMatchInfo match_info; /* job local, only used in parallel mode */
+  int rval;
+} GthDPJob;
+
+/* the data shared by all DP computations of one chain collection */
+typedef struct {
+  GthSACollection *sa_collection;
+  GthCallInfo *call_info;
+  GthInput *input;
+  GthStat *stat;
+  GtUword gen_file_num,
+          ref_file_num,
+          num_of_chains;
+  bool directmatches,
+       refseqisdna;
+  GthDNACompletePathMatrixJT dna_complete_path_matrix_jt;
+  GthProteinCompletePathMatrixJT protein_complete_path_matrix_jt;
+  /* used in parallel mode */
+  GthDPJob *jobs;
+  GtUword num_of_jobs,
+          next_job;
+  GtMutex *mutex;
+} GthDPInfo;
+
+static void prepare_dp_job(GthDPJob *job, GthChain *chain, GtUword chainctr,
+                           GthDPInfo *info, GthMatchInfo *match_info)
+{
+  GthInput *input = info->input;
+
+  job->chain = chain;
+  job->chainctr = chainctr;
+  job->rval = 0;
+  job->ref_seq_tran_rc = NULL;
+  job->ref_seq_orig_rc = NULL;
+  job->gen_offset = GT_UNDEF_UWORD;
+
+  /* compute considered genomic regions if not set by -frompos */
+  if (!gth_input_use_substring_spec(input)) {
+    job->gen_seq_bounds = gth_input_get_genomic_range(input,
+                                                      chain->gen_file_num,
+                                                      chain->gen_seq_num);
+    job->gen_total_length  = gt_range_length(&job->gen_seq_bounds);
+    job->gen_offset        = job->gen_seq_bounds.start;
+    job->gen_seq_bounds_rc = job->gen_seq_bounds;
+  }
+  else {
+    /* genomic multiseq contains exactly one sequence */
+    gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
+    job->gen_total_length =
+      gth_input_genomic_file_total_length(input, chain->gen_file_num);
+    job->gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
+    job->gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
+    job->gen_offset              = 0;
+    job->gen_seq_bounds_rc.start = job->gen_total_length - 1
+                                   - job->gen_seq_bounds.end;
+    job->gen_seq_bounds_rc.end   = job->gen_total_length - 1
+                                   - job->gen_seq_bounds.start;
+  }
+
+  /* "retrieving" the reference sequence */
+  job->range = gth_input_get_reference_range(input, chain->ref_file_num,
+                                             chain->ref_seq_num);
+  job->ref_seq_tran = gth_input_current_ref_seq_tran(input) + job->range.start;
+  job->ref_seq_orig = gth_input_current_ref_seq_orig(input) + job->range.start;
+  if (info->refseqisdna) {
+    job->ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input)
+                           + job->range.start;
+    job->ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input)
+                           + job->range.start;
+  }
+  job->ref_total_length = job->range.end - job->range.start + 1;
+
+  /* check if protein sequences have a stop amino acid */
+  if (!info->refseqisdna && !match_info->stop_amino_acid_warning &&
+     job->ref_seq_orig[job->ref_total_length - 1] != GT_STOP_AMINO) {
+    GtStr *ref_id = gt_str_new();
+    gth_input_save_ref_id(input, ref_id, chain->ref_file_num,
+                          chain->ref_seq_num);
+    gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
+               "with a stop amino acid ('%c'). If it is not a protein "
+               "fragment you should add a stop amino acid to improve the "
+               "prediction. For example with `gt seqtransform "
+               "-addstopaminos` (see http://genometools.org for details).",
+               gt_str_get(ref_id), chain->ref_seq_num,
+               gth_input_get_reference_filename(input, chain->ref_file_num),
+               GT_STOP_AMINO);
+    match_info->stop_amino_acid_warning = true;
+    gt_str_delete(ref_id);
+  }
+
+  /* allocating space for alignment */
+  job->saA = gth_sa_new_and_set(info->directmatches, true, input,
+                                chain->gen_file_num, chain->gen_seq_num,
+                                chain->ref_file_num, chain->ref_seq_num,
+                                match_info->call_number, job->gen_total_length,
+                                job->gen_offset, job->ref_total_length);
+
+  /* extend the DP borders to the left and to the right */
+  gth_chain_extend_borders(chain, &job->gen_seq_bounds,
+                           &job->gen_seq_bounds_rc, job->gen_total_length,
+                           job->gen_offset);
+
+  /* From here on the dp positions always refer to the forward strand of the
+     genomic DNA. */
+}
+
+static int run_dp_job(GthDPJob *job, GthDPInfo *info, GthStat *stat,
+                      GthMatchInfo *match_info)
+{
+  int rval;
+
+  /* call the Dynamic Programming */
+  if (info->refseqisdna) {
+    rval = call_dna_DP(info->directmatches, info->call_info, info->input, stat,
+                       info->sa_collection, job->saA, info->gen_file_num,
+                       info->ref_file_num, job->gen_total_length,
+                       job->gen_offset, &job->gen_seq_bounds,
+                       &job->gen_seq_bounds_rc, job->ref_total_length,
+                       job->range.start, job->chainctr, info->num_of_chains,
+                       match_info, job->ref_seq_tran, job->ref_seq_orig,
+                       job->ref_seq_tran_rc, job->ref_seq_orig_rc, job->chain,
+                       info->dna_complete_path_matrix_jt,
+                       info->protein_complete_path_matrix_jt);
+  }
+  else {
+    rval = call_protein_DP(info->directmatches, info->call_info, info->input,
+                           stat, info->sa_collection, job->saA,
+                           info->gen_file_num, info->ref_file_num,
+                           job->gen_total_length, job->gen_offset,
+                           &job->gen_seq_bounds, &job->gen_seq_bounds_rc,
+                           job->ref_total_length, job->range.start,
+                           job->chainctr, info->num_of_chains, match_info,
+                           job->ref_seq_tran, job->ref_seq_orig, job->chain,
+                           info->dna_complete_path_matrix_jt,
+                           info->protein_complete_path_matrix_jt);
+  }
+  /* check return value */
+  if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
+    /* statistics bookkeeping */
+    gth_stat_increment_numoffailedDPparameterallocations(stat);
+    gth_stat_increment_numofundeterminedSAs(stat);
+    /* free space */
+    gth_sa_delete(job->saA);
+    match_info->call_number--;
+    return 0; /* continue with the next DP range */
+  }
+  else if (rval)
+    return -1;
+  return 0;
+}
+
+static void* dp_job_thread(void *data)
+{
+  GthDPInfo *info = data;
+  GthStat *stat;
+  GthDPJob *job;
+
+  gt_assert(info);
+  stat = gth_stat_new();
+
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    if (info->next_job == info->num_of_jobs) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    job = info->jobs + info->next_job++;
+    gt_mutex_unlock(info->mutex);
+    job->rval = run_dp_job(job, info, stat, &job->match_info);
+  }
+
+  /* add the thread local statistics to the global ones */
+  gt_mutex_lock(info->mutex);
+  gth_stat_add_dp_counters(info->stat, stat);
+  gt_mutex_unlock(info->mutex);
+  gth_stat_delete(stat);
+
+  return NULL;
+}
+
+/* Insert the spliced alignments computed in parallel into the collection and
+   show the deferred verbose output. This is done in chain order and the call
+   numbers are assigned exactly as in the serial computation, so that the result
+   does not depend on the number of threads. */
+static int merge_dp_jobs(GthDPInfo *info, GthMatchInfo *match_info)
+{
+  GthDPJob *job;
+  GtStrArray *messages;
+  GtUword i, j;
+  int had_err = 0;
+
+  for (i = 0; i < info->num_of_jobs; i++) {
+    job = info->jobs + i;
+    if ((messages = job->match_info.deferred_messages)) {
+      for (j = 0; j < gt_str_array_size(messages); j++)
+        info->call_info->out->showverbose(gt_str_array_get(messages, j));
+      gt_str_array_delete(messages);
+    }
+    if (had_err || job->rval) {
+      had_err = -1;
+      if (job->match_info.deferred_sa)
+        gth_sa_delete(job->match_info.deferred_sa);
+      continue;
+    }
+    match_info->call_number++;
+    if (job->match_info.significant_match_found)
+      match_info->significant_match_found = true;
+    if (job->match_info.deferred_sa) {
+      gth_sa_set_call_number(job->match_info.deferred_sa,
+                             match_info->call_number);
+      save_sa(info->sa_collection, job->match_info.deferred_sa,
+              info->call_info->sa_filter, match_info, info->stat);
+    }
+    else if (!job->match_info.call_number) {
+      /* the computation for this chain was unsuccessful */
+      match_info->call_number--;
+    }
+  }
+
+  return had_err;
+}
+
+static int calc_spliced_alignments_parallel(GthDPInfo *info,
+                                            GthChainCollection
+                                            *chain_collection,
+                                            GthMatchInfo *match_info)
+{
+  GthDPJob *job;
+  GtUword chainctr;
+  GtError *err;
+  int had_err;
+
+  /* the preparation accesses the input caches and is done sequentially */
+  info->num_of_jobs = gth_chain_collection_size(chain_collection);
+  info->next_job = 0;
+  info->jobs = gt_malloc(sizeof *info->jobs * info->num_of_jobs);
+  info->mutex = gt_mutex_new();
+  for (chainctr = 0; chainctr < info->num_of_jobs; chainctr++) {
+    job = info->jobs + chainctr;
+    prepare_dp_job(job, gth_chain_collection_get(chain_collection, chainctr),
+                   chainctr, info, match_info);
+    job->match_info = *match_info;
+    job->match_info.call_number = 1;
+    job->match_info.significant_match_found = false;
+    job->match_info.defer_save = true;
+    job->match_info.deferred_sa = NULL;
+    job->match_info.input_mutex = info->mutex;
+    job->match_info.deferred_messages = info->call_info->out->showverbose
+                                        ? gt_str_array_new() : NULL;
+  }
+
+  err = gt_error_new();
+  had_err = gt_multithread(dp_job_thread, info, err);
+  gt_assert(!had_err); /* the threads do not produce errors */
+  gt_error_delete(err);
+
+  had_err = merge_dp_jobs(info, match_info);
+
+  gt_mutex_delete(info->mutex);
+  gt_free(info->jobs);
+  return had_err;
+}
+
 static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthChainCollection *chain_collection,
                                    GthCallInfo *call_info,
@@ -640,148 +957,66 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthProteinCompletePathMatrixJT
                                    protein_complete_path_matrix_jt)
 {
-  const unsigned char *ref_seq_tran, *ref_seq_orig, *ref_seq_tran_rc = NULL,
-                      *ref_seq_orig_rc = NULL;
-  GtUword chainctr, gen_offset = GT_UNDEF_UWORD, gen_total_length,
-                ref_total_length;
+  GtUword chainctr;
   GtFile *outfp = call_info->out->outfp;
-  GtRange gen_seq_bounds, gen_seq_bounds_rc;
-  bool refseqisdna;
-  GthChain *chain;
-  GtRange range;
-  GthSA *saA;
-  int rval;
+  GthDPInfo info;
+  GthDPJob job;
 
   gt_assert(sa_collection && chain_collection);
 
-  refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
-
-  for (chainctr = 0;
-       chainctr < gth_chain_collection_size(chain_collection);
-       chainctr++) {
-       chain = gth_chain_collection_get(chain_collection, chainctr);
-    if (++match_info->call_number > call_info->firstalshown &&
-        call_info->firstalshown > 0) {
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
-        gt_file_xfputc('\n', outfp);
-      else if (call_info->out->xmlout)
-        gt_file_xprintf(outfp, "<!--\n");
-
-      if (!call_info->out->gff3out) {
-        gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
-                        refseqisdna ? "EST" : "protein",
-                        call_info->firstalshown);
-        gt_file_xprintf(outfp, "Only the first %u matches will be "
-                           "displayed.\n", call_info->firstalshown);
-      }
-
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
-        gt_file_xfputc('\n', outfp);
-      else if (call_info->out->xmlout)
-        gt_file_xprintf(outfp, "-->\n");
-
-      match_info->max_call_number_reached = true;
-      break; /* break out of loop */
-    }
+  info.sa_collection = sa_collection;
+  info.call_info = call_info;
+  info.input = input;
+  info.stat = stat;
+  info.gen_file_num = gen_file_num;
+  info.ref_file_num = ref_file_num;
+  info.num_of_chains = gth_chain_collection_size(chain_collection);
+  info.directmatches = directmatches;
+  info.refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
+  info.dna_complete_path_matrix_jt = dna_complete_path_matrix_jt;
+  info.protein_complete_path_matrix_jt = protein_complete_path_matrix_jt;
+
+  /* The chains are aligned in parallel if more than one job is requested.
+     Limiting the number of shown alignments (which depends on the results of
+     the previous chains) and the comment output (which is written during the
+     DP) require the serial computation. */
+  if (gt_jobs > 1 && info.num_of_chains > 1 && !call_info->firstalshown &&
+      !call_info->out->comments && !call_info->out->showeops) {
+    if (calc_spliced_alignments_parallel(&info, chain_collection, match_info))
+      return -1;
+  }
+  else {
+    for (chainctr = 0; chainctr < info.num_of_chains; chainctr++) {
+      if (++match_info->call_number > call_info->firstalshown &&
+          call_info->firstalshown > 0) {
+        if (!(call_info->out->xmlout || call_info->out->gff3out))
+          gt_file_xfputc('\n', outfp);
+        else if (call_info->out->xmlout)
+          gt_file_xprintf(outfp, "<!--\n");
+
+        if (!call_info->out->gff3out) {
+          gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
+                          info.refseqisdna ? "EST" : "protein",
+                          call_info->firstalshown);
+          gt_file_xprintf(outfp, "Only the first %u matches will be "
+                             "displayed.\n", call_info->firstalshown);
+        }
 
-    /* compute considered genomic regions if not set by -frompos */
-    if (!gth_input_use_substring_spec(input)) {
-      gen_seq_bounds = gth_input_get_genomic_range(input, chain->gen_file_num,
-                                                   chain->gen_seq_num);
-      gen_total_length      = gt_range_length(&gen_seq_bounds);
-      gen_offset            = gen_seq_bounds.start;
-      gen_seq_bounds_rc     = gen_seq_bounds;
-    }
-    else {
-      /* genomic multiseq contains exactly one sequence */
-      gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
-      gen_total_length = gth_input_genomic_file_total_length(input,
-                                                             chain
-                                                             ->gen_file_num);
-      gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
-      gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
-      gen_offset              = 0;
-      gen_seq_bounds_rc.start = gen_total_length - 1 - gen_seq_bounds.end;
-      gen_seq_bounds_rc.end   = gen_total_length - 1 - gen_seq_bounds.start;
-    }
+        if (!(call_info->out->xmlout || call_info->out->gff3out))
+          gt_file_xfputc('\n', outfp);
+        else if (call_info->out->xmlout)
+          gt_file_xprintf(outfp, "-->\n");
 
-    /* "retrieving" the reference sequence */
-    range = gth_input_get_reference_range(input, chain->ref_file_num,
-                                          chain->ref_seq_num);
-    ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
-    ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
-    if (refseqisdna) {
-      ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input) + range.start;
-      ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input) + range.start;
-    }
-    ref_total_length = range.end - range.start + 1;
-
-    /* check if protein sequences have a stop amino acid */
-    if (!refseqisdna && !match_info->stop_amino_acid_warning &&
-       ref_seq_orig[ref_total_length - 1] != GT_STOP_AMINO) {
-      GtStr *ref_id = gt_str_new();
-      gth_input_save_ref_id(input, ref_id, chain->ref_file_num,
-                            chain->ref_seq_num);
-      gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
-                 "with a stop amino acid ('%c'). If it is not a protein "
-                 "fragment you should add a stop amino acid to improve the "
-                 "prediction. For example with `gt seqtransform "
-                 "-addstopaminos` (see http://genometools.org for details).",
-                 gt_str_get(ref_id), chain->ref_seq_num,
-                 gth_input_get_reference_filename(input, chain->ref_file_num),
-                 GT_STOP_AMINO);
-      match_info->stop_amino_acid_warning = true;
-      gt_str_delete(ref_id);
-    }
+        match_info->max_call_number_reached = true;
+        break; /* break out of loop */
+      }
 
-    /* allocating space for alignment */
-    saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
-                             chain->gen_seq_num, chain->ref_file_num,
-                             chain->ref_seq_num, match_info->call_number,
-                             gen_total_length, gen_offset, ref_total_length);
-
-    /* extend the DP borders to the left and to the right */
-    gth_chain_extend_borders(chain, &gen_seq_bounds, &gen_seq_bounds_rc,
-                             gen_total_length, gen_offset);
-
-    /* From here on the dp positions always refer to the forward strand of the
-       genomic DNA. */
-
-    /* call the Dynamic Programming */
-    if (refseqisdna) {
-      rval = call_dna_DP(directmatches, call_info, input, stat,
-                         sa_collection, saA, gen_file_num, ref_file_num,
-                         gen_total_length, gen_offset, &gen_seq_bounds,
-                         &gen_seq_bounds_rc, ref_total_length, range.start,
-                         chainctr, gth_chain_collection_size(chain_collection),
-                         match_info, ref_seq_tran, ref_seq_orig,
-                         ref_seq_tran_rc, ref_seq_orig_rc, chain,
-                         dna_complete_path_matrix_jt,
-                         protein_complete_path_matrix_jt);
+      prepare_dp_job(&job, gth_chain_collection_get(chain_collection,
+                                                    chainctr),
+                     chainctr, &info, match_info);
+      if (run_dp_job(&job, &info, stat, match_info))
+        return -1;
     }
-    else {
-      rval = call_protein_DP(directmatches, call_info, input,
-                             stat, sa_collection, saA, gen_file_num,
-                             ref_file_num, gen_total_length, gen_offset,
-                             &gen_seq_bounds, &gen_seq_bounds_rc,
-                             ref_total_length, range.start, chainctr,
-                             gth_chain_collection_size(chain_collection),
-                             match_info, ref_seq_tran, ref_seq_orig, chain,
-                             dna_complete_path_matrix_jt,
-                             protein_complete_path_matrix_jt);
-    }
-    /* check return value */
-    if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
-      /* statistics bookkeeping */
-      gth_stat_increment_numoffailedDPparameterallocations(stat);
-      gth_stat_increment_numofundeterminedSAs(stat);
-      /* free space */
-      gth_sa_delete(saA);
-      match_info->call_number--;
-      continue; /* continue with the next DP range */
-    }
-    else if (rval)
-      return -1;
   }
 
   if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
@@ -844,6 +1079,10 @@ static int compute_sa_collection(GthSACollection *sa_collection,
   match_info.significant_match_found = false;
   match_info.max_call_number_reached = false;
   match_info.stop_amino_acid_warning = false;
+  match_info.defer_save = false;
+  match_info.deferred_sa = NULL;
+  match_info.input_mutex = NULL;
+  match_info.deferred_messages = NULL;
 
   for (g = 0; g < gth_input_num_of_gen_files(input); g++) {
     for (r = 0; r < gth_input_num_of_ref_files(input); r++) {
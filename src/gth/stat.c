@@ -214,6 +214,23 @@ void gth_stat_increase_numofPGLs_stored(GthStat *stat, GtUword addend)
   stat->numofPGLs_stored += addend;
 }
 
+void gth_stat_add_dp_counters(GthStat *dest, const GthStat *src)
+{
+  gt_assert(dest && src);
+  dest->numofremovedzerobaseexons += src->numofremovedzerobaseexons;
+  dest->numofautointroncutoutcalls += src->numofautointroncutoutcalls;
+  dest->numofunsuccessfulintroncutoutDPs +=
+    src->numofunsuccessfulintroncutoutDPs;
+  dest->numoffailedDPparameterallocations +=
+    src->numoffailedDPparameterallocations;
+  dest->numoffailedmatrixallocations += src->numoffailedmatrixallocations;
+  dest->numofundeterminedSAs += src->numofundeterminedSAs;
+  dest->totalsizeofbacktracematricesinMB +=
+    src->totalsizeofbacktracematricesinMB;
+  dest->numofbacktracematrixallocations +=
+    src->numofbacktracematrixallocations;
+}
+
 GtUword gth_stat_get_numofSAs(GthStat *stat)
 {
   gt_assert(stat);
@@ -56,6 +56,9 @@ void          gth_stat_add_to_refseqcovdistri(GthStat*, GtUword);
 void          gth_stat_add_to_sa_alignment_score_distri(GthStat*,
                                                         GtUword);
 void          gth_stat_add_to_sa_coverage_distri(GthStat*, GtUword);
+/* Add the DP related counters of <src> to <dest>. Used to merge the
+   statistics collected by the threads computing spliced alignments. */
+void          gth_stat_add_dp_counters(GthStat *dest, const GthStat *src);
 void          gth_stat_show(GthStat*, bool show_full_stats, bool xmlout,
                             GtFile*);
 void          gth_stat_delete(GthStat*);
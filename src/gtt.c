@@ -42,6 +42,7 @@
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/hashtable.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport.h"
 #include "core/md5_seqid.h"
@@ -60,11 +61,13 @@
 #include "extended/encdesc.h"
 #include "extended/evaluator.h"
 #include "extended/feature_index.h"
+#include "extended/feature_index_file.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_in_stream.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
+#include "extended/genome_node_serializer.h"
 #include "extended/gff3_escaping.h"
 #include "extended/golomb.h"
 #include "extended/hmm.h"
@@ -205,6 +208,7 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "eval", gt_eval());
   gt_toolbox_add_tool(tools, "extractfeat", gt_extractfeat());
   gt_toolbox_add_tool(tools, "extractseq", gt_extractseq());
+  gt_toolbox_add_tool(tools, "featureindex", gt_featureindex());
   gt_toolbox_add_tool(tools, "fingerprint", gt_fingerprint());
   gt_toolbox_add_tool(tools, "genomediff", gt_genomediff());
   gt_toolbox_add_tool(tools, "gff3", gt_gff3());
@@ -221,6 +225,7 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "matchtool", gt_matchtool());
   gt_toolbox_add_tool(tools, "md5_to_id", gt_md5_to_id());
   gt_toolbox_add_tool(tools, "mergefeat", gt_mergefeat());
+  gt_toolbox_add_tool(tools, "mkfeatureindex", gt_mkfeatureindex());
   gt_toolbox_add_tool(tools, "packedindex", gt_packedindex());
   gt_toolbox_add_tool(tools, "prebwt", gt_prebwt());
   gt_toolbox_add_tool(tools, "readjoiner", gt_readjoiner());
@@ -251,10 +256,6 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "sketch", gt_sketch());
   gt_toolbox_add_tool(tools, "sketch_page", gt_sketch_page());
 #endif
-#if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
-  gt_toolbox_add_tool(tools, "featureindex", gt_featureindex());
-  gt_toolbox_add_tool(tools, "mkfeatureindex", gt_mkfeatureindex());
-#endif
 
   return tools;
 }
@@ -312,6 +313,10 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "feature in stream class",
                                                 gt_feature_in_stream_unit_test);
   gt_hashmap_add(unit_tests, "genome node class", gt_genome_node_unit_test);
+  gt_hashmap_add(unit_tests, "genome node serializer class",
+                                           gt_genome_node_serializer_unit_test);
+  gt_hashmap_add(unit_tests, "file feature index class",
+                                             gt_feature_index_file_unit_test);
   gt_hashmap_add(unit_tests, "gff3 escaping module",
                                                     gt_gff3_escaping_unit_test);
   gt_hashmap_add(unit_tests, "grep module", gt_grep_unit_test);
@@ -320,6 +325,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
   gt_hashmap_add(unit_tests, "huffman coding class", gt_huffman_unit_test);
+  gt_hashmap_add(unit_tests, "interval index class",
+                 gt_interval_index_unit_test);
   gt_hashmap_add(unit_tests, "interval tree class", gt_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "Lua serializer module",
                                                    gt_lua_serializer_unit_test);
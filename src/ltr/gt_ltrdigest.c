@@ -38,6 +38,7 @@
 #include "ltr/gt_ltrdigest.h"
 #include "ltr/ltrdigest_def.h"
 #include "ltr/ltrdigest_pbs_visitor.h"
+#include "ltr/ltrdigest_pdom_stream.h"
 #include "ltr/ltrdigest_pdom_visitor.h"
 #include "ltr/ltrdigest_ppt_visitor.h"
 #include "ltr/ltrdigest_strand_assign_visitor.h"
@@ -58,7 +59,8 @@ typedef struct GtLTRdigestOptions {
   GtSeqid2FileInfo *s2fi;
   GtPdomCutoff cutoff;
   double evalue_cutoff;
-  GtUword nthreads;
+  GtUword nthreads,
+          pdom_batch_size;
   unsigned int chain_max_gap_length,
                seqnamelen;
   GtRange ppt_len, ubox_len;
@@ -339,6 +341,16 @@ static GtOptionParser* gt_ltrdigest_option_parser_new(void *tool_arguments)
   gt_option_is_extended_option(o);
   gt_option_imply(o, oh);
 
+  o = gt_option_new_uword_min("pdombatchsize",
+                              "number of input nodes whose candidates are "
+                              "searched for protein domains in a single "
+                              "hmmscan run",
+                              &arguments->pdom_batch_size,
+                              100UL, 1UL);
+  gt_option_parser_add_option(op, o);
+  gt_option_is_extended_option(o);
+  gt_option_imply(o, oh);
+
   o = gt_option_new_uword("threads",
                           "DEPRECATED, only included for compatibility reasons!"
                           " Use the -j parameter of the 'gt' call instead.",
@@ -528,7 +540,10 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
         if (arguments->output_all_chains)
           gt_ltrdigest_pdom_visitor_output_all_chains((GtLTRdigestPdomVisitor*)
                                                                         pdom_v);
-        last_stream = pdom_stream = gt_visitor_stream_new(last_stream, pdom_v);
+        last_stream = pdom_stream =
+                  gt_ltrdigest_pdom_stream_new(last_stream,
+                                               (GtLTRdigestPdomVisitor*) pdom_v,
+                                               arguments->pdom_batch_size);
       }
     } else had_err = -1;
   }
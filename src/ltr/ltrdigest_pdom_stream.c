@@ -0,0 +1,117 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/array_api.h"
+#include "core/class_alloc_lock.h"
+#include "core/ma.h"
+#include "extended/node_stream_api.h"
+#include "ltr/ltrdigest_pdom_stream.h"
+
+struct GtLTRdigestPdomStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtLTRdigestPdomVisitor *lv;
+  GtArray *nodes;
+  GtUword batch_size,
+          next_index;
+};
+
+#define gt_ltrdigest_pdom_stream_cast(GS)\
+        gt_node_stream_cast(gt_ltrdigest_pdom_stream_class(), GS)
+
+static void gt_ltrdigest_pdom_stream_reset(GtLTRdigestPdomStream *ls)
+{
+  GtUword i;
+  for (i = ls->next_index; i < gt_array_size(ls->nodes); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(ls->nodes, i));
+  gt_array_reset(ls->nodes);
+  ls->next_index = 0;
+}
+
+static int gt_ltrdigest_pdom_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                         GtError *err)
+{
+  GtLTRdigestPdomStream *ls;
+  int had_err = 0;
+  gt_error_check(err);
+  ls = gt_ltrdigest_pdom_stream_cast(ns);
+
+  if (ls->next_index == gt_array_size(ls->nodes)) {
+    /* read and annotate the next batch */
+    gt_ltrdigest_pdom_stream_reset(ls);
+    while (!had_err && gt_array_size(ls->nodes) < ls->batch_size) {
+      had_err = gt_node_stream_next(ls->in_stream, gn, err);
+      if (!had_err) {
+        if (*gn == NULL)
+          break;
+        gt_array_add(ls->nodes, *gn);
+      }
+    }
+    if (!had_err && gt_array_size(ls->nodes) > 0)
+      had_err = gt_ltrdigest_pdom_visitor_process_batch(ls->lv, ls->nodes, err);
+    if (had_err) {
+      /* we own the nodes -> delete them */
+      gt_ltrdigest_pdom_stream_reset(ls);
+    }
+  }
+  if (!had_err && ls->next_index < gt_array_size(ls->nodes)) {
+    *gn = *(GtGenomeNode**) gt_array_get(ls->nodes, ls->next_index);
+    ls->next_index++;
+  }
+  else
+    *gn = NULL;
+  return had_err;
+}
+
+static void gt_ltrdigest_pdom_stream_free(GtNodeStream *ns)
+{
+  GtLTRdigestPdomStream *ls = gt_ltrdigest_pdom_stream_cast(ns);
+  gt_ltrdigest_pdom_stream_reset(ls);
+  gt_array_delete(ls->nodes);
+  gt_node_visitor_delete((GtNodeVisitor*) ls->lv);
+  gt_node_stream_delete(ls->in_stream);
+}
+
+const GtNodeStreamClass* gt_ltrdigest_pdom_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtLTRdigestPdomStream),
+                                   gt_ltrdigest_pdom_stream_free,
+                                   gt_ltrdigest_pdom_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_ltrdigest_pdom_stream_new(GtNodeStream *in_stream,
+                                           GtLTRdigestPdomVisitor *lv,
+                                           GtUword batch_size)
+{
+  GtLTRdigestPdomStream *ls;
+  GtNodeStream *ns;
+  gt_assert(in_stream && lv && batch_size > 0);
+  ns = gt_node_stream_create(gt_ltrdigest_pdom_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  ls = gt_ltrdigest_pdom_stream_cast(ns);
+  ls->in_stream = gt_node_stream_ref(in_stream);
+  ls->lv = lv;
+  ls->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  ls->batch_size = batch_size;
+  ls->next_index = 0;
+  return ns;
+}
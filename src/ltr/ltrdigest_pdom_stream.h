@@ -0,0 +1,39 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LTRDIGEST_PDOM_STREAM_H
+#define LTRDIGEST_PDOM_STREAM_H
+
+#include "extended/node_stream_api.h"
+#include "ltr/ltrdigest_pdom_visitor.h"
+
+/* Implements the <GtNodeStream> interface. A <GtLTRdigestPdomStream> annotates
+   the protein domains of the LTR retrotransposons in the nodes of its input
+   stream, like a <GtVisitorStream> with a <GtLTRdigestPdomVisitor>. But the
+   nodes are read in batches of <batch_size> nodes, such that the candidates of
+   a whole batch are searched at once (see
+   <gt_ltrdigest_pdom_visitor_process_batch()>). */
+typedef struct GtLTRdigestPdomStream GtLTRdigestPdomStream;
+
+const GtNodeStreamClass* gt_ltrdigest_pdom_stream_class(void);
+
+/* Return a new <GtLTRdigestPdomStream> reading from <in_stream>, which takes
+   ownership of <lv>. */
+GtNodeStream*            gt_ltrdigest_pdom_stream_new(GtNodeStream *in_stream,
+                                                    GtLTRdigestPdomVisitor *lv,
+                                                    GtUword batch_size);
+
+#endif
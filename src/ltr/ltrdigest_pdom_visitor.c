@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <errno.h>
 #include <signal.h>
 #include <string.h>
 #ifndef S_SPLINT_S
@@ -22,6 +23,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 #ifndef _WIN32
+#include <fcntl.h>
 #include <sys/wait.h>
 #endif
 #endif
@@ -31,10 +33,12 @@
 #include "core/codon_iterator_simple_api.h"
 #include "core/cstr_api.h"
 #include "core/cstr_array.h"
+#include "core/fa.h"
 #include "core/hashmap.h"
 #include "core/log.h"
 #include "core/ma.h"
 #include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/range.h"
 #include "core/str_api.h"
 #include "core/strand_api.h"
@@ -43,6 +47,7 @@
 #include "core/translator_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
+#include "core/xansi_api.h"
 #include "extended/node_visitor_api.h"
 #include "extended/extract_feature_sequence.h"
 #include "extended/feature_node.h"
@@ -61,13 +66,11 @@ struct GtLTRdigestPdomVisitor {
   GtRegionMapping *rmap;
   double eval_cutoff;
   GtFeatureNode *ltr_retrotrans;
-  GtStr *fwd[3], *rev[3];
   unsigned int chain_max_gap_length;
   GtUword leftLTR_5, rightLTR_3;
   GtPdomCutoff cutoff;
   GtStr *cmdline, *tag;
   bool output_all_chains;
-  char **args;
   const char *root_type;
 };
 
@@ -97,6 +100,23 @@ typedef struct {
   GtStr *alignment, *aastring;
 } GtHMMERSingleHit;
 
+/* an LTR retrotransposon searched for protein domains as part of a batch */
+typedef struct {
+  GtFeatureNode *ltr_retrotrans;
+  GtStr *fwd[3], *rev[3];
+  GtHMMERParseStatus *pstatus;
+} GtPdomCandidate;
+
+/* the candidates of a batch searched by one hmmscan process */
+typedef struct {
+  GtLTRdigestPdomVisitor *lv;
+  GtPdomCandidate *candidates;
+  GtUword nof_candidates;
+  unsigned int cpus;
+  GtError *err;
+  int had_err;
+} GtPdomScanJob;
+
 #ifndef _WIN32
 static void gt_hmmer_model_hit_delete(GtHMMERModelHit *mh);
 #endif
@@ -378,7 +398,10 @@ static int gt_ltrdigest_pdom_visitor_parse_alignments(GT_UNUSED
             {
               GT_UNUSED char *b = buf;
               b = strtok(buf, " ");
-              gt_assert(strspn(b, "012+-") == (size_t) 2);
+              /* the query name ends with the frame and the strand */
+              gt_assert(strlen(b) >= (size_t) 2
+                          && strchr("012", b[strlen(b) - 2]) != NULL
+                          && strchr("+-", b[strlen(b) - 1]) != NULL);
               b = strtok(NULL, " ");
               gt_assert(strlen(b) > 0);
               b = strtok(NULL, " ");
@@ -461,13 +484,17 @@ static int gt_ltrdigest_pdom_visitor_parse_domainhits(GtLTRdigestPdomVisitor
 
 #ifndef _WIN32
 static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
-                                                 GtHMMERParseStatus *status,
+                                                 GtPdomCandidate *candidates,
+                                                 GtUword nof_candidates,
                                                  bool *end,
                                                  FILE *instream, GtError *err)
 {
   int had_err = 0;
-  char buf[GT_HMMER_BUF_LEN];
-  gt_assert(lv && instream && status);
+  char buf[GT_HMMER_BUF_LEN], strand;
+  GtUword candidate;
+  unsigned int frame;
+  GtHMMERParseStatus *status = NULL;
+  gt_assert(lv && instream && candidates);
   gt_error_check(err);
 
   had_err = pdom_parser_get_next_line(buf, instream, err);
@@ -475,9 +502,18 @@ static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
     *end = true;
   }
   if (!had_err && !(*end)) {
-    status->strand = gt_strand_get(buf[14]);
-    buf[14] = '\0';
-    status->frame = (unsigned) atoi(buf+13);
+    /* the query name tells which frame of which candidate was searched */
+    if (sscanf(buf + 6, " "GT_WU"_%u%c", &candidate, &frame, &strand) != 3
+          || candidate >= nof_candidates || frame > 2U
+          || (strand != '+' && strand != '-')) {
+      gt_error_set(err, "unexpected query in HMMER output: '%s'", buf);
+      had_err = -1;
+    }
+    else {
+      status = candidates[candidate].pstatus;
+      status->strand = gt_strand_get(strand);
+      status->frame = frame;
+    }
   }
   if (!had_err && !(*end)) {
     had_err = gt_ltrdigest_pdom_visitor_parse_scores(lv, buf, instream, err);
@@ -496,15 +532,17 @@ static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
 
 #ifndef _WIN32
 static int gt_ltrdigest_pdom_visitor_parse_output(GtLTRdigestPdomVisitor *lv,
-                                                  GtHMMERParseStatus *status,
+                                                  GtPdomCandidate *candidates,
+                                                  GtUword nof_candidates,
                                                   FILE *instream, GtError *err)
 {
   int had_err = 0;
   bool end = false;
-  gt_assert(lv && instream && status);
+  gt_assert(lv && instream && candidates);
   gt_error_check(err);
   while (!had_err && !end) {
-    had_err = gt_ltrdigest_pdom_visitor_parse_query(lv, status, &end,
+    had_err = gt_ltrdigest_pdom_visitor_parse_query(lv, candidates,
+                                                    nof_candidates, &end,
                                                     instream, err);
   }
   /* gt_hmmer_parse_status_show(status); */
@@ -775,170 +813,314 @@ static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
   return had_err;
 }
 
-static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
-                                                  GtFeatureNode *fn,
-                                                  GtError *err)
+static int gt_ltrdigest_pdom_visitor_translate(GtLTRdigestPdomVisitor *lv,
+                                               GtPdomCandidate *candidate,
+                                               GtError *err)
 {
-  GtLTRdigestPdomVisitor *lv;
-  GtFeatureNodeIterator *fni;
-  GtFeatureNode *curnode = NULL;
+  GtCodonIterator *ci;
+  GtTranslator *tr;
+  GtTranslatorStatus status;
+  GtUword seqlen;
+  char translated, *rev_seq;
+  unsigned int frame;
   int had_err = 0;
   GtRange rng;
-  GtUword i;
-  lv = gt_ltrdigest_pdom_visitor_cast(nv);
-  gt_assert(lv);
+  GtStr *seq;
+  gt_assert(lv && candidate);
   gt_error_check(err);
 
-  /* traverse annotation subgraph and find LTR element */
-  fni = gt_feature_node_iterator_new(fn);
-  while (!had_err && (curnode = gt_feature_node_iterator_next(fni))) {
-    if (strcmp(gt_feature_node_get_type(curnode), lv->root_type) == 0) {
-      lv->ltr_retrotrans = curnode;
-    }
-  }
-  gt_feature_node_iterator_delete(fni);
-
-  if (!had_err && lv->ltr_retrotrans != NULL) {
-    GtCodonIterator *ci;
-    GtTranslator *tr;
-    GtTranslatorStatus status;
-    GtUword seqlen;
-    char translated, *rev_seq;
-#ifndef _WIN32
-    FILE *instream;
-    GtHMMERParseStatus *pstatus;
-#endif
-    unsigned int frame;
-    GtStr *seq;
-
-    seq = gt_str_new();
-    rng = gt_genome_node_get_range((GtGenomeNode*) lv->ltr_retrotrans);
-    lv->leftLTR_5 = rng.start - 1;
-    lv->rightLTR_3 = rng.end - 1;
-    seqlen = gt_range_length(&rng);
+  seq = gt_str_new();
+  rng = gt_genome_node_get_range((GtGenomeNode*) candidate->ltr_retrotrans);
+  seqlen = gt_range_length(&rng);
 
-    had_err = gt_extract_feature_sequence(seq,
-                                          (GtGenomeNode*) lv->ltr_retrotrans,
-                                          lv->root_type,
-                                          false, NULL, NULL, lv->rmap, err);
+  had_err = gt_extract_feature_sequence(seq,
+                                        (GtGenomeNode*)
+                                                      candidate->ltr_retrotrans,
+                                        lv->root_type,
+                                        false, NULL, NULL, lv->rmap, err);
 
+  if (!had_err) {
+    /* create translations */
+    ci = gt_codon_iterator_simple_new(gt_str_get(seq), seqlen, NULL);
+    gt_assert(ci);
+    tr = gt_translator_new(ci);
+    status = gt_translator_next(tr, &translated, &frame, err);
+    while (status == GT_TRANSLATOR_OK && translated) {
+      gt_str_append_char(candidate->fwd[frame], translated);
+      status = gt_translator_next(tr, &translated, &frame, NULL);
+    }
+    if (status == GT_TRANSLATOR_ERROR) had_err = -1;
     if (!had_err) {
-      for (i = 0UL; i < 3UL; i++) {
-        gt_str_reset(lv->fwd[i]);
-        gt_str_reset(lv->rev[i]);
-      }
-
-      /* create translations */
-      ci = gt_codon_iterator_simple_new(gt_str_get(seq), seqlen, NULL);
-      gt_assert(ci);
-      tr = gt_translator_new(ci);
+      rev_seq = gt_malloc((size_t) seqlen * sizeof (char));
+      strncpy(rev_seq, gt_str_get(seq), (size_t) seqlen * sizeof (char));
+      (void) gt_reverse_complement(rev_seq, seqlen, NULL);
+      gt_codon_iterator_delete(ci);
+      ci = gt_codon_iterator_simple_new(rev_seq, seqlen, NULL);
+      gt_translator_set_codon_iterator(tr, ci);
       status = gt_translator_next(tr, &translated, &frame, err);
       while (status == GT_TRANSLATOR_OK && translated) {
-        gt_str_append_char(lv->fwd[frame], translated);
+        gt_str_append_char(candidate->rev[frame], translated);
         status = gt_translator_next(tr, &translated, &frame, NULL);
       }
       if (status == GT_TRANSLATOR_ERROR) had_err = -1;
-      if (!had_err) {
-        rev_seq = gt_malloc((size_t) seqlen * sizeof (char));
-        strncpy(rev_seq, gt_str_get(seq), (size_t) seqlen * sizeof (char));
-        (void) gt_reverse_complement(rev_seq, seqlen, NULL);
-        gt_codon_iterator_delete(ci);
-        ci = gt_codon_iterator_simple_new(rev_seq, seqlen, NULL);
-        gt_translator_set_codon_iterator(tr, ci);
-        status = gt_translator_next(tr, &translated, &frame, err);
-        while (status == GT_TRANSLATOR_OK && translated) {
-          gt_str_append_char(lv->rev[frame], translated);
-          status = gt_translator_next(tr, &translated, &frame, NULL);
-        }
-        if (status == GT_TRANSLATOR_ERROR) had_err = -1;
-        gt_free(rev_seq);
-      }
-      gt_codon_iterator_delete(ci);
-      gt_translator_delete(tr);
+      gt_free(rev_seq);
     }
+    gt_codon_iterator_delete(ci);
+    gt_translator_delete(tr);
+  }
+  gt_str_delete(seq);
+  return had_err;
+}
 
-    /* run HMMER and handle results */
-    if (!had_err) {
 #ifndef _WIN32
-      int pid, pc[2], cp[2];
-      GT_UNUSED int rval;
-
-      (void) signal(SIGCHLD, SIG_IGN); /* XXX: for now, ignore child's
-                                               exit status */
-      rval = pipe(pc);
-      gt_assert(rval == 0);
-      rval = pipe(cp);
-      gt_assert(rval == 0);
-
-      switch ((pid = (int) fork())) {
-        case -1:
-          perror("Can't fork");
-          exit(1);   /* XXX: error handling */
-        case 0:    /* child */
-          (void) close(1);    /* close current stdout. */
-          rval = dup(cp[1]);  /* make stdout go to write end of pipe. */
-          (void) close(0);    /* close current stdin. */
-          rval = dup(pc[0]);  /* make stdin come from read end of pipe. */
-          (void) close(pc[0]);
-          (void) close(pc[1]);
-          (void) close(cp[0]);
-          (void) close(cp[1]);
-          (void) execvp("hmmscan", lv->args); /* XXX: read path from env */
-          perror("couldn't execute hmmscan!");
-          exit(1);
-        default:    /* parent */
-          for (i = 0UL; i < 3UL; i++) {
-            char buf[5];
-            GT_UNUSED ssize_t written;
-            (void) sprintf(buf, ">"GT_WU"%c\n", i, '+');
-            written = write(pc[1], buf, 4 * sizeof (char));
-            written = write(pc[1], gt_str_get(lv->fwd[i]),
-                            (size_t) gt_str_length(lv->fwd[i]) * sizeof (char));
-            written = write(pc[1], "\n", 1 * sizeof (char));
-            (void) sprintf(buf, ">"GT_WU"%c\n", i, '-');
-            written = write(pc[1], buf, 4 * sizeof (char));
-            written = write(pc[1], gt_str_get(lv->rev[i]),
-                            (size_t) gt_str_length(lv->rev[i]) * sizeof (char));
-            written = write(pc[1], "\n", 1 * sizeof (char));
-          }
-          (void) close(pc[0]);
-          (void) close(pc[1]);
-          (void) close(cp[1]);
-          instream = fdopen(cp[0], "r");
-          pstatus = gt_hmmer_parse_status_new();
-          had_err = gt_ltrdigest_pdom_visitor_parse_output(lv, pstatus,
-                                                           instream, err);
-          (void) fclose(instream);
-          if (!had_err)
-            had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, pstatus, err);
-          gt_hmmer_parse_status_delete(pstatus);
-      }
+/* Runs one hmmscan process on the translations of all candidates of <job>,
+   which are written to a temporary file beforehand, such that hmmscan never
+   waits for us while we wait for its output. The queries are named
+   <candidate>_<frame><strand>, which allows to assign each hit to its
+   candidate. */
+static int gt_ltrdigest_pdom_visitor_scan(GtPdomScanJob *job)
+{
+  GtStr *queryfile, *cmd;
+  char **args;
+  FILE *fp, *instream;
+  int had_err = 0, pc[2];
+  GtUword i, j;
+  gt_assert(job && job->lv && job->candidates);
+
+  queryfile = gt_str_new();
+  fp = gt_xtmpfp(queryfile);
+  for (i = 0; i < job->nof_candidates; i++) {
+    for (j = 0UL; j < 3UL; j++) {
+      fprintf(fp, ">"GT_WU"_"GT_WU"+\n%s\n", i, j,
+              gt_str_get(job->candidates[i].fwd[j]));
+      fprintf(fp, ">"GT_WU"_"GT_WU"-\n%s\n", i, j,
+              gt_str_get(job->candidates[i].rev[j]));
+    }
+  }
+  gt_fa_xfclose(fp);
+
+  cmd = gt_str_new_cstr("hmmscan --cpu ");
+  gt_str_append_uint(cmd, job->cpus);
+  gt_str_append_char(cmd, ' ');
+  gt_str_append_str(cmd, job->lv->cmdline);
+  gt_str_append_char(cmd, ' ');
+  gt_str_append_str(cmd, queryfile);
+  gt_log_log("HMMER cmdline: %s", gt_str_get(cmd));
+  args = gt_cstr_split(gt_str_get(cmd), ' ');
+
+  if (pipe(pc) != 0) {
+    gt_error_set(job->err, "cannot create pipe: %s", strerror(errno));
+    had_err = -1;
+  }
+  if (!had_err) {
+    /* do not pass the pipe on to the hmmscan processes of other jobs */
+    (void) fcntl(pc[0], F_SETFD, FD_CLOEXEC);
+    (void) fcntl(pc[1], F_SETFD, FD_CLOEXEC);
+    switch ((int) fork()) {
+      case -1:
+        gt_error_set(job->err, "cannot fork: %s", strerror(errno));
+        (void) close(pc[0]);
+        (void) close(pc[1]);
+        had_err = -1;
+        break;
+      case 0:    /* child */
+        if (dup2(pc[1], 1) == -1) /* make stdout go to write end of pipe */
+          _exit(EXIT_FAILURE);
+        (void) execvp("hmmscan", args); /* XXX: read path from env */
+        perror("couldn't execute hmmscan!");
+        _exit(EXIT_FAILURE);
+      default:    /* parent */
+        (void) close(pc[1]);
+        instream = fdopen(pc[0], "r");
+        had_err = gt_ltrdigest_pdom_visitor_parse_output(job->lv,
+                                                         job->candidates,
+                                                         job->nof_candidates,
+                                                         instream, job->err);
+        (void) fclose(instream);
+    }
+  }
+  gt_cstr_array_delete(args);
+  gt_str_delete(cmd);
+  gt_xremove(gt_str_get(queryfile));
+  gt_str_delete(queryfile);
+  return had_err;
+}
+
+static void* gt_ltrdigest_pdom_visitor_scan_thread(void *data)
+{
+  GtPdomScanJob *job = (GtPdomScanJob*) data;
+  job->had_err = gt_ltrdigest_pdom_visitor_scan(job);
+  return NULL;
+}
+
+/* Searches the candidates with up to <gt_jobs> hmmscan processes at once. */
+static int gt_ltrdigest_pdom_visitor_scan_all(GtLTRdigestPdomVisitor *lv,
+                                              GtPdomCandidate *candidates,
+                                              GtUword nof_candidates,
+                                              GtError *err)
+{
+  GtPdomScanJob *jobs;
+#ifdef GT_THREADS_ENABLED
+  GtThread **threads;
+#endif
+  GtUword i, j, nof_jobs;
+  int had_err = 0;
+  gt_assert(lv && candidates && nof_candidates > 0);
+  gt_error_check(err);
+
+  (void) signal(SIGCHLD, SIG_IGN); /* XXX: for now, ignore child's
+                                           exit status */
+#ifdef GT_THREADS_ENABLED
+  nof_jobs = MIN((GtUword) gt_jobs, nof_candidates);
+#else
+  /* without threads, all candidates are searched by one hmmscan process */
+  nof_jobs = 1UL;
+#endif
+  jobs = gt_calloc((size_t) nof_jobs, sizeof (*jobs));
+  for (i = 0, j = 0; j < nof_jobs; j++) {
+    jobs[j].lv = lv;
+    jobs[j].candidates = candidates + i;
+    jobs[j].nof_candidates = (nof_candidates - i) / (nof_jobs - j);
+    /* a single hmmscan process may use all threads itself */
+    jobs[j].cpus = nof_jobs == 1UL ? gt_jobs : 1U;
+    jobs[j].err = gt_error_new();
+    i += jobs[j].nof_candidates;
+  }
+  gt_assert(i == nof_candidates);
+#ifdef GT_THREADS_ENABLED
+  threads = gt_calloc((size_t) nof_jobs, sizeof (*threads));
+  /* the first job is run by the calling thread */
+  for (j = 1UL; j < nof_jobs; j++) {
+    threads[j] = gt_thread_new(gt_ltrdigest_pdom_visitor_scan_thread,
+                               jobs + j, NULL);
+    if (threads[j] == NULL)
+      (void) gt_ltrdigest_pdom_visitor_scan_thread(jobs + j);
+  }
+  (void) gt_ltrdigest_pdom_visitor_scan_thread(jobs);
+  for (j = 0; j < nof_jobs; j++) {
+    if (threads[j] != NULL) {
+      gt_thread_join(threads[j]);
+      gt_thread_delete(threads[j]);
+    }
+  }
+  gt_free(threads);
 #else
-      /* XXX */
-      gt_error_set(err, "HMMER call not implemented on Windows\n");
+  (void) gt_ltrdigest_pdom_visitor_scan_thread(jobs);
+#endif
+  for (j = 0; j < nof_jobs; j++) {
+    if (!had_err && jobs[j].had_err) {
+      gt_error_set(err, "%s", gt_error_get(jobs[j].err));
       had_err = -1;
+    }
+    gt_error_delete(jobs[j].err);
+  }
+  gt_free(jobs);
+  return had_err;
+}
 #endif
+
+int gt_ltrdigest_pdom_visitor_process_batch(GtLTRdigestPdomVisitor *lv,
+                                            GtArray *nodes, GtError *err)
+{
+  GtPdomCandidate *candidates;
+  GtUword i, j, nof_candidates = 0;
+  int had_err = 0;
+  gt_assert(lv && nodes);
+  gt_error_check(err);
+
+  candidates = gt_calloc((size_t) gt_array_size(nodes) + 1,
+                         sizeof (*candidates));
+  /* traverse annotation subgraphs, find LTR elements and translate them */
+  for (i = 0; !had_err && i < gt_array_size(nodes); i++) {
+    GtFeatureNode *fn, *curnode, *ltr_retrotrans = NULL;
+    GtFeatureNodeIterator *fni;
+    GtPdomCandidate *candidate;
+    if (!(fn = gt_feature_node_try_cast(*(GtGenomeNode**)
+                                                   gt_array_get(nodes, i))))
+      continue;
+    fni = gt_feature_node_iterator_new(fn);
+    while ((curnode = gt_feature_node_iterator_next(fni))) {
+      if (strcmp(gt_feature_node_get_type(curnode), lv->root_type) == 0)
+        ltr_retrotrans = curnode;
     }
-    gt_str_delete(seq);
+    gt_feature_node_iterator_delete(fni);
+    if (ltr_retrotrans == NULL)
+      continue;
+    candidate = candidates + nof_candidates++;
+    candidate->ltr_retrotrans = ltr_retrotrans;
+    for (j = 0UL; j < 3UL; j++) {
+      candidate->fwd[j] = gt_str_new();
+      candidate->rev[j] = gt_str_new();
+    }
+#ifndef _WIN32
+    candidate->pstatus = gt_hmmer_parse_status_new();
+#endif
+    had_err = gt_ltrdigest_pdom_visitor_translate(lv, candidate, err);
   }
-  if (!had_err)
-    had_err = gt_ltrdigest_pdom_visitor_choose_strand(lv);
+
+  /* run HMMER and handle results */
+  if (!had_err && nof_candidates > 0) {
+#ifndef _WIN32
+    had_err = gt_ltrdigest_pdom_visitor_scan_all(lv, candidates,
+                                                 nof_candidates, err);
+    for (i = 0; !had_err && i < nof_candidates; i++) {
+      GtRange rng;
+      lv->ltr_retrotrans = candidates[i].ltr_retrotrans;
+      rng = gt_genome_node_get_range((GtGenomeNode*) lv->ltr_retrotrans);
+      lv->leftLTR_5 = rng.start - 1;
+      lv->rightLTR_3 = rng.end - 1;
+      had_err = gt_ltrdigest_pdom_visitor_process_hits(lv,
+                                                       candidates[i].pstatus,
+                                                       err);
+      if (!had_err)
+        had_err = gt_ltrdigest_pdom_visitor_choose_strand(lv);
+    }
+#else
+    /* XXX */
+    gt_error_set(err, "HMMER call not implemented on Windows\n");
+    had_err = -1;
+#endif
+  }
+
+  for (i = 0; i < nof_candidates; i++) {
+    for (j = 0UL; j < 3UL; j++) {
+      gt_str_delete(candidates[i].fwd[j]);
+      gt_str_delete(candidates[i].rev[j]);
+    }
+#ifndef _WIN32
+    gt_hmmer_parse_status_delete(candidates[i].pstatus);
+#endif
+  }
+  gt_free(candidates);
+  return had_err;
+}
+
+static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
+                                                  GtFeatureNode *fn,
+                                                  GtError *err)
+{
+  GtLTRdigestPdomVisitor *lv;
+  GtArray *nodes;
+  int had_err;
+  lv = gt_ltrdigest_pdom_visitor_cast(nv);
+  gt_assert(lv);
+  gt_error_check(err);
+
+  /* a batch of one */
+  nodes = gt_array_new(sizeof (GtFeatureNode*));
+  gt_array_add(nodes, fn);
+  had_err = gt_ltrdigest_pdom_visitor_process_batch(lv, nodes, err);
+  gt_array_delete(nodes);
   return had_err;
 }
 
 void gt_ltrdigest_pdom_visitor_free(GtNodeVisitor *nv)
 {
   GtLTRdigestPdomVisitor *lv;
-  GtUword i;
   if (!nv) return;
   lv = gt_ltrdigest_pdom_visitor_cast(nv);
-  for (i = 0UL; i < 3UL; i++) {
-    gt_str_delete(lv->fwd[i]);
-    gt_str_delete(lv->rev[i]);
-  }
   gt_str_delete(lv->cmdline);
   gt_str_delete(lv->tag);
-  gt_cstr_array_delete(lv->args);
 }
 
 const GtNodeVisitorClass* gt_ltrdigest_pdom_visitor_class(void)
@@ -987,7 +1169,7 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
   GtNodeVisitor *nv;
   GtLTRdigestPdomVisitor *lv;
   GtStr *cmd;
-  int had_err = 0, i, rval;
+  int had_err = 0, rval;
   gt_assert(model && rmap);
 
   rval = system("hmmscan -h > /dev/null");
@@ -1016,15 +1198,10 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
   lv->tag = gt_str_new_cstr("GenomeTools");
   lv->root_type = gt_symbol(gt_ft_LTR_retrotransposon);
 
-  for (i = 0; i < 3; i++) {
-    lv->fwd[i] = gt_str_new();
-    lv->rev[i] = gt_str_new();
-  }
-
   if (!had_err) {
-    cmd = gt_str_new_cstr("hmmscan --cpu ");
-    gt_str_append_uint(cmd, gt_jobs);
-    gt_str_append_cstr(cmd, " ");
+    /* the hmmscan options and the model file, the number of threads and the
+       query file are given per call */
+    cmd = gt_str_new();
     switch (cutoff) {
       case GT_PHMM_CUTOFF_GA:
         gt_str_append_cstr(cmd, "--cut_ga");
@@ -1039,10 +1216,7 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
     }
     gt_str_append_cstr(cmd, " ");
     gt_str_append_cstr(cmd, gt_pdom_model_set_get_filename(model));
-    gt_str_append_cstr(cmd, " -");
     lv->cmdline = cmd;
-    lv->args = gt_cstr_split(gt_str_get(lv->cmdline), ' ');
-    gt_log_log("HMMER cmdline: %s", gt_str_get(cmd));
   }
   return nv;
 }
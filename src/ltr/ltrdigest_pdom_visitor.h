@@ -18,6 +18,7 @@
 #ifndef LTRDIGEST_PDOM_VISITOR_H
 #define LTRDIGEST_PDOM_VISITOR_H
 
+#include "core/array_api.h"
 #include "extended/node_visitor.h"
 #include "extended/region_mapping_api.h"
 #include "ltr/pdom_model_set.h"
@@ -46,4 +47,12 @@ void           gt_ltrdigest_pdom_visitor_set_root_type(
 void           gt_ltrdigest_pdom_visitor_set_source_tag(
                                                      GtLTRdigestPdomVisitor *lv,
                                                      const char *tag);
+/* Annotate the protein domains of the candidates in all <GtGenomeNode>s in
+   <nodes> at once, using a single <hmmscan> run per thread (see <gt_jobs>)
+   instead of one run per candidate. The results are the same as if each node
+   was visited on its own. */
+int            gt_ltrdigest_pdom_visitor_process_batch(
+                                                     GtLTRdigestPdomVisitor *lv,
+                                                     GtArray *nodes,
+                                                     GtError *err);
 #endif
@@ -26,6 +26,7 @@
 #include "core/encseq_api.h"
 #include "core/error_api.h"
 #include "core/log.h"
+#include "core/ma.h"
 #include "core/mathsupport.h"
 #include "core/md5_seqid.h"
 #include "core/minmax.h"
@@ -86,6 +87,7 @@ typedef struct
 typedef struct
 {
   GtUword contignumber,   /* ordinal number of sequence in encseq */
+                seednumber,     /* ordinal number of the extended seed */
                 leftLTR_5,      /* 5' boundary of left LTR */
                 leftLTR_3,      /* 3' boundary of left LTR */
                 rightLTR_5,     /* 5' boundary of right LTR */
@@ -179,6 +181,16 @@ static int bdcompare(const void *a, const void *b)
   {
     return 1;
   }
+  /* the order of equal predictions from different seeds must not depend on
+     the thread which extended the seed */
+  if (bda->seednumber < bdb->seednumber)
+  {
+    return -1;
+  }
+  if (bda->seednumber > bdb->seednumber)
+  {
+    return 1;
+  }
   return 0;
 }
 
@@ -903,13 +915,66 @@ static void adjustboundariesfromXdropextension(GtXdropbest xdropbest_left,
 
 /* The following function applies the filter algorithms one after another
    to all candidate pairs */
+/* The seeds are distributed among the threads in ranges. A thread extends
+   the seeds of its own range from the front. If its range is exhausted, it
+   steals the upper half of the remaining seeds of another range. */
+typedef struct
+{
+  GtMutex *mutex;
+  GtUword nextseed,
+          endseed;
+  GtArrayLTRboundaries arrayLTRboundaries; /* the predictions of the thread */
+} GtLTRharvestSeedRange;
+
+static bool gt_ltrharvest_nextseed(GtLTRharvestSeedRange *seedranges,
+                                   unsigned int numofseedranges,
+                                   unsigned int own,
+                                   GtUword *seed)
+{
+  GtLTRharvestSeedRange *ownrange = seedranges + own;
+  unsigned int idx;
+
+  gt_mutex_lock(ownrange->mutex);
+  if (ownrange->nextseed < ownrange->endseed)
+  {
+    *seed = ownrange->nextseed++;
+    gt_mutex_unlock(ownrange->mutex);
+    return true;
+  }
+  gt_mutex_unlock(ownrange->mutex);
+  /* the own range is exhausted, so no other thread steals from it */
+  for (idx = 1U; idx < numofseedranges; idx++)
+  {
+    GtLTRharvestSeedRange *victim = seedranges + (own + idx) % numofseedranges;
+    GtUword stolenstart, stolenend;
+
+    gt_mutex_lock(victim->mutex);
+    if (victim->nextseed < victim->endseed)
+    {
+      stolenstart = victim->nextseed + (victim->endseed - victim->nextseed)/2;
+      stolenend = victim->endseed;
+      victim->endseed = stolenstart;
+      gt_mutex_unlock(victim->mutex);
+      gt_mutex_lock(ownrange->mutex);
+      ownrange->nextseed = stolenstart + 1;
+      ownrange->endseed = stolenend;
+      gt_mutex_unlock(ownrange->mutex);
+      *seed = stolenstart;
+      return true;
+    }
+    gt_mutex_unlock(victim->mutex);
+  }
+  return false;
+}
+
 static int gt_searchforLTRs(GtLTRharvestStream *lo,
-                            GtArrayLTRboundaries *arrayLTRboundaries,
-                            GT_UNUSED GtMutex *rmutex,
-                            GT_UNUSED GtMutex *wmutex,
-                            GtUword *cur_seed,
+                            GtLTRharvestSeedRange *seedranges,
+                            unsigned int numofseedranges,
+                            unsigned int own,
                             GtError *err)
 {
+  GtArrayLTRboundaries *arrayLTRboundaries
+    = &seedranges[own].arrayLTRboundaries;
   GtUword my_seed;
   GtXdropresources *xdropresources;
   GtXdropbest xdropbest_left, xdropbest_right;
@@ -937,14 +1002,10 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
                   vlen,
                   seqend,
                   seqstart;
-    gt_mutex_lock(rmutex);
-    if (*cur_seed < lo->repeatinfo.repeats.nextfreeRepeat)
-      my_seed = (*cur_seed)++;
-    else {
-      gt_mutex_unlock(rmutex);
+    if (!gt_ltrharvest_nextseed(seedranges, numofseedranges, own, &my_seed))
+    {
       break;
     }
-    gt_mutex_unlock(rmutex);
 
     repeatptr = &(lo->repeatinfo.repeats.spaceRepeat[my_seed]);
     seqstart = gt_encseq_seqstartpos(lo->encseq, repeatptr->contignumber);
@@ -1041,6 +1102,7 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     }
 
     boundaries.contignumber = repeatptr->contignumber;
+    boundaries.seednumber = my_seed;
     boundaries.leftLTR_5 = (GtUword) 0;
     boundaries.leftLTR_3 = (GtUword) 0;
     boundaries.rightLTR_5 = (GtUword) 0;
@@ -1135,12 +1197,17 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     if (!gt_double_smaller_double(boundaries.similarity,
                                   lo->similaritythreshold))
     {
-      gt_mutex_lock(wmutex);
       GT_GETNEXTFREEINARRAY(boundaries_ptr,arrayLTRboundaries,LTRboundaries,5);
       *boundaries_ptr = boundaries;
-      gt_mutex_unlock(wmutex);
     }
   }
+  /* sort the predictions of this thread, they are merged afterwards */
+  if (arrayLTRboundaries->spaceLTRboundaries != NULL)
+  {
+    qsort(arrayLTRboundaries->spaceLTRboundaries,
+          (size_t) arrayLTRboundaries->nextfreeLTRboundaries,
+          sizeof (LTRboundaries), bdcompare);
+  }
 #ifdef GT_GREEDY_BUFFER
   FREESPACE(useq);
   FREESPACE(vseq);
@@ -1154,23 +1221,77 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
 
 typedef struct {
   GtLTRharvestStream *lo;
-  GtArrayLTRboundaries *arrayLTRboundaries;
-  const GtEncseq *encseq;
+  GtLTRharvestSeedRange *seedranges;
+  unsigned int numofseedranges,
+               nextseedrange;
+  GtMutex *mutex;
   GtError *err;
-  GtMutex *rmutex, *wmutex;
-  GtUword cur_seed;
 } GtLTRharvestThreadInfo;
 
 static void* gt_searchforLTRs_threadfunc(void *data) {
   GtLTRharvestThreadInfo *info = (GtLTRharvestThreadInfo*) data;
+  unsigned int own;
   GT_UNUSED int rval;
   gt_assert(info);
-  rval = gt_searchforLTRs(info->lo, info->arrayLTRboundaries, info->rmutex,
-                          info->wmutex, &info->cur_seed, info->err);
+  gt_mutex_lock(info->mutex);
+  own = info->nextseedrange++;
+  gt_mutex_unlock(info->mutex);
+  gt_assert(own < info->numofseedranges);
+  rval = gt_searchforLTRs(info->lo, info->seedranges, info->numofseedranges,
+                          own, info->err);
   gt_assert(rval == 0);
   return NULL;
 }
 
+/* Merge the sorted predictions of all threads into <arrayLTRboundaries>. The
+   number of threads is small, so the next prediction is determined by a
+   linear scan over the threads. */
+static void gt_mergeboundaries(GtArrayLTRboundaries *arrayLTRboundaries,
+                               GtLTRharvestSeedRange *seedranges,
+                               unsigned int numofseedranges)
+{
+  GtUword *nextidx, total = 0;
+  unsigned int idx;
+
+  nextidx = gt_calloc((size_t) numofseedranges, sizeof (*nextidx));
+  for (idx = 0; idx < numofseedranges; idx++)
+  {
+    total += seedranges[idx].arrayLTRboundaries.nextfreeLTRboundaries;
+  }
+  if (total > 0)
+  {
+    GT_CHECKARRAYSPACEMULTI(arrayLTRboundaries,LTRboundaries,total);
+  }
+  while (true)
+  {
+    const LTRboundaries *smallest = NULL, *current;
+    unsigned int smallestidx = 0;
+
+    for (idx = 0; idx < numofseedranges; idx++)
+    {
+      if (nextidx[idx] < seedranges[idx].arrayLTRboundaries.
+                                         nextfreeLTRboundaries)
+      {
+        current = seedranges[idx].arrayLTRboundaries.spaceLTRboundaries
+                  + nextidx[idx];
+        if (smallest == NULL || bdcompare(current, smallest) < 0)
+        {
+          smallest = current;
+          smallestidx = idx;
+        }
+      }
+    }
+    if (smallest == NULL)
+    {
+      break;
+    }
+    arrayLTRboundaries->spaceLTRboundaries
+      [arrayLTRboundaries->nextfreeLTRboundaries++] = *smallest;
+    nextidx[smallestidx]++;
+  }
+  gt_free(nextidx);
+}
+
 /* The following function removes exact duplicates from the (sorted!)
    array of predicted LTR elements. Exact duplicates occur when different seeds
    are extended to same boundary coordinates. */
@@ -1256,6 +1377,7 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
 {
   GtLTRharvestStream *ltrh_stream;
   GtLTRharvestThreadInfo threadinfo;
+  unsigned int i;
   int had_err = 0;
   gt_error_check(err);
 
@@ -1272,31 +1394,45 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
       had_err = -1;
     }
 
+    /* distribute the seeds evenly among the threads */
     threadinfo.lo = ltrh_stream;
-    threadinfo.encseq = ltrh_stream->encseq;
-    threadinfo.arrayLTRboundaries = &ltrh_stream->arrayLTRboundaries;
+    threadinfo.numofseedranges = gt_jobs;
+    threadinfo.nextseedrange = 0;
+    threadinfo.seedranges = gt_malloc(sizeof (*threadinfo.seedranges)
+                                      * threadinfo.numofseedranges);
+    for (i = 0; i < threadinfo.numofseedranges; i++) {
+      GtLTRharvestSeedRange *seedrange = threadinfo.seedranges + i;
+      seedrange->mutex = gt_mutex_new();
+      seedrange->nextseed = ltrh_stream->repeatinfo.repeats.nextfreeRepeat * i
+                            / threadinfo.numofseedranges;
+      seedrange->endseed = ltrh_stream->repeatinfo.repeats.nextfreeRepeat
+                           * (i + 1) / threadinfo.numofseedranges;
+      GT_INITARRAY(&seedrange->arrayLTRboundaries, LTRboundaries);
+    }
+    threadinfo.mutex = gt_mutex_new();
     threadinfo.err = err;
-    threadinfo.cur_seed = 0;
-    threadinfo.rmutex = gt_mutex_new();
-    threadinfo.wmutex = gt_mutex_new();
     /* apply the seed extension and filter algorithms */
     if (!had_err && gt_multithread(gt_searchforLTRs_threadfunc,
                                    &threadinfo, err) != 0)
     {
       had_err = -1;
     }
-    gt_mutex_delete(threadinfo.rmutex);
-    gt_mutex_delete(threadinfo.wmutex);
+    gt_mutex_delete(threadinfo.mutex);
 
     /* not needed any longer */
     GT_FREEARRAY(&ltrh_stream->repeatinfo.repeats, Repeat);
 
-    /* sort results after seed extension */
-    if (!had_err && threadinfo.arrayLTRboundaries->spaceLTRboundaries) {
-      qsort(threadinfo.arrayLTRboundaries->spaceLTRboundaries,
-            (size_t) threadinfo.arrayLTRboundaries->nextfreeLTRboundaries,
-             sizeof (LTRboundaries),  bdcompare);
+    /* merge the sorted results of the threads */
+    if (!had_err) {
+      gt_mergeboundaries(&ltrh_stream->arrayLTRboundaries,
+                         threadinfo.seedranges, threadinfo.numofseedranges);
+    }
+    for (i = 0; i < threadinfo.numofseedranges; i++) {
+      gt_mutex_delete(threadinfo.seedranges[i].mutex);
+      GT_FREEARRAY(&threadinfo.seedranges[i].arrayLTRboundaries,
+                   LTRboundaries);
     }
+    gt_free(threadinfo.seedranges);
 
     /* remove exact duplicates */
     if (!had_err) {
@@ -24,6 +24,7 @@
 #include "match/eis-bwtseq-extinfo.h"
 #include "match/eis-bwtseq-param.h"
 #include "match/eis-bwtseq-priv.h"
+#include "match/eis-dnaocc.h"
 #include "match/eis-encidxseq.h"
 #include "match/eis-encidxseq-construct.h"
 
@@ -181,6 +182,21 @@ gt_loadBWTSeqForSA(const char *projectName, enum seqBaseEncoding encType,
       gt_deleteEncIdxSeq(seqIdx);
     }
   }
+  else if (gt_DNAOccTableExists(projectName)
+           && gt_DNAOccTableSupported(seqIdx))
+  {
+    GtUword symTotals[DNAOCC_NUMOFSYMBOLS];
+    Symbol tSym;
+    for (tSym = 0; tSym < DNAOCC_NUMOFSYMBOLS; ++tSym)
+      symTotals[tSym] = bwtSeq->count[tSym + 1] - bwtSeq->count[tSym];
+    bwtSeq->dnaOcc = gt_mapDNAOccTable(projectName, EISLength(seqIdx),
+                                       symTotals, err);
+    if (bwtSeq->dnaOcc == NULL)
+    {
+      gt_deleteBWTSeq(bwtSeq);
+      bwtSeq = NULL;
+    }
+  }
   return bwtSeq;
 }
 
@@ -288,6 +304,18 @@ gt_createBWTSeqFromSASS(const struct bwtParam *params, SASeqSrc *src,
       gt_deleteEncIdxSeq(seqIdx);
       gt_MRAEncDelete(alphabet);
     }
+    else if (params->featureToggles & BWTInterleavedOcc)
+    {
+      if (gt_writeDNAOccTable(seqIdx, bwtSeq->hint,
+                              gt_str_get(params->projectName), err) != 0)
+      {
+        gt_deleteBWTSeq(bwtSeq);
+        bwtSeq = NULL;
+      }
+    }
+    else
+      /* a table of an earlier index with the same name is outdated */
+      gt_removeDNAOccTable(gt_str_get(params->projectName));
   }
   return bwtSeq;
 }
@@ -54,6 +54,13 @@ gt_registerPackedIndexOptions(GtOptionParser *op,
     &paramOutput->useSourceRank, false);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_bool(
+    "occinterleave", "store occurrence counts of the DNA symbols interleaved "
+    "with the 2-bit encoded sequence in blocks of 64 bytes\n"
+    "this speeds up rank queries but increases the index by 4 bits per "
+    "symbol", &paramOutput->useInterleavedOcc, false);
+  gt_option_parser_add_option(op, option);
+
   option = gt_option_new_int_min_max(
     "sprankilog", "specify the interval of rank sampling as log value\n"
     "parameter i means that each 2^i-th position of source is sampled for "
@@ -98,6 +105,8 @@ gt_computePackedIndexDefaults(struct bwtOptions *paramOutput, int extraToggles)
   if (paramOutput->final.sourceRankInterval >= 0
       || paramOutput->useSourceRank)
     paramOutput->final.featureToggles |= BWTReversiblySorted;
+  if (paramOutput->useInterleavedOcc)
+    paramOutput->final.featureToggles |= BWTInterleavedOcc;
   paramOutput->final.featureToggles |= extraToggles;
   paramOutput->final.seqParams.EISFeatureSet
     = gt_convertBWTOptFlags2EISFeatures(paramOutput->defaultOptimizationFlags);
@@ -90,6 +90,10 @@ enum BWTFeatures
                                   *   reverse establishment of context
                                   *   impossible.
                                   */
+  BWTInterleavedOcc    = 1 << 3, /**< store occurrence counts of the DNA
+                                  * symbols interleaved with the 2-bit
+                                  * encoded sequence in a separate table
+                                  * for fast rank queries */
 };
 
 /**
@@ -126,6 +130,9 @@ struct bwtOptions
   bool useSourceRank;                   /**< did the user request extra
                                          * information for sort reversing of
                                          * rank-sorted symbols? */
+  bool useInterleavedOcc;               /**< did the user request the
+                                         * interleaved occurrence table for
+                                         * DNA symbols? */
  GtOption *useLocateBitmapOption;        /**< used to query wether the
                                          * option was set or left
                                          * unspecified in which case a
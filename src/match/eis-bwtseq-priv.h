@@ -20,6 +20,7 @@
 #include "core/chardef.h"
 #include "match/eis-bwtseq.h"
 #include "match/eis-bwtseq-extinfo.h"
+#include "match/eis-dnaocc.h"
 #include "match/eis-encidxseq.h"
 #include "match/pckbucket.h"
 
@@ -44,6 +45,9 @@ struct BWTSeq
   unsigned bitsPerOrigRank;
   enum rangeSortMode *rangeSort;
   Pckbuckettable *pckbuckettable;
+  DNAOccTable *dnaOcc;           /**< interleaved occurrence counts of
+                                  * the regular symbols, NULL if the
+                                  * index has none */
 };
 
 struct BWTSeqExactMatchesIterator
@@ -54,7 +54,9 @@ BWTSeqTransformedOcc(const BWTSeq *bwtSeq, Symbol tsym, GtUword pos)
   /* two counts must be treated specially:
    * 1. for the symbols mapped to the same value as the terminator
    * 2. for queries of the terminator itself */
-  if (tsym < bwtSeq->bwtTerminatorFallback)
+  if (bwtSeq->dnaOcc != NULL && tsym < DNAOCC_NUMOFSYMBOLS)
+    return DNAOccRank(bwtSeq->dnaOcc, tsym, pos);
+  else if (tsym < bwtSeq->bwtTerminatorFallback)
     return EISSymTransformedRank(bwtSeq->seqIdx, tsym, pos, bwtSeq->hint);
   else if (tsym > bwtSeq->bwtTerminatorFallback
            && tsym != bwtSeq->alphabetSize - 1)
@@ -77,7 +79,14 @@ BWTSeqTransformedPosPairOcc(const BWTSeq *bwtSeq, Symbol tSym,
   /* two counts must be treated specially:
    * 1. for the symbols mapped to the same value as the terminator
    * 2. for queries of the terminator itself */
-  if (tSym < bwtSeq->bwtTerminatorFallback)
+  if (bwtSeq->dnaOcc != NULL && tSym < DNAOCC_NUMOFSYMBOLS)
+  {
+    GtUlongPair occ;
+    occ.a = DNAOccRank(bwtSeq->dnaOcc, tSym, posA);
+    occ.b = DNAOccRank(bwtSeq->dnaOcc, tSym, posB);
+    return occ;
+  }
+  else if (tSym < bwtSeq->bwtTerminatorFallback)
     return EISSymTransformedPosPairRank(bwtSeq->seqIdx, tSym, posA, posB,
                                         bwtSeq->hint);
   else if (tSym > bwtSeq->bwtTerminatorFallback
@@ -121,6 +130,11 @@ BWTSeqRangeOcc(const BWTSeq *bwtSeq, AlphabetRangeID range, GtUword pos,
 {
   gt_assert(bwtSeq && rangeOccs);
   gt_assert(range < MRAEncGetNumRanges(BWTSeqGetAlphabet(bwtSeq)));
+  if (bwtSeq->dnaOcc != NULL && range == 0)
+  {
+    DNAOccRangeRank(bwtSeq->dnaOcc, pos, rangeOccs);
+    return;
+  }
   EISRangeRank(bwtSeq->seqIdx, range, pos, rangeOccs, bwtSeq->hint);
   if (range == bwtSeq->bwtTerminatorFallbackRange)
   {
@@ -148,6 +162,12 @@ BWTSeqPosPairRangeOcc(const BWTSeq *bwtSeq, AlphabetRangeID range,
   gt_assert(bwtSeq && rangeOccs);
   gt_assert(posA <= posB);
   gt_assert(range < MRAEncGetNumRanges(BWTSeqGetAlphabet(bwtSeq)));
+  if (bwtSeq->dnaOcc != NULL && range == 0)
+  {
+    DNAOccRangeRank(bwtSeq->dnaOcc, posA, rangeOccs);
+    DNAOccRangeRank(bwtSeq->dnaOcc, posB, rangeOccs + DNAOCC_NUMOFSYMBOLS);
+    return;
+  }
   EISPosPairRangeRank(bwtSeq->seqIdx, range, posA, posB, rangeOccs,
                       bwtSeq->hint);
   if (range == bwtSeq->bwtTerminatorFallbackRange)
@@ -125,6 +125,7 @@ gt_newBWTSeq(EISeq *seqIdx, MRAEnc *alphabet,
     * MRAEncGetNumRanges(alphabet);
   bwtSeq = gt_malloc(totalSize);
   bwtSeq->pckbuckettable = NULL;
+  bwtSeq->dnaOcc = NULL;
   counts = (GtUword *)((char  *)bwtSeq + countsOffset);
   rangeSort = (enum rangeSortMode *)((char *)bwtSeq + rangeSortOffset);
   if (!initBWTSeqFromEncSeqIdx(bwtSeq, seqIdx, alphabet, counts, rangeSort,
@@ -140,6 +141,7 @@ void
 gt_deleteBWTSeq(BWTSeq *bwtSeq)
 {
   gt_MRAEncDelete(bwtSeq->alphabet);
+  gt_deleteDNAOccTable(bwtSeq->dnaOcc);
   deleteEISHint(bwtSeq->seqIdx, bwtSeq->hint);
   gt_deleteEncIdxSeq(bwtSeq->seqIdx);
   gt_free(bwtSeq);
@@ -0,0 +1,125 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef EIS_DNAOCC_SIOP_H
+#define EIS_DNAOCC_SIOP_H
+
+#include <inttypes.h>
+#include "core/assert_api.h"
+#include "match/eis-dnaocc.h"
+
+enum {
+  DNAOCC_NUMOFSYMBOLS = 4,
+  DNAOCC_BLOCKPOSITIONS = 128,
+  DNAOCC_BLOCKSPERSUPER = 1 << 25, /* the block counts are stored with 32 bits
+                                      relative to superblocks of 2^32
+                                      positions */
+};
+
+/* 64 bytes, the file layout guarantees alignment to a cache line */
+struct dnaOccBlock
+{
+  uint32_t occ[DNAOCC_NUMOFSYMBOLS]; /* up to the start of the block,
+                                        relative to the superblock */
+  uint64_t special[2];               /* positions of non-regular symbols,
+                                        which are stored as symbol 0 */
+  uint64_t syms[4];                  /* 2 bits per position */
+};
+
+struct dnaOccTable
+{
+  void *mapptr;
+  GtUword seqLen,
+          numOfBlocks;
+  const struct dnaOccBlock *blocks;
+  const uint64_t *superOcc;          /* four counts per superblock */
+};
+
+static const uint64_t dnaOccSymPattern[DNAOCC_NUMOFSYMBOLS] =
+{
+  UINT64_C(0x0000000000000000), UINT64_C(0x5555555555555555),
+  UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xffffffffffffffff)
+};
+
+/* one bit at the lower position of each 2-bit field in which <word> has
+   the value <tSym> */
+static inline uint64_t
+DNAOccMatchMask(uint64_t word, Symbol tSym)
+{
+  uint64_t diff = word ^ dnaOccSymPattern[tSym];
+  return ~(diff | (diff >> 1)) & dnaOccSymPattern[1];
+}
+
+static inline GtUword
+DNAOccBlockRank(const struct dnaOccBlock *block, Symbol tSym, unsigned offset)
+{
+  GtUword count = 0;
+  unsigned idx;
+
+  for (idx = 0; idx < offset / 32; idx++)
+    count += __builtin_popcountll(DNAOccMatchMask(block->syms[idx], tSym));
+  if (offset % 32)
+    count += __builtin_popcountll(DNAOccMatchMask(block->syms[idx], tSym)
+                                  & ((UINT64_C(1) << (2 * (offset % 32))) - 1));
+  return count;
+}
+
+static inline GtUword
+DNAOccBlockSpecials(const struct dnaOccBlock *block, unsigned offset)
+{
+  if (offset < 64)
+    return __builtin_popcountll(block->special[0]
+                                & ((UINT64_C(1) << offset) - 1));
+  return __builtin_popcountll(block->special[0])
+    + __builtin_popcountll(block->special[1]
+                           & ((UINT64_C(1) << (offset - 64)) - 1));
+}
+
+static inline GtUword
+DNAOccRank(const DNAOccTable *table, Symbol tSym, GtUword pos)
+{
+  GtUword blockNum = pos / DNAOCC_BLOCKPOSITIONS, count;
+  unsigned offset = pos % DNAOCC_BLOCKPOSITIONS;
+  const struct dnaOccBlock *block;
+  gt_assert(table && tSym < DNAOCC_NUMOFSYMBOLS && pos <= table->seqLen);
+  block = table->blocks + blockNum;
+  count = table->superOcc[(blockNum / DNAOCC_BLOCKSPERSUPER)
+                          * DNAOCC_NUMOFSYMBOLS + tSym]
+    + block->occ[tSym] + DNAOccBlockRank(block, tSym, offset);
+  if (tSym == 0)
+    count -= DNAOccBlockSpecials(block, offset);
+  return count;
+}
+
+static inline void
+DNAOccRangeRank(const DNAOccTable *table, GtUword pos, GtUword *rankCounts)
+{
+  GtUword blockNum = pos / DNAOCC_BLOCKPOSITIONS;
+  unsigned offset = pos % DNAOCC_BLOCKPOSITIONS;
+  const struct dnaOccBlock *block;
+  const uint64_t *superOcc;
+  Symbol tSym;
+  gt_assert(table && rankCounts && pos <= table->seqLen);
+  block = table->blocks + blockNum;
+  superOcc = table->superOcc
+    + (blockNum / DNAOCC_BLOCKSPERSUPER) * DNAOCC_NUMOFSYMBOLS;
+  for (tSym = 0; tSym < DNAOCC_NUMOFSYMBOLS; ++tSym)
+    rankCounts[tSym] = superOcc[tSym] + block->occ[tSym]
+      + DNAOccBlockRank(block, tSym, offset);
+  rankCounts[0] -= DNAOccBlockSpecials(block, offset);
+}
+
+#endif
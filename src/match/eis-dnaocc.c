@@ -0,0 +1,208 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "core/xansi_api.h"
+#include "core/xposix.h"
+#include "match/eis-dnaocc.h"
+
+/* The file starts with a header of 64 bytes, followed by the blocks and
+   the counts of the superblocks. As the mapped file is page aligned, each
+   block occupies exactly one cache line. */
+
+#define DNAOCCMAGIC "GTDNAOC1"
+
+struct dnaOccHeader
+{
+  char magic[8];
+  uint64_t seqLen,
+           numOfBlocks,
+           numOfSuper,
+           reserved[4];
+};
+
+static inline GtUword
+numOfBlocksForLength(GtUword seqLen)
+{
+  return seqLen / DNAOCC_BLOCKPOSITIONS + 1;
+}
+
+static inline GtUword
+numOfSuperForBlocks(GtUword numOfBlocks)
+{
+  return (numOfBlocks + DNAOCC_BLOCKSPERSUPER - 1) / DNAOCC_BLOCKSPERSUPER;
+}
+
+bool
+gt_DNAOccTableSupported(const EISeq *seqIdx)
+{
+  const MRAEnc *alphabet = EISGetAlphabet(seqIdx);
+  return MRAEncGetRangeBase(alphabet, 0) == 0
+    && MRAEncGetRangeSize(alphabet, 0) == DNAOCC_NUMOFSYMBOLS;
+}
+
+int
+gt_writeDNAOccTable(EISeq *seqIdx, EISHint hint, const char *projectName,
+                    GtError *err)
+{
+  struct dnaOccHeader header;
+  struct dnaOccBlock block;
+  GtUword seqLen, blockNum, pos, total[DNAOCC_NUMOFSYMBOLS],
+    superBase[DNAOCC_NUMOFSYMBOLS];
+  uint64_t *superOcc;
+  FILE *fp;
+  Symbol tSym;
+  gt_error_check(err);
+  gt_assert(seqIdx && projectName);
+  if (!gt_DNAOccTableSupported(seqIdx))
+  {
+    gt_error_set(err, "interleaved occurrence counts are only supported for "
+                 "DNA sequences");
+    return -1;
+  }
+  fp = gt_fa_fopen_with_suffix(projectName, DNAOCCTABLESUFFIX, "wb", err);
+  if (fp == NULL)
+    return -1;
+  seqLen = EISLength(seqIdx);
+  memset(&header, 0, sizeof (header));
+  memcpy(header.magic, DNAOCCMAGIC, sizeof (header.magic));
+  header.seqLen = (uint64_t) seqLen;
+  header.numOfBlocks = (uint64_t) numOfBlocksForLength(seqLen);
+  header.numOfSuper = (uint64_t) numOfSuperForBlocks(header.numOfBlocks);
+  gt_xfwrite(&header, sizeof (header), (size_t) 1, fp);
+  superOcc = gt_malloc(sizeof (*superOcc) * DNAOCC_NUMOFSYMBOLS
+                       * header.numOfSuper);
+  memset(total, 0, sizeof (total));
+  memset(superBase, 0, sizeof (superBase));
+  pos = 0;
+  for (blockNum = 0; blockNum < (GtUword) header.numOfBlocks; ++blockNum)
+  {
+    unsigned offset;
+    if (blockNum % DNAOCC_BLOCKSPERSUPER == 0)
+      for (tSym = 0; tSym < DNAOCC_NUMOFSYMBOLS; ++tSym)
+        superOcc[(blockNum / DNAOCC_BLOCKSPERSUPER) * DNAOCC_NUMOFSYMBOLS
+                 + tSym] = (uint64_t) (superBase[tSym] = total[tSym]);
+    memset(&block, 0, sizeof (block));
+    for (tSym = 0; tSym < DNAOCC_NUMOFSYMBOLS; ++tSym)
+      block.occ[tSym] = (uint32_t) (total[tSym] - superBase[tSym]);
+    for (offset = 0; offset < DNAOCC_BLOCKPOSITIONS && pos < seqLen;
+         ++offset, ++pos)
+    {
+      tSym = EISGetTransformedSym(seqIdx, pos, hint);
+      if (tSym < DNAOCC_NUMOFSYMBOLS)
+      {
+        block.syms[offset / 32] |= (uint64_t) tSym << (2 * (offset % 32));
+        ++total[tSym];
+      }
+      else
+        block.special[offset / 64] |= UINT64_C(1) << (offset % 64);
+    }
+    gt_xfwrite(&block, sizeof (block), (size_t) 1, fp);
+  }
+  gt_xfwrite(superOcc, sizeof (*superOcc),
+             (size_t) (DNAOCC_NUMOFSYMBOLS * header.numOfSuper), fp);
+  gt_free(superOcc);
+  gt_fa_fclose(fp);
+  return 0;
+}
+
+bool
+gt_DNAOccTableExists(const char *projectName)
+{
+  return gt_file_exists_with_suffix(projectName, DNAOCCTABLESUFFIX);
+}
+
+void
+gt_removeDNAOccTable(const char *projectName)
+{
+  if (gt_DNAOccTableExists(projectName))
+  {
+    GtStr *filename = gt_str_new_cstr(projectName);
+    gt_str_append_cstr(filename, DNAOCCTABLESUFFIX);
+    gt_xunlink(gt_str_get(filename));
+    gt_str_delete(filename);
+  }
+}
+
+DNAOccTable *
+gt_mapDNAOccTable(const char *projectName, GtUword seqLen,
+                  const GtUword *symTotals, GtError *err)
+{
+  DNAOccTable *table;
+  const struct dnaOccHeader *header;
+  size_t numOfBytes;
+  void *mapptr;
+  bool haserr = false;
+  gt_error_check(err);
+  gt_assert(projectName && symTotals);
+  mapptr = gt_fa_mmap_read_with_suffix(projectName, DNAOCCTABLESUFFIX,
+                                       &numOfBytes, err);
+  if (mapptr == NULL)
+    return NULL;
+  header = mapptr;
+  if (numOfBytes < sizeof (*header)
+      || memcmp(header->magic, DNAOCCMAGIC, sizeof (header->magic)) != 0
+      || header->seqLen != (uint64_t) seqLen
+      || header->numOfBlocks != (uint64_t) numOfBlocksForLength(seqLen)
+      || header->numOfSuper != (uint64_t) numOfSuperForBlocks(
+                                                    header->numOfBlocks)
+      || numOfBytes != sizeof (*header)
+                       + sizeof (struct dnaOccBlock) * header->numOfBlocks
+                       + sizeof (uint64_t) * DNAOCC_NUMOFSYMBOLS
+                         * header->numOfSuper)
+  {
+    gt_error_set(err, "file %s%s is not a valid occurrence table for an index "
+                 "of length "GT_WU, projectName, DNAOCCTABLESUFFIX, seqLen);
+    gt_fa_xmunmap(mapptr);
+    return NULL;
+  }
+  table = gt_malloc(sizeof (*table));
+  table->mapptr = mapptr;
+  table->seqLen = seqLen;
+  table->numOfBlocks = (GtUword) header->numOfBlocks;
+  table->blocks = (const struct dnaOccBlock *) (header + 1);
+  table->superOcc = (const uint64_t *) (table->blocks + table->numOfBlocks);
+  {
+    GtUword rankCounts[DNAOCC_NUMOFSYMBOLS];
+    Symbol tSym;
+    DNAOccRangeRank(table, seqLen, rankCounts);
+    for (tSym = 0; tSym < DNAOCC_NUMOFSYMBOLS; ++tSym)
+      if (rankCounts[tSym] != symTotals[tSym])
+        haserr = true;
+  }
+  if (haserr)
+  {
+    gt_error_set(err, "occurrence table %s%s does not match the index, "
+                 "rebuild the index", projectName, DNAOCCTABLESUFFIX);
+    gt_deleteDNAOccTable(table);
+    return NULL;
+  }
+  return table;
+}
+
+void
+gt_deleteDNAOccTable(DNAOccTable *table)
+{
+  if (table != NULL)
+  {
+    gt_fa_xmunmap(table->mapptr);
+    gt_free(table);
+  }
+}
@@ -0,0 +1,101 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef EIS_DNAOCC_H
+#define EIS_DNAOCC_H
+
+/**
+ * \file eis-dnaocc.h
+ * Occurrence counts of the four DNA symbols of a BWT sequence index,
+ * stored interleaved with the 2-bit encoded BWT. Each block of 64 bytes
+ * (one cache line) holds the counts up to the start of the block and
+ * the symbols of the next 128 positions, so a rank query reads a single
+ * block and counts the remaining occurrences with popcount.
+ */
+
+#include <stdbool.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+#include "match/eis-encidxseq.h"
+
+#define DNAOCCTABLESUFFIX ".ocx"
+
+/** holds an occurrence table mapped from file */
+typedef struct dnaOccTable DNAOccTable;
+
+/**
+ * \brief Tells whether the alphabet of an encoded indexed sequence
+ * allows the representation by a DNA occurrence table, i.e. whether
+ * its first range consists of exactly four symbols.
+ */
+bool
+gt_DNAOccTableSupported(const EISeq *seqIdx);
+
+/**
+ * \brief Write the occurrence table for the regular symbols of
+ * <seqIdx> to the file <projectName>.ocx.
+ * @param seqIdx sequence index to read all symbols from
+ * @param hint hint object for <seqIdx>
+ * @return 0 on success, -1 on error (err is set accordingly)
+ */
+int
+gt_writeDNAOccTable(EISeq *seqIdx, EISHint hint, const char *projectName,
+                    GtError *err);
+
+/**
+ * \brief Tells whether file <projectName>.ocx exists.
+ */
+bool
+gt_DNAOccTableExists(const char *projectName);
+
+/**
+ * \brief Remove file <projectName>.ocx, if it exists.
+ */
+void
+gt_removeDNAOccTable(const char *projectName);
+
+/**
+ * \brief Map the occurrence table of <projectName> into memory.
+ * @param seqLen length of the indexed sequence
+ * @param symTotals number of occurrences of the four regular symbols
+ * in the whole sequence, used to check that the table belongs to the
+ * index
+ * @return NULL on error (err is set accordingly)
+ */
+DNAOccTable *
+gt_mapDNAOccTable(const char *projectName, GtUword seqLen,
+                  const GtUword *symTotals, GtError *err);
+
+void
+gt_deleteDNAOccTable(DNAOccTable *table);
+
+/**
+ * \brief Return number of occurrences of regular symbol tSym (0..3) up
+ * to but not including position pos.
+ */
+static inline GtUword
+DNAOccRank(const DNAOccTable *table, Symbol tSym, GtUword pos);
+
+/**
+ * \brief Write the number of occurrences of all four regular symbols
+ * up to but not including position pos to rankCounts[0..3].
+ */
+static inline void
+DNAOccRangeRank(const DNAOccTable *table, GtUword pos, GtUword *rankCounts);
+
+#include "match/eis-dnaocc-siop.h"
+
+#endif
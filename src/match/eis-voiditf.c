@@ -413,6 +413,27 @@ void gt_deletevoidBWTSeq(FMindex *fmindex)
   gt_deleteBWTSeq(bwtseq);
 }
 
+FMindex *gt_voidBWTSeq_new_shared(const FMindex *fmindex)
+{
+  const BWTSeq *bwtseq = (const BWTSeq *) fmindex;
+  BWTSeq *shared = gt_malloc(sizeof *shared);
+
+  *shared = *bwtseq;
+  shared->hint = newEISHint(bwtseq->seqIdx);
+  return (FMindex *) shared;
+}
+
+void gt_voidBWTSeq_delete_shared(FMindex *fmindex)
+{
+  BWTSeq *shared = (BWTSeq *) fmindex;
+
+  if (shared != NULL)
+  {
+    deleteEISHint(shared->seqIdx, shared->hint);
+    gt_free(shared);
+  }
+}
+
 GtUword gt_voidpackedindexuniqueforward(const void *fmindex,
                                               GT_UNUSED GtUword offset,
                                               GT_UNUSED GtUword left,
@@ -462,7 +483,7 @@ bool gt_pck_exactpatternmatching(const FMindex *fmindex,
                                  const GtUchar *pattern,
                                  GtUword patternlength,
                                  GtUword totallength,
-                                 const GtUchar *dbsubstring,
+                                 GT_UNUSED const GtUchar *dbsubstring,
                                  ProcessIdxMatch processmatch,
                                  void *processmatchinfo)
 {
@@ -476,7 +497,7 @@ bool gt_pck_exactpatternmatching(const FMindex *fmindex,
   numofmatches = gt_EMINumMatchesTotal(bsemi);
   match.dbabsolute = true;
   match.dblen = patternlength;
-  match.dbsubstring = dbsubstring;
+  match.dbsubstring = pattern;
   match.querystartpos = 0;
   match.querylen = patternlength;
   match.distance = 0;
@@ -83,6 +83,14 @@ FMindex *gt_loadvoidBWTSeqForSA(const char *indexname,
 
 void gt_deletevoidBWTSeq(FMindex *packedindex);
 
+/* Returns a new handle on the packed index <fmindex> which shares all tables
+   with <fmindex> but has its own lookup cache. Different threads can query
+   the index concurrently, if each uses its own handle. The handle must be
+   deleted with <gt_voidBWTSeq_delete_shared()> before <fmindex>. */
+FMindex *gt_voidBWTSeq_new_shared(const FMindex *fmindex);
+
+void gt_voidBWTSeq_delete_shared(FMindex *fmindex);
+
 /* the parameter is const void *, as this is required by the other
    indexed based methods */
 
@@ -0,0 +1,180 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "esa-bottomup-parts.h"
+
+GtESAparts *gt_esa_parts_new(GtUword mindepth,
+                             unsigned int numofparts,
+                             GtUword maxsuffixes)
+{
+  GtESAparts *esaparts = gt_malloc(sizeof (*esaparts));
+
+  gt_assert(mindepth > 0 && numofparts > 0 && maxsuffixes > 0);
+  esaparts->mindepth = mindepth;
+  esaparts->numofparts = numofparts;
+  esaparts->maxsuffixes = maxsuffixes;
+  esaparts->allocatedsuffixes = maxsuffixes;
+  esaparts->suftab = gt_malloc(sizeof (*esaparts->suftab) * maxsuffixes);
+  esaparts->lcptab = gt_malloc(sizeof (*esaparts->lcptab) * (maxsuffixes+1));
+  esaparts->partends = gt_malloc(sizeof (*esaparts->partends) * numofparts);
+  gt_esa_parts_reset(esaparts);
+  return esaparts;
+}
+
+void gt_esa_parts_reset(GtESAparts *esaparts)
+{
+  unsigned int part;
+
+  gt_assert(esaparts != NULL);
+  esaparts->numofsuffixes = 0;
+  esaparts->lcptab[0] = 0;
+  for (part = 0; part < esaparts->numofparts; part++)
+  {
+    esaparts->partends[part] = 0;
+  }
+}
+
+void gt_esa_parts_add(GtESAparts *esaparts, GtUword suffix, GtUword nextlcp)
+{
+  gt_assert(esaparts != NULL);
+  if (esaparts->numofsuffixes >= esaparts->allocatedsuffixes)
+  {
+    /* the current block exceeds the section */
+    esaparts->allocatedsuffixes += esaparts->allocatedsuffixes/2;
+    esaparts->suftab = gt_realloc(esaparts->suftab,
+                                  sizeof (*esaparts->suftab) *
+                                  esaparts->allocatedsuffixes);
+    esaparts->lcptab = gt_realloc(esaparts->lcptab,
+                                  sizeof (*esaparts->lcptab) *
+                                  (esaparts->allocatedsuffixes+1));
+  }
+  esaparts->suftab[esaparts->numofsuffixes++] = suffix;
+  esaparts->lcptab[esaparts->numofsuffixes] = (GtLcpvaluetype) nextlcp;
+}
+
+bool gt_esa_parts_full(const GtESAparts *esaparts)
+{
+  gt_assert(esaparts != NULL);
+  return esaparts->numofsuffixes >= esaparts->maxsuffixes &&
+         (GtUword) esaparts->lcptab[esaparts->numofsuffixes]
+           < esaparts->mindepth;
+}
+
+int gt_esa_parts_read(GtESAparts *esaparts,
+                      Sequentialsuffixarrayreader *ssar,
+                      GtUword *remaining,
+                      GtError *err)
+{
+  GtUword suffix, lcpvalue;
+  int retval;
+  bool haserr = false;
+
+  gt_error_check(err);
+  gt_esa_parts_reset(esaparts);
+  while (*remaining > 0 && !gt_esa_parts_full(esaparts))
+  {
+    retval = gt_nextSequentiallcpvalue(&lcpvalue,ssar,err);
+    if (retval < 0)
+    {
+      haserr = true;
+      break;
+    }
+    if (retval == 0)
+    {
+      /* no successor */
+      lcpvalue = 0;
+    }
+    if (gt_nextSequentialsuftabvalue(&suffix,ssar) != 1)
+    {
+      gt_error_set(err,"Missing value in suftab");
+      haserr = true;
+      break;
+    }
+    gt_esa_parts_add(esaparts,suffix,lcpvalue);
+    (*remaining)--;
+  }
+  if (!haserr && *remaining == 0 && esaparts->numofsuffixes > 0)
+  {
+    /* the nonspecial suffixes are followed by the special suffixes, which
+       are not part of any lcp-interval */
+    esaparts->lcptab[esaparts->numofsuffixes] = 0;
+  }
+  if (!haserr)
+  {
+    gt_esa_parts_split(esaparts);
+  }
+  return haserr ? -1 : 0;
+}
+
+GtUword gt_esa_parts_blockend(const GtESAparts *esaparts, GtUword start)
+{
+  GtUword idx;
+
+  gt_assert(esaparts != NULL && start < esaparts->numofsuffixes);
+  for (idx = start; idx + 1 < esaparts->numofsuffixes &&
+                    (GtUword) esaparts->lcptab[idx+1] >= esaparts->mindepth;
+       idx++)
+    /* Nothing */ ;
+  return idx;
+}
+
+void gt_esa_parts_split(GtESAparts *esaparts)
+{
+  GtUword start = 0, width;
+  unsigned int part;
+
+  gt_assert(esaparts != NULL);
+  width = esaparts->numofsuffixes/esaparts->numofparts;
+  for (part = 0; part < esaparts->numofparts; part++)
+  {
+    if (part + 1 == esaparts->numofparts)
+    {
+      start = esaparts->numofsuffixes;
+    } else
+    {
+      if (start < esaparts->numofsuffixes &&
+          start < (part+1) * width)
+      {
+        start = gt_esa_parts_blockend(esaparts,
+                                      MAX(start,(part+1) * width - 1)) + 1;
+      }
+    }
+    esaparts->partends[part] = start;
+  }
+}
+
+void gt_esa_parts_range(const GtESAparts *esaparts,
+                        unsigned int part,
+                        GtUword *start,
+                        GtUword *end)
+{
+  gt_assert(esaparts != NULL && part < esaparts->numofparts);
+  *start = part == 0 ? 0 : esaparts->partends[part-1];
+  *end = esaparts->partends[part];
+}
+
+void gt_esa_parts_delete(GtESAparts *esaparts)
+{
+  if (esaparts != NULL)
+  {
+    gt_free(esaparts->suftab);
+    gt_free(esaparts->lcptab);
+    gt_free(esaparts->partends);
+    gt_free(esaparts);
+  }
+}
@@ -0,0 +1,94 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ESA_BOTTOMUP_PARTS_H
+#define ESA_BOTTOMUP_PARTS_H
+
+#include "core/error_api.h"
+#include "esa-seqread.h"
+#include "bcktab.h"
+
+/* A <GtESAparts> object buffers a section of consecutive suffixes of an
+   enhanced suffix array together with their lcp values and splits it into
+   parts which can be traversed bottom-up independently of each other. A
+   section and each part end at a suffix whose lcp value to its successor is
+   smaller than <mindepth>. Hence every lcp-interval with an lcp value of at
+   least <mindepth> is contained in one part. The suffixes between two such
+   positions form a block, which is a single leaf or a single lcp-interval
+   of the lcp-interval tree. */
+
+/* The default number of suffixes per part in a section. */
+#define GT_ESA_PARTS_SUFFIXES_PER_PART (1UL << 18)
+
+typedef struct
+{
+  GtUword *suftab,
+          numofsuffixes,
+          allocatedsuffixes,
+          maxsuffixes,
+          mindepth,
+          *partends;
+  /* lcptab[idx] is the lcp value of suftab[idx-1] and suftab[idx],
+     lcptab[numofsuffixes] is the lcp value of the last suffix and its
+     successor. */
+  GtLcpvaluetype *lcptab;
+  unsigned int numofparts;
+} GtESAparts;
+
+/* Returns a new <GtESAparts> object splitting sections of about
+   <maxsuffixes> suffixes into at most <numofparts> parts. <mindepth> must be
+   at least 1. */
+GtESAparts *gt_esa_parts_new(GtUword mindepth,
+                             unsigned int numofparts,
+                             GtUword maxsuffixes);
+
+/* Appends suffix <suffix> whose lcp value to its successor is <nextlcp>. */
+void        gt_esa_parts_add(GtESAparts *esaparts,
+                             GtUword suffix,
+                             GtUword nextlcp);
+
+/* Returns true if the current section is complete, i.e. it contains at least
+   <maxsuffixes> suffixes and ends at a block boundary. */
+bool        gt_esa_parts_full(const GtESAparts *esaparts);
+
+/* Reads the next section from <ssar>, of which <remaining> nonspecial
+   suffixes are still to be read. Afterwards, the section is split into
+   parts. Returns -1 on error, 0 otherwise. */
+int         gt_esa_parts_read(GtESAparts *esaparts,
+                              Sequentialsuffixarrayreader *ssar,
+                              GtUword *remaining,
+                              GtError *err);
+
+/* Splits the current section into parts of about equal size. */
+void        gt_esa_parts_split(GtESAparts *esaparts);
+
+/* Stores the range of part <part> of the current section in <start> and
+   <end> (exclusive). The range is empty if <start> equals <end>. */
+void        gt_esa_parts_range(const GtESAparts *esaparts,
+                               unsigned int part,
+                               GtUword *start,
+                               GtUword *end);
+
+/* Returns the index of the last suffix of the block beginning at index
+   <start> of the current section. */
+GtUword     gt_esa_parts_blockend(const GtESAparts *esaparts, GtUword start);
+
+/* Removes all suffixes from <esaparts>. */
+void        gt_esa_parts_reset(GtESAparts *esaparts);
+
+void        gt_esa_parts_delete(GtESAparts *esaparts);
+
+#endif
@@ -17,6 +17,10 @@
 
 #include "core/arraydef.h"
 #include "core/unused_api.h"
+#ifdef GT_THREADS_ENABLED
+#include "core/thread_api.h"
+#endif
+#include "esa-bottomup-parts.h"
 #include "esa-seqread.h"
 #include "esa-maxpairs.h"
 #include "sfx-sain.h"
@@ -65,6 +69,11 @@ typedef struct  /* global information */
   GtReadmode readmode;
   GtProcessmaxpairs processmaxpairs;
   void *processmaxpairsinfo;
+  /* the remaining components are used when processing parts of the
+     enhanced suffix array in separate threads */
+  GtUword idxoffset,
+                previousbucketlastsuffix;
+  bool firstedgefromroot;
 } GtBUstate_maxpairs;
 
 static void initBUinfo_maxpairs(GtBUinfo_maxpairs *buinfo,
@@ -383,23 +392,25 @@ static GtUword gt_ssar_ssli_nonspecials(const Sequentialsuffixarrayreader *ssar,
 
 #include "esa-bottomup-maxpairs.inc"
 
-int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
-                                 GtSainSufLcpIterator *suflcpiterator,
-                                 unsigned int searchlength,
-                                 GtProcessmaxpairs processmaxpairs,
-                                 void *processmaxpairsinfo,
-                                 GtError *err)
+static GtBUstate_maxpairs *gt_maxpairs_state_new(
+                                     Sequentialsuffixarrayreader *ssar,
+                                     GtSainSufLcpIterator *suflcpiterator,
+                                     unsigned int searchlength,
+                                     GtProcessmaxpairs processmaxpairs,
+                                     void *processmaxpairsinfo)
 {
   unsigned int base;
   GtArrayGtUlong *ptr;
   GtBUstate_maxpairs *state;
-  bool haserr = false;
 
   state = gt_malloc(sizeof (*state));
   state->searchlength = searchlength;
   state->processmaxpairs = processmaxpairs;
   state->processmaxpairsinfo = processmaxpairsinfo;
   state->initialized = false;
+  state->idxoffset = 0;
+  state->previousbucketlastsuffix = ULONG_MAX;
+  state->firstedgefromroot = true;
   if (ssar != NULL)
   {
     const GtEncseq *encseq = gt_encseqSequentialsuffixarrayreader(ssar);
@@ -428,10 +439,14 @@ int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
     ptr = &state->poslist[base];
     GT_INITARRAY(ptr,GtUlong);
   }
-  if (gt_esa_bottomup_maxpairs(ssar, suflcpiterator,  state, err) != 0)
-  {
-    haserr = true;
-  }
+  return state;
+}
+
+static void gt_maxpairs_state_delete(GtBUstate_maxpairs *state)
+{
+  unsigned int base;
+  GtArrayGtUlong *ptr;
+
   GT_FREEARRAY(&state->uniquechar,GtUlong);
   for (base = 0; base < state->alphabetsize; base++)
   {
@@ -440,6 +455,240 @@ int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
   }
   gt_free(state->poslist);
   gt_free(state);
+}
+
+#ifdef GT_THREADS_ENABLED
+
+#include "esa-bottomup-maxpairs-RAM.inc"
+
+/* Maximal pairs only occur in lcp-intervals of depth at least <searchlength>.
+   Hence the enhanced suffix array is split into parts at suffixes whose lcp
+   value to the successor is smaller than <searchlength> and the parts of a
+   section are processed in separate threads. The maximal pairs found in a
+   part are buffered and passed to <processmaxpairs> in the order of the parts,
+   so that the output is the same as for the sequential traversal. */
+
+typedef struct
+{
+  GtUword length, pos1, pos2;
+} GtMaxpair;
+
+GT_DECLAREARRAYSTRUCT(GtMaxpair);
+
+typedef struct
+{
+  GtBUstate_maxpairs *state;
+  GtArrayGtBUItvinfo_maxpairs *stack;
+  const GtESAparts *esaparts;
+  unsigned int part;
+  GtArrayGtMaxpair maxpairs;
+  GtError *err;
+  bool haserr;
+  GtThread *thread;
+} GtMaxpairsThreadinfo;
+
+static int gt_maxpairs_buffer(void *info,
+                              GT_UNUSED const GtGenericEncseq *genericencseq,
+                              GtUword length,
+                              GtUword pos1,
+                              GtUword pos2,
+                              GT_UNUSED GtError *err)
+{
+  GtArrayGtMaxpair *maxpairs = (GtArrayGtMaxpair *) info;
+  GtMaxpair *maxpair;
+
+  GT_GETNEXTFREEINARRAY(maxpair,maxpairs,GtMaxpair,
+                        256 + maxpairs->allocatedGtMaxpair/4);
+  maxpair->length = length;
+  maxpair->pos1 = pos1;
+  maxpair->pos2 = pos2;
+  return 0;
+}
+
+static void *gt_maxpairs_thread_caller(void *data)
+{
+  GtMaxpairsThreadinfo *threadinfo = (GtMaxpairsThreadinfo *) data;
+  const GtESAparts *esaparts = threadinfo->esaparts;
+  GtUword start, end;
+
+  threadinfo->maxpairs.nextfreeGtMaxpair = 0;
+  gt_esa_parts_range(esaparts,threadinfo->part,&start,&end);
+  if (start < end)
+  {
+    /* the part is processed like a complete enhanced suffix array, which
+       ends with an lcp value of 0 */
+    threadinfo->state->previousbucketlastsuffix = ULONG_MAX;
+    if (gt_esa_bottomup_RAM_maxpairs(esaparts->suftab + start,
+                                     esaparts->lcptab + start,
+                                     end - start,
+                                     threadinfo->stack,
+                                     threadinfo->state,
+                                     threadinfo->err) != 0 ||
+        gt_esa_bottomup_RAM_previousfromlast_maxpairs(
+                                     esaparts->suftab[end-1],
+                                     0,
+                                     threadinfo->stack,
+                                     threadinfo->state,
+                                     threadinfo->err) != 0)
+    {
+      threadinfo->haserr = true;
+    }
+    threadinfo->stack->nextfreeGtBUItvinfo = 0;
+  }
+  return NULL;
+}
+
+static void gt_esa_parts_read_sain(GtESAparts *esaparts,
+                                   GtSainSufLcpIterator *suflcpiterator,
+                                   GtUword *remaining)
+{
+  GtUword suffix, lcpvalue = 0;
+
+  gt_esa_parts_reset(esaparts);
+  while (*remaining > 0 && !gt_esa_parts_full(esaparts))
+  {
+    suffix = gt_sain_suf_lcp_iterator_next(&lcpvalue,suflcpiterator);
+    if (--(*remaining) == 0)
+    {
+      lcpvalue = 0;
+    }
+    gt_esa_parts_add(esaparts,suffix,lcpvalue);
+  }
+  gt_esa_parts_split(esaparts);
+}
+
+static int gt_enumeratemaxpairs_threaded(Sequentialsuffixarrayreader *ssar,
+                                         GtSainSufLcpIterator *suflcpiterator,
+                                         unsigned int searchlength,
+                                         GtProcessmaxpairs processmaxpairs,
+                                         void *processmaxpairsinfo,
+                                         unsigned int threads,
+                                         GtError *err)
+{
+  GtMaxpairsThreadinfo *threadinfo;
+  GtESAparts *esaparts;
+  GtUword remaining, idx;
+  unsigned int t;
+  bool haserr = false;
+
+  gt_assert(threads >= 2U && searchlength > 0);
+  esaparts = gt_esa_parts_new((GtUword) searchlength,threads,
+                              threads * GT_ESA_PARTS_SUFFIXES_PER_PART);
+  threadinfo = gt_malloc(sizeof (*threadinfo) * threads);
+  for (t = 0; t < threads; t++)
+  {
+    GT_INITARRAY(&threadinfo[t].maxpairs,GtMaxpair);
+    threadinfo[t].state = gt_maxpairs_state_new(ssar,suflcpiterator,
+                                                searchlength,
+                                                gt_maxpairs_buffer,
+                                                &threadinfo[t].maxpairs);
+    threadinfo[t].stack = gt_GtArrayGtBUItvinfo_new_maxpairs();
+    threadinfo[t].esaparts = esaparts;
+    threadinfo[t].part = t;
+    threadinfo[t].err = gt_error_new();
+    threadinfo[t].haserr = false;
+  }
+  remaining = ssar != NULL ? gt_Sequentialsuffixarrayreader_nonspecials(ssar)
+                           : gt_sain_suf_lcp_iterator_nonspecials(
+                                                              suflcpiterator);
+  while (!haserr && remaining > 0)
+  {
+    if (ssar != NULL)
+    {
+      if (gt_esa_parts_read(esaparts,ssar,&remaining,err) != 0)
+      {
+        haserr = true;
+        break;
+      }
+    } else
+    {
+      gt_esa_parts_read_sain(esaparts,suflcpiterator,&remaining);
+    }
+    for (t = 0; t < threads; t++)
+    {
+      threadinfo[t].thread = gt_thread_new(gt_maxpairs_thread_caller,
+                                           threadinfo + t,err);
+      if (threadinfo[t].thread == NULL)
+      {
+        haserr = true;
+      }
+    }
+    for (t = 0; t < threads; t++)
+    {
+      if (threadinfo[t].thread != NULL)
+      {
+        gt_thread_join(threadinfo[t].thread);
+        gt_thread_delete(threadinfo[t].thread);
+      }
+    }
+    for (t = 0; !haserr && t < threads; t++)
+    {
+      const GtArrayGtMaxpair *maxpairs = &threadinfo[t].maxpairs;
+
+      if (threadinfo[t].haserr)
+      {
+        gt_error_set(err,"%s",gt_error_get(threadinfo[t].err));
+        haserr = true;
+        break;
+      }
+      for (idx = 0; idx < maxpairs->nextfreeGtMaxpair; idx++)
+      {
+        const GtMaxpair *maxpair = maxpairs->spaceGtMaxpair + idx;
+
+        if (processmaxpairs(processmaxpairsinfo,
+                            &threadinfo[t].state->genericencseq,
+                            maxpair->length,maxpair->pos1,maxpair->pos2,
+                            err) != 0)
+        {
+          haserr = true;
+          break;
+        }
+      }
+    }
+  }
+  for (t = 0; t < threads; t++)
+  {
+    gt_GtArrayGtBUItvinfo_delete_maxpairs(threadinfo[t].stack,
+                                          threadinfo[t].state);
+    gt_maxpairs_state_delete(threadinfo[t].state);
+    GT_FREEARRAY(&threadinfo[t].maxpairs,GtMaxpair);
+    gt_error_delete(threadinfo[t].err);
+  }
+  gt_free(threadinfo);
+  gt_esa_parts_delete(esaparts);
+  return haserr ? -1 : 0;
+}
+#endif
+
+int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
+                                 GtSainSufLcpIterator *suflcpiterator,
+                                 unsigned int searchlength,
+                                 GtProcessmaxpairs processmaxpairs,
+                                 void *processmaxpairsinfo,
+                                 GtError *err)
+{
+  GtBUstate_maxpairs *state;
+  bool haserr = false;
+
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U && searchlength > 0)
+  {
+    return gt_enumeratemaxpairs_threaded(ssar,
+                                         suflcpiterator,
+                                         searchlength,
+                                         processmaxpairs,
+                                         processmaxpairsinfo,
+                                         gt_jobs,
+                                         err);
+  }
+#endif
+  state = gt_maxpairs_state_new(ssar,suflcpiterator,searchlength,
+                                processmaxpairs,processmaxpairsinfo);
+  if (gt_esa_bottomup_maxpairs(ssar, suflcpiterator,  state, err) != 0)
+  {
+    haserr = true;
+  }
+  gt_maxpairs_state_delete(state);
   return haserr ? -1 : 0;
 }
 
@@ -16,15 +16,22 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/unused_api.h"
 #include "core/array2dim_api.h"
+#include "core/arraydef.h"
 #include "core/logger.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/format64.h"
+#include "core/minmax.h"
+#ifdef GT_THREADS_ENABLED
+#include "core/thread_api.h"
+#endif
 #undef SHUDEBUG
 #ifdef SHUDEBUG
 #include "core/encseq.h"
 #endif
+#include "esa-bottomup-parts.h"
 #include "esa-seqread.h"
 #include "esa-splititv.h"
 #include "shu_unitfile.h"
@@ -371,6 +378,371 @@ static void shulengthdist_print(const GtStrArray *file_names,
 }
 
 #include "esa-bottomup-shulen.inc"
+#include "esa-bottomup-shulen-RAM.inc"
+
+#ifdef GT_THREADS_ENABLED
+
+/* For the threaded computation, the enhanced suffix array is split into
+   blocks at suffixes whose lcp value to the successor is smaller than some
+   small depth. Each block is a leaf or an lcp-interval whose subtree is
+   processed in a separate thread, which sums up the contributions inside the
+   subtree in its own shulen distribution. The edges above the blocks are then
+   processed in the original order using the genome distributions of the
+   blocks. */
+
+typedef struct
+{
+  GtUword start, end, lcp, distoffset;
+} GtShulenBlock;
+
+GT_DECLAREARRAYSTRUCT(GtShulenBlock);
+
+typedef struct
+{
+  GtBUstate_shulen *state;
+  const GtESAparts *esaparts;
+  unsigned int part;
+  GtArrayGtShulenBlock blocks;
+  GtArrayGtUword dists;
+  GtError *err;
+  bool haserr;
+  GtThread *thread;
+} GtShulenThreadinfo;
+
+static GtBUstate_shulen *gt_shulen_thread_state_new(
+                                            const GtBUstate_shulen *bustate)
+{
+  GtBUstate_shulen *state = gt_malloc(sizeof (*state));
+
+  state->numofdbfiles = bustate->numofdbfiles;
+  state->encseq = bustate->encseq;
+  state->file_to_genome_map = bustate->file_to_genome_map;
+#ifdef GENOMEDIFF_PAPER_IMPL
+  state->leafdist = gt_malloc(sizeof (*state->leafdist) * state->numofdbfiles);
+#endif
+#ifdef SHUDEBUG
+  state->nextid = 0;
+#endif
+  state->shulengthdist = shulengthdist_new(state->numofdbfiles);
+  state->idxoffset = 0;
+  state->previousbucketlastsuffix = ULONG_MAX;
+  state->firstedgefromroot = true;
+  state->unit_info = NULL;
+  state->stack = (void *) gt_GtArrayGtBUItvinfo_new_shulen();
+  return state;
+}
+
+static void gt_shulen_thread_state_delete(GtBUstate_shulen *state)
+{
+  gt_GtArrayGtBUItvinfo_delete_shulen(state->stack,state);
+  gt_array2dim_delete(state->shulengthdist);
+#ifdef GENOMEDIFF_PAPER_IMPL
+  gt_free(state->leafdist);
+#endif
+  gt_free(state);
+}
+
+static void *gt_shulen_thread_caller(void *data)
+{
+  GtShulenThreadinfo *threadinfo = (GtShulenThreadinfo *) data;
+  const GtESAparts *esaparts = threadinfo->esaparts;
+  GtBUstate_shulen *state = threadinfo->state;
+  GtArrayGtBUItvinfo_shulen *stack = state->stack;
+  GtUword start, end, idx, blockend, i;
+
+  threadinfo->blocks.nextfreeGtShulenBlock = 0;
+  threadinfo->dists.nextfreeGtUword = 0;
+  gt_esa_parts_range(esaparts,threadinfo->part,&start,&end);
+  for (idx = start; !threadinfo->haserr && idx < end; idx = blockend + 1)
+  {
+    GtShulenBlock *block;
+
+    blockend = gt_esa_parts_blockend(esaparts,idx);
+    GT_GETNEXTFREEINARRAY(block,&threadinfo->blocks,GtShulenBlock,256);
+    block->start = idx;
+    block->end = blockend;
+    if (idx == blockend)
+    {
+      continue; /* a leaf, processed when the blocks are combined */
+    }
+    block->lcp = (GtUword) esaparts->lcptab[idx+1];
+    for (i = idx + 2; i <= blockend; i++)
+    {
+      block->lcp = MIN(block->lcp,(GtUword) esaparts->lcptab[i]);
+    }
+    /* process the block like a complete enhanced suffix array, afterwards
+       the root holds the genome distribution of the lcp-interval */
+    state->previousbucketlastsuffix = ULONG_MAX;
+    if (gt_esa_bottomup_RAM_shulen(esaparts->suftab + idx,
+                                   NULL,
+                                   esaparts->lcptab + idx,
+                                   blockend - idx + 1,
+                                   stack,
+                                   state,
+                                   threadinfo->err) != 0 ||
+        gt_esa_bottomup_RAM_previousfromlast_shulen(esaparts->suftab[blockend],
+                                                    0,
+                                                    stack,
+                                                    state,
+                                                    threadinfo->err) != 0)
+    {
+      threadinfo->haserr = true;
+    } else
+    {
+      GtUword *rootdist = stack->spaceGtBUItvinfo[0].info.gnumdist;
+
+      gt_assert(stack->nextfreeGtBUItvinfo == 1UL && rootdist != NULL);
+      block->distoffset = threadinfo->dists.nextfreeGtUword;
+      for (i = 0; i < state->numofdbfiles; i++)
+      {
+        GT_STOREINARRAY(&threadinfo->dists,GtUword,256,rootdist[i]);
+        rootdist[i] = 0;
+      }
+    }
+    stack->nextfreeGtBUItvinfo = 0;
+  }
+  return NULL;
+}
+
+/* Process the lcp-interval of depth <lcp> with genome distribution
+   <gnumdist>, followed by a suffix with lcp value <lcpvalue>, like
+   <gt_esa_bottomup_RAM_previousfromlast_shulen> processes a leaf. */
+static int gt_shulen_combine_interval(GtBUstate_shulen *bustate,
+                                      GtUword lcp,
+                                      GtUword lb,
+                                      GtUword rb,
+                                      const GtUword *gnumdist,
+                                      GtUword lcpvalue,
+                                      GtError *err)
+{
+  const GtUword incrementstacksize = 32UL;
+  GtArrayGtBUItvinfo_shulen *stack = bustate->stack;
+  GtBUItvinfo_shulen *lastinterval = NULL;
+  bool haserr = false, firstedge,
+       firstedgefromroot = bustate->firstedgefromroot;
+
+  gt_assert(lcpvalue < lcp);
+  PUSH_ESA_BOTTOMUP_shulen(lcp,lb);
+  if (TOP_ESA_BOTTOMUP_shulen.info.gnumdist == NULL)
+  {
+    TOP_ESA_BOTTOMUP_shulen.info.gnumdist
+      = gt_malloc(sizeof (*gnumdist) * bustate->numofdbfiles);
+  }
+  memcpy(TOP_ESA_BOTTOMUP_shulen.info.gnumdist,gnumdist,
+         sizeof (*gnumdist) * bustate->numofdbfiles);
+  while (!haserr && lcpvalue < TOP_ESA_BOTTOMUP_shulen.lcp)
+  {
+    lastinterval = POP_ESA_BOTTOMUP_shulen;
+    lastinterval->rb = rb;
+    if (lcpvalue <= TOP_ESA_BOTTOMUP_shulen.lcp)
+    {
+      if (TOP_ESA_BOTTOMUP_shulen.lcp > 0 || !firstedgefromroot)
+      {
+        firstedge = false;
+      } else
+      {
+        firstedge = true;
+        firstedgefromroot = false;
+      }
+      if (processbranchingedge_shulen(firstedge,
+             TOP_ESA_BOTTOMUP_shulen.lcp,
+             &TOP_ESA_BOTTOMUP_shulen.info,
+             lastinterval->lcp,
+             lastinterval->rb - lastinterval->lb + 1,
+             &lastinterval->info,
+             bustate,
+             err) != 0)
+      {
+        haserr = true;
+      }
+      lastinterval = NULL;
+    }
+  }
+  if (!haserr && lcpvalue > TOP_ESA_BOTTOMUP_shulen.lcp)
+  {
+    GtUword lastintervallb, lastintervallcp, lastintervalrb;
+
+    gt_assert(lastinterval != NULL);
+    lastintervallb = lastinterval->lb;
+    lastintervallcp = lastinterval->lcp;
+    lastintervalrb = lastinterval->rb;
+    PUSH_ESA_BOTTOMUP_shulen(lcpvalue,lastintervallb);
+    if (processbranchingedge_shulen(true,
+                   TOP_ESA_BOTTOMUP_shulen.lcp,
+                   &TOP_ESA_BOTTOMUP_shulen.info,
+                   lastintervallcp,
+                   lastintervalrb - lastintervallb + 1,
+                   NULL,
+                   bustate,
+                   err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr)
+  {
+    bustate->firstedgefromroot = firstedgefromroot;
+  }
+  return haserr ? -1 : 0;
+}
+
+static GtUword gt_shulen_blockdepth(GtUword numofchars, GtUword nonspecials)
+{
+  /* the expected size of a block should be small compared to the size of a
+     part */
+  const GtUword wantedblocks
+    = 64UL * (nonspecials/GT_ESA_PARTS_SUFFIXES_PER_PART + 1);
+  GtUword depth = 1UL, numofprefixes = numofchars;
+
+  while (numofchars > 1UL && numofprefixes < wantedblocks && depth < 32UL)
+  {
+    numofprefixes *= numofchars;
+    depth++;
+  }
+  return depth;
+}
+
+static int gt_esa_bottomup_shulen_threaded(Sequentialsuffixarrayreader *ssar,
+                                           GtBUstate_shulen *bustate,
+                                           unsigned int threads,
+                                           GtError *err)
+{
+  const GtUword incrementstacksize = 32UL;
+  GtShulenThreadinfo *threadinfo;
+  GtArrayGtBUItvinfo_shulen *stack;
+  GtESAparts *esaparts;
+  GtUword remaining, idx, i, j;
+  unsigned int t;
+  bool haserr = false;
+
+  gt_assert(threads >= 2U);
+  remaining = gt_Sequentialsuffixarrayreader_nonspecials(ssar);
+  esaparts = gt_esa_parts_new(gt_shulen_blockdepth(
+                                gt_alphabet_num_of_chars(
+                                  gt_encseq_alphabet(bustate->encseq)),
+                                remaining),
+                              threads,
+                              threads * GT_ESA_PARTS_SUFFIXES_PER_PART);
+  threadinfo = gt_malloc(sizeof (*threadinfo) * threads);
+  for (t = 0; t < threads; t++)
+  {
+    threadinfo[t].state = gt_shulen_thread_state_new(bustate);
+    threadinfo[t].esaparts = esaparts;
+    threadinfo[t].part = t;
+    GT_INITARRAY(&threadinfo[t].blocks,GtShulenBlock);
+    GT_INITARRAY(&threadinfo[t].dists,GtUword);
+    threadinfo[t].err = gt_error_new();
+    threadinfo[t].haserr = false;
+  }
+  stack = gt_GtArrayGtBUItvinfo_new_shulen();
+  bustate->stack = (void *) stack;
+  bustate->firstedgefromroot = true;
+  PUSH_ESA_BOTTOMUP_shulen(0,0);
+  while (!haserr && remaining > 0)
+  {
+    if (gt_esa_parts_read(esaparts,ssar,&remaining,err) != 0)
+    {
+      haserr = true;
+      break;
+    }
+    for (t = 0; t < threads; t++)
+    {
+      threadinfo[t].thread = gt_thread_new(gt_shulen_thread_caller,
+                                           threadinfo + t,err);
+      if (threadinfo[t].thread == NULL)
+      {
+        haserr = true;
+      }
+    }
+    for (t = 0; t < threads; t++)
+    {
+      if (threadinfo[t].thread != NULL)
+      {
+        gt_thread_join(threadinfo[t].thread);
+        gt_thread_delete(threadinfo[t].thread);
+      }
+    }
+    for (t = 0; !haserr && t < threads; t++)
+    {
+      const GtArrayGtShulenBlock *blocks = &threadinfo[t].blocks;
+
+      if (threadinfo[t].haserr)
+      {
+        gt_error_set(err,"%s",gt_error_get(threadinfo[t].err));
+        haserr = true;
+        break;
+      }
+      for (idx = 0; !haserr && idx < blocks->nextfreeGtShulenBlock; idx++)
+      {
+        const GtShulenBlock *block = blocks->spaceGtShulenBlock + idx;
+        const GtUword lcpvalue = (GtUword) esaparts->lcptab[block->end+1];
+
+        if (block->start == block->end)
+        {
+          if (gt_esa_bottomup_RAM_previousfromlast_shulen(
+                                             esaparts->suftab[block->start],
+                                             lcpvalue,
+                                             stack,
+                                             bustate,
+                                             err) != 0)
+          {
+            haserr = true;
+          }
+        } else
+        {
+          if (gt_shulen_combine_interval(bustate,
+                                         block->lcp,
+                                         block->start,
+                                         block->end,
+                                         threadinfo[t].dists.spaceGtUword +
+                                         block->distoffset,
+                                         lcpvalue,
+                                         err) != 0)
+          {
+            haserr = true;
+          }
+        }
+      }
+    }
+  }
+  for (t = 0; t < threads; t++)
+  {
+    if (!haserr)
+    {
+      for (i = 0; i < bustate->numofdbfiles; i++)
+      {
+        for (j = 0; j < bustate->numofdbfiles; j++)
+        {
+          bustate->shulengthdist[i][j]
+            += threadinfo[t].state->shulengthdist[i][j];
+        }
+      }
+    }
+    gt_shulen_thread_state_delete(threadinfo[t].state);
+    GT_FREEARRAY(&threadinfo[t].blocks,GtShulenBlock);
+    GT_FREEARRAY(&threadinfo[t].dists,GtUword);
+    gt_error_delete(threadinfo[t].err);
+  }
+  gt_free(threadinfo);
+  gt_GtArrayGtBUItvinfo_delete_shulen(stack,bustate);
+  bustate->stack = NULL;
+  gt_esa_parts_delete(esaparts);
+  return haserr ? -1 : 0;
+}
+#endif
+
+static int gt_esa_bottomup_shulen_generic(Sequentialsuffixarrayreader *ssar,
+                                          GtBUstate_shulen *bustate,
+                                          GtError *err)
+{
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U)
+  {
+    return gt_esa_bottomup_shulen_threaded(ssar,bustate,gt_jobs,err);
+  }
+#endif
+  return gt_esa_bottomup_shulen(ssar,bustate,err);
+}
 
 int gt_multiesa2shulengthdist_print(Sequentialsuffixarrayreader *ssar,
                                     const GtEncseq *encseq,
@@ -381,6 +753,7 @@ int gt_multiesa2shulengthdist_print(Sequentialsuffixarrayreader *ssar,
 
   state = gt_malloc(sizeof (*state));
   state->numofdbfiles = gt_encseq_num_of_files(encseq);
+  state->file_to_genome_map = NULL;
   state->encseq = encseq;
 #ifdef GENOMEDIFF_PAPER_IMPL
   state->leafdist = gt_malloc(sizeof (*state->leafdist) * state->numofdbfiles);
@@ -389,7 +762,7 @@ int gt_multiesa2shulengthdist_print(Sequentialsuffixarrayreader *ssar,
   state->nextid = 0;
 #endif
   state->shulengthdist = shulengthdist_new(state->numofdbfiles);
-  if (gt_esa_bottomup_shulen(ssar, state, err) != 0)
+  if (gt_esa_bottomup_shulen_generic(ssar, state, err) != 0)
   {
     haserr = true;
   }
@@ -549,7 +922,7 @@ int gt_multiesa2shulengthdist(Sequentialsuffixarrayreader *ssar,
   bustate->nextid = 0;
 #endif
   bustate->shulengthdist = shulen;
-  if (gt_esa_bottomup_shulen(ssar, bustate, err) != 0)
+  if (gt_esa_bottomup_shulen_generic(ssar, bustate, err) != 0)
   {
     haserr = true;
   }
@@ -593,8 +966,6 @@ GtBUstate_shulen *gt_sfx_multiesashulengthdist_new(const GtEncseq *encseq,
   return bustate;
 }
 
-#include "esa-bottomup-shulen-RAM.inc"
-
 int gt_sfx_multiesa2shulengthdist(GtBUstate_shulen *bustate,
                                   const GtUword *bucketofsuffixes,
                                   const uint32_t *bucketofsuffixes_uint32,
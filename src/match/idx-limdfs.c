@@ -43,6 +43,7 @@ struct Genericindex
   bool withesa;
   const Mbtab **mbtab;      /* only relevant for packedindex */
   unsigned int maxdepth;    /* maximaldepth of boundaries */
+  bool shared;              /* tables are owned by another Genericindex */
 };
 
 void genericindex_delete(Genericindex *genericindex)
@@ -51,6 +52,12 @@ void genericindex_delete(Genericindex *genericindex)
   {
     return;
   }
+  if (genericindex->shared)
+  {
+    gt_voidBWTSeq_delete_shared(genericindex->packedindex);
+    gt_free(genericindex);
+    return;
+  }
   gt_freesuffixarray(genericindex->suffixarray);
   gt_free(genericindex->suffixarray);
   if (genericindex->packedindex != NULL)
@@ -87,6 +94,7 @@ Genericindex *genericindex_new(const char *indexname,
   Genericindex *genericindex;
 
   genericindex = gt_malloc(sizeof (*genericindex));
+  genericindex->shared = false;
   if (withesa)
   {
     demand |= SARR_SUFTAB;
@@ -166,6 +174,20 @@ Genericindex *genericindex_new(const char *indexname,
   return genericindex;
 }
 
+Genericindex *genericindex_new_shared(const Genericindex *genericindex)
+{
+  Genericindex *shared = gt_malloc(sizeof (*shared));
+
+  *shared = *genericindex;
+  shared->shared = true;
+  if (genericindex->packedindex != NULL)
+  {
+    shared->packedindex
+      = gt_voidBWTSeq_new_shared(genericindex->packedindex);
+  }
+  return shared;
+}
+
 typedef struct
 {
   GtUword offset,
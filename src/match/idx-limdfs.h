@@ -47,6 +47,12 @@ Genericindex *genericindex_new(const char *indexname,
                                GtLogger *logger,
                                GtError *err);
 
+/* Returns a new Genericindex which shares the mapped tables of
+   <genericindex> but has its own lookup state, so that it can be used in a
+   thread different from the one using <genericindex>. It must be deleted
+   before <genericindex>. */
+Genericindex *genericindex_new_shared(const Genericindex *genericindex);
+
 typedef struct Limdfsresources Limdfsresources;
 
 Limdfsresources *gt_newLimdfsresources(const Genericindex *genericindex,
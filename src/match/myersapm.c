@@ -15,10 +15,12 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/chardef.h"
 #include "core/types_api.h"
 #include "core/encseq.h"
 #include "core/defined-types.h"
+#include "core/intbits.h"
 #include "core/ma_api.h"
 #include "myersapm.h"
 #include "procmatch.h"
@@ -171,3 +173,187 @@ void gt_edistmyersbitvectorAPM(Myersonlineresources *mor,
     }
   }
 }
+
+/* For the simultaneous search of several patterns, each pattern occupies
+   one lane, i.e. one machine word, of the bit vectors. The bits of a
+   pattern of length m are stored in the m most significant bits of its
+   lane, so that the score of each lane is determined by the most
+   significant bit. The remaining bits of a lane are cleared in each step
+   by the mask of the lane, so that they do not influence the bits of the
+   pattern. Thus all lanes perform exactly the same
+   operations and the loop over the lanes can be vectorized. */
+
+#define GT_MYERS_TOPBIT(V)  ((V) >> (GT_INTWORDSIZE - 1))
+
+#define GT_MYERS_MULTISTEP_BODY\
+        GtUword lane, hits = 0;\
+        for (lane = 0; lane < numoflanes; lane++)\
+        {\
+          const GtUword eq = Eq[lane], pv = Pv[lane], mv = Mv[lane],\
+                        xv = eq | mv,\
+                        xh = (((eq & pv) + pv) ^ pv) | eq;\
+          GtUword ph = mv | ~(xh | pv),\
+                  mh = pv & xh;\
+          score[lane] = score[lane] + GT_MYERS_TOPBIT(ph) -\
+                        GT_MYERS_TOPBIT(mh);\
+          ph = (ph & mask[lane]) << 1;\
+          Pv[lane] = ((mh << 1) | ~(xv | ph)) & mask[lane];\
+          Mv[lane] = ph & xv;\
+          hits |= (GtUword) (score[lane] <= maxdistance);\
+        }\
+        return hits > 0 ? true : false
+
+typedef bool (*GtMyersMultistepfunc)(GtUword *Pv,
+                                     GtUword *Mv,
+                                     GtUword *score,
+                                     const GtUword *Eq,
+                                     const GtUword *mask,
+                                     GtUword numoflanes,
+                                     GtUword maxdistance);
+
+static bool gt_myers_multistep(GtUword *Pv,
+                               GtUword *Mv,
+                               GtUword *score,
+                               const GtUword *Eq,
+                               const GtUword *mask,
+                               GtUword numoflanes,
+                               GtUword maxdistance)
+{
+  GT_MYERS_MULTISTEP_BODY;
+}
+
+#if defined (__x86_64__) && defined (__GNUC__) && !defined (__clang__)
+#define GT_MYERS_WITH_AVX2
+/* the same code, but compiled for processors supporting AVX2. It is
+   only called if the processor running the program supports AVX2. */
+__attribute__ ((target ("avx2")))
+static bool gt_myers_multistep_avx2(GtUword *Pv,
+                                    GtUword *Mv,
+                                    GtUword *score,
+                                    const GtUword *Eq,
+                                    const GtUword *mask,
+                                    GtUword numoflanes,
+                                    GtUword maxdistance)
+{
+  GT_MYERS_MULTISTEP_BODY;
+}
+#endif
+
+static GtMyersMultistepfunc gt_myers_multistep_select(void)
+{
+#ifdef GT_MYERS_WITH_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return gt_myers_multistep_avx2;
+  }
+#endif
+  return gt_myers_multistep;
+}
+
+void gt_edistmyersbitvectorAPM_multi(Myersonlineresources *mor,
+                                     const GtUchar * const *patterns,
+                                     const GtUword *patternlengths,
+                                     GtUword numofpatterns,
+                                     GtUword maxdistance,
+                                     ProcessIdxMultimatch processmultimatch,
+                                     void *processmultimatchinfo)
+{
+  GtUword *Pv, *Mv, *score, *mask, *eqstab, *initscore, pos, lane,
+          cc, shift;
+  const GtUword wildcardrow = (GtUword) mor->alphasize;
+  const GtReadmode readmode = GT_READMODE_REVERSE;
+  GtMyersMultistepfunc multistep = gt_myers_multistep_select();
+  GtIdxMatch match;
+
+  gt_assert(numofpatterns > 0);
+  Pv = gt_malloc(sizeof *Pv * numofpatterns);
+  Mv = gt_malloc(sizeof *Mv * numofpatterns);
+  score = gt_malloc(sizeof *score * numofpatterns);
+  initscore = gt_malloc(sizeof *initscore * numofpatterns);
+  mask = gt_malloc(sizeof *mask * numofpatterns);
+  /* row <cc> of <eqstab> contains the eqs-vectors of all patterns for the
+     character <cc>, the last row is for the wildcard and contains 0 */
+  eqstab = gt_calloc((size_t) (wildcardrow + 1) * numofpatterns,
+                     sizeof *eqstab);
+  for (lane = 0; lane < numofpatterns; lane++)
+  {
+    gt_assert(patternlengths[lane] > 0 &&
+              patternlengths[lane] <= (GtUword) GT_INTWORDSIZE);
+    shift = (GtUword) GT_INTWORDSIZE - patternlengths[lane];
+    gt_initeqsvectorrev(mor->eqsvectorrev,(GtUword) mor->alphasize,
+                        patterns[lane],patternlengths[lane]);
+    for (cc = 0; cc < wildcardrow; cc++)
+    {
+      eqstab[cc * numofpatterns + lane] = mor->eqsvectorrev[cc] << shift;
+    }
+    mask[lane] = ~0UL << shift;
+    initscore[lane] = patternlengths[lane];
+  }
+  memcpy(Pv,mask,sizeof *Pv * numofpatterns);
+  memset(Mv,0,sizeof *Mv * numofpatterns);
+  memcpy(score,initscore,sizeof *score * numofpatterns);
+  gt_encseq_reader_reinit_with_readmode(mor->esr, mor->encseq, readmode, 0);
+  match.dbabsolute = NULL;
+  match.dbsubstring = NULL;
+  match.querystartpos = 0;
+  match.alignment = NULL;
+  for (pos = 0; pos < mor->totallength; pos++)
+  {
+    GtUchar ch = gt_encseq_reader_next_encoded_char(mor->esr);
+
+    if (ch == (GtUchar) SEPARATOR)
+    {
+      memcpy(Pv,mask,sizeof *Pv * numofpatterns);
+      memset(Mv,0,sizeof *Mv * numofpatterns);
+      memcpy(score,initscore,sizeof *score * numofpatterns);
+    } else
+    {
+      cc = ch == (GtUchar) WILDCARD ? wildcardrow : (GtUword) ch;
+      if (multistep(Pv,Mv,score,eqstab + cc * numofpatterns,mask,
+                    numofpatterns,maxdistance))
+      {
+        GtUword dbstartpos = GT_REVERSEPOS(mor->totallength,pos);
+
+        for (lane = 0; lane < numofpatterns; lane++)
+        {
+          if (score[lane] <= maxdistance)
+          {
+            Definedunsignedlong matchlength;
+
+            if (maxdistance > 0)
+            {
+              matchlength = gt_forwardprefixmatch(mor->encseq,
+                                                  mor->alphasize,
+                                                  dbstartpos,
+                                                  mor->nowildcards,
+                                                  mor->eqsvector,
+                                                  patterns[lane],
+                                                  patternlengths[lane],
+                                                  maxdistance);
+            } else
+            {
+              matchlength.defined = true;
+              matchlength.valueunsignedlong = patternlengths[lane];
+            }
+            gt_assert(matchlength.defined || mor->nowildcards);
+            if (matchlength.defined)
+            {
+              match.dbstartpos = dbstartpos;
+              match.dblen = (GtUword) matchlength.valueunsignedlong;
+              match.querylen = patternlengths[lane];
+              match.distance = score[lane];
+              processmultimatch(processmultimatchinfo,lane,&match);
+            }
+          }
+        }
+      }
+    }
+  }
+  gt_free(Pv);
+  gt_free(Mv);
+  gt_free(score);
+  gt_free(initscore);
+  gt_free(mask);
+  gt_free(eqstab);
+}
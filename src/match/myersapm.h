@@ -38,4 +38,23 @@ void gt_edistmyersbitvectorAPM(Myersonlineresources *mor,
                             GtUword patternlength,
                             GtUword maxdistance);
 
+typedef void (*ProcessIdxMultimatch)(void *processinfo,
+                                     GtUword patternnum,
+                                     const GtIdxMatch *match);
+
+/* Search the <numofpatterns> patterns <patterns[0..numofpatterns-1]> of
+   lengths <patternlengths[0..numofpatterns-1]> with at most <maxdistance>
+   differences in one scan over the sequence. Each pattern must not be
+   longer than <GT_INTWORDSIZE>. The matches of pattern <i> are reported by
+   calling <processmultimatch> with <i> as second argument, in the same
+   order as <gt_edistmyersbitvectorAPM> reports them. If the processor
+   supports it, the patterns are processed with AVX2 instructions. */
+void gt_edistmyersbitvectorAPM_multi(Myersonlineresources *mor,
+                                     const GtUchar * const *patterns,
+                                     const GtUword *patternlengths,
+                                     GtUword numofpatterns,
+                                     GtUword maxdistance,
+                                     ProcessIdxMultimatch processmultimatch,
+                                     void *processmultimatchinfo);
+
 #endif
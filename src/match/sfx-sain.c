@@ -16,10 +16,14 @@
 */
 
 #include <limits.h>
+#include "core/intbits.h"
 #include "core/minmax.h"
 #include "core/unused_api.h"
 #include "core/timer_api.h"
 #include "core/mathsupport.h"
+#ifdef GT_THREADS_ENABLED
+#include "core/thread_api.h"
+#endif
 #include "sfx-lwcheck.h"
 #include "bare-encseq.h"
 #include "sfx-sain.h"
@@ -666,10 +670,511 @@ static void gt_sain_induceStypes2fromspecialranges(const GtSainseq *sainseq,
 
 #include "match/sfx-sain.inc"
 
+static int gt_sain_compare_Sstarstrings(const GtSainseq *sainseq,
+                                        GtUword start1,
+                                        GtUword start2,
+                                        GtUword len)
+{
+  switch (sainseq->seqtype)
+  {
+    case GT_SAIN_PLAINSEQ:
+      return gt_sain_PLAINSEQ_compare_Sstarstrings(sainseq,
+                                                   sainseq->seq.plainseq,
+                                                   start1,start2,len);
+    case GT_SAIN_ENCSEQ:
+      return gt_sain_ENCSEQ_compare_Sstarstrings(sainseq,
+                                                 sainseq->seq.encseq,
+                                                 start1,start2,len);
+    case GT_SAIN_INTSEQ:
+      return gt_sain_INTSEQ_compare_Sstarstrings(sainseq,
+                                                 sainseq->seq.array,
+                                                 start1,start2,len);
+    case GT_SAIN_BARE_ENCSEQ:
+      return gt_sain_BARE_ENCSEQ_compare_Sstarstrings(sainseq,
+                                                      sainseq->seq.plainseq,
+                                                      start1,start2,len);
+  }
+  /*@ignore@*/
+  return 0;
+  /*@end@*/
+}
+
+#ifdef GT_THREADS_ENABLED
+
+/* The following functions implement the steps of the algorithm which can be
+   split into independent parts of the sequence or the suffix array, namely
+   the classification of the suffixes and the insertion of the Sstar suffixes
+   into their buckets, the naming of the sorted Sstar substrings and the
+   mapping of the order of the reduced problem back to the original
+   sequence. Each step consists of a counting phase and a phase which writes
+   the results to the positions determined by the counts of the parts
+   processed before, so that the suffix array is the same as the one
+   computed with a single thread. The induction steps remain sequential. */
+
+/* the minimum number of positions a thread processes */
+#define GT_SAIN_MINPARTWIDTH (1UL << 16)
+
+typedef enum
+{
+  GT_SAIN_THREAD_COUNTSSTARBYCHAR,
+  GT_SAIN_THREAD_INSERTSSTAR,
+  GT_SAIN_THREAD_COUNTSSTAR,
+  GT_SAIN_THREAD_EXPANDSSTAR,
+  GT_SAIN_THREAD_MAPSSTAR,
+  GT_SAIN_THREAD_COMPARESSTAR,
+  GT_SAIN_THREAD_ASSIGNNAMES,
+  GT_SAIN_THREAD_COUNTMARKED,
+  GT_SAIN_THREAD_FASTASSIGNNAMES,
+  GT_SAIN_THREAD_UNMARK
+} GtSainThreadmode;
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  GtUsainindextype *suftab, *sstarptr, *fillptr;
+  GtBitsequence *newname;
+  GtUword start, end, count, currentname, countSstartype;
+  GtSainThreadmode mode;
+  GtThread *thread;
+} GtSainThreadinfo;
+
+static unsigned int gt_sain_numofparts(GtUword width, GtUword alignment)
+{
+  GtUword parts;
+
+  if (gt_jobs <= 1U)
+  {
+    return 1U;
+  }
+  parts = MIN((GtUword) gt_jobs,width/MAX(GT_SAIN_MINPARTWIDTH,alignment));
+  return parts == 0 ? 1U : (unsigned int) parts;
+}
+
+/* split the range from 0 to <width>-1 into <parts> parts, whose
+   boundaries are multiples of <alignment> */
+static GtSainThreadinfo *gt_sain_threadinfo_new(const GtSainseq *sainseq,
+                                                GtUsainindextype *suftab,
+                                                unsigned int parts,
+                                                GtUword width,
+                                                GtUword alignment)
+{
+  unsigned int part;
+  GtSainThreadinfo *threadinfo = gt_malloc(sizeof (*threadinfo) * parts);
+
+  for (part = 0; part < parts; part++)
+  {
+    threadinfo[part].sainseq = sainseq;
+    threadinfo[part].suftab = suftab;
+    threadinfo[part].sstarptr = NULL;
+    threadinfo[part].fillptr = NULL;
+    threadinfo[part].newname = NULL;
+    threadinfo[part].start = part == 0
+                             ? 0
+                             : threadinfo[part-1].end;
+    threadinfo[part].end = part == parts - 1
+                           ? width
+                           : (width/parts * (part+1))/alignment * alignment;
+    threadinfo[part].count = 0;
+    threadinfo[part].currentname = 0;
+    threadinfo[part].countSstartype = 0;
+  }
+  return threadinfo;
+}
+
+static void gt_sain_boundarytype(const GtSainseq *sainseq,
+                                 GtUword position,
+                                 GtUword *nextcc,
+                                 bool *nextisStype)
+{
+  if (position == sainseq->totallength)
+  {
+    *nextcc = GT_UNIQUEINT(sainseq->totallength);
+    *nextisStype = true;
+  } else
+  {
+    GtUword cc = 0, idx;
+
+    *nextcc = gt_sainseq_getchar(sainseq,position);
+    for (idx = position + 1; idx < sainseq->totallength; idx++)
+    {
+      if ((cc = gt_sainseq_getchar(sainseq,idx)) != *nextcc)
+      {
+        break;
+      }
+    }
+    *nextisStype = (idx == sainseq->totallength || *nextcc < cc)
+                   ? true : false;
+  }
+}
+
+static void gt_sain_thread_scan(GtSainThreadinfo *threadinfo)
+{
+  const GtSainseq *sainseq = threadinfo->sainseq;
+  GtEncseqReader *esr = NULL;
+  GtUword nextcc, position;
+  bool nextisStype;
+
+  gt_sain_boundarytype(sainseq,threadinfo->end,&nextcc,&nextisStype);
+  if (sainseq->seqtype == GT_SAIN_ENCSEQ)
+  {
+    esr = gt_encseq_create_reader_with_readmode(
+                            sainseq->seq.encseq,
+                            gt_readmode_inverse_direction(sainseq->readmode),
+                            sainseq->totallength - threadinfo->end);
+  }
+  for (position = threadinfo->end; position > threadinfo->start; /* Nothing */)
+  {
+    GtUword currentcc;
+    bool currentisStype;
+
+    position--;
+    if (esr != NULL)
+    {
+      GtUchar tmpcc = gt_encseq_reader_next_encoded_char(esr);
+
+      currentcc = ISSPECIAL(tmpcc) ? GT_UNIQUEINT(position) : (GtUword) tmpcc;
+    } else
+    {
+      currentcc = gt_sainseq_getchar(sainseq,position);
+    }
+    currentisStype = (currentcc < nextcc ||
+                      (currentcc == nextcc && nextisStype)) ? true : false;
+    if (!currentisStype && nextisStype)
+    {
+      switch (threadinfo->mode)
+      {
+        case GT_SAIN_THREAD_COUNTSSTARBYCHAR:
+          threadinfo->fillptr[nextcc]++;
+          break;
+        case GT_SAIN_THREAD_INSERTSSTAR:
+          threadinfo->suftab[--threadinfo->fillptr[nextcc]]
+            = (GtUsainindextype) position;
+          break;
+        case GT_SAIN_THREAD_EXPANDSSTAR:
+          *--threadinfo->sstarptr = (GtUsainindextype) (position+1);
+          break;
+        default:
+          break;
+      }
+      threadinfo->count++;
+    }
+    nextisStype = currentisStype;
+    nextcc = currentcc;
+  }
+  if (esr != NULL)
+  {
+    gt_encseq_reader_delete(esr);
+  }
+}
+
+static void *gt_sain_thread_caller(void *data)
+{
+  GtSainThreadinfo *threadinfo = (GtSainThreadinfo *) data;
+  GtUsainindextype *suftab = threadinfo->suftab,
+                   *secondhalf = suftab + threadinfo->countSstartype;
+  const GtUword totallength = threadinfo->sainseq->totallength;
+  GtUword idx;
+
+  switch (threadinfo->mode)
+  {
+    case GT_SAIN_THREAD_COUNTSSTARBYCHAR:
+    case GT_SAIN_THREAD_INSERTSSTAR:
+    case GT_SAIN_THREAD_COUNTSSTAR:
+    case GT_SAIN_THREAD_EXPANDSSTAR:
+      threadinfo->count = 0;
+      gt_sain_thread_scan(threadinfo);
+      break;
+    case GT_SAIN_THREAD_MAPSSTAR:
+      for (idx = threadinfo->start; idx < threadinfo->end; idx++)
+      {
+        suftab[idx] = threadinfo->sstarptr[suftab[idx]];
+      }
+      break;
+    case GT_SAIN_THREAD_COMPARESSTAR:
+      /* the Sstar substrings have been sorted, so they are compared with
+         their predecessor in the suffix array to decide if they obtain a
+         new name. This only reads the lengths of the Sstar substrings. */
+      threadinfo->count = 0;
+      for (idx = MAX(threadinfo->start,1UL); idx < threadinfo->end; idx++)
+      {
+        GtUword previouspos = (GtUword) suftab[idx-1],
+                position = (GtUword) suftab[idx],
+                previouslen = (GtUword) secondhalf[GT_DIV2(previouspos)],
+                currentlen = (GtUword) secondhalf[GT_DIV2(position)];
+
+        if (previouslen != currentlen ||
+            gt_sain_compare_Sstarstrings(threadinfo->sainseq,previouspos,
+                                         position,currentlen) == -1)
+        {
+          GT_SETIBIT(threadinfo->newname,idx);
+          threadinfo->count++;
+        }
+      }
+      break;
+    case GT_SAIN_THREAD_ASSIGNNAMES:
+      for (idx = threadinfo->start; idx < threadinfo->end; idx++)
+      {
+        if (idx > 0 && GT_ISIBITSET(threadinfo->newname,idx))
+        {
+          threadinfo->currentname++;
+        }
+        secondhalf[GT_DIV2(suftab[idx])]
+          = (GtUsainindextype) threadinfo->currentname;
+      }
+      break;
+    case GT_SAIN_THREAD_COUNTMARKED:
+      threadinfo->count = 0;
+      for (idx = threadinfo->start; idx < threadinfo->end; idx++)
+      {
+        if (suftab[idx] >= (GtUsainindextype) totallength)
+        {
+          threadinfo->count++;
+        }
+      }
+      break;
+    case GT_SAIN_THREAD_FASTASSIGNNAMES:
+      for (idx = threadinfo->end; idx > threadinfo->start; /* Nothing */)
+      {
+        GtUsainindextype position = suftab[--idx];
+
+        if (position >= (GtUsainindextype) totallength)
+        {
+          position -= totallength;
+          gt_assert(threadinfo->currentname > 0);
+          threadinfo->currentname--;
+        }
+        secondhalf[GT_DIV2(position)]
+          = (GtUsainindextype) threadinfo->currentname;
+      }
+      break;
+    case GT_SAIN_THREAD_UNMARK:
+      for (idx = threadinfo->start; idx < threadinfo->end; idx++)
+      {
+        if (suftab[idx] >= (GtUsainindextype) totallength)
+        {
+          suftab[idx] -= totallength;
+        }
+      }
+      break;
+  }
+  return NULL;
+}
+
+static void gt_sain_threads_run(GtSainThreadinfo *threadinfo,
+                                unsigned int parts,
+                                GtSainThreadmode mode)
+{
+  unsigned int part;
+
+  for (part = 0; part < parts; part++)
+  {
+    threadinfo[part].mode = mode;
+    threadinfo[part].thread = gt_thread_new(gt_sain_thread_caller,
+                                            threadinfo + part,NULL);
+    if (threadinfo[part].thread == NULL)
+    {
+      /* the result does not depend on the thread processing a part */
+      (void) gt_sain_thread_caller(threadinfo + part);
+    }
+  }
+  for (part = 0; part < parts; part++)
+  {
+    if (threadinfo[part].thread != NULL)
+    {
+      gt_thread_join(threadinfo[part].thread);
+      gt_thread_delete(threadinfo[part].thread);
+    }
+  }
+}
+
+static bool gt_sain_threaded_insertSstarsuffixes(GtUword *countSstartype,
+                                                 GtSainseq *sainseq,
+                                                 GtUsainindextype *suftab)
+{
+  unsigned int part,
+               parts = gt_sain_numofparts(sainseq->totallength,1UL);
+  GtUword charidx;
+  GtUsainindextype *fillptrspace;
+  GtSainThreadinfo *threadinfo;
+
+  /* each thread requires its own table of bucket pointers, which is only
+     affordable for small alphabets */
+  if (parts < 2U ||
+      (GtUword) parts * sainseq->numofchars > GT_DIV4(sainseq->totallength))
+  {
+    return false;
+  }
+  threadinfo = gt_sain_threadinfo_new(sainseq,suftab,parts,
+                                      sainseq->totallength,1UL);
+  fillptrspace = gt_calloc((size_t) parts * sainseq->numofchars,
+                           sizeof (*fillptrspace));
+  for (part = 0; part < parts; part++)
+  {
+    threadinfo[part].fillptr = fillptrspace + part * sainseq->numofchars;
+  }
+  gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_COUNTSSTARBYCHAR);
+  gt_sain_endbuckets(sainseq);
+  *countSstartype = 0;
+  for (part = parts; part > 0; part--)
+  {
+    GtUsainindextype *fillptr = threadinfo[part-1].fillptr;
+
+    for (charidx = 0; charidx < sainseq->numofchars; charidx++)
+    {
+      GtUsainindextype count = fillptr[charidx];
+
+      fillptr[charidx] = sainseq->bucketfillptr[charidx];
+      sainseq->bucketfillptr[charidx] -= count;
+      if (sainseq->seqtype != GT_SAIN_INTSEQ)
+      {
+        sainseq->sstarfirstcharcount[charidx] += count;
+      }
+    }
+    *countSstartype += threadinfo[part-1].count;
+  }
+  gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_INSERTSSTAR);
+  gt_free(fillptrspace);
+  gt_free(threadinfo);
+  gt_assert(GT_MULT2(*countSstartype) <= sainseq->totallength);
+  return true;
+}
+
+static bool gt_sain_threaded_assignSstarnames(GtUword *numberofnames,
+                                              const GtSainseq *sainseq,
+                                              GtUword countSstartype,
+                                              GtUsainindextype *suftab)
+{
+  unsigned int part,
+               parts = gt_sain_numofparts(countSstartype,GT_INTWORDSIZE);
+  GtUword currentname = 1UL;
+  GtBitsequence *newname;
+  GtSainThreadinfo *threadinfo;
+
+  if (parts < 2U)
+  {
+    return false;
+  }
+  /* the part boundaries are aligned to the words of the bit vector, so that
+     no two threads modify the same word */
+  threadinfo = gt_sain_threadinfo_new(sainseq,suftab,parts,countSstartype,
+                                      GT_INTWORDSIZE);
+  GT_INITBITTAB(newname,countSstartype);
+  for (part = 0; part < parts; part++)
+  {
+    threadinfo[part].newname = newname;
+    threadinfo[part].countSstartype = countSstartype;
+  }
+  gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_COMPARESSTAR);
+  for (part = 0; part < parts; part++)
+  {
+    threadinfo[part].currentname = currentname;
+    currentname += threadinfo[part].count;
+  }
+  gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_ASSIGNNAMES);
+  gt_free(newname);
+  gt_free(threadinfo);
+  *numberofnames = currentname;
+  return true;
+}
+
+static bool gt_sain_threaded_fast_assignSstarnames(const GtSainseq *sainseq,
+                                                   GtUword countSstartype,
+                                                   GtUsainindextype *suftab,
+                                                   GtUword numberofnames,
+                                                   GtUword nonspecialentries)
+{
+  unsigned int part, parts;
+  GtSainThreadinfo *threadinfo;
+
+  if (numberofnames < countSstartype)
+  {
+    GtUword currentname = numberofnames + 1;
+
+    /* all marked Sstar suffixes have been moved to the front */
+    if ((parts = gt_sain_numofparts(countSstartype,1UL)) < 2U)
+    {
+      return false;
+    }
+    threadinfo = gt_sain_threadinfo_new(sainseq,suftab,parts,countSstartype,
+                                        1UL);
+    for (part = 0; part < parts; part++)
+    {
+      threadinfo[part].countSstartype = countSstartype;
+    }
+    gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_COUNTMARKED);
+    for (part = parts; part > 0; part--)
+    {
+      threadinfo[part-1].currentname = currentname;
+      gt_assert(currentname >= threadinfo[part-1].count);
+      currentname -= threadinfo[part-1].count;
+    }
+    gt_assert(currentname == 1UL);
+    gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_FASTASSIGNNAMES);
+  } else
+  {
+    if ((parts = gt_sain_numofparts(nonspecialentries,1UL)) < 2U)
+    {
+      return false;
+    }
+    threadinfo = gt_sain_threadinfo_new(sainseq,suftab,parts,
+                                        nonspecialentries,1UL);
+    gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_UNMARK);
+  }
+  gt_free(threadinfo);
+  return true;
+}
+
+static bool gt_sain_threaded_expandorder2original(GtSainseq *sainseq,
+                                                  GtUword numberofsuffixes,
+                                                  GtUsainindextype *suftab)
+{
+  unsigned int part,
+               parts = gt_sain_numofparts(sainseq->totallength,1UL);
+  GtUsainindextype *sstarsuffixes = suftab + GT_MULT2(numberofsuffixes);
+  GtSainThreadinfo *threadinfo;
+
+  /* for the reduced problem, the bucket sizes are determined in the same
+     scan, which requires a table per thread */
+  if (parts < 2U || sainseq->seqtype == GT_SAIN_INTSEQ)
+  {
+    return false;
+  }
+  threadinfo = gt_sain_threadinfo_new(sainseq,suftab,parts,
+                                      sainseq->totallength,1UL);
+  gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_COUNTSSTAR);
+  for (part = parts; part > 0; part--)
+  {
+    threadinfo[part-1].sstarptr = sstarsuffixes;
+    sstarsuffixes -= threadinfo[part-1].count;
+  }
+  gt_assert(sstarsuffixes == suftab + numberofsuffixes);
+  gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_EXPANDSSTAR);
+  gt_free(threadinfo);
+  parts = gt_sain_numofparts(numberofsuffixes,1UL);
+  threadinfo = gt_sain_threadinfo_new(sainseq,suftab,parts,numberofsuffixes,
+                                      1UL);
+  for (part = 0; part < parts; part++)
+  {
+    threadinfo[part].sstarptr = sstarsuffixes;
+  }
+  gt_sain_threads_run(threadinfo,parts,GT_SAIN_THREAD_MAPSSTAR);
+  gt_free(threadinfo);
+  return true;
+}
+#endif
+
 static GtUword gt_sain_insertSstarsuffixes(GtSainseq *sainseq,
                                            GtUsainindextype *suftab,
                                            GtLogger *logger)
 {
+#ifdef GT_THREADS_ENABLED
+  GtUword countSstartype;
+
+  if (gt_sain_threaded_insertSstarsuffixes(&countSstartype,sainseq,suftab))
+  {
+    return countSstartype;
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -887,14 +1392,22 @@ static GtUword gt_sain_fast_moveSstar2front(
   return namecount;
 }
 
-static void gt_sain_fast_assignSstarnames(GtUword totallength,
+static void gt_sain_fast_assignSstarnames(const GtSainseq *sainseq,
                                           GtUword countSstartype,
                                           GtUsainindextype *suftab,
                                           GtUword numberofnames,
                                           GtUword nonspecialentries)
 {
+  const GtUword totallength = sainseq->totallength;
   GtUsainindextype *suftabptr, *secondhalf = suftab + countSstartype;
 
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_threaded_fast_assignSstarnames(sainseq,countSstartype,suftab,
+                                             numberofnames,nonspecialentries))
+  {
+    return;
+  }
+#endif
   if ((GtUword) numberofnames < countSstartype)
   {
     GtUword currentname = numberofnames + 1;
@@ -1079,6 +1592,12 @@ static void gt_sain_expandorder2original(GtSainseq *sainseq,
                                          GtUword numberofsuffixes,
                                          GtUsainindextype *suftab)
 {
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_threaded_expandorder2original(sainseq,numberofsuffixes,suftab))
+  {
+    return;
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -1129,6 +1648,13 @@ static GtUword gt_sain_assignSstarnames(const GtSainseq *sainseq,
                    previouspos;
   GtUword previouslen, currentname = 1UL;
 
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_threaded_assignSstarnames(&currentname,sainseq,countSstartype,
+                                        suftab))
+  {
+    return currentname;
+  }
+#endif
   previouspos = suftab[0];
   previouslen = (GtUword) secondhalf[GT_DIV2(previouspos)];
   secondhalf[GT_DIV2(previouspos)] = (GtUsainindextype) currentname;
@@ -1142,37 +1668,10 @@ static GtUword gt_sain_assignSstarnames(const GtSainseq *sainseq,
     currentlen = (GtUword) secondhalf[GT_DIV2(position)];
     if (previouslen == currentlen)
     {
-      switch (sainseq->seqtype)
-      {
-        case GT_SAIN_PLAINSEQ:
-          cmp = gt_sain_PLAINSEQ_compare_Sstarstrings(sainseq,
-                                                      sainseq->seq.plainseq,
-                                                      (GtUword) previouspos,
-                                                      (GtUword) position,
-                                                      currentlen);
-          break;
-        case GT_SAIN_ENCSEQ:
-          cmp = gt_sain_ENCSEQ_compare_Sstarstrings(sainseq,
-                                                    sainseq->seq.encseq,
-                                                    (GtUword) previouspos,
-                                                    (GtUword) position,
-                                                    currentlen);
-          break;
-        case GT_SAIN_INTSEQ:
-          cmp = gt_sain_INTSEQ_compare_Sstarstrings(sainseq,
-                                                    sainseq->seq.array,
-                                                    (GtUword) previouspos,
-                                                    (GtUword) position,
-                                                    currentlen);
-          break;
-        case GT_SAIN_BARE_ENCSEQ:
-          cmp = gt_sain_BARE_ENCSEQ_compare_Sstarstrings(sainseq,
-                                                         sainseq->seq.plainseq,
-                                                         (GtUword) previouspos,
-                                                         (GtUword) position,
-                                                         currentlen);
-          break;
-      }
+      cmp = gt_sain_compare_Sstarstrings(sainseq,
+                                         (GtUword) previouspos,
+                                         (GtUword) position,
+                                         currentlen);
       gt_assert(cmp != 1);
     } else
     {
@@ -1441,7 +1940,7 @@ static void gt_sain_rec_sortsuffixes(unsigned int level,
         sainseq->roundtable = NULL;
       }
       GT_SAIN_SHOWTIMER("fast assignSstarnames");
-      gt_sain_fast_assignSstarnames(sainseq->totallength,countSstartype,
+      gt_sain_fast_assignSstarnames(sainseq,countSstartype,
                                     suftab,numberofnames,nonspecialentries);
     }
     gt_assert(numberofnames <= countSstartype);
@@ -16,6 +16,7 @@
 */
 
 #include <limits.h>
+#include <stdarg.h>
 #include "core/alphabet.h"
 #include "core/arraydef.h"
 #include "core/error.h"
@@ -23,9 +24,12 @@
 #include "core/format64.h"
 #include "core/intbits.h"
 #include "core/ma_api.h"
+#include "core/multithread_api.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
+#include "core/xansi_api.h"
 #include "apmeoveridx.h"
 #include "dist-short.h"
 #include "echoseq.h"
@@ -57,6 +61,7 @@ typedef struct
   GtUchar transformedtag[MAXTAGSIZE],
         rctransformedtag[MAXTAGSIZE];
   GtUword taglen;
+  GtStr *outbuf; /* if not NULL, the output for the tag is appended here */
 } TgrTagwithlength;
 
 typedef struct
@@ -70,32 +75,74 @@ typedef struct
   const GtEncseq *encseq;
 } TgrShowmatchinfo;
 
-#define ADDTABULATOR\
+#define ADDTABULATOR(TWL)\
         if (firstitem)\
         {\
           firstitem = false;\
         } else\
         {\
-          (void) putchar('\t');\
+          tgr_printf(TWL,"\t");\
         }
 
+static void tgr_printf(const TgrTagwithlength *twl,const char *format,...)
+{
+  va_list ap;
+
+  va_start(ap,format);
+  if (twl->outbuf == NULL)
+  {
+    (void) vprintf(format,ap);
+  } else
+  {
+    char buffer[64];
+    GT_UNUSED int len = vsnprintf(buffer,sizeof buffer,format,ap);
+
+    gt_assert(len >= 0 && (size_t) len < sizeof buffer);
+    gt_str_append_cstr(twl->outbuf,buffer);
+  }
+  va_end(ap);
+}
+
+static void tgr_decode_seq(const TgrTagwithlength *twl,
+                           const GtAlphabet *alpha,
+                           const GtUchar *src,
+                           GtUword len)
+{
+  if (twl->outbuf == NULL)
+  {
+    gt_alphabet_decode_seq_to_fp(alpha,stdout,src,len);
+  } else
+  {
+    const GtUchar *characters = (alpha == NULL)
+                                  ? (const GtUchar *) "acgt"
+                                  : gt_alphabet_characters(alpha);
+    GtUword idx;
+
+    for (idx = 0; idx < len; idx++)
+    {
+      gt_str_append_char(twl->outbuf,(char) characters[src[idx]]);
+    }
+  }
+}
+
 static void tgr_showmatch(void *processinfo,const GtIdxMatch *match)
 {
   TgrShowmatchinfo *showmatchinfo = (TgrShowmatchinfo *) processinfo;
+  const TgrTagwithlength *twl = showmatchinfo->twlptr;
   bool firstitem = true;
 
   gt_assert(showmatchinfo->tageratoroptions != NULL);
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_DBLENGTH)
   {
-    printf(""GT_WU"",match->dblen);
+    tgr_printf(twl,""GT_WU"",match->dblen);
     firstitem = false;
   }
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_DBSTARTPOS)
   {
-    ADDTABULATOR;
+    ADDTABULATOR(twl);
     if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_DBABSPOS)
     {
-      printf(""GT_WU"",match->dbstartpos);
+      tgr_printf(twl,""GT_WU"",match->dbstartpos);
     } else
     {
       GtUword seqstartpos,
@@ -103,27 +150,26 @@ static void tgr_showmatch(void *processinfo,const GtIdxMatch *match)
                                                   match->dbstartpos);
       seqstartpos = gt_encseq_seqstartpos(showmatchinfo->encseq, seqnum);
       gt_assert(seqstartpos <= match->dbstartpos);
-      printf(""GT_WU"\t"GT_WU"",seqnum, match->dbstartpos - seqstartpos);
+      tgr_printf(twl,""GT_WU"\t"GT_WU"",seqnum,
+                 match->dbstartpos - seqstartpos);
     }
   }
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_DBSEQUENCE)
   {
-    ADDTABULATOR;
+    ADDTABULATOR(twl);
     gt_assert(match->dbsubstring != NULL);
-    gt_alphabet_decode_seq_to_fp(showmatchinfo->alpha,
-                                 stdout,
-                                 match->dbsubstring,
-                                 (GtUword) match->dblen);
+    tgr_decode_seq(twl,showmatchinfo->alpha,match->dbsubstring,
+                   (GtUword) match->dblen);
   }
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_STRAND)
   {
-    ADDTABULATOR;
-    printf("%c",ISRCDIR(showmatchinfo->twlptr) ? '-' : '+');
+    ADDTABULATOR(twl);
+    tgr_printf(twl,"%c",ISRCDIR(twl) ? '-' : '+');
   }
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_EDIST)
   {
-    ADDTABULATOR;
-    printf(""GT_WU"",match->distance);
+    ADDTABULATOR(twl);
+    tgr_printf(twl,""GT_WU"",match->distance);
   }
   if (showmatchinfo->tageratoroptions->maxintervalwidth > 0)
   {
@@ -144,48 +190,44 @@ static void tgr_showmatch(void *processinfo,const GtIdxMatch *match)
         gt_assert(match->querylen >= suffixlength);
         if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGSTARTPOS)
         {
-          ADDTABULATOR;
-          printf(""GT_WU"",match->querylen - suffixlength);
+          ADDTABULATOR(twl);
+          tgr_printf(twl,""GT_WU"",match->querylen - suffixlength);
         }
         if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
         {
-          ADDTABULATOR;
-          printf(""GT_WU"",suffixlength);
+          ADDTABULATOR(twl);
+          tgr_printf(twl,""GT_WU"",suffixlength);
         }
         if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGSUFFIXSEQ)
         {
-          ADDTABULATOR;
-          gt_alphabet_decode_seq_to_fp(NULL,
-                                       stdout,showmatchinfo->tagptr +
-                                       (match->querylen - suffixlength),
-                                       suffixlength);
+          ADDTABULATOR(twl);
+          tgr_decode_seq(twl,NULL,showmatchinfo->tagptr +
+                                  (match->querylen - suffixlength),
+                         suffixlength);
         }
       }
     } else
     {
       if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGSTARTPOS)
       {
-        ADDTABULATOR;
-        printf("0");
+        ADDTABULATOR(twl);
+        tgr_printf(twl,"0");
       }
       if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
       {
-        ADDTABULATOR;
-        printf(""GT_WU"",match->querylen);
+        ADDTABULATOR(twl);
+        tgr_printf(twl,""GT_WU"",match->querylen);
       }
       if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGSUFFIXSEQ)
       {
-        ADDTABULATOR;
-        gt_alphabet_decode_seq_to_fp(NULL,
-                                     stdout,
-                                     showmatchinfo->tagptr,
-                                     match->querylen);
+        ADDTABULATOR(twl);
+        tgr_decode_seq(twl,NULL,showmatchinfo->tagptr,match->querylen);
       }
     }
   }
   if (!firstitem)
   {
-    printf("\n");
+    tgr_printf(twl,"\n");
   }
 }
 
@@ -273,7 +315,7 @@ static void showmstats(void *processinfo,
 {
   TgrTagwithlength *twl = (TgrTagwithlength *) patterninfo;
 
-  printf(""GT_WU" %c",mstatlength,ISRCDIR(twl) ? '-' : '+');
+  tgr_printf(twl,""GT_WU" %c",mstatlength,ISRCDIR(twl) ? '-' : '+');
   if (gt_intervalwidthleq((const Limdfsresources *) processinfo,leftbound,
                        rightbound))
   {
@@ -285,10 +327,10 @@ static void showmstats(void *processinfo,
                                   mstatlength);
     for (idx = 0; idx<mstatspos->nextfreeGtUlong; idx++)
     {
-      printf(" "GT_WU"",mstatspos->spaceGtUlong[idx]);
+      tgr_printf(twl," "GT_WU"",mstatspos->spaceGtUlong[idx]);
     }
   }
-  printf("\n");
+  tgr_printf(twl,"\n");
 }
 
 static int cmpdescend(const void *a,const void *b)
@@ -536,9 +578,393 @@ static void searchoverstrands(const TageratorOptions *tageratoroptions,
   }
 }
 
+static void tgr_showtagheader(const TageratorOptions *tageratoroptions,
+                              const GtAlphabet *alpha,
+                              uint64_t tagnumber,
+                              const TgrTagwithlength *twl)
+{
+  bool firstitem = true;
+
+  tgr_printf(twl,"#");
+  if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
+  {
+    tgr_printf(twl,"\t" Formatuint64_t,PRINTuint64_tcast(tagnumber));
+    firstitem = false;
+  }
+  if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
+  {
+    ADDTABULATOR(twl);
+    tgr_printf(twl,""GT_WU"",twl->taglen);
+  }
+  if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
+  {
+    ADDTABULATOR(twl);
+    tgr_decode_seq(twl,alpha,twl->transformedtag,twl->taglen);
+  }
+  tgr_printf(twl,"\n");
+}
+
+GT_DECLAREARRAYSTRUCT(GtIdxMatch);
+
+/* In online mode, the tags are collected in batches. All tags of a batch
+   are searched in one scan over the sequence, and the matches of each tag
+   are stored until the scan is complete. Then the tags and their matches
+   are output in the same order as if each tag was searched separately. */
+
+typedef struct
+{
+  TgrTagwithlength *tags;
+  uint64_t *tagnumbers;
+  GtUword numoftags,
+          maxnumoftags,
+          *patternlengths;
+  const GtUchar **patterns;
+  GtArrayGtIdxMatch *matches; /* matches of the forward and the reverse
+                               complemented tag, for each tag */
+} TgrOnlinebatch;
+
+static TgrOnlinebatch *tgr_onlinebatch_new(GtUword maxnumoftags)
+{
+  TgrOnlinebatch *batch = gt_malloc(sizeof *batch);
+  GtUword idx;
+
+  batch->numoftags = 0;
+  batch->maxnumoftags = maxnumoftags;
+  batch->tags = gt_malloc(sizeof *batch->tags * maxnumoftags);
+  batch->tagnumbers = gt_malloc(sizeof *batch->tagnumbers * maxnumoftags);
+  batch->patterns = gt_malloc(sizeof *batch->patterns * 2 * maxnumoftags);
+  batch->patternlengths = gt_malloc(sizeof *batch->patternlengths * 2 *
+                                    maxnumoftags);
+  batch->matches = gt_malloc(sizeof *batch->matches * 2 * maxnumoftags);
+  for (idx = 0; idx < 2 * maxnumoftags; idx++)
+  {
+    GT_INITARRAY(batch->matches + idx,GtIdxMatch);
+  }
+  return batch;
+}
+
+static void tgr_onlinebatch_delete(TgrOnlinebatch *batch)
+{
+  if (batch != NULL)
+  {
+    GtUword idx;
+
+    for (idx = 0; idx < 2 * batch->maxnumoftags; idx++)
+    {
+      GT_FREEARRAY(batch->matches + idx,GtIdxMatch);
+    }
+    gt_free(batch->matches);
+    gt_free(batch->patterns);
+    gt_free(batch->patternlengths);
+    gt_free(batch->tagnumbers);
+    gt_free(batch->tags);
+    gt_free(batch);
+  }
+}
+
+static void tgr_onlinebatch_storematch(void *processinfo,
+                                       GtUword patternnum,
+                                       const GtIdxMatch *match)
+{
+  GtArrayGtIdxMatch *matches = (GtArrayGtIdxMatch *) processinfo;
+
+  GT_STOREINARRAY(matches + patternnum,GtIdxMatch,32,*match);
+}
+
+static void tgr_onlinebatch_flush(TgrOnlinebatch *batch,
+                                  const TageratorOptions *tageratoroptions,
+                                  Myersonlineresources *mor,
+                                  const GtAlphabet *alpha,
+                                  TgrTagwithlength *twl,
+                                  TgrShowmatchinfo *showmatchinfo)
+{
+  GtUword idx, numofpatterns = 0, patternnum;
+  GtArrayGtIdxMatch *matches;
+  int try;
+
+  if (batch->numoftags == 0)
+  {
+    return;
+  }
+  gt_assert(tageratoroptions->userdefinedmaxdistance >= 0);
+  for (idx = 0; idx < batch->numoftags; idx++)
+  {
+    if (!tageratoroptions->nofwdmatch)
+    {
+      batch->patterns[numofpatterns] = batch->tags[idx].transformedtag;
+      batch->patternlengths[numofpatterns++] = batch->tags[idx].taglen;
+    }
+    if (!tageratoroptions->norcmatch)
+    {
+      batch->patterns[numofpatterns] = batch->tags[idx].rctransformedtag;
+      batch->patternlengths[numofpatterns++] = batch->tags[idx].taglen;
+    }
+  }
+  for (patternnum = 0; patternnum < numofpatterns; patternnum++)
+  {
+    batch->matches[patternnum].nextfreeGtIdxMatch = 0;
+  }
+  if (numofpatterns > 0)
+  {
+    gt_edistmyersbitvectorAPM_multi(mor,
+                                    batch->patterns,
+                                    batch->patternlengths,
+                                    numofpatterns,
+                                    (GtUword) tageratoroptions->
+                                              userdefinedmaxdistance,
+                                    tgr_onlinebatch_storematch,
+                                    batch->matches);
+  }
+  patternnum = 0;
+  for (idx = 0; idx < batch->numoftags; idx++)
+  {
+    *twl = batch->tags[idx];
+    tgr_showtagheader(tageratoroptions,alpha,batch->tagnumbers[idx],twl);
+    for (try = 0; try < 2; try++)
+    {
+      if ((try == 0 && !tageratoroptions->nofwdmatch) ||
+          (try == 1 && !tageratoroptions->norcmatch))
+      {
+        GtUword ss;
+
+        showmatchinfo->tagptr = twl->tagptr
+                              = (try == 0) ? twl->transformedtag
+                                           : twl->rctransformedtag;
+        matches = batch->matches + patternnum++;
+        for (ss = 0; ss < matches->nextfreeGtIdxMatch; ss++)
+        {
+          tgr_showmatch(showmatchinfo,matches->spaceGtIdxMatch + ss);
+        }
+      }
+    }
+  }
+  batch->numoftags = 0;
+}
+
+static void tgr_onlinebatch_add(TgrOnlinebatch *batch,
+                                const TageratorOptions *tageratoroptions,
+                                Myersonlineresources *mor,
+                                const GtAlphabet *alpha,
+                                TgrTagwithlength *twl,
+                                TgrShowmatchinfo *showmatchinfo,
+                                uint64_t tagnumber)
+{
+  gt_assert(batch->numoftags < batch->maxnumoftags);
+  batch->tags[batch->numoftags] = *twl;
+  batch->tags[batch->numoftags].tagptr
+    = batch->tags[batch->numoftags].transformedtag;
+  batch->tagnumbers[batch->numoftags++] = tagnumber;
+  if (batch->numoftags == batch->maxnumoftags)
+  {
+    tgr_onlinebatch_flush(batch,tageratoroptions,mor,alpha,twl,
+                          showmatchinfo);
+  }
+}
+
+/* With more than one thread, the tags are searched in the index in
+   batches. Each thread has its own Limdfsresources over its own handle on the
+   shared index and repeatedly takes the next tag of the batch which is not
+   processed yet. The output for each tag is collected in a buffer, and the
+   buffers are written in the order of the input. */
+
+#define TGR_TAGSPERTHREAD 1024UL
+
+typedef struct
+{
+  Genericindex *genericindex;
+  Limdfsresources *limdfsresources;
+  TgrShowmatchinfo showmatchinfo;
+  TgrTagwithlength twl;
+} TgrThreadresources;
+
+typedef struct
+{
+  const TageratorOptions *tageratoroptions;
+  const AbstractDfstransformer *dfst;
+  const GtAlphabet *alpha;
+  TgrThreadresources *threadresources;
+  TgrTagwithlength *tags;
+  GtStr **outbufs;
+  uint64_t firsttagnumber;
+  GtUword numoftags,
+          maxnumoftags,
+          nexttag;
+  unsigned int numofthreads,
+               nextthread;
+  GtMutex *mutex;
+} TgrParallelbatch;
+
+static TgrParallelbatch *tgr_parallelbatch_new(
+                                   const TageratorOptions *tageratoroptions,
+                                   const Genericindex *genericindex,
+                                   const AbstractDfstransformer *dfst,
+                                   GtUword maxpathlength,
+                                   unsigned int numofthreads)
+{
+  TgrParallelbatch *batch = gt_malloc(sizeof *batch);
+  const GtEncseq *encseq = genericindex_getencseq(genericindex);
+  unsigned int thread;
+  GtUword idx;
+
+  batch->tageratoroptions = tageratoroptions;
+  batch->dfst = dfst;
+  batch->alpha = gt_encseq_alphabet(encseq);
+  batch->numofthreads = numofthreads;
+  batch->nextthread = 0;
+  batch->threadresources = gt_malloc(sizeof *batch->threadresources *
+                                     numofthreads);
+  for (thread = 0; thread < numofthreads; thread++)
+  {
+    TgrThreadresources *tr = batch->threadresources + thread;
+
+    tr->genericindex = genericindex_new_shared(genericindex);
+    tr->showmatchinfo.tageratoroptions = tageratoroptions;
+    tr->showmatchinfo.alphasize
+      = gt_alphabet_num_of_chars(batch->alpha);
+    tr->showmatchinfo.alpha = batch->alpha;
+    tr->showmatchinfo.eqsvector
+      = gt_malloc(sizeof (*tr->showmatchinfo.eqsvector) *
+                  tr->showmatchinfo.alphasize);
+    tr->showmatchinfo.twlptr = &tr->twl;
+    tr->showmatchinfo.encseq = encseq;
+    tr->twl.outbuf = NULL;
+    tr->limdfsresources
+      = gt_newLimdfsresources(tr->genericindex,
+                              tageratoroptions->nowildcards,
+                              tageratoroptions->maxintervalwidth,
+                              maxpathlength,
+                              false, /* keepexpandedonstack */
+                              tgr_showmatch,
+                              &tr->showmatchinfo,
+                              showmstats,
+                              &tr->twl,
+                              dfst);
+  }
+  batch->firsttagnumber = 0;
+  batch->numoftags = batch->nexttag = 0;
+  batch->maxnumoftags = TGR_TAGSPERTHREAD * numofthreads;
+  batch->tags = gt_malloc(sizeof *batch->tags * batch->maxnumoftags);
+  batch->outbufs = gt_malloc(sizeof *batch->outbufs * batch->maxnumoftags);
+  for (idx = 0; idx < batch->maxnumoftags; idx++)
+  {
+    batch->outbufs[idx] = gt_str_new();
+  }
+  batch->mutex = gt_mutex_new();
+  return batch;
+}
+
+static void tgr_parallelbatch_delete(TgrParallelbatch *batch)
+{
+  if (batch != NULL)
+  {
+    unsigned int thread;
+    GtUword idx;
+
+    for (thread = 0; thread < batch->numofthreads; thread++)
+    {
+      TgrThreadresources *tr = batch->threadresources + thread;
+
+      gt_freeLimdfsresources(&tr->limdfsresources,batch->dfst);
+      gt_free(tr->showmatchinfo.eqsvector);
+      genericindex_delete(tr->genericindex);
+    }
+    for (idx = 0; idx < batch->maxnumoftags; idx++)
+    {
+      gt_str_delete(batch->outbufs[idx]);
+    }
+    gt_mutex_delete(batch->mutex);
+    gt_free(batch->outbufs);
+    gt_free(batch->tags);
+    gt_free(batch->threadresources);
+    gt_free(batch);
+  }
+}
+
+static void *tgr_parallelbatch_thread(void *data)
+{
+  TgrParallelbatch *batch = (TgrParallelbatch *) data;
+  TgrThreadresources *tr;
+  GtUword tagnum;
+
+  gt_mutex_lock(batch->mutex);
+  gt_assert(batch->nextthread < batch->numofthreads);
+  tr = batch->threadresources + batch->nextthread++;
+  gt_mutex_unlock(batch->mutex);
+  for (;;)
+  {
+    gt_mutex_lock(batch->mutex);
+    tagnum = batch->nexttag;
+    if (tagnum < batch->numoftags)
+    {
+      batch->nexttag++;
+    }
+    gt_mutex_unlock(batch->mutex);
+    if (tagnum >= batch->numoftags)
+    {
+      break;
+    }
+    tr->twl = batch->tags[tagnum];
+    tr->twl.outbuf = batch->outbufs[tagnum];
+    gt_str_reset(tr->twl.outbuf);
+    tgr_showtagheader(batch->tageratoroptions,batch->alpha,
+                      batch->firsttagnumber + tagnum,&tr->twl);
+    searchoverstrands(batch->tageratoroptions,
+                      &tr->twl,
+                      batch->dfst,
+                      NULL,
+                      tr->limdfsresources,
+                      &tr->showmatchinfo,
+                      NULL,
+                      NULL);
+  }
+  return NULL;
+}
+
+static int tgr_parallelbatch_flush(TgrParallelbatch *batch,GtError *err)
+{
+  GtUword idx;
+
+  if (batch->numoftags == 0)
+  {
+    return 0;
+  }
+  batch->nexttag = 0;
+  batch->nextthread = 0;
+  if (gt_multithread(tgr_parallelbatch_thread,batch,err) != 0)
+  {
+    return -1;
+  }
+  for (idx = 0; idx < batch->numoftags; idx++)
+  {
+    gt_xfwrite(gt_str_get_mem(batch->outbufs[idx]),sizeof (char),
+               (size_t) gt_str_length(batch->outbufs[idx]),stdout);
+  }
+  batch->firsttagnumber += (uint64_t) batch->numoftags;
+  batch->numoftags = 0;
+  return 0;
+}
+
+static int tgr_parallelbatch_add(TgrParallelbatch *batch,
+                                 const TgrTagwithlength *twl,
+                                 GT_UNUSED uint64_t tagnumber,
+                                 GtError *err)
+{
+  gt_assert(batch->numoftags < batch->maxnumoftags);
+  gt_assert(batch->firsttagnumber + batch->numoftags == tagnumber);
+  batch->tags[batch->numoftags] = *twl;
+  batch->tags[batch->numoftags].tagptr
+    = batch->tags[batch->numoftags].transformedtag;
+  batch->numoftags++;
+  if (batch->numoftags == batch->maxnumoftags)
+  {
+    return tgr_parallelbatch_flush(batch,err);
+  }
+  return 0;
+}
+
 int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
 {
-  bool haserr = false, firstitem;
+  bool haserr = false;
   int retval;
   Myersonlineresources *mor = NULL;
   Genericindex *genericindex = NULL;
@@ -597,7 +1023,10 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
     ArrayTgrSimplematch storeonline, storeoffline;
     const AbstractDfstransformer *dfst;
     GtSeqIterator *seqit = NULL;
+    TgrOnlinebatch *onlinebatch = NULL;
+    TgrParallelbatch *parallelbatch = NULL;
 
+    twl.outbuf = NULL;
     if (tageratoroptions->userdefinedmaxdistance >= 0)
     {
       dfst = gt_apme_AbstractDfstransformer();
@@ -639,6 +1068,11 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
                                     encseq,
                                     processmatch,
                                     processmatchinfoonline);
+      if (tageratoroptions->doonline &&
+          tageratoroptions->onlinebatchsize > 1UL)
+      {
+        onlinebatch = tgr_onlinebatch_new(tageratoroptions->onlinebatchsize);
+      }
     }
     if (!tageratoroptions->doonline || tageratoroptions->docompare)
     {
@@ -653,18 +1087,26 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
       {
         maxpathlength = (GtUword) (1+MAXTAGSIZE);
       }
-      limdfsresources = gt_newLimdfsresources(genericindex,
-                                           tageratoroptions->nowildcards,
-                                           tageratoroptions->maxintervalwidth,
-                                           maxpathlength,
-                                           false, /* keepexpandedonstack */
-                                           processmatch,
-                                           processmatchinfooffline,
-                                           tageratoroptions->docompare
-                                             ? checkmstats
-                                             : showmstats,
-                                           &twl, /* refer to uninit structure */
-                                           dfst);
+      if (gt_jobs > 1U && !tageratoroptions->docompare)
+      {
+        parallelbatch = tgr_parallelbatch_new(tageratoroptions,genericindex,
+                                              dfst,maxpathlength,gt_jobs);
+      } else
+      {
+        limdfsresources
+          = gt_newLimdfsresources(genericindex,
+                                  tageratoroptions->nowildcards,
+                                  tageratoroptions->maxintervalwidth,
+                                  maxpathlength,
+                                  false, /* keepexpandedonstack */
+                                  processmatch,
+                                  processmatchinfooffline,
+                                  tageratoroptions->docompare
+                                    ? checkmstats
+                                    : showmstats,
+                                  &twl, /* refer to uninit structure */
+                                  dfst);
+      }
     }
     printf("# for each match show: ");
     gt_getsetargmodekeywords(tageratoroptions->modedesc,
@@ -694,38 +1136,42 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
                            tageratoroptions->replacewildcard,
                            err) != 0)
         {
+          if (onlinebatch != NULL)
+          {
+            tgr_onlinebatch_flush(onlinebatch,tageratoroptions,mor,alpha,
+                                  &twl,&showmatchinfo);
+          }
+          if (parallelbatch != NULL)
+          {
+            (void) tgr_parallelbatch_flush(parallelbatch,NULL);
+          }
           haserr = true;
-          gt_free(desc);
           break;
         }
         gt_copy_reversecomplement(twl.rctransformedtag,twl.transformedtag,
                                twl.taglen);
         twl.tagptr = twl.transformedtag;
-        firstitem = true;
-        printf("#");
-        if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
+        if (onlinebatch == NULL && parallelbatch == NULL)
         {
-          printf("\t" Formatuint64_t,PRINTuint64_tcast(tagnumber));
-          firstitem = false;
+          tgr_showtagheader(tageratoroptions,alpha,tagnumber,&twl);
         }
-        if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
-        {
-          ADDTABULATOR;
-          printf(""GT_WU"",twl.taglen);
-        }
-        if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
-        {
-          ADDTABULATOR;
-          gt_alphabet_decode_seq_to_fp(alpha,stdout,twl.transformedtag,
-                                       twl.taglen);
-        }
-        printf("\n");
         storeoffline.nextfreeTgrSimplematch = 0;
         storeonline.nextfreeTgrSimplematch = 0;
         if (tageratoroptions->userdefinedmaxdistance > 0 &&
             twl.taglen <= (GtUword)
                           tageratoroptions->userdefinedmaxdistance)
         {
+          if (onlinebatch != NULL)
+          {
+            tgr_onlinebatch_flush(onlinebatch,tageratoroptions,mor,alpha,
+                                  &twl,&showmatchinfo);
+            tgr_showtagheader(tageratoroptions,alpha,tagnumber,&twl);
+          }
+          if (parallelbatch != NULL)
+          {
+            (void) tgr_parallelbatch_flush(parallelbatch,NULL);
+            tgr_showtagheader(tageratoroptions,alpha,tagnumber,&twl);
+          }
           gt_error_set(err,"tag \"%*.*s\" of length "GT_WU"; "
                        "tags must be longer than the allowed number of errors "
                        "(which is "GT_WD")",
@@ -734,23 +1180,50 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
                        twl.taglen,
                        tageratoroptions->userdefinedmaxdistance);
           haserr = true;
-          gt_free(desc);
           break;
         }
         gt_assert(tageratoroptions->userdefinedmaxdistance < 0 ||
                   twl.taglen > (GtUword)
                                tageratoroptions->userdefinedmaxdistance);
-        searchoverstrands(tageratoroptions,
-                          &twl,
-                          dfst,
-                          mor,
-                          limdfsresources,
-                          &showmatchinfo,
-                          &storeonline,
-                          &storeoffline);
+        if (onlinebatch != NULL)
+        {
+          tgr_onlinebatch_add(onlinebatch,tageratoroptions,mor,alpha,&twl,
+                              &showmatchinfo,tagnumber);
+        } else
+        {
+          if (parallelbatch != NULL)
+          {
+            if (tgr_parallelbatch_add(parallelbatch,&twl,tagnumber,err) != 0)
+            {
+              haserr = true;
+            }
+          } else
+          {
+            searchoverstrands(tageratoroptions,
+                              &twl,
+                              dfst,
+                              mor,
+                              limdfsresources,
+                              &showmatchinfo,
+                              &storeonline,
+                              &storeoffline);
+          }
+        }
+      }
+      if (onlinebatch != NULL)
+      {
+        tgr_onlinebatch_flush(onlinebatch,tageratoroptions,mor,alpha,&twl,
+                              &showmatchinfo);
+      }
+      if (!haserr && parallelbatch != NULL &&
+          tgr_parallelbatch_flush(parallelbatch,err) != 0)
+      {
+        haserr = true;
       }
       gt_seq_iterator_delete(seqit);
     }
+    tgr_onlinebatch_delete(onlinebatch);
+    tgr_parallelbatch_delete(parallelbatch);
     GT_FREEARRAY(&storeonline,TgrSimplematch);
     GT_FREEARRAY(&storeoffline,TgrSimplematch);
     gt_free(showmatchinfo.eqsvector);
@@ -56,7 +56,8 @@ typedef struct
   GtWord userdefinedmaxdistance; /* maximal number of allowed differences */
   int userdefinedmaxdepth;   /* use pckbuckets only up to this depth */
   unsigned int outputmode;  /* mode of output of tag matches */
-  GtUword maxintervalwidth; /* max width of interval */
+  GtUword maxintervalwidth, /* max width of interval */
+          onlinebatchsize;  /* number of tags per scan in online search */
   size_t numberofmodedescentries;
 } TageratorOptions;
 
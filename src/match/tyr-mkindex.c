@@ -19,8 +19,13 @@
 #include "core/alphabet.h"
 #include "core/divmodmul.h"
 #include "core/fa.h"
+#include "core/fileutils_api.h"
 #include "core/format64.h"
+#include "core/intbits.h"
 #include "core/logger.h"
+#include "core/minmax.h"
+#include "core/radix_sort.h"
+#include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/spacecalc.h"
 #include "core/str.h"
 #include "core/unused_api.h"
@@ -65,7 +70,11 @@ typedef struct /* global information */
                 totallength,
                 minocc,
                 maxocc;
+  /* if <encseq> is NULL, the mers are counted in sequence files and the
+     positions delivered to <processoccurrencecount> are the integer codes
+     of the mers */
   const GtEncseq *encseq;
+  const GtAlphabet *alphabet;
   GtReadmode readmode;
   Processoccurrencecount processoccurrencecount;
   GtArrayCountwithpositions occdistribution;
@@ -180,15 +189,33 @@ static void wrapListUlong(ListUlong *node)
   }
 }
 
-static void showListUlong(const GtEncseq *encseq,
-                          GtUword mersize,
-                          const ListUlong *node)
+static void showmercode(const GtAlphabet *alphabet,GtUword code,
+                        GtUword mersize)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < mersize; idx++)
+  {
+    gt_alphabet_echo_pretty_symbol(alphabet,stdout,
+                                   (GtUchar) ((code >>
+                                               GT_MULT2(mersize - 1 - idx))
+                                              & 3UL));
+  }
+}
+
+static void showListUlong(const TyrDfsstate *state,const ListUlong *node)
 {
   const ListUlong *tmp;
 
   for (tmp = node; tmp != NULL; tmp = tmp->nextptr)
   {
-    gt_fprintfencseq(stdout,encseq,tmp->position,mersize);
+    if (state->encseq != NULL)
+    {
+      gt_fprintfencseq(stdout,state->encseq,tmp->position,state->mersize);
+    } else
+    {
+      showmercode(state->alphabet,tmp->position,state->mersize);
+    }
     (void) putchar((int) '\n');
   }
 }
@@ -254,8 +281,7 @@ static void showmerdistribution(const TyrDfsstate *state)
                                 spaceCountwithpositions[countocc].occcount);
       if (decideifocc(state,countocc))
       {
-        showListUlong(state->encseq,
-                      state->mersize,
+        showListUlong(state,
                       state->occdistribution.spaceCountwithpositions[countocc].
                                              positionlist);
         wrapListUlong(state->occdistribution.spaceCountwithpositions[countocc].
@@ -266,7 +292,7 @@ static void showmerdistribution(const TyrDfsstate *state)
 }
 
 static void showfinalstatistics(const TyrDfsstate *state,
-                                const char *inputindex,
+                                const char *inputdescription,
                                 GtLogger *logger)
 {
   uint64_t dnumofmers = addupdistribution(&state->occdistribution);
@@ -277,8 +303,7 @@ static void showfinalstatistics(const TyrDfsstate *state,
   }
   gt_logger_log(logger,
               "the following output refers to the set of all sequences");
-  gt_logger_log(logger,
-              "represented by the index \"%s\"",inputindex);
+  gt_logger_log(logger,"represented by %s",inputdescription);
   gt_logger_log(logger,
               "number of "GT_WU"-mers in the sequences not containing a "
               "wildcard: " Formatuint64_t,
@@ -344,19 +369,29 @@ static int adddistpos2distribution(GtUword countocc,
 
 #define MAXSMALLMERCOUNT UCHAR_MAX
 
-static int outputsortedstring2indexviafileptr(const GtEncseq *encseq,
-                                              GtUword mersize,
-                                              GtUchar *bytebuffer,
+/* store the code of a mer of length <mersize> in the same format as
+   <gt_encseq_sequence2bytecode()> */
+static void mercode2bytecode(GtUchar *bytecode,GtUword code,GtUword mersize)
+{
+  GtUword idx, numofbytes = MERBYTES(mersize);
+
+  code <<= GT_MULT2(GT_MULT4(numofbytes) - mersize);
+  for (idx = 0; idx < numofbytes; idx++)
+  {
+    bytecode[idx] = (GtUchar) ((code >> GT_MULT8(numofbytes - 1 - idx))
+                               & UCHAR_MAX);
+  }
+}
+
+static int outputsortedstring2indexviafileptr(GtUchar *bytebuffer,
                                               GtUword sizeofbuffer,
                                               FILE *merindexfpout,
                                               FILE *countsfilefpout,
-                                              GtUword position,
                                               GtUword countocc,
                                               GtArrayLargecount *largecounts,
                                               GtUword countoutputmers,
                                               GT_UNUSED GtError *err)
 {
-  gt_encseq_sequence2bytecode(bytebuffer,encseq,position,mersize);
   gt_xfwrite(bytebuffer, sizeof (*bytebuffer), (size_t) sizeofbuffer,
              merindexfpout);
   if (countsfilefpout != NULL)
@@ -389,13 +424,18 @@ static int outputsortedstring2index(GtUword countocc,
 
   if (decideifocc(state,countocc))
   {
-    if (outputsortedstring2indexviafileptr(state->encseq,
-                                           state->mersize,
-                                           state->bytebuffer,
+    if (state->encseq != NULL)
+    {
+      gt_encseq_sequence2bytecode(state->bytebuffer,state->encseq,position,
+                                  state->mersize);
+    } else
+    {
+      mercode2bytecode(state->bytebuffer,position,state->mersize);
+    }
+    if (outputsortedstring2indexviafileptr(state->bytebuffer,
                                            state->sizeofbuffer,
                                            state->merindexfpout,
                                            state->countsfilefpout,
-                                           position,
                                            countocc,
                                            &state->largecounts,
                                            state->countoutputmers,
@@ -511,36 +551,36 @@ static void outputbytewiseUlongvalue(FILE *fpout,GtUword value)
   }
 }
 
-static int enumeratelcpintervals(const char *inputindex,
-                                 Sequentialsuffixarrayreader *ssar,
-                                 const char *storeindex,
-                                 bool storecounts,
-                                 GtUword mersize,
-                                 GtUword minocc,
-                                 GtUword maxocc,
-                                 bool performtest,
-                                 GtLogger *logger,
-                                 GtError *err)
+static TyrDfsstate *tyr_dfsstate_new(const GtEncseq *encseq,
+                                     const GtAlphabet *alphabet,
+                                     GtReadmode readmode,
+                                     GtUword mersize,
+                                     GtUword minocc,
+                                     GtUword maxocc,
+                                     const char *storeindex,
+                                     bool storecounts,
+                                     bool performtest)
 {
-  TyrDfsstate *state;
-  bool haserr = false;
-  unsigned int alphasize;
+  TyrDfsstate *state = gt_malloc(sizeof (*state));
 
-  gt_error_check(err);
-  state = gt_malloc(sizeof (*state));
   GT_INITARRAY(&state->occdistribution,Countwithpositions);
-  state->esrspace = gt_encseq_create_reader_with_readmode(
-                                   gt_encseqSequentialsuffixarrayreader(ssar),
-                                   gt_readmodeSequentialsuffixarrayreader(ssar),
-                                   0);
+  state->encseq = encseq;
+  state->alphabet = alphabet;
+  state->readmode = readmode;
+  if (encseq != NULL)
+  {
+    state->esrspace = gt_encseq_create_reader_with_readmode(encseq,readmode,
+                                                            0);
+    state->totallength = gt_encseq_total_length(encseq);
+  } else
+  {
+    state->esrspace = NULL;
+    state->totallength = 0;
+  }
   state->mersize = (GtUword) mersize;
-  state->encseq = gt_encseqSequentialsuffixarrayreader(ssar);
-  alphasize = gt_alphabet_num_of_chars(gt_encseq_alphabet(state->encseq));
-  state->readmode = gt_readmodeSequentialsuffixarrayreader(ssar);
   state->storecounts = storecounts;
   state->minocc = minocc;
   state->maxocc = maxocc;
-  state->totallength = gt_encseq_total_length(state->encseq);
   state->performtest = performtest;
   state->countoutputmers = 0;
   state->merindexfpout = NULL;
@@ -556,15 +596,127 @@ static int enumeratelcpintervals(const char *inputindex,
     state->bytebuffer = gt_malloc(sizeof *state->bytebuffer
                                   * state->sizeofbuffer);
   }
+  state->currentmer = NULL;
+  state->suftab = NULL;
+  return state;
+}
+
+static int tyr_dfsstate_openoutput(TyrDfsstate *state,
+                                   const char *storeindex,
+                                   GtError *err)
+{
+  bool haserr = false;
+
+  if (strlen(storeindex) == 0)
+  {
+    state->processoccurrencecount = adddistpos2distribution;
+  } else
+  {
+    state->merindexfpout = gt_fa_fopen_with_suffix(storeindex,MERSUFFIX,
+                                                  "wb",err);
+    if (state->merindexfpout == NULL)
+    {
+      haserr = true;
+    } else
+    {
+      if (state->storecounts)
+      {
+        state->countsfilefpout
+          = gt_fa_fopen_with_suffix(storeindex,COUNTSSUFFIX,"wb",err);
+        if (state->countsfilefpout == NULL)
+        {
+          haserr = true;
+        }
+      }
+    }
+    state->processoccurrencecount = outputsortedstring2index;
+  }
+  return haserr ? -1 : 0;
+}
+
+static void tyr_dfsstate_finish(TyrDfsstate *state,
+                                const char *inputdescription,
+                                const char *storeindex,
+                                GtLogger *logger)
+{
+  if (strlen(storeindex) == 0)
+  {
+    showfinalstatistics(state,inputdescription,logger);
+  }
+  if (state->countsfilefpout != NULL)
+  {
+    gt_logger_log(logger,"write "GT_WU" mercounts > "GT_WU
+                  " to file \"%s%s\"",
+                  state->largecounts.nextfreeLargecount,
+                  (GtUword) MAXSMALLMERCOUNT,
+                  storeindex,
+                  COUNTSSUFFIX);
+    gt_xfwrite(state->largecounts.spaceLargecount, sizeof (Largecount),
+              (size_t) state->largecounts.nextfreeLargecount,
+              state->countsfilefpout);
+  }
+  gt_logger_log(logger,"number of "GT_WU"-mers in index: "GT_WU"",
+              state->mersize,
+              state->countoutputmers);
+  gt_logger_log(logger,"index size: %.2f megabytes\n",
+              GT_MEGABYTES(state->countoutputmers * state->sizeofbuffer +
+                           sizeof (GtUword) * EXTRAINTEGERS));
+  /* now out EXTRAINTEGERS integer values */
+  if (state->merindexfpout != NULL)
+  {
+    outputbytewiseUlongvalue(state->merindexfpout,
+                             (GtUword) state->mersize);
+    outputbytewiseUlongvalue(state->merindexfpout,
+                             (GtUword) gt_alphabet_num_of_chars(
+                                                      state->alphabet));
+  }
+}
+
+static void tyr_dfsstate_delete(TyrDfsstate *state)
+{
+  gt_fa_xfclose(state->merindexfpout);
+  gt_fa_xfclose(state->countsfilefpout);
+  GT_FREEARRAY(&state->occdistribution,Countwithpositions);
+  gt_free(state->currentmer);
+  gt_free(state->bytebuffer);
+  GT_FREEARRAY(&state->largecounts,Largecount);
+  if (state->esrspace != NULL)
+  {
+    gt_encseq_reader_delete(state->esrspace);
+  }
+  gt_free(state);
+}
+
+static int enumeratelcpintervals(const char *inputindex,
+                                 Sequentialsuffixarrayreader *ssar,
+                                 const char *storeindex,
+                                 bool storecounts,
+                                 GtUword mersize,
+                                 GtUword minocc,
+                                 GtUword maxocc,
+                                 bool performtest,
+                                 GtLogger *logger,
+                                 GtError *err)
+{
+  TyrDfsstate *state;
+  const GtEncseq *encseq = gt_encseqSequentialsuffixarrayreader(ssar);
+  bool haserr = false;
+
+  gt_error_check(err);
+  state = tyr_dfsstate_new(encseq,
+                           gt_encseq_alphabet(encseq),
+                           gt_readmodeSequentialsuffixarrayreader(ssar),
+                           mersize,
+                           minocc,
+                           maxocc,
+                           storeindex,
+                           storecounts,
+                           performtest);
   if (performtest)
   {
     state->currentmer = gt_malloc(sizeof *state->currentmer
                                   * state->mersize);
     state->suftab = gt_suftabSequentialsuffixarrayreader(ssar);
-  } else
-  {
-    state->currentmer = NULL;
-    state->suftab = NULL;
   }
   if (state->mersize > state->totallength)
   {
@@ -574,29 +726,9 @@ static int enumeratelcpintervals(const char *inputindex,
     haserr = true;
   } else
   {
-    if (strlen(storeindex) == 0)
-    {
-      state->processoccurrencecount = adddistpos2distribution;
-    } else
+    if (tyr_dfsstate_openoutput(state,storeindex,err) != 0)
     {
-      state->merindexfpout = gt_fa_fopen_with_suffix(storeindex,MERSUFFIX,
-                                                    "wb",err);
-      if (state->merindexfpout == NULL)
-      {
-        haserr = true;
-      } else
-      {
-        if (state->storecounts)
-        {
-          state->countsfilefpout
-            = gt_fa_fopen_with_suffix(storeindex,COUNTSSUFFIX,"wb",err);
-          if (state->countsfilefpout == NULL)
-          {
-            haserr = true;
-          }
-        }
-      }
-      state->processoccurrencecount = outputsortedstring2index;
+      haserr = true;
     }
     if (!haserr)
     {
@@ -614,51 +746,19 @@ static int enumeratelcpintervals(const char *inputindex,
       {
         haserr = true;
       }
-      if (strlen(storeindex) == 0)
-      {
-        showfinalstatistics(state,inputindex,logger);
-      }
     }
     if (!haserr)
     {
-      if (state->countsfilefpout != NULL)
-      {
-        gt_logger_log(logger,"write "GT_WU" mercounts > "GT_WU
-                      " to file \"%s%s\"",
-                      state->largecounts.nextfreeLargecount,
-                      (GtUword) MAXSMALLMERCOUNT,
-                      storeindex,
-                      COUNTSSUFFIX);
-        gt_xfwrite(state->largecounts.spaceLargecount, sizeof (Largecount),
-                  (size_t) state->largecounts.nextfreeLargecount,
-                  state->countsfilefpout);
-      }
-    }
-    if (!haserr)
-    {
-      gt_logger_log(logger,"number of "GT_WU"-mers in index: "GT_WU"",
-                  mersize,
-                  state->countoutputmers);
-      gt_logger_log(logger,"index size: %.2f megabytes\n",
-                  GT_MEGABYTES(state->countoutputmers * state->sizeofbuffer +
-                               sizeof (GtUword) * EXTRAINTEGERS));
+      GtStr *inputdescription = gt_str_new_cstr("the index \"");
+
+      gt_str_append_cstr(inputdescription,inputindex);
+      gt_str_append_char(inputdescription,'"');
+      tyr_dfsstate_finish(state,gt_str_get(inputdescription),storeindex,
+                          logger);
+      gt_str_delete(inputdescription);
     }
   }
-  /* now out EXTRAINTEGERS integer values */
-  if (!haserr && state->merindexfpout != NULL)
-  {
-    outputbytewiseUlongvalue(state->merindexfpout,
-                             (GtUword) state->mersize);
-    outputbytewiseUlongvalue(state->merindexfpout,(GtUword) alphasize);
-  }
-  gt_fa_xfclose(state->merindexfpout);
-  gt_fa_xfclose(state->countsfilefpout);
-  GT_FREEARRAY(&state->occdistribution,Countwithpositions);
-  gt_free(state->currentmer);
-  gt_free(state->bytebuffer);
-  GT_FREEARRAY(&state->largecounts,Largecount);
-  gt_encseq_reader_delete(state->esrspace);
-  gt_free(state);
+  tyr_dfsstate_delete(state);
   return haserr ? -1 : 0;
 }
 
@@ -711,3 +811,289 @@ int gt_merstatistics(const char *inputindex,
   }
   return haserr ? -1 : 0;
 }
+
+/* The following functions count the mers in a single pass over a set of
+   sequence files. Each mer not containing a wildcard is stored as an integer
+   code in a temporary bucket file determined by its prefix of length
+   <prefixlength>. The buckets are then processed in lexicographic order:
+   the codes of a bucket are sorted by radixsort, and equal codes are
+   counted. A bucket with more codes than fit into the given amount of
+   memory is split into ranges of codes, each of which requires another
+   scan of the bucket file. */
+
+#define TYR_STREAM_MAXPREFIXLENGTH 4U
+#define TYR_STREAM_READBUFFERSIZE  4096UL
+
+typedef struct
+{
+  GtStr *filename;
+  FILE *fp;
+  GtUword numofcodes;
+} TyrMerbucket;
+
+static unsigned int tyr_stream_prefixlength(GtUword mersize,
+                                            GtUword estimatedmers,
+                                            GtUword maxentries)
+{
+  unsigned int prefixlength = 1U;
+
+  while (prefixlength < TYR_STREAM_MAXPREFIXLENGTH &&
+         (GtUword) prefixlength < mersize &&
+         (estimatedmers >> GT_MULT2(prefixlength)) > maxentries)
+  {
+    prefixlength++;
+  }
+  return prefixlength;
+}
+
+static int tyr_stream_fillbuckets(TyrMerbucket *buckets,
+                                  const GtStrArray *filenames,
+                                  const GtAlphabet *alphabet,
+                                  GtUword mersize,
+                                  unsigned int prefixlength,
+                                  GtError *err)
+{
+  GtSeqIterator *seqit;
+  const GtUchar *sequence;
+  GtUword len;
+  char *desc;
+  const GtUword mask = mersize == (GtUword) GT_UNITSIN2BITENC
+                       ? ~0UL
+                       : (1UL << GT_MULT2(mersize)) - 1,
+                shiftright = GT_MULT2(mersize - prefixlength);
+  bool haserr = false;
+
+  seqit = gt_seq_iterator_sequence_buffer_new(filenames, err);
+  if (seqit == NULL)
+  {
+    return -1;
+  }
+  gt_seq_iterator_set_symbolmap(seqit,gt_alphabet_symbolmap(alphabet));
+  while (!haserr)
+  {
+    GtUword idx, code = 0, validlength = 0;
+    int retval = gt_seq_iterator_next(seqit,&sequence,&len,&desc,err);
+
+    if (retval < 0)
+    {
+      haserr = true;
+    }
+    if (retval <= 0)
+    {
+      break;
+    }
+    for (idx = 0; idx < len; idx++)
+    {
+      if (ISSPECIAL(sequence[idx]))
+      {
+        validlength = 0;
+      } else
+      {
+        code = ((code << 2) | (GtUword) sequence[idx]) & mask;
+        if (++validlength >= mersize)
+        {
+          TyrMerbucket *bucket = buckets + (code >> shiftright);
+
+          gt_xfwrite(&code,sizeof (code),(size_t) 1,bucket->fp);
+          bucket->numofcodes++;
+        }
+      }
+    }
+  }
+  gt_seq_iterator_delete(seqit);
+  return haserr ? -1 : 0;
+}
+
+static int tyr_stream_countrange(TyrDfsstate *state,
+                                 TyrMerbucket *bucket,
+                                 GtRadixsortinfo *radixsortinfo,
+                                 GtUword maxentries,
+                                 GtUword *readbuffer,
+                                 GtUword lowercode,
+                                 GtUword uppercode,
+                                 GtError *err)
+{
+  GtUword *sortspace = gt_radixsort_space_ulong(radixsortinfo),
+          numofcodes = 0, idx;
+  size_t numread;
+  bool haserr = false;
+
+  rewind(bucket->fp);
+  while ((numread = fread(readbuffer,sizeof (*readbuffer),
+                          (size_t) TYR_STREAM_READBUFFERSIZE,bucket->fp)) > 0)
+  {
+    for (idx = 0; idx < (GtUword) numread; idx++)
+    {
+      if (readbuffer[idx] >= lowercode && readbuffer[idx] <= uppercode)
+      {
+        if (numofcodes < maxentries)
+        {
+          sortspace[numofcodes] = readbuffer[idx];
+        }
+        numofcodes++;
+      }
+    }
+  }
+  if (ferror(bucket->fp))
+  {
+    gt_error_set(err,"cannot read file \"%s\"",gt_str_get(bucket->filename));
+    return -1;
+  }
+  if (numofcodes == 0)
+  {
+    return 0;
+  }
+  if (numofcodes > maxentries)
+  {
+    if (lowercode == uppercode)
+    {
+      return state->processoccurrencecount(numofcodes,lowercode,state,err);
+    } else
+    {
+      GtUword middlecode = lowercode + GT_DIV2(uppercode - lowercode);
+
+      if (tyr_stream_countrange(state,bucket,radixsortinfo,maxentries,
+                                readbuffer,lowercode,middlecode,err) != 0 ||
+          tyr_stream_countrange(state,bucket,radixsortinfo,maxentries,
+                                readbuffer,middlecode+1,uppercode,err) != 0)
+      {
+        haserr = true;
+      }
+    }
+  } else
+  {
+    GtUword countocc = 1UL;
+
+    gt_radixsort_inplace_sort(radixsortinfo,numofcodes);
+    for (idx = 1UL; !haserr && idx <= numofcodes; idx++)
+    {
+      if (idx < numofcodes && sortspace[idx] == sortspace[idx-1])
+      {
+        countocc++;
+      } else
+      {
+        if (state->processoccurrencecount(countocc,sortspace[idx-1],state,
+                                          err) != 0)
+        {
+          haserr = true;
+        }
+        countocc = 1UL;
+      }
+    }
+  }
+  return haserr ? -1 : 0;
+}
+
+int gt_merstatistics_stream(const GtStrArray *filenames,
+                            GtUword mersize,
+                            GtUword minocc,
+                            GtUword maxocc,
+                            const char *storeindex,
+                            bool storecounts,
+                            GtUword maximumspace,
+                            GtLogger *logger,
+                            GtError *err)
+{
+  TyrDfsstate *state;
+  GtAlphabet *alphabet;
+  TyrMerbucket *buckets;
+  GtRadixsortinfo *radixsortinfo;
+  GtUword numofbuckets, bucketnum, filenum, spaceentries, maxentries = 0,
+          estimatedmers, *readbuffer;
+  unsigned int prefixlength;
+  bool haserr = false;
+
+  gt_error_check(err);
+  if (mersize == 0 || mersize > (GtUword) GT_UNITSIN2BITENC)
+  {
+    gt_error_set(err,"mersize must be in the range from 1 to %u when "
+                     "counting the mers of sequence files",
+                 (unsigned int) GT_UNITSIN2BITENC);
+    return -1;
+  }
+  for (filenum = 0; filenum < gt_str_array_size(filenames); filenum++)
+  {
+    if (!gt_file_exists(gt_str_array_get(filenames,filenum)))
+    {
+      gt_error_set(err,"file \"%s\" does not exist",
+                   gt_str_array_get(filenames,filenum));
+      return -1;
+    }
+  }
+  alphabet = gt_alphabet_new_dna();
+  state = tyr_dfsstate_new(NULL,alphabet,GT_READMODE_FORWARD,mersize,minocc,
+                           maxocc,storeindex,storecounts,false);
+  if (tyr_dfsstate_openoutput(state,storeindex,err) != 0)
+  {
+    tyr_dfsstate_delete(state);
+    gt_alphabet_delete(alphabet);
+    return -1;
+  }
+  spaceentries = MAX(gt_radixsort_max_num_of_entries_ulong(maximumspace),
+                     TYR_STREAM_READBUFFERSIZE);
+  estimatedmers = (GtUword) gt_files_estimate_total_size(filenames);
+  prefixlength = tyr_stream_prefixlength(mersize,estimatedmers,spaceentries);
+  numofbuckets = 1UL << GT_MULT2(prefixlength);
+  gt_logger_log(logger,"count "GT_WU"-mers in "GT_WU" buckets of prefix "
+                       "length %u",mersize,numofbuckets,prefixlength);
+  buckets = gt_malloc(sizeof (*buckets) * numofbuckets);
+  for (bucketnum = 0; bucketnum < numofbuckets; bucketnum++)
+  {
+    buckets[bucketnum].filename = gt_str_new();
+    buckets[bucketnum].fp = gt_xtmpfp(buckets[bucketnum].filename);
+    buckets[bucketnum].numofcodes = 0;
+  }
+  if (tyr_stream_fillbuckets(buckets,filenames,alphabet,mersize,prefixlength,
+                             err) != 0)
+  {
+    haserr = true;
+  }
+  for (bucketnum = 0; !haserr && bucketnum < numofbuckets; bucketnum++)
+  {
+    maxentries = MAX(maxentries,buckets[bucketnum].numofcodes);
+  }
+  maxentries = MIN(maxentries,spaceentries);
+  radixsortinfo = gt_radixsort_new_ulong(MAX(maxentries,1UL));
+  readbuffer = gt_malloc(sizeof (*readbuffer) * TYR_STREAM_READBUFFERSIZE);
+  for (bucketnum = 0; !haserr && bucketnum < numofbuckets; bucketnum++)
+  {
+    const GtUword shiftleft = GT_MULT2(mersize - prefixlength),
+                  lowercode = bucketnum << shiftleft,
+                  uppercode = lowercode + (1UL << shiftleft) - 1;
+
+    if (buckets[bucketnum].numofcodes > 0 &&
+        tyr_stream_countrange(state,buckets + bucketnum,radixsortinfo,
+                              maxentries,readbuffer,lowercode,uppercode,
+                              err) != 0)
+    {
+      haserr = true;
+    }
+  }
+  gt_free(readbuffer);
+  gt_radixsort_delete(radixsortinfo);
+  for (bucketnum = 0; bucketnum < numofbuckets; bucketnum++)
+  {
+    gt_fa_xfclose(buckets[bucketnum].fp);
+    gt_xremove(gt_str_get(buckets[bucketnum].filename));
+    gt_str_delete(buckets[bucketnum].filename);
+  }
+  gt_free(buckets);
+  if (!haserr)
+  {
+    GtStr *inputdescription = gt_str_new_cstr("the sequence files");
+    GtUword idx;
+
+    for (idx = 0; idx < gt_str_array_size(filenames); idx++)
+    {
+      gt_str_append_cstr(inputdescription,idx == 0 ? " \"" : ", \"");
+      gt_str_append_cstr(inputdescription,gt_str_array_get(filenames,idx));
+      gt_str_append_char(inputdescription,'"');
+    }
+    tyr_dfsstate_finish(state,gt_str_get(inputdescription),storeindex,
+                        logger);
+    gt_str_delete(inputdescription);
+  }
+  tyr_dfsstate_delete(state);
+  gt_alphabet_delete(alphabet);
+  return haserr ? -1 : 0;
+}
@@ -20,6 +20,7 @@
 
 #include <stdbool.h>
 #include "core/str.h"
+#include "core/str_array.h"
 #include "core/error_api.h"
 #include "core/logger.h"
 
@@ -34,4 +35,18 @@ int gt_merstatistics(const char *inputindex,
                      GtLogger *logger,
                      GtError *err);
 
+/* Count the mers of length <mersize> in the sequences of the files
+   <filenames> without constructing an enhanced suffix array, using at most
+   about <maximumspace> bytes for sorting the mers. The mers are processed
+   as by <gt_merstatistics()> for an index of these files. */
+int gt_merstatistics_stream(const GtStrArray *filenames,
+                            GtUword mersize,
+                            GtUword minocc,
+                            GtUword maxocc,
+                            const char *storeindex,
+                            bool storecounts,
+                            GtUword maximumspace,
+                            GtLogger *logger,
+                            GtError *err);
+
 #endif
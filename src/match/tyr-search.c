@@ -20,9 +20,15 @@
 #include "core/unused_api.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/chardef.h"
+#include "core/divmodmul.h"
 #include "core/format64.h"
 #include "core/encseq.h"
 #include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/radix_sort.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
 #include "revcompl.h"
 #include "tyr-map.h"
 #include "tyr-search.h"
@@ -100,19 +106,16 @@ static void gt_tyrsearchinfo_delete(Tyrsearchinfo *tyrsearchinfo)
           (void) putchar('\t');\
         }
 
-static void mermatchoutput(const Tyrindex *tyrindex,
-                           const Tyrcountinfo *tyrcountinfo,
+static void mermatchoutput(const Tyrcountinfo *tyrcountinfo,
                            const Tyrsearchinfo *tyrsearchinfo,
-                           const GtUchar *result,
-                           const GtUchar *query,
-                           const GtUchar *qptr,
+                           GtUword mernumber,
+                           GtUword queryposition,
+                           const GtUchar *merseq,
                            uint64_t unitnum,
                            bool forward)
 {
   bool firstitem = true;
-  GtUword queryposition;
 
-  queryposition = (GtUword) (qptr-query);
   if (tyrsearchinfo->showmode & SHOWQSEQNUM)
   {
     printf(Formatuint64_t,PRINTuint64_tcast(unitnum));
@@ -125,7 +128,6 @@ static void mermatchoutput(const Tyrindex *tyrindex,
   }
   if (tyrsearchinfo->showmode & SHOWCOUNTS)
   {
-    GtUword mernumber = gt_tyrindex_ptr2number(tyrindex,result);
     ADDTABULATOR;
     printf(""GT_WU"",gt_tyrcountinfo_get(tyrcountinfo,mernumber));
   }
@@ -134,7 +136,7 @@ static void mermatchoutput(const Tyrindex *tyrindex,
     ADDTABULATOR;
     gt_alphabet_decode_seq_to_fp(tyrsearchinfo->dnaalpha,
                                  stdout,
-                                 qptr,
+                                 merseq,
                                  tyrsearchinfo->mersize);
   }
   if (tyrsearchinfo->showmode & (SHOWSEQUENCE | SHOWQPOS | SHOWCOUNTS))
@@ -172,11 +174,10 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
         result = gt_searchsinglemer(qptr,tyrindex,tyrsearchinfo,tyrbckinfo);
         if (result != NULL)
         {
-          mermatchoutput(tyrindex,
-                         tyrcountinfo,
+          mermatchoutput(tyrcountinfo,
                          tyrsearchinfo,
-                         result,
-                         query,
+                         gt_tyrindex_ptr2number(tyrindex,result),
+                         (GtUword) (qptr-query),
                          qptr,
                          unitnum,
                          true);
@@ -191,11 +192,10 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
                                     tyrsearchinfo,tyrbckinfo);
         if (result != NULL)
         {
-          mermatchoutput(tyrindex,
-                         tyrcountinfo,
+          mermatchoutput(tyrcountinfo,
                          tyrsearchinfo,
-                         result,
-                         query,
+                         gt_tyrindex_ptr2number(tyrindex,result),
+                         (GtUword) (qptr-query),
                          qptr,
                          unitnum,
                          false);
@@ -210,10 +210,376 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
   }
 }
 
+/* In batch mode, the mers of the queries are collected in blocks of at most
+   <batchsize> mers. The mers of a block are sorted by their integer codes
+   and merged with the sorted mer table. This replaces one binary search
+   per mer by a single scan over the part of the mer table which is
+   relevant for the block. The blocks are processed by <gt_jobs> threads
+   (see gt_multithread()) and the matches are reported in the order of the
+   queries. */
+
+typedef struct
+{
+  uint64_t unitnum;
+  GtUword queryposition,
+          mercode,    /* code of the mer on the forward strand */
+          searchcode; /* code of the mer searched in the index */
+  bool forward;
+} Tyrbatchquery;
+
+typedef struct
+{
+  const Tyrindex *tyrindex;
+  GtUword numofmers,
+          numofqueries,
+          *mernumbers;
+  Tyrbatchquery *queries;
+  GtRadixsortinfo *radixsortinfo;
+} Tyrbatchblock;
+
+typedef struct
+{
+  const Tyrcountinfo *tyrcountinfo;
+  const Tyrsearchinfo *tyrsearchinfo;
+  Tyrbatchblock *blocks;
+  unsigned int numofblocks,
+               currentblock,
+               numofusedblocks, /* the blocks processed by the threads */
+               nextblock; /* the next block to be processed by a thread */
+  GtMutex *mutex; /* protects <nextblock> */
+  GtUword batchsize,
+          merbytes;
+  GtUchar *merseq;
+} Tyrbatchsearch;
+
+static GtUword tyr_bytecode2code(const GtUchar *bytecode,GtUword merbytes)
+{
+  GtUword idx, code = 0;
+
+  for (idx = 0; idx < merbytes; idx++)
+  {
+    code = (code << 8) | (GtUword) bytecode[idx];
+  }
+  return code;
+}
+
+static void tyr_code2merseq(GtUchar *merseq,GtUword code,GtUword mersize,
+                            GtUword merbytes)
+{
+  GtUword idx;
+  unsigned int shift = (unsigned int) (GT_MULT8(merbytes) - GT_MULT2(mersize));
+
+  for (idx = mersize; idx > 0; idx--)
+  {
+    merseq[idx-1] = (GtUchar) ((code >> shift) & 3UL);
+    shift += 2;
+  }
+}
+
+static Tyrbatchsearch *tyr_batchsearch_new(const Tyrindex *tyrindex,
+                                           const Tyrcountinfo *tyrcountinfo,
+                                           const Tyrsearchinfo *tyrsearchinfo,
+                                           GtUword batchsize,
+                                           unsigned int numofblocks)
+{
+  Tyrbatchsearch *batch = gt_malloc(sizeof *batch);
+  unsigned int idx;
+
+  gt_assert(batchsize > 0 && numofblocks > 0);
+  batch->tyrcountinfo = tyrcountinfo;
+  batch->tyrsearchinfo = tyrsearchinfo;
+  batch->batchsize = batchsize;
+  batch->merbytes = gt_tyrindex_merbytes(tyrindex);
+  batch->numofblocks = numofblocks;
+  batch->currentblock = 0;
+  batch->numofusedblocks = 0;
+  batch->nextblock = 0;
+  batch->mutex = gt_mutex_new();
+  batch->merseq = gt_malloc(sizeof *batch->merseq * tyrsearchinfo->mersize);
+  batch->blocks = gt_malloc(sizeof *batch->blocks * numofblocks);
+  for (idx = 0; idx < numofblocks; idx++)
+  {
+    Tyrbatchblock *block = batch->blocks + idx;
+
+    block->tyrindex = tyrindex;
+    block->numofmers = gt_tyrindex_isempty(tyrindex)
+                         ? 0
+                         : gt_tyrindex_ptr2number(tyrindex,
+                                                  gt_tyrindex_lastmer(tyrindex))
+                           + 1;
+    block->numofqueries = 0;
+    block->queries = gt_malloc(sizeof *block->queries * batchsize);
+    block->mernumbers = gt_malloc(sizeof *block->mernumbers * batchsize);
+    block->radixsortinfo = gt_radixsort_new_ulongpair(batchsize);
+  }
+  return batch;
+}
+
+static void tyr_batchsearch_delete(Tyrbatchsearch *batch)
+{
+  if (batch != NULL)
+  {
+    unsigned int idx;
+
+    for (idx = 0; idx < batch->numofblocks; idx++)
+    {
+      gt_free(batch->blocks[idx].queries);
+      gt_free(batch->blocks[idx].mernumbers);
+      gt_radixsort_delete(batch->blocks[idx].radixsortinfo);
+    }
+    gt_free(batch->blocks);
+    gt_mutex_delete(batch->mutex);
+    gt_free(batch->merseq);
+    gt_free(batch);
+  }
+}
+
+#define TYR_MERCODE(IDX)\
+        tyr_bytecode2code(mertable + (IDX) * merbytes,merbytes)
+
+/* Return the smallest index <idx> >= <left> such that the code of mer
+   <idx> is not smaller than <key>. As the keys of a block are sorted,
+   we search with exponentially increasing steps from the previous
+   result. */
+
+static GtUword tyr_mertable_lowerbound(const GtUchar *mertable,
+                                       GtUword merbytes,
+                                       GtUword numofmers,
+                                       GtUword left,
+                                       GtUword key)
+{
+  GtUword step, right, mid;
+
+  if (left >= numofmers || TYR_MERCODE(left) >= key)
+  {
+    return left;
+  }
+  for (step = 1UL; left + step < numofmers && TYR_MERCODE(left + step) < key;
+       step = GT_MULT2(step))
+  {
+    left += step;
+  }
+  right = MIN(left + step,numofmers);
+  /* now the code of mer <left> is smaller than <key> and
+     <right> is either <numofmers> or the code of mer <right> is not
+     smaller than key */
+  while (left + 1 < right)
+  {
+    mid = left + GT_DIV2(right - left);
+    if (TYR_MERCODE(mid) < key)
+    {
+      left = mid;
+    } else
+    {
+      right = mid;
+    }
+  }
+  return right;
+}
+
+static void tyr_batchblock_join(Tyrbatchblock *block)
+{
+  GtUlongPair *pairs = gt_radixsort_space_ulongpair(block->radixsortinfo);
+  const GtUchar *mertable = gt_tyrindex_mertable(block->tyrindex);
+  const GtUword merbytes = gt_tyrindex_merbytes(block->tyrindex);
+  GtUword idx, mernumber = 0;
+
+  for (idx = 0; idx < block->numofqueries; idx++)
+  {
+    pairs[idx].a = block->queries[idx].searchcode;
+    pairs[idx].b = idx;
+  }
+  gt_radixsort_inplace_sort(block->radixsortinfo,block->numofqueries);
+  for (idx = 0; idx < block->numofqueries; idx++)
+  {
+    mernumber = tyr_mertable_lowerbound(mertable,merbytes,block->numofmers,
+                                        mernumber,pairs[idx].a);
+    if (mernumber < block->numofmers &&
+        TYR_MERCODE(mernumber) == pairs[idx].a)
+    {
+      block->mernumbers[pairs[idx].b] = mernumber;
+    } else
+    {
+      block->mernumbers[pairs[idx].b] = GT_UNDEF_UWORD;
+    }
+  }
+}
+
+static void *tyr_batchsearch_thread_caller(void *data)
+{
+  Tyrbatchsearch *batch = (Tyrbatchsearch *) data;
+  unsigned int idx;
+
+  while (true)
+  {
+    gt_mutex_lock(batch->mutex);
+    if (batch->nextblock == batch->numofusedblocks)
+    {
+      gt_mutex_unlock(batch->mutex);
+      break;
+    }
+    idx = batch->nextblock++;
+    gt_mutex_unlock(batch->mutex);
+    tyr_batchblock_join(batch->blocks + idx);
+  }
+  return NULL;
+}
+
+static void tyr_batchblock_output(const Tyrbatchsearch *batch,
+                                  const Tyrbatchblock *block)
+{
+  const Tyrsearchinfo *tyrsearchinfo = batch->tyrsearchinfo;
+  GtUword idx;
+
+  for (idx = 0; idx < block->numofqueries; idx++)
+  {
+    const Tyrbatchquery *query = block->queries + idx;
+
+    if (block->mernumbers[idx] != GT_UNDEF_UWORD)
+    {
+      if (tyrsearchinfo->showmode & SHOWSEQUENCE)
+      {
+        tyr_code2merseq(batch->merseq,query->mercode,tyrsearchinfo->mersize,
+                        batch->merbytes);
+      }
+      mermatchoutput(batch->tyrcountinfo,
+                     tyrsearchinfo,
+                     block->mernumbers[idx],
+                     query->queryposition,
+                     batch->merseq,
+                     query->unitnum,
+                     query->forward);
+    }
+  }
+}
+
+static int tyr_batchsearch_flush(Tyrbatchsearch *batch,GtError *err)
+{
+  unsigned int idx, numofusedblocks = batch->currentblock;
+  bool haserr = false;
+
+  if (numofusedblocks < batch->numofblocks &&
+      batch->blocks[numofusedblocks].numofqueries > 0)
+  {
+    numofusedblocks++;
+  }
+  if (numofusedblocks > 1U)
+  {
+    batch->numofusedblocks = numofusedblocks;
+    batch->nextblock = 0;
+    if (gt_multithread(tyr_batchsearch_thread_caller,batch,err) != 0)
+    {
+      haserr = true;
+    }
+  } else
+  {
+    if (numofusedblocks == 1U)
+    {
+      tyr_batchblock_join(batch->blocks);
+    }
+  }
+  for (idx = 0; idx < numofusedblocks; idx++)
+  {
+    if (!haserr)
+    {
+      tyr_batchblock_output(batch,batch->blocks + idx);
+    }
+    batch->blocks[idx].numofqueries = 0;
+  }
+  batch->currentblock = 0;
+  return haserr ? -1 : 0;
+}
+
+static int tyr_batchsearch_add(Tyrbatchsearch *batch,
+                               uint64_t unitnum,
+                               GtUword queryposition,
+                               GtUword mercode,
+                               GtUword searchcode,
+                               bool forward,
+                               GtError *err)
+{
+  Tyrbatchblock *block = batch->blocks + batch->currentblock;
+  Tyrbatchquery *query = block->queries + block->numofqueries++;
+
+  query->unitnum = unitnum;
+  query->queryposition = queryposition;
+  query->mercode = mercode;
+  query->searchcode = searchcode;
+  query->forward = forward;
+  if (block->numofqueries == batch->batchsize)
+  {
+    batch->currentblock++;
+    if (batch->currentblock == batch->numofblocks)
+    {
+      return tyr_batchsearch_flush(batch,err);
+    }
+  }
+  return 0;
+}
+
+static int singleseqtyrbatchsearch(Tyrbatchsearch *batch,
+                                   uint64_t unitnum,
+                                   const GtUchar *query,
+                                   GtUword querylen,
+                                   GtError *err)
+{
+  const Tyrsearchinfo *tyrsearchinfo = batch->tyrsearchinfo;
+  const GtUchar *qptr;
+  GtUword offset, skipvalue, mercode, rccode;
+
+  if (tyrsearchinfo->mersize > querylen)
+  {
+    return 0;
+  }
+  qptr = query;
+  offset = 0;
+  while (qptr <= query + querylen - tyrsearchinfo->mersize)
+  {
+    skipvalue = containsspecialbytestring(qptr,offset,tyrsearchinfo->mersize);
+    if (skipvalue == tyrsearchinfo->mersize)
+    {
+      offset = tyrsearchinfo->mersize-1;
+      gt_encseq_plainseq2bytecode(tyrsearchinfo->bytecode,qptr,
+                                  tyrsearchinfo->mersize);
+      mercode = tyr_bytecode2code(tyrsearchinfo->bytecode,batch->merbytes);
+      if (tyrsearchinfo->searchstrand & STRAND_FORWARD)
+      {
+        if (tyr_batchsearch_add(batch,unitnum,(GtUword) (qptr-query),
+                                mercode,mercode,true,err) != 0)
+        {
+          return -1;
+        }
+      }
+      if (tyrsearchinfo->searchstrand & STRAND_REVERSE)
+      {
+        gt_assert(tyrsearchinfo->rcbuf != NULL);
+        gt_copy_reversecomplement(tyrsearchinfo->rcbuf,qptr,
+                                  tyrsearchinfo->mersize);
+        gt_encseq_plainseq2bytecode(tyrsearchinfo->bytecode,
+                                    tyrsearchinfo->rcbuf,
+                                    tyrsearchinfo->mersize);
+        rccode = tyr_bytecode2code(tyrsearchinfo->bytecode,batch->merbytes);
+        if (tyr_batchsearch_add(batch,unitnum,(GtUword) (qptr-query),
+                                mercode,rccode,false,err) != 0)
+        {
+          return -1;
+        }
+      }
+      qptr++;
+    } else
+    {
+      offset = 0;
+      qptr += (skipvalue+1);
+    }
+  }
+  return 0;
+}
+
 int gt_tyrsearch(const char *tyrindexname,
                  const GtStrArray *queryfilenames,
                  unsigned int showmode,
                  unsigned int searchstrand,
+                 GtUword batchsize,
                  bool verbose,
                  bool performtest,
                  GtError *err)
@@ -265,6 +631,16 @@ int gt_tyrsearch(const char *tyrindexname,
       }
     }
   }
+  if (!haserr && batchsize > 0)
+  {
+    gt_assert(tyrindex != NULL);
+    if (gt_tyrindex_merbytes(tyrindex) > (GtUword) sizeof (GtUword))
+    {
+      gt_error_set(err,"option -batch requires a mersize of at most "GT_WU,
+                   (GtUword) GT_MULT4(sizeof (GtUword)));
+      haserr = true;
+    }
+  }
   if (!haserr)
   {
     const GtUchar *query;
@@ -273,10 +649,16 @@ int gt_tyrsearch(const char *tyrindexname,
     uint64_t unitnum;
     int retval;
     Tyrsearchinfo tyrsearchinfo;
+    Tyrbatchsearch *batch = NULL;
     GtSeqIterator *seqit;
 
     gt_assert(tyrindex != NULL);
     gt_tyrsearchinfo_init(&tyrsearchinfo,tyrindex,showmode,searchstrand);
+    if (batchsize > 0)
+    {
+      batch = tyr_batchsearch_new(tyrindex,tyrcountinfo,&tyrsearchinfo,
+                                  batchsize,MAX(gt_jobs,1U));
+    }
     seqit = gt_seq_iterator_sequence_buffer_new(queryfilenames, err);
     if (!seqit)
       haserr = true;
@@ -300,17 +682,33 @@ int gt_tyrsearch(const char *tyrindexname,
         {
           break;
         }
-        singleseqtyrsearch(tyrindex,
-                           tyrcountinfo,
-                           &tyrsearchinfo,
-                           tyrbckinfo,
-                           unitnum,
-                           query,
-                           querylen,
-                           desc);
+        if (batch != NULL)
+        {
+          if (singleseqtyrbatchsearch(batch,unitnum,query,querylen,err) != 0)
+          {
+            haserr = true;
+            break;
+          }
+        } else
+        {
+          singleseqtyrsearch(tyrindex,
+                             tyrcountinfo,
+                             &tyrsearchinfo,
+                             tyrbckinfo,
+                             unitnum,
+                             query,
+                             querylen,
+                             desc);
+        }
+      }
+      if (!haserr && batch != NULL &&
+          tyr_batchsearch_flush(batch,err) != 0)
+      {
+        haserr = true;
       }
       gt_seq_iterator_delete(seqit);
     }
+    tyr_batchsearch_delete(batch);
     gt_tyrsearchinfo_delete(&tyrsearchinfo);
   }
   if (tyrbckinfo != NULL)
@@ -23,10 +23,14 @@
 #include "core/str_array_api.h"
 #include "core/error_api.h"
 
+/* Search the mers of the sequences in <queryfilenames> in the index
+   <tyrindexname>. If <batchsize> is not 0, then the mers are searched in
+   blocks of <batchsize> mers, which are processed by <gt_jobs> threads. */
 int gt_tyrsearch(const char *tyrindexname,
                  const GtStrArray *queryfilenames,
                  unsigned int showmode,
                  unsigned int searchstrand,
+                 GtUword batchsize,
                  bool verbose,
                  bool performtest,
                  GtError *err);
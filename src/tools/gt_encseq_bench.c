@@ -23,17 +23,21 @@
 #include "core/mathsupport.h"
 #include "core/showtime.h"
 #include "core/logger.h"
+#include "core/readmode_api.h"
+#include "core/str_api.h"
 #include "tools/gt_encseq_bench.h"
 
 typedef struct
 {
-  GtUword ccext;
+  GtUword ccext, substrext, substrlen;
+  GtStr *readmode;
   bool sortlenprepare, verbose;
 } GtEncseqBenchArguments;
 
 static void* gt_encseq_bench_arguments_new(void)
 {
   GtEncseqBenchArguments *arguments = gt_malloc(sizeof *arguments);
+  arguments->readmode = gt_str_new();
   return arguments;
 }
 
@@ -43,6 +47,7 @@ static void gt_encseq_bench_arguments_delete(void *tool_arguments)
 
   if (arguments != NULL)
   {
+    gt_str_delete(arguments->readmode);
     gt_free(arguments);
   }
 }
@@ -64,6 +69,22 @@ static GtOptionParser* gt_encseq_bench_option_parser_new(void *tool_arguments)
                                &arguments->ccext, 0UL);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_uword("substrext", "specify number of random "
+                                            "substring extractions",
+                               &arguments->substrext, 0UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("substrlen", "specify length of substrings "
+                                                "extracted with -substrext",
+                                   &arguments->substrlen, 1000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_string("readmode", "specify readmode of substrings "
+                                            "extracted with -substrext\n"
+                                            "(fwd, rev, cpl or rcl)",
+                                arguments->readmode, "fwd");
+  gt_option_parser_add_option(op, option);
+
   option = gt_option_new_bool("solepr", "prepare data structure for sequences "
                                          "ordered by their length",
                                &arguments->sortlenprepare, false);
@@ -102,6 +123,40 @@ static void gt_bench_character_extractions(const GtEncseq *encseq,
   }
 }
 
+static void gt_bench_substring_extractions(const GtEncseq *encseq,
+                                           GtReadmode readmode,
+                                           GtUword substrext,
+                                           GtUword substrlen)
+{
+  GtUword idx, pos, ccsum = 0, totallength = gt_encseq_total_length(encseq);
+  GtUchar *buffer;
+  GtTimer *timer = NULL;
+
+  if (substrlen > totallength)
+    substrlen = totallength;
+  buffer = gt_malloc(sizeof (*buffer) * substrlen);
+  if (gt_showtime_enabled()) {
+    timer = gt_timer_new_with_progress_description("run substring "
+                                                   "extractions");
+    gt_timer_start(timer);
+  }
+  for (idx = 0; idx < substrext; idx++) {
+    GtUword startpos = gt_rand_max(totallength - substrlen);
+
+    gt_encseq_extract_encoded_with_readmode(encseq, buffer, readmode,
+                                            startpos, startpos + substrlen - 1);
+    for (pos = 0; pos < substrlen; pos++) {
+      ccsum += (GtUword) buffer[pos];
+    }
+  }
+  printf("ccsum="GT_WU"\n",ccsum);
+  if (timer != NULL) {
+    gt_timer_show_progress_final(timer, stdout);
+    gt_timer_delete(timer);
+  }
+  gt_free(buffer);
+}
+
 typedef struct
 {
   GtUword minlength, maxlength, numofdifferentseqlen, *seqlenseppos,
@@ -327,6 +382,18 @@ static int gt_encseq_bench_runner(GT_UNUSED int argc, const char **argv,
       gt_logger_log(logger,"perform character extractions");
       gt_bench_character_extractions(encseq,arguments->ccext);
     }
+    if (!had_err && arguments->substrext > 0) {
+      int readmode = gt_readmode_parse(gt_str_get(arguments->readmode), err);
+
+      if (readmode < 0)
+        had_err = -1;
+      else {
+        gt_logger_log(logger,"perform substring extractions");
+        gt_bench_substring_extractions(encseq, (GtReadmode) readmode,
+                                       arguments->substrext,
+                                       arguments->substrlen);
+      }
+    }
   }
   gt_encseq_delete(encseq);
   gt_encseq_loader_delete(encseq_loader);
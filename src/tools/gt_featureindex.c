@@ -24,6 +24,7 @@
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/anno_db_schema_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_file_api.h"
 #include "extended/feature_node.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_visitor.h"
@@ -38,6 +39,7 @@
 
 #define GT_SQLITE_BACKEND_STRING "sqlite"
 #define GT_MYSQL_BACKEND_STRING  "mysql"
+#define GT_FILE_BACKEND_STRING   "file"
 
 typedef struct {
   GtRange qry_rng;
@@ -95,6 +97,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
     GT_MYSQL_BACKEND_STRING,
 #endif
+    GT_FILE_BACKEND_STRING,
     NULL
   };
   gt_assert(arguments);
@@ -121,12 +124,12 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
   backend_option = gt_option_new_choice("backend", "database backend to use\n"
                                         "choose from ["
 #ifdef HAVE_SQLITE
-                                         GT_SQLITE_BACKEND_STRING
+                                        GT_SQLITE_BACKEND_STRING "|"
 #endif
 #ifdef HAVE_MYSQL
-                                        "|" GT_MYSQL_BACKEND_STRING
+                                        GT_MYSQL_BACKEND_STRING "|"
 #endif
-                                        "]",
+                                        GT_FILE_BACKEND_STRING "]",
                                         arguments->backend, backends[0],
                                         backends);
   gt_option_parser_add_option(op, backend_option);
@@ -134,7 +137,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
   /* -filename */
   filenameoption = gt_option_new_string("filename",
                                         "filename for feature database "
-                                        "(sqlite backend only)",
+                                        "(sqlite and file backends only)",
                                         arguments->filename, NULL);
   gt_option_parser_add_option(op, filenameoption);
 
@@ -247,15 +250,22 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
     }
   }
 #endif
-  if (!had_err)
-    adbs = gt_anno_db_gfflike_new();
+  if (!had_err && strcmp(gt_str_get(arguments->backend),
+                         GT_FILE_BACKEND_STRING) == 0) {
+    fi = gt_feature_index_file_new(gt_str_get(arguments->filename), err);
+    had_err = fi ? 0 : -1;
+  }
+  else {
+    if (!had_err)
+      adbs = gt_anno_db_gfflike_new();
 
-  if (!had_err && !adbs)
-    had_err = -1;
+    if (!had_err && !adbs)
+      had_err = -1;
 
-  if (!had_err) {
-    fi = gt_anno_db_schema_get_feature_index(adbs, rdb, err);
-    had_err = fi ? 0 : -1;
+    if (!had_err) {
+      fi = gt_anno_db_schema_get_feature_index(adbs, rdb, err);
+      had_err = fi ? 0 : -1;
+    }
   }
 
   if (!had_err && gt_str_length(arguments->seqid) == 0) {
@@ -280,6 +290,11 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
                                                    gt_str_get(arguments->seqid),
                                                    &arguments->qry_rng, err);
   }
+  if (!had_err && !adbs) {
+    /* the file based index keeps its features, the loop below deletes them */
+    for (i = 0; i < gt_array_size(results); i++)
+      gt_genome_node_ref(*(GtGenomeNode**) gt_array_get(results, i));
+  }
   if (!had_err) {
     gff3visitor = gt_gff3_visitor_new(NULL);
     if (arguments->retain)
@@ -289,6 +304,12 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
                                                    gt_str_get(arguments->seqid),
                                                    err);
   }
+  if (!had_err) {
+    /* prefer the range of the original sequence region */
+    had_err = gt_feature_index_get_orig_range_for_seqid(fi, &rng,
+                                                   gt_str_get(arguments->seqid),
+                                                        err);
+  }
   if (!had_err) {
     regn = gt_region_node_new(arguments->seqid, rng.start, rng.end);
     gt_genome_node_accept(regn, gff3visitor, err);
@@ -20,6 +20,7 @@
 #include "core/option_api.h"
 #include "core/output_file_api.h"
 #include "core/undef_api.h"
+#include "core/unused_api.h"
 #include "core/versionfunc.h"
 #include "extended/add_introns_stream_api.h"
 #include "extended/genome_node.h"
@@ -51,8 +52,9 @@ typedef struct {
        show,
        fixboundaries;
   GtWord offset;
-  GtStr *offsetfile, *newsource;
-  GtUword width;
+  GtStr *offsetfile, *newsource, *memlimitarg;
+  GtUword width,
+          memlimit;
   GtTypecheckInfo *tci;
   GtXRFCheckInfo *xci;
   GtOutputFileInfo *ofi;
@@ -64,6 +66,7 @@ static void* gt_gff3_arguments_new(void)
   GFF3Arguments *arguments = gt_calloc(1, sizeof *arguments);
   arguments->newsource = gt_str_new();
   arguments->offsetfile = gt_str_new();
+  arguments->memlimitarg = gt_str_new();
   arguments->tci = gt_typecheck_info_new();
   arguments->xci = gt_xrfcheck_info_new();
   arguments->ofi = gt_output_file_info_new();
@@ -80,6 +83,7 @@ static void gt_gff3_arguments_delete(void *tool_arguments)
   gt_typecheck_info_delete(arguments->tci);
   gt_xrfcheck_info_delete(arguments->xci);
   gt_str_delete(arguments->offsetfile);
+  gt_str_delete(arguments->memlimitarg);
   gt_free(arguments);
 }
 
@@ -89,7 +93,7 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   GtOptionParser *op;
   GtOption *sort_option, *load_option, *strict_option, *tidy_option,
            *mergefeat_option, *addintrons_option, *offset_option,
-           *offsetfile_option, *setsource_option, *option;
+           *offsetfile_option, *setsource_option, *memlimit_option, *option;
   gt_assert(arguments);
 
   /* init */
@@ -103,6 +107,16 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                                    &arguments->sort, false);
   gt_option_parser_add_option(op, sort_option);
 
+  /* -memlimit */
+  memlimit_option = gt_option_new_string("memlimit", "limit the memory used "
+                                         "for sorting, sort in external memory "
+                                         "(temporary files) if necessary (in "
+                                         "bytes, the keywords 'MB' and 'GB' "
+                                         "are allowed)",
+                                         arguments->memlimitarg, NULL);
+  gt_option_imply(memlimit_option, sort_option);
+  gt_option_parser_add_option(op, memlimit_option);
+
   /* -strict */
   strict_option = gt_option_new_bool("strict", "be very strict during GFF3 "
                                      "parsing (stricter than the specification "
@@ -218,6 +232,21 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   return op;
 }
 
+static int gt_gff3_arguments_check(GT_UNUSED int rest_argc,
+                                   void *tool_arguments, GtError *err)
+{
+  GFF3Arguments *arguments = tool_arguments;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+  arguments->memlimit = 0;
+  if (gt_str_length(arguments->memlimitarg)) {
+    had_err = gt_option_parse_spacespec(&arguments->memlimit, "memlimit",
+                                        arguments->memlimitarg, err);
+  }
+  return had_err;
+}
+
 static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
                           void *tool_arguments, GtError *err)
 {
@@ -296,6 +325,8 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   /* create sort stream (if necessary) */
   if (!had_err && arguments->sort) {
     sort_stream = gt_sort_stream_new(last_stream);
+    if (arguments->memlimit)
+      gt_sort_stream_set_memlimit(sort_stream, arguments->memlimit);
     last_stream = sort_stream;
   }
 
@@ -354,6 +385,6 @@ GtTool* gt_gff3(void)
   return gt_tool_new(gt_gff3_arguments_new,
                      gt_gff3_arguments_delete,
                      gt_gff3_option_parser_new,
-                     NULL,
+                     gt_gff3_arguments_check,
                      gt_gff3_runner);
 }
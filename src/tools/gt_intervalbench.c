@@ -0,0 +1,219 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/interval_index_api.h"
+#include "core/interval_tree_api.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/msort_api.h"
+#include "core/str.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "core/yarandom.h"
+#include "tools/gt_intervalbench.h"
+
+typedef struct {
+  GtStr *impl;
+  GtUword num_intervals,
+          num_queries,
+          maxpos,
+          width,
+          query_width,
+          seed;
+  bool verbose;
+} IntervalBenchArguments;
+
+static void *gt_intervalbench_arguments_new(void)
+{
+  IntervalBenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->impl = gt_str_new();
+  return arguments;
+}
+
+static void gt_intervalbench_arguments_delete(void *tool_arguments)
+{
+  IntervalBenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->impl);
+  gt_free(arguments);
+}
+
+static const char *gt_interval_implementation_names[]
+  = {"tree", "index", "batch", NULL};
+
+static GtOptionParser* gt_intervalbench_option_parser_new(void *tool_arguments)
+{
+  IntervalBenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...]",
+                            "Benchmark interval tree against interval index.");
+
+  option = gt_option_new_choice("impl", "implementation\n"
+                                "choose from tree|index|batch",
+                                arguments->impl,
+                                gt_interval_implementation_names[0],
+                                gt_interval_implementation_names);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("size", "number of intervals",
+                               &arguments->num_intervals, 1000000UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("queries", "number of query ranges",
+                               &arguments->num_queries, 1000000UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("maxpos", "maximal start position",
+                                   &arguments->maxpos, 100000000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("width", "maximal interval width",
+                                   &arguments->width, 5000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("qwidth", "maximal query range width",
+                                   &arguments->query_width, 10000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("seed", "seed for random number generator",
+                               &arguments->seed, 366292341UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+  return op;
+}
+
+static int count_overlap(GT_UNUSED GtIntervalTreeNode *node, void *data)
+{
+  (*(GtUword*) data)++;
+  return 0;
+}
+
+static int count_index_overlap(GT_UNUSED void *interval_data, void *data)
+{
+  (*(GtUword*) data)++;
+  return 0;
+}
+
+static int count_batch_overlap(GT_UNUSED GtUword query,
+                               GT_UNUSED void *interval_data, void *data,
+                               GT_UNUSED GtError *err)
+{
+  (*(GtUword*) data)++;
+  return 0;
+}
+
+static int gt_intervalbench_runner(GT_UNUSED int argc,
+                                   GT_UNUSED const char **argv,
+                                   GT_UNUSED int parsed_args,
+                                   void *tool_arguments, GtError *err)
+{
+  IntervalBenchArguments *arguments = tool_arguments;
+  const char *impl;
+  GtRange *intervals, *queries;
+  GtTimer *timer;
+  GtUword i, num_overlaps = 0;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+  impl = gt_str_get(arguments->impl);
+  if (arguments->verbose) {
+    printf("# number of intervals = "GT_WU"\n", arguments->num_intervals);
+    printf("# number of queries = "GT_WU"\n", arguments->num_queries);
+    printf("# implementation = %s\n", impl);
+  }
+
+  /* prepare benchmark input data, intervals in random order and queries
+     sorted by start position */
+  (void) gt_ya_rand_init((unsigned int) arguments->seed);
+  intervals = gt_malloc(sizeof *intervals * arguments->num_intervals);
+  for (i = 0; i < arguments->num_intervals; i++) {
+    intervals[i].start = gt_rand_max(arguments->maxpos);
+    intervals[i].end = intervals[i].start + gt_rand_max(arguments->width);
+  }
+  queries = gt_malloc(sizeof *queries * arguments->num_queries);
+  for (i = 0; i < arguments->num_queries; i++) {
+    queries[i].start = gt_rand_max(arguments->maxpos);
+    queries[i].end = queries[i].start + gt_rand_max(arguments->query_width);
+  }
+  gt_msort(queries, (size_t) arguments->num_queries, sizeof *queries,
+           (GtCompare) gt_range_compare);
+
+  timer = gt_timer_new_with_progress_description("build");
+  gt_timer_start(timer);
+  if (strcmp(impl, "tree") == 0) {
+    GtIntervalTree *it = gt_interval_tree_new(NULL);
+    for (i = 0; i < arguments->num_intervals; i++) {
+      gt_interval_tree_insert(it, gt_interval_tree_node_new(intervals + i,
+                                                          intervals[i].start,
+                                                          intervals[i].end));
+    }
+    gt_timer_show_progress(timer, "query", stdout);
+    for (i = 0; i < arguments->num_queries; i++) {
+      gt_interval_tree_iterate_overlapping(it, count_overlap, queries[i].start,
+                                           queries[i].end, &num_overlaps);
+    }
+    gt_interval_tree_delete(it);
+  }
+  else {
+    GtIntervalIndex *ii = gt_interval_index_new(NULL);
+    for (i = 0; i < arguments->num_intervals; i++) {
+      gt_interval_index_add(ii, intervals + i, intervals[i].start,
+                            intervals[i].end);
+    }
+    gt_interval_index_build(ii);
+    gt_timer_show_progress(timer, "query", stdout);
+    if (strcmp(impl, "batch") == 0) {
+      had_err = gt_interval_index_batch_query(ii, queries,
+                                              arguments->num_queries,
+                                              count_batch_overlap,
+                                              &num_overlaps, err);
+    }
+    else {
+      for (i = 0; i < arguments->num_queries; i++) {
+        (void) gt_interval_index_iterate_overlapping(ii, count_index_overlap,
+                                                     queries[i].start,
+                                                     queries[i].end,
+                                                     &num_overlaps);
+      }
+    }
+    gt_interval_index_delete(ii);
+  }
+  gt_timer_show_progress_final(timer, stdout);
+  gt_timer_delete(timer);
+  if (!had_err)
+    printf("overlaps = "GT_WU"\n", num_overlaps);
+  gt_free(queries);
+  gt_free(intervals);
+  return had_err;
+}
+
+GtTool* gt_intervalbench(void)
+{
+  return gt_tool_new(gt_intervalbench_arguments_new,
+                     gt_intervalbench_arguments_delete,
+                     gt_intervalbench_option_parser_new,
+                     NULL,
+                     gt_intervalbench_runner);
+}
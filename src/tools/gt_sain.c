@@ -28,7 +28,7 @@
 
 typedef struct
 {
-  bool icheck, fcheck, outlcptab, lcpkasai,
+  bool icheck, fcheck, outsuftab, outlcptab, lcpkasai,
        verbose, dommap, dnaalphabet, proteinalphabet;
   GtStr *encseqfile, *plainseqfile, *fastafile, *dir, *smap;
   GtReadmode readmode;
@@ -61,6 +61,17 @@ static void gt_sain_arguments_delete(void *tool_arguments)
   }
 }
 
+static void gt_sain_showsuftab(const GtUsainindextype *suftab,
+                               GtUword numofsuffixes)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < numofsuffixes; idx++)
+  {
+    printf(GT_WU "\n",(GtUword) suftab[idx]);
+  }
+}
+
 static GtOptionParser *gt_sain_option_parser_new(void *tool_arguments)
 {
   GtSainArguments *arguments = tool_arguments;
@@ -85,6 +96,11 @@ static GtOptionParser *gt_sain_option_parser_new(void *tool_arguments)
   /* -dir */
   gt_encseq_options_add_readmode_option(op, arguments->dir);
 
+  /* -suf */
+  option = gt_option_new_bool("suf", "output suffix array, one suffix per line",
+                              &arguments->outsuftab, false);
+  gt_option_parser_add_option(op, option);
+
   /* -lcp */
   optionlcp = gt_option_new_bool("lcp", "output lcp table",
                                  &arguments->outlcptab, false);
@@ -329,6 +345,10 @@ static int gt_sain_runner(int argc, GT_UNUSED const char **argv,
                                                arguments->fcheck,
                                                tl->logger,
                                                tl->timer);
+          if (arguments->outsuftab)
+          {
+            gt_sain_showsuftab(suftab,gt_encseq_total_length(encseq)+1);
+          }
           gt_sain_timer_logger_delete(tl);
           gt_free(suftab);
         }
@@ -416,6 +436,13 @@ static int gt_sain_runner(int argc, GT_UNUSED const char **argv,
                                                       tl->logger,
                                                       tl->timer);
           }
+          if (arguments->outsuftab)
+          {
+            gt_sain_showsuftab(suftab,
+                               gt_str_length(arguments->plainseqfile) > 0
+                                 ? (GtUword) len
+                                 : gt_bare_encseq_total_length(bare_encseq)+1);
+          }
           if (arguments->outlcptab)
           {
             unsigned int *lcptab;
@@ -136,6 +136,17 @@ static GtOptionParser* gt_tagerator_option_parser_new(void *tool_arguments)
   gt_option_exclude(optiononline,optioncmp);
   gt_option_is_development_option(optioncmp);
 
+  option = gt_option_new_uword_min("onlinebatch",
+                                   "Specify the number of tags searched "
+                                   "simultaneously in one scan over the "
+                                   "sequence (only relevant with option "
+                                   "-online)",
+                                   &arguments->onlinebatchsize,
+                                   64UL,1UL);
+  gt_option_parser_add_option(op, option);
+  gt_option_imply(option,optiononline);
+  gt_option_is_development_option(option);
+
   optionrw = gt_option_new_bool("rw","Replace wildcard in tag by random char",
                              &arguments->replacewildcard, false);
   gt_option_parser_add_option(op, optionrw);
@@ -24,6 +24,7 @@
 #include "core/ma_api.h"
 #include "core/option_api.h"
 #include "core/str.h"
+#include "core/str_array.h"
 #include "core/tool.h"
 #include "core/toolbox.h"
 #include "core/unused_api.h"
@@ -54,12 +55,15 @@ typedef struct
 {
   GtUword mersize,
                 userdefinedminocc,
-                userdefinedmaxocc;
+                userdefinedmaxocc,
+                maximumspace;
   unsigned int userdefinedprefixlength;
   Prefixlengthvalue prefixlength;
   GtOption *refoptionpl;
   GtStr *str_storeindex,
-        *str_inputindex;
+        *str_inputindex,
+        *memlimitarg;
+  GtStrArray *inputfiles;
   bool storecounts,
        performtest,
        verbose,
@@ -72,6 +76,8 @@ static void *gt_tyr_mkindex_arguments_new(void)
     = gt_malloc(sizeof (Tyr_mkindex_options));
   arguments->str_storeindex = gt_str_new();
   arguments->str_inputindex = gt_str_new();
+  arguments->memlimitarg = gt_str_new();
+  arguments->inputfiles = gt_str_array_new();
   return arguments;
 }
 
@@ -85,6 +91,8 @@ static void gt_tyr_mkindex_arguments_delete(void *tool_arguments)
   }
   gt_str_delete(arguments->str_storeindex);
   gt_str_delete(arguments->str_inputindex);
+  gt_str_delete(arguments->memlimitarg);
+  gt_str_array_delete(arguments->inputfiles);
   gt_option_delete(arguments->refoptionpl);
   gt_free(arguments);
 }
@@ -99,21 +107,40 @@ static GtOptionParser *gt_tyr_mkindex_option_parser_new(void *tool_arguments)
            *optionstoreindex,
            *optionstorecounts,
            *optionscan,
+           *optiontest,
+           *optiondb,
+           *optionmemlimit,
            *optionesa;
   Tyr_mkindex_options *arguments = tool_arguments;
 
   op = gt_option_parser_new("[options] -esa suffixerator-index [options]",
                             "Count and index k-mers in the given enhanced "
-                            "suffix array for a fixed value of k.");
+                            "suffix array or sequence files for a fixed "
+                            "value of k.");
   gt_option_parser_set_mail_address(op, "<kurtz@zbh.uni-hamburg.de>");
 
-  optionesa = gt_option_new_string("esa","specify suffixerator-index\n"
-                                   "(mandatory option)",
+  optionesa = gt_option_new_string("esa","specify suffixerator-index",
                                    arguments->str_inputindex,
                                    NULL);
-  gt_option_is_mandatory(optionesa);
   gt_option_parser_add_option(op, optionesa);
 
+  optiondb = gt_option_new_filename_array("db",
+                                          "specify DNA sequence files to "
+                                          "count the k-mers in without "
+                                          "constructing an index; the "
+                                          "k-mers are sorted in temporary "
+                                          "files",
+                                          arguments->inputfiles);
+  gt_option_parser_add_option(op, optiondb);
+
+  optionmemlimit = gt_option_new_string("memlimit",
+                                        "specify the maximal amount of "
+                                        "memory used for sorting the k-mers "
+                                        "of the sequence files (the keywords "
+                                        "'MB' and 'GB' are allowed)",
+                                        arguments->memlimitarg, "1GB");
+  gt_option_parser_add_option(op, optionmemlimit);
+
   option = gt_option_new_uword("mersize",
                                "Specify the mer size.",
                                &arguments->mersize,
@@ -157,11 +184,12 @@ static GtOptionParser *gt_tyr_mkindex_option_parser_new(void *tool_arguments)
                                          &arguments->storecounts,false);
   gt_option_parser_add_option(op, optionstorecounts);
 
-  option = gt_option_new_bool("test", "perform tests to verify program "
-                                      "correctness", &arguments->performtest,
-                                      false);
-  gt_option_is_development_option(option);
-  gt_option_parser_add_option(op, option);
+  optiontest = gt_option_new_bool("test", "perform tests to verify program "
+                                          "correctness",
+                                  &arguments->performtest,
+                                  false);
+  gt_option_is_development_option(optiontest);
+  gt_option_parser_add_option(op, optiontest);
 
   optionscan = gt_option_new_bool("scan",
                                   "read enhanced suffix array sequentially "
@@ -173,6 +201,11 @@ static GtOptionParser *gt_tyr_mkindex_option_parser_new(void *tool_arguments)
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
 
+  gt_option_is_mandatory_either(optionesa, optiondb);
+  gt_option_exclude(optionesa, optiondb);
+  gt_option_exclude(optiondb, optionscan);
+  gt_option_exclude(optiondb, optiontest);
+  gt_option_imply(optionmemlimit, optiondb);
   gt_option_imply(optionpl, optionstoreindex);
   gt_option_imply(optionstorecounts, optionstoreindex);
   gt_option_imply_either_2(optionstoreindex,optionminocc,optionmaxocc);
@@ -206,6 +239,13 @@ static int gt_tyr_mkindex_arguments_check(int rest_argc,
     arguments->prefixlength.flag = Undeterminedprefixlength;
     arguments->prefixlength.value = 0;
   }
+  if (gt_option_parse_spacespec(&arguments->maximumspace,
+                                "memlimit",
+                                arguments->memlimitarg,
+                                err) != 0)
+  {
+    return -1;
+  }
   return 0;
 }
 
@@ -256,20 +296,51 @@ static int gt_tyr_mkindex_runner(GT_UNUSED int argc,
     {
       printf("# storeindex=%s\n",gt_str_get(arguments->str_storeindex));
     }
-    printf("# inputindex=%s\n",gt_str_get(arguments->str_inputindex));
+    if (gt_str_array_size(arguments->inputfiles) > 0)
+    {
+      GtUword idx;
+
+      printf("# inputfiles=");
+      for (idx = 0; idx < gt_str_array_size(arguments->inputfiles); idx++)
+      {
+        printf("%s%s",idx == 0 ? "" : " ",
+               gt_str_array_get(arguments->inputfiles,idx));
+      }
+      printf("\n");
+    } else
+    {
+      printf("# inputindex=%s\n",gt_str_get(arguments->str_inputindex));
+    }
   }
-  if (gt_merstatistics(gt_str_get(arguments->str_inputindex),
-                    arguments->mersize,
-                    arguments->userdefinedminocc,
-                    arguments->userdefinedmaxocc,
-                    gt_str_get(arguments->str_storeindex),
-                    arguments->storecounts,
-                    arguments->scanfile,
-                    arguments->performtest,
-                    logger,
-                    err) != 0)
+  if (gt_str_array_size(arguments->inputfiles) > 0)
   {
-    haserr = true;
+    if (gt_merstatistics_stream(arguments->inputfiles,
+                                arguments->mersize,
+                                arguments->userdefinedminocc,
+                                arguments->userdefinedmaxocc,
+                                gt_str_get(arguments->str_storeindex),
+                                arguments->storecounts,
+                                arguments->maximumspace,
+                                logger,
+                                err) != 0)
+    {
+      haserr = true;
+    }
+  } else
+  {
+    if (gt_merstatistics(gt_str_get(arguments->str_inputindex),
+                      arguments->mersize,
+                      arguments->userdefinedminocc,
+                      arguments->userdefinedmaxocc,
+                      gt_str_get(arguments->str_storeindex),
+                      arguments->storecounts,
+                      arguments->scanfile,
+                      arguments->performtest,
+                      logger,
+                      err) != 0)
+    {
+      haserr = true;
+    }
   }
   if (!haserr &&
       gt_str_length(arguments->str_storeindex) > 0 &&
@@ -796,6 +867,7 @@ typedef struct
   GtStrArray *showmodespec;
   unsigned int strand,
                showmode;
+  GtUword batchsize;
   bool verbose,
        performtest;
 } Tyr_search_options;
@@ -866,6 +938,16 @@ static GtOptionParser *gt_tyr_search_option_parser_new(void *tool_arguments)
                                       arguments->showmodespec);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_uword("batch",
+                               "search the k-mers in blocks of the given "
+                               "size by sorting them and merging them with "
+                               "the index; the blocks are processed in "
+                               "parallel (use 0 to search each k-mer "
+                               "separately)",
+                               &arguments->batchsize,
+                               0);
+  gt_option_parser_add_option(op, option);
+
   option = gt_option_new_bool("test", "perform tests to verify program "
                                       "correctness", &arguments->performtest,
                                       false);
@@ -941,6 +1023,7 @@ static int gt_tyr_search_runner(GT_UNUSED int argc,
                    arguments->queryfilenames,
                    arguments->showmode,
                    arguments->strand,
+                   arguments->batchsize,
                    arguments->verbose,
                    arguments->performtest,
                    err) != 0)
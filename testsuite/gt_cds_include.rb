@@ -101,6 +101,18 @@ Test do
   run "diff #{last_stdout} #{$testdata}nGASP/resIIIcds.gff3"
 end
 
+Name "gt cds test (nGASP, multiple threads)"
+Keywords "gt_cds nGASP"
+Test do
+  run_test "#{$bin}gt -j 4 cds -startcodon yes -finalstopcodon no " +
+           "-minorflen 64 -seqfile #{$testdata}nGASP/III.fas -usedesc " +
+           "#{$testdata}nGASP/resIII.gff3"
+  run "diff #{last_stdout} #{$testdata}nGASP/resIIIcds.gff3"
+  run_test "#{$bin}gt -j 4 cds -seqfile #{$testdata}U89959_genomic.fas " +
+           "-usedesc #{$testdata}nGASP/resIII.gff3", :retval => 1
+  grep last_stderr, 'no sequence with ID "III" found'
+end
+
 Name "gt cds test (U89959)"
 Keywords "gt_cds"
 Test do
@@ -54,6 +54,46 @@ Test do
   grep(last_stderr, /cannot open file.*ois/)
 end
 
+Name "gt encseq encode multithreaded"
+Keywords "encseq gt_encseq_encode multithread"
+Test do
+  [["#{$testdata}at1MB " * 3, "-dna"],
+   ["#{$testdata}U89959_ests.fas #{$testdata}Random-Small.fna", ""],
+   ["#{$testdata}sw100K1.fsa", "-protein"]].each do |files, alpha|
+    run_test "#{$bin}gt encseq encode -lossless #{alpha} -indexname serial " +
+             files
+    [2, 4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} encseq encode -lossless #{alpha} " +
+               "-indexname parallel #{files}"
+      ["esq", "des", "sds", "ssp", "md5", "ois"].each do |suffix|
+        if File.exist?("serial.#{suffix}")
+          run "cmp serial.#{suffix} parallel.#{suffix}"
+        end
+      end
+    end
+  end
+end
+
+Name "gt encseq check substring extraction"
+Keywords "encseq gt_encseq_check extract"
+Test do
+  ["Atinsert.fna", "RandomN.fna", "Duplicate.fna"].each do |file|
+    ["direct", "bit", "uchar", "ushort", "uint32"].each do |sat|
+      run_test "#{$bin}gt encseq encode -sat #{sat} -indexname sfx " +
+               "#{$testdata}#{file}"
+      run_test "#{$bin}gt encseq check -scantrials 100 sfx", :maxtime => 120
+    end
+  end
+  run_test "#{$bin}gt encseq encode -sat eqlen -indexname sfx " +
+           "#{$testdata}readjoiner/70x_100nt.fas"
+  run_test "#{$bin}gt encseq check -scantrials 100 sfx"
+  ["fwd", "rev", "cpl", "rcl"].each do |readmode|
+    run_test "#{$bin}gt encseq bench -substrext 100 -substrlen 50 " +
+             "-readmode #{readmode} sfx"
+    grep last_stdout, /ccsum=/
+  end
+end
+
 STDREADMODES  = ["fwd", "rev"]
 DNAREADMODES  = STDREADMODES + ["cpl", "rcl"]
 DNATESTSEQS   = ["#{$testdata}foobar.fas",
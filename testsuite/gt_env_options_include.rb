@@ -11,3 +11,42 @@ Test do
   run "env GT_ENV_OPTIONS=-spacepeak #{$bin}gt gff3 #{$testdata}standard_gene_as_tree.gff3"
   grep last_stdout, /space peak in megabytes/
 end
+
+Name "$GT_ENV_OPTIONS parsing (-mmap*)"
+Keywords "gt_env_options"
+Test do
+  run "#{$bin}gt suffixerator -db #{$testdata}Atinsert.fna -indexname sfx " +
+      "-dna -suf -tis -lcp"
+  run "#{$bin}gt uniquesub -min 10 -max 20 -esa sfx " +
+      "-query #{$testdata}U89959_genomic.fas"
+  run "mv #{last_stdout} uniquesub.out"
+  ["-mmappopulate -mmaphugepages -mmapaccess random",
+   "-mmapinterleave -mmapaccess sequential",
+   "-mmapaccess willneed"].each do |opts|
+    run "env GT_ENV_OPTIONS='#{opts}' #{$bin}gt uniquesub -min 10 -max 20 " +
+        "-esa sfx -query #{$testdata}U89959_genomic.fas"
+    run "cmp #{last_stdout} uniquesub.out"
+  end
+  run("env GT_ENV_OPTIONS='-mmapaccess often' #{$bin}gt encseq info sfx")
+  grep last_stderr, /must be one of/
+end
+
+Name "$GT_ENV_OPTIONS parsing (-statsjson)"
+Keywords "gt_env_options"
+Test do
+  run "env GT_MEM_BOOKKEEPING=on GT_ENV_OPTIONS='-statsjson stats.json' " +
+      "#{$bin}gt suffixerator -db #{$testdata}Atinsert.fna -indexname sfx " +
+      "-dna -suf -lcp"
+  if File.size(last_stdout) > 0 then
+    raise TestFailed, "-statsjson without -showtime must not print times"
+  end
+  grep "stats.json", /"name": "sorting the buckets"/
+  grep "stats.json", /"total": \{"name": "total", "realtime": [0-9.]+/
+  grep "stats.json", /"heap_peak": [1-9]/
+  run "env GT_MEM_BOOKKEEPING=off " +
+      "GT_ENV_OPTIONS='-statsjson stats.json -showtime' " +
+      "#{$bin}gt suffixerator -db #{$testdata}Atinsert.fna -indexname sfx " +
+      "-dna -suf"
+  grep last_stdout, /# TIME sorting the buckets/
+  grep "stats.json", /"heap": null, "heap_peak": null/
+end
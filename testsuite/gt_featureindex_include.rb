@@ -1,4 +1,11 @@
-if not $arguments["nordb"] then
+# the following tests use the default backend, which is the sqlite backend if
+# it is compiled in (without a database the file backend is the default, it is
+# tested below)
+def featureindex_sqlite_backend?
+  !(`#{$bin}gt mkfeatureindex -help 2>&1` =~ /choose from \[[^\]]*sqlite/).nil?
+end
+
+if not $arguments["nordb"] and featureindex_sqlite_backend? then
 
   Name "gt featureindex (empty file)"
   Keywords "gt_featureindex"
@@ -66,3 +73,82 @@ if not $arguments["nordb"] then
   end
 
 end
+
+Name "gt featureindex file backend (empty file)"
+Keywords "gt_featureindex file_backend"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx #{$testdata}/gt_view_prob_1.gff3"
+  run "#{$bin}gt featureindex -backend file -filename tmp.idx", :retval => 1
+  grep(last_stderr, /no sequence regions in index/)
+end
+
+Name "gt featureindex file backend (empty region)"
+Keywords "gt_featureindex file_backend"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx #{$testdata}/gt_view_prob_2.gff3"
+  run "#{$bin}gt featureindex -backend file -filename tmp.idx"
+  run "diff #{last_stdout} #{$testdata}/gt_view_prob_2.gff3"
+end
+
+Name "gt featureindex file backend (parse error in GFF3)"
+Keywords "gt_featureindex file_backend"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx #{$testdata}/gt_gff3_fail_1.gff3", :retval => 1
+  grep(last_stderr, /has already been defined/)
+  run "#{$bin}gt featureindex -backend file -filename tmp.idx", :retval => 1
+  grep(last_stderr, /cannot open file/)
+end
+
+Name "gt featureindex file backend (existing file)"
+Keywords "gt_featureindex file_backend"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx #{$testdata}/standard_gene_simple.gff3"
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx #{$testdata}/standard_gene_simple.gff3", :retval => 1
+  grep(last_stderr, /exists already/)
+  run "#{$bin}gt mkfeatureindex -force -backend file -filename tmp.idx #{$testdata}/standard_gene_simple.gff3"
+end
+
+Name "gt featureindex file backend (invalid sequence ID)"
+Keywords "gt_featureindex file_backend"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx #{$testdata}/standard_gene_simple.gff3"
+  run "#{$bin}gt featureindex -backend file -seqid foo -filename tmp.idx", :retval => 1
+  grep(last_stderr, /does not contain the given sequence id/)
+end
+
+Name "gt featureindex file backend (corrupt file)"
+Keywords "gt_featureindex file_backend"
+Test do
+  File.open("corrupt.idx", "w") do |file|
+    file.write("sdfnhsnl")
+  end
+  run "#{$bin}gt featureindex -backend file -filename corrupt.idx", :retval => 1
+  grep(last_stderr, /not a feature index file/)
+end
+
+["eden.gff3", "standard_gene_simple.gff3", "standard_gene_as_tree.gff3",
+ "standard_gene_with_introns_as_tree.gff3",
+ "encode_known_genes_Mar07.gff3"].each do |file|
+  Name "gt featureindex file backend vs. parser (#{file})"
+  Keywords "gt_featureindex file_backend"
+  Test do
+    run "#{$bin}gt seqids #{$testdata}/#{file}"
+    seqids = File.open(last_stdout).readlines
+    run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx #{$testdata}/#{file}"
+    seqids.each do |seqid|
+      seqid.chomp!
+      run "#{$bin}gt featureindex -backend file -seqid #{seqid} -retain no -filename tmp.idx > out.gff3"
+      run "#{$bin}gt gff3 -retainids no #{$testdata}/#{file} | #{$bin}gt select -seqid #{seqid}"
+      run "diff out.gff3 #{last_stdout}"
+    end
+  end
+end
+
+Name "gt featureindex file backend (range query)"
+Keywords "gt_featureindex file_backend"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend file -filename tmp.idx #{$testdata}/encode_known_genes_Mar07.gff3"
+  run "#{$bin}gt featureindex -backend file -seqid chr10 -range 55238349 55300000 -retain no -filename tmp.idx > out.gff3"
+  run "#{$bin}gt gff3 -retainids no #{$testdata}/encode_known_genes_Mar07.gff3 | #{$bin}gt select -seqid chr10 -overlap 55238349 55300000"
+  run "diff out.gff3 #{last_stdout}"
+end
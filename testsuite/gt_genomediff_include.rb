@@ -332,6 +332,23 @@ check_shulen_for_list_pairwise(allfiles)
 
 check_shulen_for_list_pairwise(bigfiles)
 
+# with -j the enhanced suffix array is read in sections which are split into
+# parts, the result must not depend on the number of jobs
+[2, 4].each do |jobs|
+  Name "gt genomediff esa -j #{jobs}"
+  Keywords "gt_genomediff esa multithreading"
+  Test do
+    run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB " +
+             "#{$testdata}U89959_genomic.fas #{$testdata}Atinsert.fna " +
+             "-indexname esa -dna -suf -tis -lcp -ssp"
+    run_test "#{$bin}gt -j 1 genomediff -indextype esa esa", :maxtime => 600
+    run "mv #{last_stdout} serial.out"
+    run_test "#{$bin}gt -j #{jobs} genomediff -indextype esa esa",
+             :maxtime => 600
+    run "diff #{last_stdout} serial.out"
+  end
+end
+
 Name "gt genomediff smallfiles all at once"
 Keywords "gt_genomediff esa pck small check_shulen"
 Test do
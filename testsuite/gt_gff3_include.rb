@@ -1390,6 +1390,203 @@ Test do
   grep last_stderr, "wrong separator"
 end
 
+["encode_known_genes_Mar07.gff3", "standard_fasta_example.gff3",
+ "two_fasta_seqs.gff3", "gt_gff3_test_3.gff3",
+ "standard_gene_as_tree.gff3"].each do |file|
+  Name "gt gff3 multithreaded parsing (#{file})"
+  Keywords "gt_gff3 multithread"
+  Test do
+    run_test "#{$bin}gt gff3 -sort #{$testdata}#{file}"
+    run "mv #{last_stdout} serial.gff3"
+    run_test "#{$bin}gt -j 4 gff3 -sort #{$testdata}#{file}"
+    run "diff #{last_stdout} serial.gff3"
+  end
+end
+
+# the features on ctg2 are not separated by terminators and exceed the maximum
+# chunk size, the rest of the file is parsed serially
+def write_unterminated_gff3(filename, last_end)
+  File.open(filename, "w") do |f|
+    f.puts "##gff-version 3"
+    f.puts "##sequence-region ctg1 1 100000000"
+    1.upto(15000) do |i|
+      f.puts "ctg1\t.\tgene\t#{i*10}\t#{i*10+200}\t.\t+\t.\tID=first#{i}"
+      f.puts "###" if i % 100 == 0
+    end
+    f.puts "ctg1\t.\tCDS\t10\t20\t.\t+\t0\tID=cds0"
+    f.puts "ctg1\t.\tCDS\t30\t40\t.\t+\t1\tID=cds0"
+    f.puts "###"
+    f.puts "##sequence-region ctg2 1 100000000"
+    1.upto(200000) do |i|
+      f.puts "ctg2\t.\tgene\t#{i*10}\t#{i*10+200}\t.\t+\t.\tID=gene#{i}"
+    end
+    1.step(200000, 1000) do |i|
+      f.puts "ctg2\t.\texon\t#{i*10}\t#{i*10+100}\t.\t+\t.\tParent=gene#{i}"
+    end
+    f.puts "ctg1\t.\tgene\t100\t#{last_end}\t.\t+\t.\tID=last"
+  end
+end
+
+Name "gt gff3 multithreaded parsing without terminators"
+Keywords "gt_gff3 multithread"
+Test do
+  write_unterminated_gff3("unterminated.gff3", 200)
+  run_test "#{$bin}gt gff3 -sort unterminated.gff3", :maxtime => 300
+  run "mv #{last_stdout} serial.gff3"
+  run_test "#{$bin}gt -j 4 gff3 -sort unterminated.gff3", :maxtime => 300
+  run "diff #{last_stdout} serial.gff3"
+  write_unterminated_gff3("outside.gff3", 200000000)
+  run_test "#{$bin}gt -j 4 gff3 outside.gff3", :retval => 1, :maxtime => 300
+  grep last_stderr, /line 215357 .* is not contained in range \(1,100000000\)/
+end
+
+# the features are not separated by terminators, but the sequence ids change
+# often enough to split the file into chunks at the sequence id boundaries
+def write_seqid_split_gff3(filename, mode)
+  gene = lambda do |s, g|
+    st = g * 1000 + 1
+    ["seq#{s}\tt\tgene\t#{st}\t#{st+800}\t.\t+\t.\tID=g#{s}_#{g}",
+     "seq#{s}\tt\tmRNA\t#{st}\t#{st+800}\t.\t+\t.\tID=m#{s}_#{g};" +
+     "Parent=g#{s}_#{g}",
+     "seq#{s}\tt\texon\t#{st}\t#{st+300}\t.\t+\t.\tParent=m#{s}_#{g}",
+     "seq#{s}\tt\tCDS\t#{st+10}\t#{st+300}\t.\t+\t0\tID=c#{s}_#{g};" +
+     "Parent=m#{s}_#{g}",
+     "seq#{s}\tt\texon\t#{st+500}\t#{st+800}\t.\t+\t.\tParent=m#{s}_#{g}",
+     "seq#{s}\tt\tCDS\t#{st+500}\t#{st+700}\t.\t+\t0\tID=c#{s}_#{g};" +
+     "Parent=m#{s}_#{g}"]
+  end
+  lines = []
+  case mode
+  when "bytype"
+    0.upto(5) do |k|
+      0.upto(399) { |s| 0.upto(39) { |g| lines.push(gene.call(s, g)[k]) } }
+    end
+  when "childfirst"
+    0.upto(399) { |s| 0.upto(39) { |g| lines.concat(gene.call(s, g)[1..-1]) } }
+    0.upto(399) { |s| 0.upto(39) { |g| lines.push(gene.call(s, g)[0]) } }
+  else
+    0.upto(399) { |s| 0.upto(39) { |g| lines.concat(gene.call(s, g)) } }
+  end
+  case mode
+  when "dupid"
+    lines.push("seq400\tt\tgene\t1\t100\t.\t+\t.\tID=g3_5")
+  when "missing"
+    lines.push("seq400\tt\tmRNA\t1\t100\t.\t+\t.\tParent=nogene")
+  end
+  File.open(filename, "w") do |f|
+    f.puts "##gff-version 3"
+    lines.each { |line| f.puts line }
+  end
+end
+
+[["sorted", 0], ["bytype", 0], ["childfirst", 0], ["dupid", 1],
+ ["missing", 1]].each do |mode, retval|
+  Name "gt gff3 multithreaded parsing at seqid boundaries (#{mode})"
+  Keywords "gt_gff3 multithread"
+  Test do
+    write_seqid_split_gff3("#{mode}.gff3", mode)
+    run_test "#{$bin}gt gff3 -sort #{mode}.gff3", :retval => retval,
+             :maxtime => 300
+    run "mv #{last_stdout} serial.gff3"
+    run "mv #{last_stderr} serial.err"
+    run_test "#{$bin}gt -j 4 gff3 -sort #{mode}.gff3", :retval => retval,
+             :maxtime => 300
+    run "diff #{last_stdout} serial.gff3"
+    run "diff #{last_stderr} serial.err"
+  end
+end
+
+Name "gt gff3 multithreaded reading of compressed files"
+Keywords "gt_gff3 multithread compressed"
+Test do
+  run "cp #{$testdata}encode_known_genes_Mar07.gff3 encode.gff3"
+  run "gzip -c encode.gff3 > encode.gff3.gz"
+  run "bzip2 -c encode.gff3 > encode.gff3.bz2"
+  run_test "#{$bin}gt gff3 -sort encode.gff3"
+  run "mv #{last_stdout} serial.gff3"
+  ["encode.gff3.gz", "encode.gff3.bz2",
+   "#{$testdata}encode_known_genes_Mar07_bgzf.gff3.gz"].each do |file|
+    [2, 4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} gff3 -sort #{file}"
+      run "diff #{last_stdout} serial.gff3"
+    end
+  end
+end
+
+Name "gt gff3 multithreaded writing of compressed files"
+Keywords "gt_gff3 multithread compressed"
+Test do
+  run_test "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} serial.gff3"
+  [2, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} gff3 -sort -gzip -force -o out.gff3.gz " +
+             "#{$testdata}encode_known_genes_Mar07.gff3"
+    run "gzip -dc out.gff3.gz > out.gff3"
+    run "diff out.gff3 serial.gff3"
+    run_test "#{$bin}gt -j #{jobs} gff3 -sort out.gff3.gz"
+    run "diff #{last_stdout} serial.gff3"
+  end
+end
+
+Name "gt gff3 multithreaded parsing (parse error)"
+Keywords "gt_gff3 multithread"
+Test do
+  run_test "#{$bin}gt -j 4 gff3 #{$testdata}gt_gff3_fail_1.gff3",
+           :retval => 1
+  grep last_stderr, "has already been defined"
+end
+
+["encode_known_genes_Mar07.gff3", "standard_fasta_example.gff3",
+ "gt_gff3_test_3.gff3"].each do |file|
+  Name "gt gff3 -memlimit (#{file})"
+  Keywords "gt_gff3 memlimit"
+  Test do
+    run_test "#{$bin}gt gff3 -sort #{$testdata}#{file}"
+    run "mv #{last_stdout} internal.gff3"
+    run_test "#{$bin}gt gff3 -sort -memlimit 1MB #{$testdata}#{file}"
+    run "diff #{last_stdout} internal.gff3"
+  end
+end
+
+# every tenth gene has the same range, which checks the stability of the merge
+def write_shuffled_gff3(filename, num_of_genes)
+  r = Random.new(42)
+  File.open(filename, "w") do |f|
+    f.puts "##gff-version 3"
+    1.upto(3) { |s| f.puts "##sequence-region seq#{s} 1 10000000" }
+    1.upto(num_of_genes) do |i|
+      s = r.rand(3) + 1
+      start = i % 10 == 0 ? 5000 : r.rand(9000000) + 1
+      f.puts "seq#{s}\t.\tgene\t#{start}\t#{start+999}\t.\t+\t.\tID=gene#{i}"
+      f.puts "seq#{s}\t.\texon\t#{start}\t#{start+99}\t.\t+\t.\t" +
+             "Parent=gene#{i}"
+      f.puts "###"
+    end
+  end
+end
+
+# about 30 runs, more than are merged at once
+Name "gt gff3 -memlimit (many runs)"
+Keywords "gt_gff3 memlimit"
+Test do
+  write_shuffled_gff3("shuffled.gff3", 60000)
+  run_test "#{$bin}gt gff3 -sort shuffled.gff3", :maxtime => 300
+  run "mv #{last_stdout} internal.gff3"
+  run_test "#{$bin}gt gff3 -sort -memlimit 1MB shuffled.gff3", :maxtime => 300
+  run "cmp #{last_stdout} internal.gff3"
+  run_test "sh -c 'ulimit -n 10 && #{$bin}gt gff3 -sort -memlimit 1MB " +
+           "shuffled.gff3'", :maxtime => 300
+  run "cmp #{last_stdout} internal.gff3"
+end
+
+Name "gt gff3 -memlimit (invalid argument)"
+Keywords "gt_gff3 memlimit"
+Test do
+  run_test "#{$bin}gt gff3 -sort -memlimit 1TB " +
+           "#{$testdata}standard_gene_as_tree.gff3", :retval => 1
+  grep last_stderr, "followed by one of the keywords MB and GB"
+end
+
 def large_gff3_test(name, file)
   Name "gt gff3 #{name}"
   Keywords "gt_gff3 large_gff3"
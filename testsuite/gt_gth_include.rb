@@ -0,0 +1,25 @@
+# the spliced alignments of a chain collection are computed in parallel with
+# -j, the output (including the call numbers shown by -gs2out and the verbose
+# output) must not depend on the number of jobs
+def remove_gth_dates(outfile, resultfile)
+  run "grep -v -e 'Date run:' -e 'date finished:' -e 'run_date=' " +
+      "#{outfile} > #{resultfile}"
+end
+
+[["", "default"], ["-gs2out", "gs2out"], ["-v", "verbose"],
+ ["-gff3out", "gff3out"], ["-xmlout", "xmlout"]].each do |opt, desc|
+  [2, 4].each do |jobs|
+    Name "gt gth -j #{jobs} (#{desc})"
+    Keywords "gt_gth multithreading"
+    Test do
+      run "cp #{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas ."
+      run_test "#{$bin}gt -j 1 gth #{opt} -genomic U89959_genomic.fas " +
+               "-cdna U89959_ests.fas", :maxtime => 600
+      remove_gth_dates(last_stdout, "serial.out")
+      run_test "#{$bin}gt -j #{jobs} gth #{opt} -genomic U89959_genomic.fas " +
+               "-cdna U89959_ests.fas", :maxtime => 600
+      remove_gth_dates(last_stdout, "parallel.out")
+      run "diff parallel.out serial.out"
+    end
+  end
+end
@@ -52,6 +52,12 @@ def checktagerator(queryfile,ms)
     run_test("#{$bin}gt tagerator -rw -cmp -esa sfx -q patternfile " +
              " -maxocc 10",
              :maxtime => 240)
+    run_test("#{$bin}gt tagerator -rw -online -e 1 -esa sfx -q patternfile " +
+             "-onlinebatch 1",:maxtime => 240)
+    run "mv #{last_stdout} tmp.online"
+    run_test("#{$bin}gt tagerator -rw -online -e 1 -esa sfx -q patternfile",
+             :maxtime => 240)
+    run "cmp -s #{last_stdout} tmp.online"
     run_test "#{$bin}gt prebwt -maxdepth 4 -pck pck", :maxtime => 180
     run_test("#{$bin}gt tagerator -rw -cmp -e 0 -pck pck -q patternfile",
              :maxtime => 240)
@@ -141,6 +147,49 @@ Test do
   run_test "#{$bin}gt dev patternmatch -samples 10000 -ii sfx"
 end
 
+Name "gt tagerator multiple threads"
+Keywords "gt_tagerator"
+Test do
+  run "#{$bin}gt suffixerator -indexname sfx -tis -suf -ssp -dna " +
+      "-db #{$testdata}Atinsert.fna"
+  run "#{$bin}gt packedindex mkindex -tis -ssp -indexname pck " +
+      "-db #{$testdata}Atinsert.fna -sprank -dna -pl -bsize 10 " +
+      "-locfreq 32 -dir rev", :maxtime => 180
+  run "#{$bin}gt prebwt -maxdepth 4 -pck pck"
+  # more tags than fit into one batch of two threads
+  run "for i in 1 2 3 4 5 6; do " +
+      "#{$bin}gt shredder -minlength 12 -maxlength 30 " +
+      "#{$testdata}Atinsert.fna; done | " +
+      "#{$bin}gt seqfilter -minlength 12 -maxlength 32 - | " +
+      "sed -e \'s/^>.*/>/\' > patternfile"
+  ["-esa sfx", "-pck pck"].each do |index|
+    ["-e 0", "-e 2", "-e 1 -best -output dbstartpos dbsequence strand edist",
+     "-maxocc 10", "-e 1 -maxocc 5 -skpp"].each do |opts|
+      run_test("#{$bin}gt -j 1 tagerator -rw #{opts} #{index} " +
+               "-q patternfile", :maxtime => 240)
+      run "mv #{last_stdout} tmp.serial"
+      [2, 3].each do |jobs|
+        run_test("#{$bin}gt -j #{jobs} tagerator -rw #{opts} #{index} " +
+                 "-q patternfile", :maxtime => 240)
+        run "cmp #{last_stdout} tmp.serial"
+      end
+    end
+  end
+end
+
+Name "gt tagerator wildcard in tag"
+Keywords "gt_tagerator"
+Test do
+  run "#{$bin}gt suffixerator -indexname sfx -tis -suf -dna " +
+      "-db #{$testdata}Atinsert.fna"
+  run "printf '>first\\nacgtacgtacgt\\n>second\\nacgtnacgtacgt\\n' " +
+      "> patternfile"
+  run_test("#{$bin}gt tagerator -e 0 -esa sfx -q patternfile",
+           :retval => 1)
+  grep last_stderr, /wildcard in tag number 1/
+  run_test("#{$bin}gt tagerator -rw -e 0 -esa sfx -q patternfile")
+end
+
 Name "gt repfind small"
 Keywords "gt_repfind"
 Test do
@@ -156,6 +205,35 @@ Test do
   run "#{$bin}gt repfind -samples 1000 -l 6 -ii sfx",:maxtime => 600
 end
 
+# with -j the enhanced suffix array of at1MB is read in sections which are
+# split into parts, the output must not depend on the number of jobs
+[2, 4].each do |jobs|
+  Name "gt repfind -j #{jobs}"
+  Keywords "gt_repfind multithreading"
+  Test do
+    run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB " +
+             "-indexname sfx -dna -tis -suf -lcp -ssp"
+    ["-l 20", "-l 20 -r", "-l 14"].each do |opt|
+      run_test "#{$bin}gt -j 1 repfind #{opt} -ii sfx", :maxtime => 600
+      run "mv #{last_stdout} serial.out"
+      run_test "#{$bin}gt -j #{jobs} repfind #{opt} -ii sfx", :maxtime => 600
+      run "diff #{last_stdout} serial.out"
+    end
+  end
+
+  Name "gt shulengthdist -j #{jobs}"
+  Keywords "gt_shulengthdist multithreading"
+  Test do
+    run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB " +
+             "#{$testdata}U89959_genomic.fas #{$testdata}Atinsert.fna " +
+             "-indexname sfx -dna -tis -suf -lcp -ssp"
+    run_test "#{$bin}gt -j 1 shulengthdist -ii sfx", :maxtime => 600
+    run "mv #{last_stdout} serial.out"
+    run_test "#{$bin}gt -j #{jobs} shulengthdist -ii sfx", :maxtime => 600
+    run "diff #{last_stdout} serial.out"
+  end
+end
+
 if $gttestdata then
   Name "gt repfind extend at1MB"
   Keywords "gt_repfind extend"
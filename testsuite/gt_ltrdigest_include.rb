@@ -185,6 +185,24 @@ def check_amino_acid_output(gff3file, chr, pdoms)
   end
 end
 
+Name "gt ltrdigest batched pHMM search (stub hmmscan)"
+Keywords "gt_ltrdigest"
+Test do
+  # the stubs stand in for HMMER, see testdata/ltrdigest_batch/hmmscan
+  env = "env PATH=#{$testdata}ltrdigest_batch:#{ENV['PATH']} TMPDIR=."
+  args = "-seqfile #{$testdata}U89959_genomic.fas -matchdesc " + \
+         "-hmms #{$testdata}ltrdigest_batch/stub.hmm -- " + \
+         "#{$testdata}ltrdigest_batch/candidates.gff3"
+  run_test "#{env} #{$bin}gt -j 1 ltrdigest -pdombatchsize 1 #{args}"
+  run "mv #{last_stdout} batch1.gff3"
+  grep "batch1.gff3", /protein_match.*Parent=LTR_retrotransposon10;/
+  [[1, 4], [3, 4], [3, 100]].each do |jobs, batchsize|
+    run_test "#{env} #{$bin}gt -j #{jobs} ltrdigest " + \
+             "-pdombatchsize #{batchsize} #{args}"
+    run "diff #{last_stdout} batch1.gff3"
+  end
+end
+
 if $gttestdata then
   Name "gt ltrdigest missing input GFF"
   Keywords "gt_ltrdigest"
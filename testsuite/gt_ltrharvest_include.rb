@@ -148,6 +148,46 @@ Test do
   run_test "#{$bin}gt ltrharvest -index Random.fna"
 end
 
+Name "gt ltrharvest multiple threads"
+Keywords "gt_ltrharvest"
+Test do
+  # sequences with planted LTR pairs
+  rng = Random.new(42)
+  rand_dna = lambda { |n| Array.new(n) { "acgt"[rng.rand(4)] }.join }
+  File.open("planted.fas", "w") do |f|
+    3.times do |k|
+      seq = ""
+      8.times do
+        ltr = "tg" + rand_dna.call(300 + rng.rand(400)) + "ca"
+        copy = ltr.chars.map { |c| rng.rand < 0.03 ? "acgt"[rng.rand(4)] : c }
+        tsd = rand_dna.call(5)
+        seq += rand_dna.call(2000 + rng.rand(3000)) + tsd + ltr +
+               rand_dna.call(3000 + rng.rand(4000)) + copy.join + tsd
+      end
+      f.puts ">seq#{k}"
+      f.puts seq + rand_dna.call(2000)
+    end
+  end
+  run_test "#{$bin}gt suffixerator -db planted.fas -dna -suf -sds -lcp " +
+           "-tis -des -ssp"
+  ["", "-similar 80 -overlaps all"].each_with_index do |opts, k|
+    run_test "#{$bin}gt -j 1 ltrharvest -index planted.fas -mintsd 4 " +
+             "-maxtsd 6 #{opts} -gff3 out.gff3"
+    run "mv #{last_stdout} j1_#{k}.out"
+    run "mv out.gff3 j1_#{k}.gff3"
+    if k == 0 then
+      run "grep -vc '^#' j1_#{k}.out"
+      grep last_stdout, /^24$/
+    end
+    [2, 4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} ltrharvest -index planted.fas -mintsd 4 " +
+               "-maxtsd 6 #{opts} -gff3 out.gff3"
+      run "diff #{last_stdout} j1_#{k}.out"
+      run "diff out.gff3 j1_#{k}.gff3"
+    end
+  end
+end
+
 Name "gt ltrharvest motif and motifmis"
 Keywords "gt_ltrharvest"
 Test do
@@ -94,6 +94,19 @@ Test do
                          :timeOuts => { :chksearch => 800 })
 end
 
+Name "gt packedindex check tools for simple sequences with interleaved occ"
+Keywords "gt_packedindex"
+Test do
+  allfiles = prependTestdata(myfilelist)
+  runAndCheckPackedIndex('miniindex', allfiles,
+                         :bdx => { '-sprank' => nil, '-occinterleave' => nil },
+                         :chksearch => { '-full-lfmap' => nil },
+                         :timeOuts => { :chksearch => 800 })
+  prependTestdata(['Random160.fna', 'Random159.fna']).each do |file|
+    runAndCheckPackedIndex(nil, [file], :bdx => { '-occinterleave' => nil })
+  end
+end
+
 Name "gt packedindex check tools for revcom sequence with sprank"
 Keywords "gt_packedindex"
 Test do
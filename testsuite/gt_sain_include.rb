@@ -0,0 +1,30 @@
+# the induced sorting steps of gt dev sain are split into parts with -j if
+# the sequence is long enough, the suffix array must not depend on the number
+# of jobs
+def sain_compare_jobs(input)
+  run_test "#{$bin}gt -j 1 dev sain -suf #{input}", :maxtime => 300
+  run "mv #{last_stdout} serial.out"
+  run_test "#{$bin}gt -j 4 dev sain -suf -fcheck -icheck #{input}",
+           :maxtime => 300
+  run "diff #{last_stdout} serial.out"
+end
+
+Name "gt dev sain -j 4 (dna)"
+Keywords "gt_sain multithreading"
+Test do
+  sain_compare_jobs("-dna -fasta #{$testdata}at1MB")
+end
+
+Name "gt dev sain -j 4 (protein)"
+Keywords "gt_sain multithreading"
+Test do
+  run "#{$bin}gt seqtranslate -reverse no -o at1MB.prot #{$testdata}at1MB"
+  sain_compare_jobs("-protein -fasta at1MB.prot")
+end
+
+Name "gt dev sain -j 4 (encseq)"
+Keywords "gt_sain multithreading"
+Test do
+  run "#{$bin}gt encseq encode -indexname at1MB #{$testdata}at1MB"
+  sain_compare_jobs("-esq at1MB")
+end
@@ -49,6 +49,80 @@ runtyrmkifail("-mersize 21 -pl")
 runtyrmkifail("-mersize 21 -pl -minocc")
 runtyrmkifail("-pl -minocc 30 -maxocc 40")
 
+def checktallymerstream(reffiles,mersize,memlimit)
+  reffilepaths=reffiles.map {|f| "#{$testdata}#{f}"}.join(" ")
+  outoptions="-counts -pl -mersize #{mersize} -minocc 2 -maxocc 30"
+  run_test "#{$bin}gt suffixerator -pl -dna -tis -suf -lcp " +
+           "-indexname sfxidx -db #{reffilepaths}"
+  run_test "#{$bin}gt tallymer mkindex #{outoptions} " +
+           "-indexname tyr-esa -esa sfxidx"
+  run_test "#{$bin}gt tallymer mkindex #{outoptions} -memlimit #{memlimit} " +
+           "-indexname tyr-db -db #{reffilepaths}"
+  ["mer","mct","mbd"].each do |suffix|
+    if File.exist?("tyr-esa.#{suffix}")
+      run "cmp -s tyr-esa.#{suffix} tyr-db.#{suffix}"
+    end
+  end
+  run_test "#{$bin}gt tallymer mkindex -mersize #{mersize} -esa sfxidx"
+  run "mv #{last_stdout} tyr-esa.dist"
+  run_test "#{$bin}gt tallymer mkindex -mersize #{mersize} " +
+           "-db #{reffilepaths}"
+  run "cmp -s #{last_stdout} tyr-esa.dist"
+end
+
+[[["Atinsert.fna"], 12, "1GB"],
+ [["at1MB"], 20, "1MB"],
+ [["RandomN.fna"], 3, "1GB"],
+ [["Atinsert.fna", "U89959_genomic.fas"], 9, "1MB"]].each do |reffiles,
+                                                            mersize,
+                                                            memlimit|
+  Name "gt tallymer mkindex -db #{reffiles.join(' ')} #{mersize}"
+  Keywords "gt_tallymer mkindex stream"
+  Test do
+    checktallymerstream(reffiles,mersize,memlimit)
+  end
+end
+
+Name "gt tallymer mkindex -db and -esa"
+Keywords "gt_tallymer mkindex stream"
+Test do
+  run_test "#{$bin}gt tallymer mkindex -mersize 10 -db " +
+           "#{$testdata}Atinsert.fna -esa sfxidx", :retval => 1
+  grep last_stderr, /exclude each other/
+end
+
+Name "gt tallymer mkindex -db mersize too large"
+Keywords "gt_tallymer mkindex stream"
+Test do
+  run_test "#{$bin}gt tallymer mkindex -mersize 33 -db " +
+           "#{$testdata}Atinsert.fna", :retval => 1
+  grep last_stderr, /mersize must be in the range/
+end
+
+Name "gt tallymer search -batch"
+Keywords "gt_tallymer search batch"
+Test do
+  query = "#{$testdata}Atinsert.fna #{$testdata}U89959_genomic.fas"
+  searchoptions = "-strand fp -output qseqnum qpos counts sequence"
+  run_test "#{$bin}gt suffixerator -pl -dna -tis -suf -lcp " +
+           "-indexname sfxidx -db #{$testdata}at1MB"
+  [7, 20, 32].each do |mersize|
+    run_test "#{$bin}gt tallymer mkindex -counts -pl -mersize #{mersize} " +
+             "-minocc 1 -indexname tyr-index -esa sfxidx"
+    run_test "#{$bin}gt tallymer search #{searchoptions} " +
+             "-tyr tyr-index -q #{query}"
+    run "mv #{last_stdout} tyr-search.out"
+    run_test "#{$bin}gt -j 4 tallymer search #{searchoptions} -batch 100 " +
+             "-tyr tyr-index -q #{query}"
+    run "cmp -s #{last_stdout} tyr-search.out"
+  end
+  run_test "#{$bin}gt tallymer mkindex -mersize 33 -minocc 1 " +
+           "-indexname tyr-index -esa sfxidx"
+  run_test "#{$bin}gt tallymer search -batch 100 -tyr tyr-index " +
+           "-q #{query}", :retval => 1
+  grep last_stderr, /requires a mersize of at most/
+end
+
 if $gttestdata then
   tyrfiles.each_pair do |reffile,mersize|
     Name "gt tallymer #{reffile}"
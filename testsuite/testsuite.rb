@@ -141,6 +141,10 @@ def python_tests_runnable?
   end
 end
 
+def gth_tests_runnable?
+  system("#{$bin}gt gth -help > /dev/null 2>&1")
+end
+
 def ruby_tests_runnable?
   rv = RUBY_VERSION.match(/^(\d+\.\d+)/)
   if rv.nil? or rv[1].to_f >= 1.9 then
@@ -173,6 +177,9 @@ require 'gt_genomediff_include'
 require 'gt_gff3_include'
 require 'gt_gff3validator_include'
 require 'gt_gtf_to_gff3_include'
+if gth_tests_runnable? then
+  require 'gt_gth_include'
+end
 require 'gt_hop_include'
 require 'gt_id_to_md5_include'
 require 'gt_include'
@@ -233,6 +240,7 @@ require 'gt_extractseq_include'
 require 'gt_idxsearch_include'
 require 'gt_mergeesa_include'
 require 'gt_packedindex_include'
+require 'gt_sain_include'
 require 'gt_sortbench_include'
 require 'gt_suffixerator_include'
 require 'gt_encseq2spm_include'